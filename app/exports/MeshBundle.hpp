@@ -6,6 +6,7 @@
 #include <BoundingVolumes.hpp>
 
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 
 struct Vertex
 {
@@ -14,6 +15,33 @@ struct Vertex
 	DirectX::XMFLOAT2 uv;
 };
 
+// Half the size of the Vertex. The attributes must be decoded with the VertexQuantisation of
+// their mesh.
+struct QuantisedVertex
+{
+	// Relative to the position bounds of the mesh. The w is unused.
+	DirectX::PackedVector::XMUSHORTN4 position;
+	// Octahedral encoded.
+	DirectX::PackedVector::XMSHORTN2  normal;
+	// Relative to the uv bounds of the mesh, so the uvs outside of 0 to 1 can be kept.
+	DirectX::PackedVector::XMUSHORTN2 uv;
+};
+
+// The bounds the attributes of a mesh were quantised to. The w components are unused.
+struct VertexQuantisation
+{
+	DirectX::XMFLOAT4 positionMin;
+	DirectX::XMFLOAT4 positionExtent;
+	// The xy are the minimum and the zw are the extent.
+	DirectX::XMFLOAT4 uvBounds;
+};
+
+enum class VertexLayout
+{
+	Float,
+	Quantised
+};
+
 struct Meshlet
 {
 	std::uint32_t indexCount;
@@ -26,10 +54,18 @@ struct MeshTemporaryDetailsVS
 {
 	std::uint32_t          indexCount;
 	std::uint32_t          indexOffset;
+	// The first vertex of the mesh. The indices have already been offset with it.
+	std::uint32_t          vertexOffset;
 	// Can't really offset the indices in the shader on a Vertex Shader,
 	// as the Input Assembler will handle that. So, will have to offset it
 	// while generating the data.
 	AxisAlignedBoundingBox aabb;
+	// The coarser levels of detail of the mesh are the lodCount details from the lodOffset,
+	// from the finest to the coarsest. They are after the details of all of the meshes. The
+	// lodError of a level is its simplification error, as a distance in the model space.
+	std::uint32_t          lodOffset = 0u;
+	std::uint32_t          lodCount  = 0u;
+	float                  lodError  = 0.f;
 };
 
 struct MeshTemporaryDetailsMS
@@ -40,6 +76,10 @@ struct MeshTemporaryDetailsMS
 	std::uint32_t          primitiveOffset;
 	std::uint32_t          vertexOffset;
 	AxisAlignedBoundingBox aabb;
+	// Same as the ones of the MeshTemporaryDetailsVS.
+	std::uint32_t          lodOffset = 0u;
+	std::uint32_t          lodCount  = 0u;
+	float                  lodError  = 0.f;
 };
 
 struct MeshBundleTemporaryDetails
@@ -57,10 +97,15 @@ struct MeshletDetails
 
 struct MeshBundleTemporaryData
 {
-	std::vector<Vertex>         vertices;
-	std::vector<std::uint32_t>  indices;
-	std::vector<std::uint32_t>  primIndices;
-	std::vector<MeshletDetails> meshletDetails;
-	MeshBundleTemporaryDetails  bundleDetails;
+	std::vector<Vertex>             vertices;
+	std::vector<std::uint32_t>      indices;
+	std::vector<std::uint32_t>      primIndices;
+	std::vector<MeshletDetails>     meshletDetails;
+	MeshBundleTemporaryDetails      bundleDetails;
+	// With the quantised layout, the vertices are empty and each mesh has a quantisation, in
+	// the same order as the mesh details.
+	std::vector<QuantisedVertex>    quantisedVertices;
+	std::vector<VertexQuantisation> vertexQuantisations;
+	VertexLayout                    vertexLayout = VertexLayout::Float;
 };
 #endif
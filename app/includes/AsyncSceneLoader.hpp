@@ -0,0 +1,156 @@
+#ifndef ASYNC_SCENE_LOADER_HPP_
+#define ASYNC_SCENE_LOADER_HPP_
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SceneProcessor.hpp>
+#include <SceneMaterialProcessor.hpp>
+#include <MeshBundleCache.hpp>
+#include <SolScene.hpp>
+#include <ParallelUtility.hpp>
+#include <VertexQuantiser.hpp>
+#include <MeshletHierarchy.hpp>
+
+namespace Sol
+{
+enum class SceneLoadStage : std::uint32_t
+{
+	Queued,
+	Import,
+	Materials,
+	Textures,
+	Meshes,
+	Ready,
+	Cancelled,
+	Failed
+};
+
+struct SceneLoadOptions
+{
+	bool                  meshShader   = false;
+	MeshProcessingOptions meshOptions{};
+	// The assimp post processing, like the flags of a profile from the ConfigManager.
+	SceneImportFlags      importFlags{};
+	// The meshes are processed on this many workers of the load's submitter. The thread
+	// doing the load is one of them.
+	size_t                workerCount  = 1u;
+	// Reads the processed meshes, nodes and materials from the .solmesh cache if it is up to
+	// date, without importing the scene, and writes the cache otherwise. The meshlet
+	// hierarchies aren't cached, so a scene which needs them is always imported.
+	bool                  useCache     = false;
+	// Decodes the textures and packs them into the atlases.
+	bool                  loadTextures = true;
+};
+
+// Everything the renderer needs from a loaded scene, which hasn't been given to it yet.
+struct SceneLoadResult
+{
+	// Empty if the scene was read from the cache.
+	std::shared_ptr<SceneProcessor>         sceneProcessor;
+	std::unique_ptr<SceneMaterialProcessor> materialProcessor;
+	SceneCacheData                          sceneData;
+	// A hierarchy per mesh of the scene, if the mesh shader options asked for them.
+	std::vector<MeshletHierarchy>           meshletHierarchies;
+
+	// Must be called on the thread which owns the renderer. Adds the materials, the texture
+	// atlases and the mesh bundle, and sets up the scene. Returns the index of the mesh bundle.
+	template<class Renderer_t, class BlinnPhongLightTechnique_t>
+	[[nodiscard]]
+	std::uint32_t AddToRenderer(
+		Renderer_t& renderer, BlinnPhongLightTechnique_t& blinnPhongTechnique, SolScene& scene
+	) {
+		materialProcessor->LoadBlinnPhongMaterials(renderer, blinnPhongTechnique);
+		materialProcessor->LoadPreparedTextureAtlases(renderer);
+
+		scene.SetSceneNodes(std::move(sceneData.sceneNodeData));
+		scene.SetMeshMaterialDetails(sceneData.meshMaterialIndices, *materialProcessor);
+
+		CheckRenderableVertexLayout(sceneData.bundleData);
+
+		return static_cast<std::uint32_t>(
+			renderer.AddMeshBundle(std::move(sceneData.bundleData))
+		);
+	}
+};
+
+// The state of a load, which is shared with the thread doing it.
+struct SceneLoadState
+{
+	std::atomic<SceneLoadStage> stage{ SceneLoadStage::Queued };
+	std::stop_source            stopSource{};
+};
+
+class SceneLoadHandle
+{
+public:
+	SceneLoadHandle() : m_state{}, m_result{}, m_thread{} {}
+	SceneLoadHandle(
+		std::shared_ptr<SceneLoadState> state, std::future<SceneLoadResult>&& result,
+		std::jthread&& thread
+	) : m_state{ std::move(state) }, m_result{ std::move(result) }, m_thread{ std::move(thread) }
+	{}
+	// Cancels the load. If it was running on its own thread, waits for the current stage.
+	~SceneLoadHandle() noexcept;
+
+	// The cancellation is checked between the stages. A cancelled load throws in the Get.
+	void Cancel() noexcept;
+
+	// The finished stages over all of them, as the stages can't report their own progress.
+	[[nodiscard]]
+	float GetProgress() const noexcept;
+	[[nodiscard]]
+	SceneLoadStage GetStage() const noexcept;
+	// True once the load has finished, failed or been cancelled, so the Get won't block.
+	[[nodiscard]]
+	bool IsReady() const;
+	[[nodiscard]]
+	bool IsValid() const noexcept { return m_result.valid(); }
+
+	// Waits for the load and can only be called once. Rethrows the exception of a failed load.
+	[[nodiscard]]
+	SceneLoadResult Get();
+
+private:
+	std::shared_ptr<SceneLoadState> m_state;
+	std::future<SceneLoadResult>    m_result;
+	std::jthread                    m_thread;
+
+public:
+	SceneLoadHandle(const SceneLoadHandle&) = delete;
+	SceneLoadHandle& operator=(const SceneLoadHandle&) = delete;
+
+	SceneLoadHandle(SceneLoadHandle&& other) noexcept
+		: m_state{ std::move(other.m_state) }, m_result{ std::move(other.m_result) },
+		m_thread{ std::move(other.m_thread) }
+	{}
+	SceneLoadHandle& operator=(SceneLoadHandle&& other) noexcept
+	{
+		Cancel();
+
+		m_state  = std::move(other.m_state);
+		m_result = std::move(other.m_result);
+		// Joins the old thread.
+		m_thread = std::move(other.m_thread);
+
+		return *this;
+	}
+};
+
+using SceneLoadWorkSubmitter = ParallelWorkSubmitter;
+
+// Imports the scene, processes its materials, textures and meshes on a different thread. The
+// work is given to the submitter, or to a thread of the handle if there isn't one. The meshes
+// are only processed in parallel with a submitter. Only the AddToRenderer of the result must
+// be done on the renderer's thread.
+[[nodiscard]]
+SceneLoadHandle LoadSceneAsync(
+	std::string scenePath, const SceneLoadOptions& options,
+	const SceneLoadWorkSubmitter& submitWork = {}
+);
+}
+#endif
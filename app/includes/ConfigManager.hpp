@@ -34,6 +34,17 @@ public:
 	{
 		m_parser.AddOrUpdateValue("Systems", "RenderEngine", name);
 	}
+	// The vertex and primitive limits, like "64x126". Only used by the mesh shader engines.
+	void SetMeshletLimits(const std::string& limits) noexcept
+	{
+		m_parser.AddOrUpdateValue("Systems", "MeshletLimits", limits);
+	}
+	// "fast", "full" or "cooked-source". The flags of the profile can be overridden with
+	// true or false values in the SceneImport section, like "CalcTangentSpace=true".
+	void SetSceneImportProfile(const std::string& profile) noexcept
+	{
+		m_parser.AddOrUpdateValue("Systems", "SceneImportProfile", profile);
+	}
 
 	[[nodiscard]]
 	std::string GetRendererName() const noexcept
@@ -48,6 +59,13 @@ public:
 	WindowModule GetWindowModuleType() const noexcept;
 	[[nodiscard]]
 	InputModule GetInputModuleType() const noexcept;
+	[[nodiscard]]
+	MeshletLimitsType GetMeshletLimitsType() const noexcept;
+	[[nodiscard]]
+	SceneImportProfile GetSceneImportProfileType() const noexcept;
+	// The flags of the import profile, with the overrides of the SceneImport section.
+	[[nodiscard]]
+	SceneImportFlags GetSceneImportFlags() const noexcept;
 
 	[[nodiscard]]
 	std::string GetIOName() const noexcept
@@ -64,6 +82,20 @@ public:
 	{
 		return m_parser.GetValue("RenderEngine", "Systems");
 	}
+	[[nodiscard]]
+	std::string GetMeshletLimits() const noexcept
+	{
+		return m_parser.GetValue("MeshletLimits", "Systems");
+	}
+	[[nodiscard]]
+	std::string GetSceneImportProfile() const noexcept
+	{
+		return m_parser.GetValue("SceneImportProfile", "Systems");
+	}
+
+private:
+	// Keeps the value if the flag isn't in the SceneImport section.
+	void ReadSceneImportFlag(const std::string& flagName, bool& flag) const noexcept;
 
 private:
 	IniParser m_parser;
@@ -1,26 +1,81 @@
 #ifndef GLTF_OBJECT_HPP_
 #define GLTF_OBJECT_HPP_
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
 #include <tiny_gltf.h>
+#include <MappedFile.hpp>
 
 namespace Sol
 {
+using GLTFBufferData = std::span<const std::uint8_t>;
+
+enum class GLTFBufferMode
+{
+	// The buffers are kept in the model, where tinygltf copied them.
+	Copied,
+	// The binary chunk of a .glb and the external .bin files are mapped, and the copies of
+	// tinygltf are freed once the file has been loaded. So, the buffers are read from the
+	// page cache instead of the heap while the meshes are processed.
+	Mapped
+};
+
 class GLTFObject
 {
 public:
-	GLTFObject() : m_gltf{} {}
+	GLTFObject() : m_gltf{}, m_bufferData{}, m_mappedFiles{}, m_warning{} {}
 
-	void Set(tinygltf::Model&& model) noexcept { m_gltf = std::move(model); }
+	void Set(tinygltf::Model&& model) noexcept;
 
-	void LoadFromFile(const char* fileName);
+	// Loads a .gltf or a .glb file, which are told apart by the magic of the file. The file
+	// is mapped and parsed in place. Throws if it couldn't be loaded.
+	void LoadFromFile(const char* fileName, GLTFBufferMode bufferMode = GLTFBufferMode::Copied);
 
 	[[nodiscard]]
 	const tinygltf::Model& Get() const noexcept { return m_gltf; }
+	// The data of every buffer of the model, in the same order. The data of the mapped buffers
+	// isn't in the model anymore, so the buffers should always be read from here.
+	[[nodiscard]]
+	const std::vector<GLTFBufferData>& GetBufferData() const noexcept { return m_bufferData; }
+	// The warnings of the last load, empty if there weren't any.
+	[[nodiscard]]
+	const std::string& GetWarning() const noexcept { return m_warning; }
 
 private:
-	static void LoadFromFile(tinygltf::Model& model, const char* fileName);
+	// Returns the data of a buffer from a mapping, or an empty span if it can't be mapped.
+	[[nodiscard]]
+	GLTFBufferData MapBuffer(
+		const tinygltf::Buffer& buffer, GLTFBufferData binaryChunk,
+		const std::string& baseDirectory
+	);
+
+	void SetBufferDataFromModel();
 
 private:
-	tinygltf::Model m_gltf;
+	tinygltf::Model             m_gltf;
+	std::vector<GLTFBufferData> m_bufferData;
+	std::vector<MappedFile>     m_mappedFiles;
+	std::string                 m_warning;
+
+public:
+	GLTFObject(const GLTFObject&) = delete;
+	GLTFObject& operator=(const GLTFObject&) = delete;
+
+	// The buffer data stays valid, as neither the data of the model nor the mappings move.
+	GLTFObject(GLTFObject&& other) noexcept
+		: m_gltf{ std::move(other.m_gltf) }, m_bufferData{ std::move(other.m_bufferData) },
+		m_mappedFiles{ std::move(other.m_mappedFiles) }, m_warning{ std::move(other.m_warning) }
+	{}
+	GLTFObject& operator=(GLTFObject&& other) noexcept
+	{
+		m_gltf        = std::move(other.m_gltf);
+		m_bufferData  = std::move(other.m_bufferData);
+		m_mappedFiles = std::move(other.m_mappedFiles);
+		m_warning     = std::move(other.m_warning);
+
+		return *this;
+	}
 };
 }
 #endif
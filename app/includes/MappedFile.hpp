@@ -0,0 +1,56 @@
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+#include <cstdint>
+#include <string>
+#include <span>
+#include <utility>
+
+namespace Sol
+{
+// A read only view of a whole file, mapped into the memory. The pages are only read from the
+// disk when they are touched.
+class MappedFile
+{
+public:
+	MappedFile() : m_data{ nullptr }, m_size{ 0u } {}
+	~MappedFile() noexcept;
+
+	// Returns false if the file couldn't be opened or mapped. An empty file can't be mapped.
+	[[nodiscard]]
+	bool Open(const std::string& filePath);
+	void Close() noexcept;
+
+	[[nodiscard]]
+	bool IsOpen() const noexcept { return m_data != nullptr; }
+	[[nodiscard]]
+	size_t GetSize() const noexcept { return m_size; }
+	[[nodiscard]]
+	std::span<const std::uint8_t> GetData() const noexcept
+	{
+		return std::span<const std::uint8_t>{ m_data, m_size };
+	}
+
+private:
+	std::uint8_t const* m_data;
+	size_t              m_size;
+
+public:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+		: m_data{ std::exchange(other.m_data, nullptr) },
+		m_size{ std::exchange(other.m_size, 0u) }
+	{}
+	MappedFile& operator=(MappedFile&& other) noexcept
+	{
+		Close();
+
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0u);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -1,5 +1,8 @@
 #ifndef MESH_BOUND_IMPL_HPP_
 #define MESH_BOUND_IMPL_HPP_
+#include <span>
+#include <array>
+#include <limits>
 #include <MeshBundle.hpp>
 #include <BoundingVolumes.hpp>
 #include <ConversionUtilities.hpp>
@@ -7,11 +10,35 @@
 
 namespace Sol
 {
+enum class SphereBVAlgorithm
+{
+	// The centre of the AABB and the distance to the farthest vertex. The cheapest, but the
+	// sphere can be a lot larger than needed for the elongated or the diagonal meshlets.
+	AABBCentre,
+	// Ritter's approximation. Usually within a few percent of the minimum sphere.
+	Ritter,
+	// Welzl's algorithm. The minimum sphere, but a few times slower than Ritter's.
+	Welzl
+};
+
+enum class NormalConeAlgorithm
+{
+	// The axis is the AABB centre of the vertex normals and the vertex normals are tested.
+	// The smooth shaded meshlets get wide or degenerate cones.
+	VertexNormals,
+	// The axis is the centre of the minimum sphere of the face normals and the face normals
+	// are tested. As the backface culling uses the face normals, the cone is as tight as it
+	// can be without culling a front facing triangle.
+	FaceNormals
+};
+
 struct AABBGenerator
 {
+	// The axes start inverted, so the first position sets both of them. Otherwise the origin
+	// would always be inside the AABB.
 	AABBGenerator()
-		: m_positiveAxes{ DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f) },
-		m_negativeAxes{ DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f) }
+		: m_positiveAxes{ DirectX::XMVectorReplicate(-std::numeric_limits<float>::max()) },
+		m_negativeAxes{ DirectX::XMVectorReplicate(std::numeric_limits<float>::max()) }
 	{}
 
 	void ProcessAxes(const DirectX::XMFLOAT3& position) noexcept;
@@ -30,8 +57,11 @@ struct SphereBVGenerator
 	{}
 
 	void SetCentre(const AxisAlignedBoundingBox& aabb) noexcept;
+	void SetCentre(const DirectX::XMFLOAT3& centre) noexcept;
 
 	void ProcessRadius(const DirectX::XMFLOAT3& position) noexcept;
+	// Grows the radius, so the whole sphere is inside.
+	void ProcessSphere(const SphereBoundingVolume& sphere) noexcept;
 
 	[[nodiscard]]
 	SphereBoundingVolume GenerateBV() const noexcept;
@@ -40,16 +70,28 @@ struct SphereBVGenerator
 	float             m_radius;
 };
 
+// Four triangles, with the components in the lanes. The unused lanes should have copies of
+// a used lane.
+struct NormalConeTriangleBatch
+{
+	// The x, y and z of the unit face normals.
+	std::array<DirectX::XMVECTOR, 3u>                 normal;
+	// The x, y and z of each vertex's position.
+	std::array<std::array<DirectX::XMVECTOR, 3u>, 3u> positions;
+};
+
 struct NormalConeGenerator
 {
 	NormalConeGenerator()
 		: m_normalCentre{ DirectX::XMVectorSet(0.f, 0.f, 0.f, 0.f) },
+		m_quantisedCentre{ DirectX::XMVectorSet(0.f, 0.f, 0.f, 0.f) },
 		m_spatialCentre{ DirectX::XMVectorSet(0.f, 0.f, 0.f, 0.f) },
 		m_minimumDot{ DirectX::XMVectorSet(1.f, 1.f, 1.f, 1.f) },
 		m_apexOffset{ 0.f }
 	{}
 
-	// The radius isn't necessary. Only the centre.
+	// The radius isn't necessary. Only the centre. It is quantised like the packed cone, so
+	// the minimum dot and the apex offset are for the axis the culling will use.
 	void SetNormalCentre(const SphereBoundingVolume& normalSphere) noexcept;
 	// The radius isn't necessary. Only the centre.
 	void SetSpatialCentre(const SphereBoundingVolume& spatialSphere) noexcept;
@@ -61,13 +103,19 @@ struct NormalConeGenerator
 		const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& normal
 	);
 
+	// Processes the minimum dot and the apex offset of four triangles at once. Both centres
+	// must have been set.
+	void ProcessTriangleBatch(const NormalConeTriangleBatch& batch) noexcept;
+
 	[[nodiscard]]
 	bool IsConeDegenerate() const noexcept;
 
 	[[nodiscard]]
 	ClusterNormalCone GenerateNormalCone() const noexcept;
 
+	// The unit length axis and the snorm8 one it was normalised from.
 	DirectX::XMVECTOR m_normalCentre;
+	DirectX::XMVECTOR m_quantisedCentre;
 	DirectX::XMVECTOR m_spatialCentre;
 	DirectX::XMVECTOR m_minimumDot;
 	float             m_apexOffset;
@@ -83,36 +131,57 @@ AxisAlignedBoundingBox GetAABB(const aiAABB& aiAABB) noexcept;
 SphereBoundingVolume GenerateSphereBV(const std::vector<Vertex>& vertices) noexcept;
 [[nodiscard]]
 SphereBoundingVolume GenerateSphereBV(const std::vector<DirectX::XMFLOAT3>& positions) noexcept;
+[[nodiscard]]
+SphereBoundingVolume GenerateSphereBV(
+	std::span<const DirectX::XMFLOAT3> positions, SphereBVAlgorithm algorithm
+) noexcept;
 
+// The offsets of the meshlets are relative to the start of the indices. So, the indices and
+// the vertices can be views of the parts of the bundle containers, where the mesh starts.
 [[nodiscard]]
 AxisAlignedBoundingBox GenerateAABB(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
 	const Meshlet& meshlet
 ) noexcept;
 [[nodiscard]]
 AxisAlignedBoundingBox GenerateAABB(
-	aiVector3D* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	aiVector3D* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet
 ) noexcept;
 
 [[nodiscard]]
 SphereBoundingVolume GenerateSphereBV(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
-	const Meshlet& meshlet
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
+	const Meshlet& meshlet, SphereBVAlgorithm algorithm = SphereBVAlgorithm::AABBCentre
 ) noexcept;
 [[nodiscard]]
 SphereBoundingVolume GenerateSphereBV(
-	aiVector3D* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	aiVector3D* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet,
+	SphereBVAlgorithm algorithm = SphereBVAlgorithm::AABBCentre
+) noexcept;
+
+// The positions should have the three vertices of each triangle. The triangles are processed
+// four at a time.
+[[nodiscard]]
+ClusterNormalCone GenerateFaceNormalCone(
+	std::span<const DirectX::XMFLOAT3> trianglePositions,
+	const SphereBoundingVolume& spatialSphere
 ) noexcept;
 
+// The sphere of the meshlet must have been generated already, as the apex is relative to its
+// centre.
 [[nodiscard]]
 ClusterNormalCone GenerateNormalCone(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
-	const std::vector<std::uint32_t>& primIndices, const MeshletDetails& meshletDetails
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices, const MeshletDetails& meshletDetails,
+	NormalConeAlgorithm algorithm = NormalConeAlgorithm::VertexNormals
 ) noexcept;
+// The normals aren't used with the face normals. Without any normals, the face normals are
+// used instead.
 [[nodiscard]]
 ClusterNormalCone GenerateNormalCone(
-	aiVector3D* vertices, aiVector3D* normals, const std::vector<std::uint32_t>& vertexIndices,
-	const std::vector<std::uint32_t>& primIndices, const MeshletDetails& meshletDetails
+	aiVector3D* vertices, aiVector3D* normals, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices, const MeshletDetails& meshletDetails,
+	NormalConeAlgorithm algorithm = NormalConeAlgorithm::VertexNormals
 ) noexcept;
 }
 #endif
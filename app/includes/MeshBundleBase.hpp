@@ -12,28 +12,73 @@ namespace Sol
 class MeshBundleTempCustom
 {
 public:
+	MeshBundleTempCustom() : m_tempMeshes{}, m_options{} {}
+
 	[[nodiscard]]
 	MeshBundleTemporaryData GenerateTemporaryData(bool meshShader);
 
 	void AddMesh(Mesh&& mesh) noexcept;
 
+	void SetMeshletBuildMode(MeshletBuildMode buildMode) noexcept
+	{
+		m_options.meshletBuildMode = buildMode;
+	}
+	void SetMeshletLimits(MeshletLimitsType limitsType) noexcept
+	{
+		m_options.meshletLimits = limitsType;
+	}
+	void SetVertexCacheOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseVertexCache = optimise;
+	}
+	void SetOverdrawOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseOverdraw = optimise;
+	}
+	void SetVertexFetchOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseVertexFetch = optimise;
+	}
+	void SetSphereBVAlgorithm(SphereBVAlgorithm algorithm) noexcept
+	{
+		m_options.sphereBVAlgorithm = algorithm;
+	}
+	void SetNormalConeAlgorithm(NormalConeAlgorithm algorithm) noexcept
+	{
+		m_options.normalConeAlgorithm = algorithm;
+	}
+	void SetVertexQuantisation(bool quantise) noexcept
+	{
+		m_options.quantiseVertices = quantise;
+	}
+	void SetLodGeneration(size_t lodCount, float triangleRatio = 0.5f) noexcept
+	{
+		m_options.lodCount         = lodCount;
+		m_options.lodTriangleRatio = triangleRatio;
+	}
+
 private:
 	static void GenerateMeshShaderData(
-		std::vector<Mesh>& meshes, MeshBundleTemporaryData& meshBundleTemporaryData
+		std::vector<Mesh>& meshes, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	);
 	static void GenerateVertexShaderData(
-		std::vector<Mesh>& meshes, MeshBundleTemporaryData& meshBundleTemporaryData
+		std::vector<Mesh>& meshes, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	);
 
 	static void ProcessMeshVS(
-		Mesh& mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+		Mesh& mesh, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 	static void ProcessMeshMS(
-		Mesh& mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+		Mesh& mesh, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 
 private:
-	std::vector<Mesh> m_tempMeshes;
+	std::vector<Mesh>     m_tempMeshes;
+	MeshProcessingOptions m_options;
 };
 
 class MeshBundleTempAssimp
@@ -46,6 +91,58 @@ public:
 
 	void SetSceneProcessor(std::shared_ptr<SceneProcessor> scene);
 
+	void SetMeshletBuildMode(MeshletBuildMode buildMode) noexcept
+	{
+		m_meshProcessor.SetMeshletBuildMode(buildMode);
+	}
+	void SetMeshletLimits(MeshletLimitsType limitsType) noexcept
+	{
+		m_meshProcessor.SetMeshletLimits(limitsType);
+	}
+	void SetVertexCacheOptimisation(bool optimise) noexcept
+	{
+		m_meshProcessor.SetVertexCacheOptimisation(optimise);
+	}
+	void SetOverdrawOptimisation(bool optimise) noexcept
+	{
+		m_meshProcessor.SetOverdrawOptimisation(optimise);
+	}
+	void SetVertexFetchOptimisation(bool optimise) noexcept
+	{
+		m_meshProcessor.SetVertexFetchOptimisation(optimise);
+	}
+	void SetSphereBVAlgorithm(SphereBVAlgorithm algorithm) noexcept
+	{
+		m_meshProcessor.SetSphereBVAlgorithm(algorithm);
+	}
+	void SetNormalConeAlgorithm(NormalConeAlgorithm algorithm) noexcept
+	{
+		m_meshProcessor.SetNormalConeAlgorithm(algorithm);
+	}
+	void SetVertexQuantisation(bool quantise) noexcept
+	{
+		m_meshProcessor.SetVertexQuantisation(quantise);
+	}
+	void SetMeshDeduplication(bool deduplicate) noexcept
+	{
+		m_meshProcessor.SetMeshDeduplication(deduplicate);
+	}
+	void SetLodGeneration(size_t lodCount, float triangleRatio = 0.5f) noexcept
+	{
+		m_meshProcessor.SetLodGeneration(lodCount, triangleRatio);
+	}
+	void SetParallelWork(ParallelWork parallelWork) noexcept
+	{
+		m_meshProcessor.SetParallelWork(std::move(parallelWork));
+	}
+
+	// The cooked caches are keyed with these.
+	[[nodiscard]]
+	const MeshProcessingOptions& GetOptions() const noexcept
+	{
+		return m_meshProcessor.GetOptions();
+	}
+
 private:
 	SceneMeshProcessor m_meshProcessor;
 
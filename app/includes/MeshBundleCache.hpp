@@ -0,0 +1,95 @@
+#ifndef MESH_BUNDLE_CACHE_HPP_
+#define MESH_BUNDLE_CACHE_HPP_
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <MeshBundle.hpp>
+#include <SolMeshUtility.hpp>
+#include <SceneMeshProcessor.hpp>
+
+namespace Sol
+{
+// A material of a scene, so a cached scene doesn't need to be imported for its materials.
+struct SceneMaterialData
+{
+	DirectX::XMFLOAT4 ambient;
+	DirectX::XMFLOAT4 diffuse;
+	DirectX::XMFLOAT4 specular;
+	float             shininess;
+	std::uint32_t     isTransparent;
+	std::uint32_t     diffuseTextureCount;
+	std::uint32_t     specularTextureCount;
+};
+
+// The processed data of a scene, which is cooked into its .solmesh cache.
+struct SceneCacheData
+{
+	MeshBundleTemporaryData        bundleData;
+	std::vector<SceneNodeData>     sceneNodeData;
+	// The index of the scene material of each mesh.
+	std::vector<std::uint32_t>     meshMaterialIndices;
+	std::vector<SceneMaterialData> materials;
+	// The name of each material, followed by the paths of its diffuse and then of its specular
+	// textures, relative to the scene's directory. Each string ends with a null.
+	std::vector<char>              materialStrings;
+};
+
+namespace MeshBundleCache
+{
+	// Must be increased whenever the layout of the cache or of any of the cached structures
+	// changes. The element sizes are checked as well, but a reordered structure would pass.
+	static constexpr std::uint32_t s_cacheVersion = 3u;
+
+	// The size and the write time of a file the processed data depends on, when its content
+	// was hashed. The content is only hashed again once either of them changes.
+	struct CacheFileStamp
+	{
+		std::uint64_t pathHash;
+		std::uint64_t byteCount;
+		std::int64_t  writeTime;
+		std::uint64_t contentHash;
+	};
+
+	struct CacheKey
+	{
+		std::uint64_t               hash = 0u;
+		// The source's stamp first and then the stamps of the files it references.
+		std::vector<CacheFileStamp> fileStamps;
+		// The paths of the referenced files, each one followed by a null. They are kept, so
+		// an unchanged source doesn't need to be read again to find them.
+		std::vector<char>           referencedPaths;
+	};
+
+	// The cache is written next to the source, with .solmesh appended to the source path.
+	[[nodiscard]]
+	std::string GetCachePath(const std::string& sourcePath);
+
+	// A hash of the content of the source and of the buffers it references, and of the options
+	// which change the processed data. The buffers are the external buffers of a glTF and the
+	// material libraries of an OBJ. The stamps in the existing cache of the source are used to
+	// skip hashing the files which haven't changed. The import flags only matter for the
+	// scenes which are imported with assimp.
+	[[nodiscard]]
+	CacheKey GenerateCacheKey(
+		const std::string& sourcePath, bool meshShader, const MeshProcessingOptions& options,
+		const SceneImportFlags& importFlags = SceneImportFlags{}
+	);
+
+	// Returns false if the cache couldn't be written. It is written to a temporary file first,
+	// so a failed write never leaves a broken cache behind.
+	bool WriteCache(
+		const std::string& cachePath, const CacheKey& cacheKey, const SceneCacheData& sceneData
+	);
+
+	// The cache is memory mapped and each container is filled with a single copy. Returns
+	// nothing if the cache is missing, broken, from another version or has a different key,
+	// so the scene must be processed again. If the files were only touched, their new stamps
+	// are written into the cache.
+	[[nodiscard]]
+	std::optional<SceneCacheData> ReadCache(
+		const std::string& cachePath, const CacheKey& cacheKey
+	);
+}
+}
+#endif
@@ -0,0 +1,32 @@
+#ifndef MESH_DEDUPLICATOR_HPP_
+#define MESH_DEDUPLICATOR_HPP_
+#include <cstdint>
+#include <vector>
+#include <assimp/scene.h>
+
+namespace Sol
+{
+namespace MeshDeduplicator
+{
+	// Hashes 8 bytes at a time, instead of a byte at a time like FNV. The other hashes are
+	// made with it.
+	[[nodiscard]]
+	std::uint64_t HashBytes(void const* data, size_t byteCount, std::uint64_t seed) noexcept;
+
+	// A 64bit hash of the vertex count, the positions, the normals, the first uv channel and
+	// the faces. The meshes with the same hash should still be compared.
+	[[nodiscard]]
+	std::uint64_t HashMeshGeometry(aiMesh const* mesh) noexcept;
+
+	// Compares the same attributes as the hash.
+	[[nodiscard]]
+	bool IsGeometryEqual(aiMesh const* mesh1, aiMesh const* mesh2) noexcept;
+
+	// For each mesh of the scene, the index of the first mesh with the same geometry or its
+	// own index if it is the first. If the materials must match, the meshes with different
+	// materials are never merged, so a node can reference the first mesh instead.
+	[[nodiscard]]
+	std::vector<std::uint32_t> GenerateMeshRemap(aiScene const* scene, bool matchMaterials);
+}
+}
+#endif
@@ -0,0 +1,58 @@
+#ifndef MESH_INDEX_CODEC_HPP_
+#define MESH_INDEX_CODEC_HPP_
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <MeshBundle.hpp>
+
+namespace Sol
+{
+namespace IndexCodec
+{
+	// Encodes a triangle list. Each triangle is coded against a FIFO of the recently seen
+	// edges and a FIFO of the recently seen vertices, so most triangles only take a byte. The
+	// vertices which aren't in either are coded as the next new vertex or as a variable length
+	// delta from the last one. So, the lists which have gone through the vertex cache and
+	// fetch optimisations compress the best.
+	// The triangles may be rotated, their winding and order are kept. The encoded data is
+	// added at the end of the container.
+	void EncodeTriangles(std::span<const std::uint32_t> indices, std::vector<std::uint8_t>& data);
+	// The indices must be sized to the triangle count of the encoded list. Returns the size of
+	// the data which was read, or 0, if the data is truncated.
+	[[nodiscard]]
+	size_t DecodeTriangles(
+		std::span<const std::uint8_t> data, std::span<std::uint32_t> indices
+	) noexcept;
+
+	// Encodes indices which aren't triangles, like the vertex indices of the meshlets, as
+	// variable length deltas from the previous index.
+	void EncodeSequence(std::span<const std::uint32_t> indices, std::vector<std::uint8_t>& data);
+	[[nodiscard]]
+	size_t DecodeSequence(
+		std::span<const std::uint8_t> data, std::span<std::uint32_t> indices
+	) noexcept;
+}
+
+// The indices of a mesh bundle, encoded for storing. With the mesh shader data, the indices
+// are the vertex indices of the meshlets and the triangles of each meshlet are encoded on
+// their own. The rest of the bundle is stored as it is.
+struct EncodedMeshBundleIndices
+{
+	std::vector<std::uint8_t> indices;
+	std::vector<std::uint8_t> primIndices;
+	std::uint32_t             indexCount     = 0u;
+	std::uint32_t             primIndexCount = 0u;
+};
+
+[[nodiscard]]
+EncodedMeshBundleIndices EncodeMeshBundleIndices(const MeshBundleTemporaryData& bundleData);
+
+// The rest of the bundle, the meshlets and the mesh details, must have been loaded already,
+// as the triangles of the meshlets are decoded with their offsets. Returns false, if the data
+// is truncated.
+[[nodiscard]]
+bool DecodeMeshBundleIndices(
+	const EncodedMeshBundleIndices& encodedIndices, MeshBundleTemporaryData& bundleData
+);
+}
+#endif
@@ -0,0 +1,57 @@
+#ifndef MESH_LOD_HPP_
+#define MESH_LOD_HPP_
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <MeshBundle.hpp>
+#include <SolMeshUtility.hpp>
+#include <SceneMeshProcessor.hpp>
+
+namespace Sol
+{
+// The attribute weights of the simplification, relative to the size of the mesh. So, turning
+// a normal by 90 degrees costs about as much as moving a vertex by 7% of the mesh's size.
+static constexpr float s_lodNormalWeight = 0.05f;
+static constexpr float s_lodUVWeight     = 0.05f;
+
+struct MeshLodLevel
+{
+	// Local to the vertices of the mesh the level was made from.
+	std::vector<std::uint32_t> indices;
+	// The sum of the simplification errors of this and the finer levels, so it only grows
+	// down the chain.
+	float                      error;
+};
+
+// Each level has the triangleRatio of the previous level's triangles. The open borders aren't
+// locked, but their outline is kept. The chain stops early, if a level can't be simplified to
+// at most 95% of the previous one's triangles.
+[[nodiscard]]
+std::vector<MeshLodLevel> GenerateMeshLods(
+	std::span<const std::uint32_t> indices, std::span<const Vertex> vertices, size_t lodCount,
+	float triangleRatio
+);
+
+// Adds the lodCount and the lodTriangleRatio levels of the options for every mesh of the
+// bundle. The levels are made like the meshes and added after all of them, with the vertices
+// of their mesh. So, the mesh indices don't change. Must be done before the quantisation.
+void GenerateMeshBundleLods(
+	MeshBundleTemporaryData& bundleData, const MeshProcessingOptions& options
+);
+
+// Returns the index of the coarsest level of the mesh, whose error is within the threshold.
+// The errors are projected by dividing them with the distance, like the meshlet hierarchy,
+// so the errorThreshold is the error per unit of distance. Returns the meshIndex if none of
+// the levels are.
+[[nodiscard]]
+std::uint32_t SelectMeshLod(
+	std::span<const MeshTemporaryDetailsVS> meshDetails, std::uint32_t meshIndex,
+	float distance, float errorThreshold
+) noexcept;
+[[nodiscard]]
+std::uint32_t SelectMeshLod(
+	std::span<const MeshTemporaryDetailsMS> meshDetails, std::uint32_t meshIndex,
+	float distance, float errorThreshold
+) noexcept;
+}
+#endif
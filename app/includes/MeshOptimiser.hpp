@@ -0,0 +1,84 @@
+#ifndef MESH_OPTIMISER_HPP_
+#define MESH_OPTIMISER_HPP_
+#include <cstdint>
+#include <span>
+#include <MeshBundle.hpp>
+
+namespace Sol
+{
+namespace MeshOptimiser
+{
+	// The FIFO cache size most GPUs can be expected to have at least.
+	static constexpr size_t s_defaultVertexCacheSize  = 16u;
+	// How much worse than its whole run of triangles, a cluster's cache miss ratio can be.
+	// A higher value makes smaller clusters, which sort better but miss the cache more.
+	static constexpr float  s_defaultOverdrawThreshold = 1.05f;
+
+	struct VertexCacheStatistics
+	{
+		size_t vertexTransformCount = 0u;
+		// Average Cache Miss Ratio, the transformed vertex count per triangle. Goes from 3
+		// to around 0.5.
+		float  acmr                 = 0.f;
+		// Average Transform to Vertex Ratio, the transformed vertex count per unique
+		// vertex. It is 1 at best.
+		float  atvr                 = 0.f;
+	};
+
+	struct OverdrawStatistics
+	{
+		size_t pixelsCovered = 0u;
+		size_t pixelsShaded  = 0u;
+		// The shaded pixel count per covered pixel. It is 1 at best.
+		float  overdraw      = 0.f;
+	};
+
+	// Reorders the triangles of an index list with the Tipsify algorithm, so the vertices
+	// are reused from the post transform cache as much as possible. The indices must be
+	// local to the mesh, as in start from 0.
+	void OptimiseVertexCache(
+		std::span<std::uint32_t> indices, size_t cacheSize = s_defaultVertexCacheSize
+	);
+
+	// Reorders the vertices in the order they are first referenced by the indices and remaps
+	// the indices to match, so the vertex fetches go through the vertex buffer linearly. The
+	// unreferenced vertices are moved to the end. The indices can be the meshlet vertex
+	// indices as well. If the indices are already offset, the vertexOffset should be the
+	// index of the first vertex.
+	void OptimiseVertexFetch(
+		std::span<std::uint32_t> indices, std::span<Vertex> vertices,
+		std::uint32_t vertexOffset = 0u
+	);
+
+	// Splits the triangles into clusters where the vertex cache misses and sorts the clusters,
+	// so the ones which face away from the centre of the mesh are drawn first, as they are
+	// the likely occluders from most views. The triangle order in a cluster is kept, so it
+	// should be done after the vertex cache optimisation. If the indices are already offset,
+	// the vertexOffset should be the index of the first vertex.
+	void OptimiseOverdraw(
+		std::span<std::uint32_t> indices, std::span<const Vertex> vertices,
+		std::uint32_t vertexOffset = 0u, float threshold = s_defaultOverdrawThreshold
+	);
+
+	// Simulates a FIFO post transform cache on the triangles.
+	[[nodiscard]]
+	VertexCacheStatistics AnalyseVertexCache(
+		std::span<const std::uint32_t> indices, size_t cacheSize = s_defaultVertexCacheSize
+	);
+
+	// Rasterises the triangles with a depth test and backface culling from the six axis
+	// directions, with a small software rasteriser, and counts the shaded pixels. The
+	// indices must be local to the vertices.
+	[[nodiscard]]
+	OverdrawStatistics AnalyseOverdraw(
+		std::span<const std::uint32_t> indices, std::span<const Vertex> vertices
+	);
+
+	// The maximum index + 1.
+	[[nodiscard]]
+	size_t GetVertexCount(std::span<const std::uint32_t> indices) noexcept;
+
+	void OffsetIndices(std::span<std::uint32_t> indices, std::uint32_t offset) noexcept;
+}
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef MESH_SIMPLIFIER_HPP_
+#define MESH_SIMPLIFIER_HPP_
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <MeshBundle.hpp>
+
+namespace Sol
+{
+namespace MeshSimplifier
+{
+	struct SimplificationOptions
+	{
+		// The differences of the attributes of a collapse are scaled with these and added to
+		// its cost, so they are in the position units too. They only change the order of the
+		// collapses, the errors are still only about the positions.
+		float normalWeight = 0.f;
+		float uvWeight     = 0.f;
+		// Without the locking, a border vertex can still be collapsed onto the next vertex of
+		// its border. The planes through the border edges keep the outline of the border.
+		bool  lockBorders  = true;
+	};
+
+	// Reduces the triangle count of an index list by collapsing its edges, the ones with the
+	// least quadric error first. The indices must be local to the vertices. The vertices
+	// aren't changed, the collapsed ones just won't be referenced anymore. The collapses stop
+	// once the index count is at or below the target, or the next collapse would have a
+	// larger error than the targetError.
+	// The locked vertices, the ones on the open borders and the ones which share their
+	// position with other vertices, as on the UV seams, are never moved. So the border of a
+	// mesh, or of a part of a mesh, stays the same and won't crack. The open borders can be
+	// unlocked with the options.
+	// Returns the largest error of the collapses, as a distance in the position units.
+	[[nodiscard]]
+	float Simplify(
+		std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices,
+		size_t targetIndexCount, float targetError,
+		std::span<const std::uint8_t> lockedVertices = {},
+		const SimplificationOptions& options = SimplificationOptions{}
+	);
+}
+}
+#endif
@@ -0,0 +1,72 @@
+#ifndef MESHLET_CULLER_HPP_
+#define MESHLET_CULLER_HPP_
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <DirectXMath.h>
+#include <MeshBundle.hpp>
+#include <Camera.hpp>
+
+namespace Sol
+{
+// A run of consecutive meshlets of a model.
+struct MeshletRange
+{
+	std::uint32_t meshletOffset;
+	std::uint32_t meshletCount;
+	std::uint32_t modelIndex;
+};
+
+struct MeshletCullingModel
+{
+	DirectX::XMMATRIX modelMatrix;
+	// The meshlets of the model's mesh in the bundle.
+	std::uint32_t     meshletOffset;
+	std::uint32_t     meshletCount;
+};
+
+namespace MeshletCuller
+{
+	// The normal cone as the shaders unpack it.
+	struct NormalCone
+	{
+		DirectX::XMFLOAT3 axis;
+		// If the dot product of the inverted axis and the direction from the apex to the
+		// camera is larger than this, all of the triangles face away from the camera.
+		float             cutoff;
+		// The degenerate cones can't cull anything.
+		bool              isDegenerate;
+	};
+
+	[[nodiscard]]
+	NormalCone UnpackNormalCone(const ClusterNormalCone& packedCone) noexcept;
+
+	// Tests the bounding sphere against the frustum planes and the normal cone against the
+	// camera position, the same way the mesh shaders do. The frustum and the camera position
+	// must be in the world space. The axis of the cone is transformed with the model matrix
+	// and the radius and the apex offset are scaled by its largest scale.
+	[[nodiscard]]
+	bool IsMeshletVisible(
+		const MeshletDetails& meshletDetails, const DirectX::XMMATRIX& modelMatrix,
+		const Frustum& frustum, const DirectX::XMFLOAT3& cameraPosition
+	) noexcept;
+
+	// Does the same tests as IsMeshletVisible on four meshlets at a time. The visible
+	// meshlets are added to the ranges, with the meshletOffset added to their indices, and
+	// the consecutive ones are merged.
+	void CullMeshlets(
+		std::span<const MeshletDetails> meshletDetails, const DirectX::XMMATRIX& modelMatrix,
+		const Frustum& frustum, const DirectX::XMFLOAT3& cameraPosition,
+		std::uint32_t meshletOffset, std::vector<MeshletRange>& visibleRanges,
+		std::uint32_t modelIndex = 0u
+	);
+	// Culls the meshlets of each model. The meshlet details should be of the whole bundle.
+	// The ranges have the index of their model.
+	void CullMeshlets(
+		std::span<const MeshletDetails> bundleMeshletDetails,
+		std::span<const MeshletCullingModel> models, const Frustum& frustum,
+		const DirectX::XMFLOAT3& cameraPosition, std::vector<MeshletRange>& visibleRanges
+	);
+}
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef MESHLET_HIERARCHY_HPP_
+#define MESHLET_HIERARCHY_HPP_
+#include <cstdint>
+#include <vector>
+#include <ModuleTypes.hpp>
+#include <SolMeshUtility.hpp>
+#include <MeshBoundImpl.hpp>
+
+namespace Sol
+{
+// The level of detail data of a meshlet in the hierarchy. It is kept separate from the
+// MeshletDetails, so the layout the renderers upload doesn't change.
+struct MeshletLodDetails
+{
+	// The bounds and the error of the group this meshlet was made from. The meshlets of the
+	// first level use their own bounds and don't have any error.
+	SphereBoundingVolume lodBounds;
+	float                error;
+	// The bounds and the error of the group this meshlet was simplified with. If the meshlet
+	// wasn't simplified any further, the error is the largest float.
+	SphereBoundingVolume parentLodBounds;
+	float                parentError;
+	// The meshlets which were made by simplifying this meshlet's group.
+	std::uint32_t        parentOffset;
+	std::uint32_t        parentCount;
+	// Into the childMeshletIndices. The meshlets of the group this meshlet was made from.
+	std::uint32_t        childOffset;
+	std::uint32_t        childCount;
+	std::uint32_t        level;
+};
+
+// The meshlets of every level of a mesh. The meshlets of a level are made by simplifying
+// groups of the neighbouring meshlets of the previous level, with the borders of the groups
+// locked, and splitting them again. So, picking any cut through the hierarchy with the
+// errors won't crack the mesh. The meshlets of a group which couldn't be simplified are
+// grouped again on the next level, so their parents can be more than a level above them.
+// The vertex indices are local to the mesh, and the offsets of the meshlets are relative to
+// the start of the vectors.
+struct MeshletHierarchy
+{
+	std::vector<std::uint32_t>     vertexIndices;
+	std::vector<std::uint32_t>     primIndices;
+	std::vector<MeshletDetails>    meshletDetails;
+	std::vector<MeshletLodDetails> lodDetails;
+	std::vector<std::uint32_t>     childMeshletIndices;
+	// The meshlets of the first level are at the start, the rest follow in the level order.
+	std::uint32_t                  firstLevelMeshletCount = 0u;
+	std::uint32_t                  levelCount             = 0u;
+};
+
+// The meshlets are always built spatially, as the groups need compact meshlets to find their
+// neighbours.
+[[nodiscard]]
+MeshletHierarchy GenerateMeshletHierarchy(
+	const Mesh& mesh, MeshletLimitsType limitsType,
+	SphereBVAlgorithm sphereBVAlgorithm     = SphereBVAlgorithm::AABBCentre,
+	NormalConeAlgorithm normalConeAlgorithm = NormalConeAlgorithm::VertexNormals
+);
+
+// Adds the indices of the meshlets which should be drawn from the view position to the
+// selectedMeshlets. The errors are projected by dividing them with the distance to their
+// bounds, so the errorThreshold is the error per unit of distance, the allowed screen error
+// multiplied by the view's spread per pixel. A meshlet is selected, when its error is within
+// the threshold but its parent error isn't. As the errors and the bounds grow up the
+// hierarchy, the selected meshlets always cover the mesh exactly once.
+void SelectMeshlets(
+	const MeshletHierarchy& hierarchy, const DirectX::XMFLOAT3& viewPosition,
+	float errorThreshold, std::vector<std::uint32_t>& selectedMeshlets
+);
+}
+#endif
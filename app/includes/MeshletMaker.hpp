@@ -1,31 +1,139 @@
 #ifndef MESHLET_MAKER_HPP_
 #define MESHLET_MAKER_HPP_
 #include <vector>
-#include <unordered_map>
+#include <array>
+#include <limits>
+#include <bit>
+#include <span>
+#include <ModuleTypes.hpp>
 #include <SolMeshUtility.hpp>
 #include <assimp/scene.h>
 
 namespace Sol
 {
-class MeshletGenerator
+// The layout of the packed primitive indices, which the mesh shaders decode. The three local
+// vertex indices of a triangle get the same number of bits each.
+static constexpr size_t s_primIndexBitCount = 10u;
+
+struct PrimitiveIndicesUnpacked
+{
+	std::uint32_t firstIndex  : s_primIndexBitCount;
+	std::uint32_t secondIndex : s_primIndexBitCount;
+	std::uint32_t thirdIndex  : s_primIndexBitCount;
+};
+
+[[nodiscard]]
+std::uint32_t PackPrim(const PrimitiveIndicesUnpacked& unpackedIndices) noexcept;
+[[nodiscard]]
+PrimitiveIndicesUnpacked UnpackPrim(std::uint32_t packedIndices) noexcept;
+
+struct MeshletPrimTriangle
+{
+	std::uint32_t vertex0;
+	std::uint32_t vertex1;
+	std::uint32_t vertex2;
+};
+
+// A view of the triangles of an index source. So, the meshlet builders can read the triangles
+// where they already are, instead of copying them into an intermediate vector first. The
+// source must outlive the view.
+class MeshletTriangleView
 {
 public:
-	struct PrimTriangle
-	{
-		std::uint32_t vertex0;
-		std::uint32_t vertex1;
-		std::uint32_t vertex2;
-	};
+	MeshletTriangleView(std::span<const std::uint32_t> indices) noexcept;
+	// For the smaller index types of the glTF accessors.
+	MeshletTriangleView(std::span<const std::uint16_t> indices) noexcept;
+	MeshletTriangleView(std::span<const std::uint8_t> indices) noexcept;
+	// The faces must be triangles.
+	MeshletTriangleView(aiFace const* faces, size_t faceCount) noexcept;
 
-	struct PrimitiveIndicesUnpacked
+	[[nodiscard]]
+	MeshletPrimTriangle GetTriangle(size_t triangleIndex) const noexcept;
+
+	[[nodiscard]]
+	size_t GetTriangleCount() const noexcept { return m_triangleCount; }
+
+private:
+	enum class SourceType
 	{
-		std::uint32_t firstIndex  : 10u;
-		std::uint32_t secondIndex : 10u;
-		std::uint32_t thirdIndex  : 10u;
+		Index32,
+		Index16,
+		Index8,
+		Face
 	};
 
-	static constexpr size_t s_meshletVertexLimit    = 64u;
-	static constexpr size_t s_meshletPrimitiveLimit = 126u;
+private:
+	void const* m_source;
+	size_t      m_triangleCount;
+	SourceType  m_sourceType;
+};
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+struct MeshletLimits
+{
+	static constexpr size_t s_vertexLimit       = vertexLimit_t;
+	static constexpr size_t s_primitiveLimit    = primitiveLimit_t;
+	// The number of bits needed to store the local index of the last vertex.
+	static constexpr size_t s_localIndexBitCount
+		= static_cast<size_t>(std::bit_width(vertexLimit_t - 1u));
+
+	static_assert(
+		s_localIndexBitCount <= s_primIndexBitCount,
+		"The local vertex indices won't fit in the packed primitive indices."
+	);
+};
+
+// Calls the function with the MeshletLimits of the type. So, the meshlet builders can be
+// picked at runtime, from the config for example.
+template<typename Function_t>
+decltype(auto) VisitMeshletLimits(MeshletLimitsType limitsType, Function_t&& function)
+{
+	using enum MeshletLimitsType;
+
+	if (limitsType == Vertex64Primitive84)
+		return function(MeshletLimits<64u, 84u>{});
+	else if (limitsType == Vertex128Primitive128)
+		return function(MeshletLimits<128u, 128u>{});
+	else if (limitsType == Vertex256Primitive256)
+		return function(MeshletLimits<256u, 256u>{});
+	else
+		return function(MeshletLimits<64u, 126u>{});
+}
+
+// The most meshlets the triangles can be split into, with the index order build mode. Every
+// meshlet but the last one is only closed when it doesn't have the space for the next
+// triangle, so it has either the primitive limit or at least a third of the vertex limit of
+// triangles.
+[[nodiscard]]
+size_t GetMeshletCountUpperBound(size_t triangleCount, MeshletLimitsType limitsType) noexcept;
+
+// The position of the vertex index in the first localVertexCount slots of the local vertex
+// table, or the max of std::uint32_t if it isn't there. The slots after the count are ignored,
+// even if they still have the indices of a previous meshlet. Scans 4 slots at a time with SSE,
+// so the table must be 16 bytes aligned and its size must be a multiple of 4.
+[[nodiscard]]
+std::uint32_t FindLocalVertexIndex(
+	std::span<const std::uint32_t> localVertexIndices, std::uint32_t localVertexCount,
+	std::uint32_t vertexIndex
+) noexcept;
+// The same search a slot at a time, which is used when DirectXMath doesn't use SSE.
+[[nodiscard]]
+std::uint32_t FindLocalVertexIndexScalar(
+	std::span<const std::uint32_t> localVertexIndices, std::uint32_t localVertexCount,
+	std::uint32_t vertexIndex
+) noexcept;
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+class MeshletGenerator
+{
+public:
+	using PrimTriangle = MeshletPrimTriangle;
+
+	// Going through the MeshletLimits, so its checks are done.
+	static constexpr size_t s_meshletVertexLimit
+		= MeshletLimits<vertexLimit_t, primitiveLimit_t>::s_vertexLimit;
+	static constexpr size_t s_meshletPrimitiveLimit
+		= MeshletLimits<vertexLimit_t, primitiveLimit_t>::s_primitiveLimit;
 
 public:
 	MeshletGenerator(
@@ -44,31 +152,39 @@ public:
 
 	[[nodiscard]]
 	bool IsMeshletLimitReached(const PrimTriangle& primitive) const noexcept;
-
+	// The number of vertices of the primitive which aren't in the current meshlet yet.
 	[[nodiscard]]
-	static PrimitiveIndicesUnpacked UnpackPrim(std::uint32_t packedIndices) noexcept;
+	size_t GetAddableVertexIndexCount(const PrimTriangle& primitive) const noexcept;
+	[[nodiscard]]
+	size_t GetMeshletPrimitiveIndexCount() const noexcept;
+
+	// Starts a new meshlet after the currently added indices. Doesn't need to clear anything,
+	// as only the first m_localVertexCount slots of the lookup table are ever checked.
+	void StartNewMeshlet() noexcept;
 
 private:
+	static constexpr std::uint32_t s_invalidLocalIndex
+		= std::numeric_limits<std::uint32_t>::max();
+
 	[[nodiscard]]
-	bool IsInMap(std::uint32_t vertexIndex) const noexcept;
-	[[nodiscard]]
-	size_t GetAddableVertexIndexCount(const PrimTriangle& primitive) const noexcept;
+	std::uint32_t FindLocalIndex(std::uint32_t vertexIndex) const noexcept;
 
 	[[nodiscard]]
 	std::uint32_t GetOrAddPrimitiveIndex(std::uint32_t vertexIndex) noexcept;
 
 	[[nodiscard]]
 	size_t GetMeshletVertexIndexCount() const noexcept;
-	[[nodiscard]]
-	size_t GetMeshletPrimitiveIndexCount() const noexcept;
 
 private:
-	std::vector<std::uint32_t>&                      m_vertexIndices;
-	size_t                                           m_vertexIndexOffset;
-	std::vector<std::uint32_t>&                      m_primitiveIndices;
-	size_t                                           m_primitiveIndexOffset;
-	// I might want to replace this with a flat_map one day.
-	std::unordered_map<std::uint32_t, std::uint32_t> m_primitiveIndexMap;
+	std::vector<std::uint32_t>& m_vertexIndices;
+	size_t                      m_vertexIndexOffset;
+	std::vector<std::uint32_t>& m_primitiveIndices;
+	size_t                      m_primitiveIndexOffset;
+	// A meshlet can't have more than s_meshletVertexLimit unique vertices, so a fixed table
+	// is enough to map the global vertex indices to the local ones. The position of a vertex
+	// index in this table is its local index.
+	alignas(16) std::array<std::uint32_t, s_meshletVertexLimit> m_localVertexIndices;
+	std::uint32_t                                               m_localVertexCount;
 
 public:
 	MeshletGenerator(const MeshletGenerator&) = delete;
@@ -79,7 +195,8 @@ public:
 		m_vertexIndexOffset{ other.m_vertexIndexOffset },
 		m_primitiveIndices{ other.m_primitiveIndices },
 		m_primitiveIndexOffset{ other.m_primitiveIndexOffset },
-		m_primitiveIndexMap{ std::move(other.m_primitiveIndexMap) }
+		m_localVertexIndices{ other.m_localVertexIndices },
+		m_localVertexCount{ other.m_localVertexCount }
 	{}
 	MeshletGenerator& operator=(MeshletGenerator&& other) noexcept
 	{
@@ -87,27 +204,81 @@ public:
 		m_vertexIndexOffset    = other.m_vertexIndexOffset;
 		m_primitiveIndices     = other.m_primitiveIndices;
 		m_primitiveIndexOffset = other.m_primitiveIndexOffset;
-		m_primitiveIndexMap    = std::move(other.m_primitiveIndexMap);
+		m_localVertexIndices   = other.m_localVertexIndices;
+		m_localVertexCount     = other.m_localVertexCount;
 
 		return *this;
 	}
 };
 
-class MeshletMaker
+enum class MeshletBuildMode
+{
+	// Fills the meshlets with the triangles in the order of the index buffer.
+	IndexOrder,
+	// Grows each meshlet through the adjacent triangles, which are closest to the meshlet
+	// and face the same way. Makes the bounding spheres smaller and the normal cones tighter.
+	Spatial
+};
+
+// Builds the meshlets of a mesh straight into the containers of a mesh bundle, so they don't
+// need to be copied again. The meshlets are added after the current elements and their
+// offsets are relative to the start of the mesh, which is where the containers end when the
+// maker is constructed.
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+class MeshletStreamMaker
 {
+	using MeshletGenerator_t = MeshletGenerator<vertexLimit_t, primitiveLimit_t>;
+
 public:
-	struct PrimitiveIndicesUnpacked
-	{
-		std::uint32_t firstIndex  : 10u;
-		std::uint32_t secondIndex : 10u;
-		std::uint32_t thirdIndex  : 10u;
-	};
+	MeshletStreamMaker(
+		std::vector<std::uint32_t>& vertexIndices, std::vector<std::uint32_t>& primitiveIndices,
+		std::vector<MeshletDetails>& meshletDetails,
+		MeshletBuildMode buildMode = MeshletBuildMode::IndexOrder
+	);
+
+	// The vertices are only read in the spatial mode.
+	void GenerateMeshlets(const MeshletTriangleView& triangles, Vertex const* vertices) noexcept;
+	void GenerateMeshlets(
+		const MeshletTriangleView& triangles, aiVector3D const* vertices
+	) noexcept;
+
+private:
+	void MakeMeshlets(const MeshletTriangleView& triangles) noexcept;
+
+	template<typename Vertex_t>
+	void MakeMeshletsSpatial(
+		Vertex_t const* vertices, const MeshletTriangleView& triangles
+	) noexcept;
+
+	void AddMeshlet(const MeshletGenerator_t& meshletGen) noexcept;
+
+private:
+	MeshletBuildMode             m_buildMode;
+	std::vector<std::uint32_t>&  m_vertexIndices;
+	std::vector<std::uint32_t>&  m_primitiveIndices;
+	std::vector<MeshletDetails>& m_meshletDetails;
+	size_t                       m_vertexIndexMeshOffset;
+	size_t                       m_primitiveIndexMeshOffset;
 
 public:
-	MeshletMaker();
+	MeshletStreamMaker(const MeshletStreamMaker&) = delete;
+	MeshletStreamMaker& operator=(const MeshletStreamMaker&) = delete;
+};
+
+// Keeps the meshlets of a single mesh in its own containers.
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+class MeshletMaker
+{
+	using MeshletStreamMaker_t = MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>;
+
+public:
+	MeshletMaker(MeshletBuildMode buildMode = MeshletBuildMode::IndexOrder);
 
 	void GenerateMeshlets(const Mesh& mesh) noexcept;
 	void GenerateMeshlets(aiMesh const* mesh) noexcept;
+	// Uses the indices instead of the faces of the mesh. For when the indices have been
+	// reordered.
+	void GenerateMeshlets(aiMesh const* mesh, const std::vector<std::uint32_t>& indices) noexcept;
 
 	void LoadVertexIndices(std::vector<std::uint32_t>& vertexIndices) noexcept;
 
@@ -115,14 +286,8 @@ public:
 	// It is not const, because it will move the data.
 	MeshExtraForMesh GenerateExtraMeshData() noexcept;
 
-	[[nodiscard]]
-	static PrimitiveIndicesUnpacked UnpackPrim(std::uint32_t packedIndices) noexcept;
-
-private:
-	void MakeMeshlets(const std::vector<std::uint32_t>& indices) noexcept;
-	void MakeMeshlets(aiFace* faces, size_t faceCount) noexcept;
-
 private:
+	MeshletBuildMode            m_buildMode;
 	std::vector<std::uint32_t>  m_vertexIndices;
 	std::vector<std::uint32_t>  m_primitiveIndices;
 	std::vector<MeshletDetails> m_meshletDetails;
@@ -0,0 +1,55 @@
+#ifndef MESHLET_PACKING_HPP_
+#define MESHLET_PACKING_HPP_
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <SolMeshUtility.hpp>
+
+namespace Sol
+{
+// A smaller format of the meshlets, for storing them. Each triangle uses three bytes instead
+// of a U32 and the vertex indices use 16 bits, if the meshlet's vertices are close enough to
+// each other. The renderers still need the unpacked format.
+struct PackedMeshlet
+{
+	// The vertex references are relative to this.
+	std::uint32_t baseVertex;
+	// In bytes. Each meshlet's vertex references and triangles start at a 4 byte boundary.
+	std::uint32_t vertexReferenceOffset;
+	std::uint32_t primitiveOffset;
+	std::uint16_t vertexCount;
+	std::uint16_t primitiveCount;
+	// 2 or 4 bytes.
+	std::uint32_t vertexReferenceSize;
+};
+
+struct PackedMeshletDetails
+{
+	PackedMeshlet        meshlet;
+	SphereBoundingVolume sphereB;
+	ClusterNormalCone    coneNormal;
+};
+
+struct PackedMeshletData
+{
+	std::vector<PackedMeshletDetails> meshletDetails;
+	std::vector<std::uint8_t>         vertexReferences;
+	std::vector<std::uint8_t>         primitives;
+};
+
+// The meshlets should be of a single mesh, as in, their offsets should be relative to the
+// start of the vertexIndices and the primIndices.
+[[nodiscard]]
+PackedMeshletData PackMeshlets(
+	std::span<const MeshletDetails> meshletDetails, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices
+);
+
+// Adds the meshlets at the end of the containers. The offsets of the unpacked meshlets will
+// be relative to the start of the containers.
+void UnpackMeshlets(
+	const PackedMeshletData& packedData, std::vector<std::uint32_t>& vertexIndices,
+	MeshExtraForMesh& extraMeshData
+);
+}
+#endif
@@ -0,0 +1,64 @@
+#ifndef MESHLET_VALIDATOR_HPP_
+#define MESHLET_VALIDATOR_HPP_
+#include <string>
+#include <vector>
+#include <MeshBundle.hpp>
+#include <MeshletMaker.hpp>
+#include <MeshOptimiser.hpp>
+
+namespace Sol
+{
+namespace MeshletValidator
+{
+	// Only the first few errors of a mesh are kept. The rest are only counted.
+	static constexpr size_t s_maximumErrorCount = 32u;
+
+	struct MeshReport
+	{
+		// The meshlet statistics are only there on the mesh shader path.
+		bool                                 isMeshShader               = false;
+		size_t                               meshletCount               = 0u;
+		size_t                               triangleCount              = 0u;
+		// The average meshlet vertex and primitive counts over the limits.
+		float                                vertexUtilisation          = 0.f;
+		float                                primitiveUtilisation       = 0.f;
+		float                                minimumSphereRadius        = 0.f;
+		float                                averageSphereRadius        = 0.f;
+		float                                medianSphereRadius         = 0.f;
+		float                                maximumSphereRadius        = 0.f;
+		float                                degenerateConeRatio        = 0.f;
+		// The spheres which don't contain all of their meshlet's vertices.
+		size_t                               nonConservativeSphereCount = 0u;
+		// The cones which would cull a meshlet, while some of its triangles face the camera.
+		size_t                               nonConservativeConeCount   = 0u;
+		MeshOptimiser::VertexCacheStatistics vertexCache;
+		size_t                               errorCount                 = 0u;
+		std::vector<std::string>             errors;
+	};
+
+	struct MeshBundleReport
+	{
+		// The mesh shader meshes first and then the vertex shader ones, like the bundle.
+		std::vector<MeshReport>  meshReports;
+		std::vector<std::string> errors;
+
+		[[nodiscard]]
+		bool IsValid() const noexcept;
+	};
+
+	// Checks that the meshlets and the indices of every mesh are inside the bundle containers,
+	// that the primitive indices are inside their meshlet and that the spheres and the normal
+	// cones are conservative. The non conservative bounds are errors as well, as they would
+	// cull the visible meshlets. The limits should be the ones the bundle was made with.
+	[[nodiscard]]
+	MeshBundleReport ValidateMeshBundle(
+		const MeshBundleTemporaryData& bundleData,
+		MeshletLimitsType limitsType = MeshletLimitsType::Vertex64Primitive126
+	);
+
+	// A line for each mesh, followed by its errors.
+	[[nodiscard]]
+	std::string FormatReport(const MeshBundleReport& report);
+}
+}
+#endif
@@ -10,6 +10,58 @@ enum class RenderEngineType
 	MeshDraw
 };
 
+// The maximum vertex and primitive counts of a meshlet. Should match the limits of the mesh
+// shaders of the renderer.
+enum class MeshletLimitsType
+{
+	Vertex64Primitive126,
+	Vertex64Primitive84,
+	Vertex128Primitive128,
+	Vertex256Primitive256
+};
+
+// The optional assimp post processing of a scene. The triangulation, the conversion to left
+// handed and the bounding boxes are always done, as the mesh processing needs them.
+enum class SceneImportProfile
+{
+	// Everything but the tangents, which nothing uses.
+	Fast,
+	// Everything, the tangents included.
+	Full,
+	// Only the required steps, for the sources which are already indexed and have their
+	// normals and uvs. Like the glTFs which were exported by a tool.
+	CookedSource
+};
+
+struct SceneImportFlags
+{
+	bool calcTangentSpace         = false;
+	bool joinIdenticalVertices    = true;
+	bool genNormals               = true;
+	bool genUVCoords              = true;
+	bool removeRedundantMaterials = true;
+
+	[[nodiscard]]
+	static constexpr SceneImportFlags FromProfile(SceneImportProfile profile) noexcept
+	{
+		SceneImportFlags importFlags{};
+
+		if (profile == SceneImportProfile::Full)
+			importFlags.calcTangentSpace = true;
+		else if (profile == SceneImportProfile::CookedSource)
+			importFlags = SceneImportFlags
+			{
+				.calcTangentSpace         = false,
+				.joinIdenticalVertices    = false,
+				.genNormals               = false,
+				.genUVCoords              = false,
+				.removeRedundantMaterials = false
+			};
+
+		return importFlags;
+	}
+};
+
 enum class RendererModule
 {
 	Terra,
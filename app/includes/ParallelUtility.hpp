@@ -0,0 +1,95 @@
+#ifndef PARALLEL_UTILITY_HPP_
+#define PARALLEL_UTILITY_HPP_
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
+
+namespace Sol
+{
+// Submits a piece of work to a thread, like the work submission of the ThreadPool.
+using ParallelWorkSubmitter = std::function<void(std::function<void()>)>;
+
+// The threads a ParallelFor can use. The calling thread is one of the workers, so the
+// submitter is given at most workerCount - 1 pieces of work. Without a submitter, everything
+// runs serially on the caller.
+struct ParallelWork
+{
+	ParallelWorkSubmitter submitWork{};
+	size_t                workerCount = 1u;
+};
+
+// Shared with the submitted workers, as they might only start after the ParallelFor has
+// returned.
+struct ParallelForState
+{
+	std::atomic<size_t>     nextIndex{ 0u };
+	std::mutex              workerMutex{};
+	std::condition_variable workerFinished{};
+	size_t                  runningWorkerCount = 0u;
+	bool                    isClosed           = false;
+};
+
+// Calls the function with every index in [0, elementCount). The indices are handed out one
+// at a time, so elements which take longer don't hold up the others. Only the submitted
+// workers which have started are waited for, so it doesn't deadlock when the threads of the
+// submitter are all busy, even if the caller is one of them. The ones which start later
+// return without calling the function.
+template<typename Function_t>
+void ParallelFor(size_t elementCount, const ParallelWork& parallelWork, Function_t&& function)
+{
+	const size_t workerCount = std::min(parallelWork.workerCount, elementCount);
+
+	if (workerCount < 2u || !parallelWork.submitWork)
+	{
+		for (size_t index = 0u; index < elementCount; ++index)
+			function(index);
+
+		return;
+	}
+
+	auto state = std::make_shared<ParallelForState>();
+
+	auto RunIndices = [&nextIndex = state->nextIndex, &function, elementCount]
+	{
+		for (size_t index = nextIndex++; index < elementCount; index = nextIndex++)
+			function(index);
+	};
+
+	for (size_t index = 1u; index < workerCount; ++index)
+		parallelWork.submitWork(
+			[state, RunIndices]
+			{
+				{
+					std::scoped_lock lock{ state->workerMutex };
+
+					if (state->isClosed)
+						return;
+
+					++state->runningWorkerCount;
+				}
+
+				RunIndices();
+
+				{
+					std::scoped_lock lock{ state->workerMutex };
+
+					--state->runningWorkerCount;
+				}
+
+				state->workerFinished.notify_one();
+			}
+		);
+
+	RunIndices();
+
+	std::unique_lock lock{ state->workerMutex };
+
+	state->isClosed = true;
+
+	state->workerFinished.wait(lock, [&state] { return state->runningWorkerCount == 0u; });
+}
+}
+#endif
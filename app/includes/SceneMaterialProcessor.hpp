@@ -7,6 +7,7 @@
 #include <optional>
 #include <BlinnPhongLightTechnique.hpp>
 #include <SceneProcessor.hpp>
+#include <MeshBundleCache.hpp>
 #include <TextureAtlas.hpp>
 #include <SolMeshUtility.hpp>
 
@@ -40,11 +41,23 @@ private:
 	};
 
 public:
+	SceneMaterialProcessor()
+		: m_scene{}, m_materialData{}, m_materialDetails{}, m_texturePaths{}, m_diffuseAtlas{},
+		m_specularAtlas{}
+	{}
 	SceneMaterialProcessor(std::shared_ptr<SceneProcessor> scene)
-		: m_scene{ std::move(scene) }, m_materialData{}, m_materialDetails{}, m_texturePaths{}
+		: m_scene{ std::move(scene) }, m_materialData{}, m_materialDetails{}, m_texturePaths{},
+		m_diffuseAtlas{}, m_specularAtlas{}
 	{}
 
 	void ProcessMeshAndMaterialData();
+	// Instead of the scene's materials, so a cached scene doesn't need to be imported. The
+	// scene path is needed for the texture paths, which are relative to its directory.
+	void ProcessCachedMaterialData(const SceneCacheData& sceneData, const std::string& scenePath);
+
+	// Adds the materials and their texture paths to the data, which will be cached. They must
+	// have been processed from the scene.
+	void AddToCacheData(SceneCacheData& sceneData) const;
 
 	template<class Renderer_t, class BlinnPhongLightTechnique_t>
 	void LoadBlinnPhongMaterials(
@@ -61,24 +74,21 @@ public:
 	template<class Renderer_t>
 	void LoadTexturesAsAtlas(Renderer_t& renderer)
 	{
-		TextureAtlas diffuseAtlas{};
-		TextureAtlas specularAtlas{};
-
-		// Maybe later I will make it so there are multiple atlas and only a certain number of
-		// textures are put into a single atlas. As the precision would decrease the more textures
-		// we put in one.
-		for (const TexturePaths& texturePath : m_texturePaths)
-			for (const TexturePath& diffuseTexturePath : texturePath.diffusePaths)
-				diffuseAtlas.AddTexture(diffuseTexturePath.name, diffuseTexturePath.path);
+		PrepareTextureAtlases();
+		LoadPreparedTextureAtlases(renderer);
+	}
 
-		for (const TexturePaths& texturePath : m_texturePaths)
-			for (const TexturePath& specularTexturePath : texturePath.specularPaths)
-				specularAtlas.AddTexture(specularTexturePath.name, specularTexturePath.path);
+	// Decodes the textures and packs them into a diffuse and a specular atlas. Doesn't need
+	// the renderer, so it can be done on a different thread than the loading of the atlases.
+	void PrepareTextureAtlases();
 
+	template<class Renderer_t>
+	void LoadPreparedTextureAtlases(Renderer_t& renderer)
+	{
 		auto [diffuseTextureIndex, diffuseBindingIndex]
-			= CreateAndAddAtlas(diffuseAtlas, renderer);
+			= AddAtlas(m_diffuseAtlas, renderer);
 		auto [specularTextureIndex, specularBindingIndex]
-			= CreateAndAddAtlas(specularAtlas, renderer);
+			= AddAtlas(m_specularAtlas, renderer);
 
 		const size_t materialCount = std::size(m_materialDetails);
 
@@ -89,12 +99,12 @@ public:
 
 			ConfigureMaterialTextures(
 				materialDetails.diffuseDetails, materialTexturePaths.diffusePaths,
-				diffuseAtlas, diffuseTextureIndex, diffuseBindingIndex
+				m_diffuseAtlas, diffuseTextureIndex, diffuseBindingIndex
 			);
 
 			ConfigureMaterialTextures(
 				materialDetails.specularDetails, materialTexturePaths.specularPaths,
-				specularAtlas, specularTextureIndex, specularBindingIndex
+				m_specularAtlas, specularTextureIndex, specularBindingIndex
 			);
 		}
 	}
@@ -179,16 +189,15 @@ private:
 
 	template<class Renderer_t>
 	[[nodiscard]]
-	static std::pair<std::uint32_t, std::uint32_t> CreateAndAddAtlas(
+	static std::pair<std::uint32_t, std::uint32_t> AddAtlas(
 		class TextureAtlas& atlas, Renderer_t& renderer
 	) {
 		auto textureIndex = std::numeric_limits<std::uint32_t>::max();
 		auto bindingIndex = std::numeric_limits<std::uint32_t>::max();
 
-		if (atlas.DoUnprocessedTexturesExist())
+		// The atlas must have been created by the PrepareTextureAtlases.
+		if (atlas.DoesTextureExist())
 		{
-			atlas.CreateAtlas();
-
 			textureIndex = static_cast<std::uint32_t>(
 				renderer.AddTexture(std::move(atlas.MoveTexture()))
 			);
@@ -205,6 +214,8 @@ private:
 	std::vector<BlinnPhongMaterial> m_materialData;
 	std::vector<MaterialDetails>    m_materialDetails;
 	std::vector<TexturePaths>       m_texturePaths;
+	TextureAtlas                    m_diffuseAtlas;
+	TextureAtlas                    m_specularAtlas;
 
 public:
 	SceneMaterialProcessor(const SceneMaterialProcessor&) = delete;
@@ -214,7 +225,9 @@ public:
 		: m_scene{ std::move(other.m_scene) },
 		m_materialData{ std::move(other.m_materialData) },
 		m_materialDetails{ std::move(other.m_materialDetails) },
-		m_texturePaths{ std::move(other.m_texturePaths) }
+		m_texturePaths{ std::move(other.m_texturePaths) },
+		m_diffuseAtlas{ std::move(other.m_diffuseAtlas) },
+		m_specularAtlas{ std::move(other.m_specularAtlas) }
 	{}
 	SceneMaterialProcessor& operator=(SceneMaterialProcessor&& other) noexcept
 	{
@@ -222,6 +235,8 @@ public:
 		m_materialData    = std::move(other.m_materialData);
 		m_materialDetails = std::move(other.m_materialDetails);
 		m_texturePaths    = std::move(other.m_texturePaths);
+		m_diffuseAtlas    = std::move(other.m_diffuseAtlas);
+		m_specularAtlas   = std::move(other.m_specularAtlas);
 
 		return *this;
 	}
@@ -5,53 +5,200 @@
 #include <SceneProcessor.hpp>
 #include <SolMeshUtility.hpp>
 #include <GLTFObject.hpp>
+#include <MeshletMaker.hpp>
+#include <MeshletHierarchy.hpp>
+#include <MeshBoundImpl.hpp>
+#include <ParallelUtility.hpp>
 
 namespace Sol
 {
+struct MeshProcessingOptions
+{
+	MeshletBuildMode    meshletBuildMode    = MeshletBuildMode::IndexOrder;
+	MeshletLimitsType   meshletLimits       = MeshletLimitsType::Vertex64Primitive126;
+	// Reorders the triangles of each mesh for the post transform vertex cache, before the
+	// indices are added to the bundle or the meshlets are made.
+	bool                optimiseVertexCache = false;
+	// Sorts the triangle clusters of each mesh, so the likely occluders are drawn first.
+	// Only done on the vertex shader path, after the vertex cache optimisation.
+	bool                optimiseOverdraw    = false;
+	// Reorders the vertices of each mesh in the order they are first used by the indices or
+	// the meshlets.
+	bool                optimiseVertexFetch = false;
+	// How the bounding spheres of the meshlets are made.
+	SphereBVAlgorithm   sphereBVAlgorithm   = SphereBVAlgorithm::AABBCentre;
+	// How the backface culling cones of the meshlets are made.
+	NormalConeAlgorithm normalConeAlgorithm = NormalConeAlgorithm::VertexNormals;
+	// Replaces the vertices with the 16 byte quantised ones, once everything else is done.
+	// The renderer can't draw them yet, so they are only for storing the bundles.
+	bool                quantiseVertices    = false;
+	// The meshes with the same geometry as an earlier mesh of the scene aren't processed
+	// again. Their details are a copy of the first one's, so they share its data in the
+	// bundle. Only used with the assimp scenes.
+	bool                deduplicateMeshes   = false;
+	// The coarser levels of detail made for each mesh, each with the lodTriangleRatio of the
+	// previous level's triangles. They are added as extra mesh details, after the meshes.
+	size_t              lodCount            = 0u;
+	float               lodTriangleRatio    = 0.5f;
+	// Makes a MeshletHierarchy of each mesh on the mesh shader path of the AsyncSceneLoader.
+	// The renderers can't select the meshlets of a cut yet, so the hierarchies are only kept
+	// with the loaded scene. They don't change the bundle and aren't in the .solmesh cache.
+	bool                generateHierarchy   = false;
+};
+
 class SceneMeshProcessor
 {
 public:
-	SceneMeshProcessor() : m_scene{} {}
-	SceneMeshProcessor(std::shared_ptr<SceneProcessor> scene) : m_scene{ std::move(scene) } {}
+	SceneMeshProcessor() : m_scene{}, m_options{}, m_parallelWork{} {}
+	SceneMeshProcessor(std::shared_ptr<SceneProcessor> scene)
+		: m_scene{ std::move(scene) }, m_options{}, m_parallelWork{}
+	{}
 
 	void SetSceneProcessor(std::shared_ptr<SceneProcessor> scene);
+	void SetOptions(const MeshProcessingOptions& options) noexcept { m_options = options; }
+	void SetMeshletBuildMode(MeshletBuildMode buildMode) noexcept
+	{
+		m_options.meshletBuildMode = buildMode;
+	}
+	void SetMeshletLimits(MeshletLimitsType limitsType) noexcept
+	{
+		m_options.meshletLimits = limitsType;
+	}
+	void SetVertexCacheOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseVertexCache = optimise;
+	}
+	void SetOverdrawOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseOverdraw = optimise;
+	}
+	void SetVertexFetchOptimisation(bool optimise) noexcept
+	{
+		m_options.optimiseVertexFetch = optimise;
+	}
+	void SetSphereBVAlgorithm(SphereBVAlgorithm algorithm) noexcept
+	{
+		m_options.sphereBVAlgorithm = algorithm;
+	}
+	void SetNormalConeAlgorithm(NormalConeAlgorithm algorithm) noexcept
+	{
+		m_options.normalConeAlgorithm = algorithm;
+	}
+	void SetVertexQuantisation(bool quantise) noexcept
+	{
+		m_options.quantiseVertices = quantise;
+	}
+	void SetMeshDeduplication(bool deduplicate) noexcept
+	{
+		m_options.deduplicateMeshes = deduplicate;
+	}
+	void SetLodGeneration(size_t lodCount, float triangleRatio = 0.5f) noexcept
+	{
+		m_options.lodCount         = lodCount;
+		m_options.lodTriangleRatio = triangleRatio;
+	}
+	// With a submitter and more than a single worker, each mesh will be processed into its
+	// own temporary data on the submitter's threads and then they will be concatenated. The
+	// result is the same as the serial processing.
+	void SetParallelWork(ParallelWork parallelWork) noexcept
+	{
+		m_parallelWork = std::move(parallelWork);
+	}
+
+	[[nodiscard]]
+	const MeshProcessingOptions& GetOptions() const noexcept { return m_options; }
 
 	[[nodiscard]]
 	MeshBundleTemporaryData GenerateTemporaryMeshData(bool meshShader);
+	// A hierarchy per mesh, in the order of the meshes of the scene. Uses the meshlet limits,
+	// the bound algorithms and the parallel work, but not the other options.
+	[[nodiscard]]
+	std::vector<MeshletHierarchy> GenerateMeshletHierarchies() const;
+
+	// For each mesh of the scene, the index of the mesh its nodes should reference. Unlike
+	// the data, the material must match too, as the material details are per mesh index.
+	// Every mesh references itself, if the deduplication is off.
+	[[nodiscard]]
+	static std::vector<std::uint32_t> GenerateNodeMeshRemap(
+		aiScene const* scene, const MeshProcessingOptions& options
+	);
 
 private:
 	[[nodiscard]]
-	static MeshBundleTemporaryData GenerateMeshShaderData(aiScene const* scene);
+	static MeshBundleTemporaryData GenerateMeshShaderData(
+		aiScene const* scene, const MeshProcessingOptions& options
+	);
 	[[nodiscard]]
-	static MeshBundleTemporaryData GenerateVertexShaderData(aiScene const* scene);
+	static MeshBundleTemporaryData GenerateVertexShaderData(
+		aiScene const* scene, const MeshProcessingOptions& options
+	);
+
+	// For each mesh of the scene, the index of the mesh whose data it uses. Every mesh uses its
+	// own, if the deduplication is off.
+	[[nodiscard]]
+	static std::vector<std::uint32_t> GenerateMeshRemap(
+		aiScene const* scene, const MeshProcessingOptions& options, bool matchMaterials = false
+	);
+
+	[[nodiscard]]
+	static MeshBundleTemporaryData GenerateMeshShaderDataParallel(
+		aiScene const* scene, const MeshProcessingOptions& options,
+		const ParallelWork& parallelWork
+	);
+	[[nodiscard]]
+	static MeshBundleTemporaryData GenerateVertexShaderDataParallel(
+		aiScene const* scene, const MeshProcessingOptions& options,
+		const ParallelWork& parallelWork
+	);
+
+	// The per mesh data must have been generated into empty temporary data. The data of the
+	// remapped meshes isn't used.
+	[[nodiscard]]
+	static MeshBundleTemporaryData ConcatenateMeshShaderData(
+		std::vector<MeshBundleTemporaryData>& perMeshData,
+		std::span<const std::uint32_t> meshRemap, const ParallelWork& parallelWork
+	);
+	[[nodiscard]]
+	static MeshBundleTemporaryData ConcatenateVertexShaderData(
+		std::vector<MeshBundleTemporaryData>& perMeshData,
+		std::span<const std::uint32_t> meshRemap, const ParallelWork& parallelWork
+	);
 
 	static void ProcessMeshVS(
-		aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+		aiMesh* mesh, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 	static void ProcessMeshMS(
-		aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+		aiMesh* mesh, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 
 	static void ProcessMeshVertices(
 		aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 	static void ProcessMeshFaces(
-		aiMesh* mesh, std::uint32_t vertexOffset, MeshBundleTemporaryData& meshBundleTemporaryData
+		aiMesh* mesh, std::uint32_t vertexOffset, bool optimiseVertexCache,
+		MeshBundleTemporaryData& meshBundleTemporaryData
 	) noexcept;
 
 private:
 	std::shared_ptr<SceneProcessor> m_scene;
+	MeshProcessingOptions           m_options;
+	ParallelWork                    m_parallelWork;
 
 public:
 	SceneMeshProcessor(const SceneMeshProcessor&) = delete;
 	SceneMeshProcessor& operator=(const SceneMeshProcessor&) = delete;
 
 	SceneMeshProcessor(SceneMeshProcessor&& other) noexcept
-		: m_scene{ std::move(other.m_scene) }
+		: m_scene{ std::move(other.m_scene) }, m_options{ other.m_options },
+		m_parallelWork{ std::move(other.m_parallelWork) }
 	{}
 	SceneMeshProcessor& operator=(SceneMeshProcessor&& other) noexcept
 	{
-		m_scene = std::move(other.m_scene);
+		m_scene        = std::move(other.m_scene);
+		m_options      = other.m_options;
+		m_parallelWork = std::move(other.m_parallelWork);
 
 		return *this;
 	}
@@ -60,7 +207,10 @@ public:
 namespace SceneMeshProcessor1
 {
 	[[nodiscard]]
-	MeshBundleTemporaryData GenerateTemporaryMeshData(const GLTFObject& gltfObj, bool meshShader);
+	MeshBundleTemporaryData GenerateTemporaryMeshData(
+		const GLTFObject& gltfObj, bool meshShader,
+		const MeshProcessingOptions& options = MeshProcessingOptions{}
+	);
 };
 }
 #endif
@@ -1,14 +1,18 @@
 #ifndef SCENE_PROCESSOR_HPP_
 #define SCENE_PROCESSOR_HPP_
 #include <assimp/scene.h>
+#include <chrono>
 #include <string>
+#include <ModuleTypes.hpp>
 
 namespace Sol
 {
 class SceneProcessor
 {
 public:
-	SceneProcessor(const std::string& scenePath);
+	SceneProcessor(
+		const std::string& scenePath, const SceneImportFlags& importFlags = SceneImportFlags{}
+	);
 	~SceneProcessor() noexcept;
 
 	[[nodiscard]]
@@ -18,19 +22,28 @@ public:
 
 	[[nodiscard]]
 	aiScene const* GetScene() const noexcept { return m_scene; }
+	[[nodiscard]]
+	const SceneImportFlags& GetImportFlags() const noexcept { return m_importFlags; }
+	// How long assimp took to read and post process the scene.
+	[[nodiscard]]
+	std::chrono::nanoseconds GetImportTime() const noexcept { return m_importTime; }
 
 	[[nodiscard]]
 	static std::string GetFileName(const std::string& filePath) noexcept;
-
-private:
 	[[nodiscard]]
 	static std::string GetFileDirectory(const std::string& filePath) noexcept;
+
+private:
 	[[nodiscard]]
 	static size_t GetFileNameCount(const std::string& filePath) noexcept;
+	[[nodiscard]]
+	static std::uint32_t GetPostProcessFlags(const SceneImportFlags& importFlags) noexcept;
 
 private:
-	aiScene const* m_scene;
-	std::string    m_filePath;
+	aiScene const*           m_scene;
+	std::string              m_filePath;
+	SceneImportFlags         m_importFlags;
+	std::chrono::nanoseconds m_importTime;
 
 public:
 	SceneProcessor(const SceneProcessor&) = delete;
@@ -38,12 +51,15 @@ public:
 
 	SceneProcessor(SceneProcessor&& other) noexcept
 		: m_scene{ std::exchange(other.m_scene, nullptr) },
-		m_filePath{ std::move(other.m_filePath) }
+		m_filePath{ std::move(other.m_filePath) }, m_importFlags{ other.m_importFlags },
+		m_importTime{ other.m_importTime }
 	{}
 	SceneProcessor& operator=(SceneProcessor&& other) noexcept
 	{
-		m_scene    = std::exchange(other.m_scene, nullptr);
-		m_filePath = std::move(other.m_filePath);
+		m_scene       = std::exchange(other.m_scene, nullptr);
+		m_filePath    = std::move(other.m_filePath);
+		m_importFlags = other.m_importFlags;
+		m_importTime  = other.m_importTime;
 
 		return *this;
 	}
@@ -15,6 +15,7 @@
 #include <RenderPassManager.hpp>
 #include <CameraManagerSol.hpp>
 #include <ModelContainer.hpp>
+#include <ParallelUtility.hpp>
 
 #ifdef SOL_WIN32
 #include <WinWindow.hpp>
@@ -105,7 +106,7 @@ public:
 		: m_appName{ appName },
 		m_configManager{ std::move(configManager) },
 		m_frameTime{},
-		m_threadPool{ std::make_shared<ThreadPool>( 8u ) },
+		m_threadPool{ std::make_shared<ThreadPool>( s_threadCount ) },
 		m_inputManager{ CreateInputManager() },
 		m_window{ CreateWindowModule(s_width, s_height, appName) },
 		m_cameraManager{},
@@ -163,8 +164,14 @@ public:
 		// Create the fixed Descriptors here.
 		m_extensionManager.SetFixedDescriptors(m_renderer);
 
-		// App
-		m_app.Init(m_renderer, m_extensionManager, m_renderPassManager);
+		// App. The meshes of its scenes are processed on the thread pool.
+		m_app.Init(
+			m_renderer, m_extensionManager, m_renderPassManager, m_configManager,
+			ParallelWork{
+				.submitWork  = GetWorkSubmitter(m_threadPool),
+				.workerCount = s_threadCount
+			}
+		);
 	}
 
 	int Run()
@@ -271,6 +278,15 @@ private:
 			};
 	}
 
+	[[nodiscard]]
+	static ParallelWorkSubmitter GetWorkSubmitter(std::shared_ptr<ThreadPool> threadPool)
+	{
+		return [threadPool = std::move(threadPool)](std::function<void()> work)
+		{
+			threadPool->SubmitWork(std::move(work));
+		};
+	}
+
 	static void Win32InputCallbackProxy(
 		void* hwnd, std::uint32_t message, std::uint64_t wParam, std::uint64_t lParam,
 		void* extraData
@@ -354,9 +370,10 @@ private:
 
 private:
 	// Default resolution
-	static constexpr std::uint32_t s_width      = 1920u;
-	static constexpr std::uint32_t s_height     = 1080u;
-	static constexpr std::uint32_t s_frameCount = 2u;
+	static constexpr std::uint32_t s_width       = 1920u;
+	static constexpr std::uint32_t s_height      = 1080u;
+	static constexpr std::uint32_t s_frameCount  = 2u;
+	static constexpr size_t        s_threadCount = 8u;
 
 private:
 	std::string                 m_appName;
@@ -3,7 +3,9 @@
 #include <utility>
 #include <cstring>
 #include <vector>
+#include <type_traits>
 #include <MeshBundle.hpp>
+#include <ModuleTypes.hpp>
 #include <Model.hpp>
 
 namespace Sol
@@ -59,25 +61,64 @@ struct MeshMaterialDetails
 	std::uint32_t                   pipelineIndex;
 };
 
+// Appends without resizing first, so the new elements aren't value initialised before being
+// overwritten. The insert of a trivially copyable type is a memcpy.
 template<typename T>
 static void MemcpyIntoVector(std::vector<T>& dst, const std::vector<T>& src) noexcept
 {
-	const size_t srcElementCount = std::size(src);
-	const size_t dstElementCount = std::size(dst);
+	static_assert(std::is_trivially_copyable_v<T>, "The elements can't be memcpied.");
 
-	const size_t srcDataSize  = sizeof(T) * srcElementCount;
-	// Since std::data returns T*, the start would be the old count.
-	const size_t dstDataStart = dstElementCount;
+	dst.insert(std::end(dst), std::begin(src), std::end(src));
+}
+
+// Unlike the shrink_to_fit, which is only a request, the capacity will always be the size
+// afterwards. The elements aren't value initialised in the new allocation.
+template<typename T>
+static void ReallocateToSize(std::vector<T>& elements)
+{
+	if (elements.capacity() == std::size(elements))
+		return;
+
+	std::vector<T> exactElements{};
+
+	exactElements.reserve(std::size(elements));
 
-	dst.resize(srcElementCount + dstElementCount);
+	MemcpyIntoVector(exactElements, elements);
 
-	memcpy(std::data(dst) + dstDataStart, std::data(src), srcDataSize);
+	elements = std::move(exactElements);
 }
 
 void CopyAndOffsetIndices(
 	std::vector<std::uint32_t>& dst, const std::vector<std::uint32_t>& src, std::uint32_t offset
 ) noexcept;
 
+// The element counts of the containers of a mesh bundle, so they can be allocated once before
+// the meshes are added to them. When the meshlets haven't been made yet, the index, primitive
+// and meshlet counts of the mesh shader data are upper bounds.
+struct MeshBundleElementCounts
+{
+	size_t vertexCount    = 0u;
+	size_t indexCount     = 0u;
+	size_t primitiveCount = 0u;
+	size_t meshletCount   = 0u;
+
+	// The indices should be triangles.
+	void AddMesh(
+		size_t meshVertexCount, size_t meshIndexCount, bool meshShader,
+		MeshletLimitsType meshletLimits
+	) noexcept;
+};
+
+// Only reserves the containers, so the memory isn't initialised before the meshes are written
+// into it. Nothing will be reallocated while the meshes are added, if the counts are right.
+void ReserveMeshBundleData(
+	MeshBundleTemporaryData& meshBundleTempData, const MeshBundleElementCounts& elementCounts
+);
+// Frees the capacity the upper bounds of the meshlet data reserved, but didn't use. Each
+// container with unused capacity is moved into an allocation of its exact size, one at a time,
+// so at most one container is held twice.
+void TrimMeshBundleData(MeshBundleTemporaryData& meshBundleTempData);
+
 void SetDefaultTextureDetails(std::uint32_t textureIndex, std::uint32_t bindingIndex) noexcept;
 
 [[nodiscard]]
@@ -1,5 +1,6 @@
 #ifndef SOL_SCENE_HPP_
 #define SOL_SCENE_HPP_
+#include <span>
 #include <SolMeshUtility.hpp>
 #include <assimp/scene.h>
 #include <SceneMeshProcessor.hpp>
@@ -12,11 +13,30 @@ class SolScene
 public:
 	SolScene() : m_sceneNodeData{}, m_meshMaterialDetails{} {}
 
-	void SetSceneNodes(const SceneProcessor& sceneProcessor);
+	// With the mesh deduplication on, the nodes with a mesh which has the same geometry and
+	// material as an earlier mesh of the scene, reference the earlier one instead. The
+	// options should be the ones the meshes were processed with.
+	void SetSceneNodes(
+		const SceneProcessor& sceneProcessor, const MeshProcessingOptions& meshOptions
+	);
+	// The nodes of a cooked scene.
+	void SetSceneNodes(std::vector<SceneNodeData>&& sceneNodeData) noexcept
+	{
+		m_sceneNodeData = std::move(sceneNodeData);
+	}
 
 	void SetMeshMaterialDetails(
 		const SceneProcessor& sceneProcessor, const SceneMaterialProcessor& materialProcessor
 	);
+	// With the material index of each mesh, so the meshes of a cooked scene can be matched to
+	// the materials.
+	void SetMeshMaterialDetails(
+		std::span<const std::uint32_t> meshMaterialIndices,
+		const SceneMaterialProcessor& materialProcessor
+	);
+
+	[[nodiscard]]
+	static std::vector<std::uint32_t> GetMeshMaterialIndices(const SceneProcessor& sceneProcessor);
 
 	[[nodiscard]]
 	const MeshMaterialDetails& GetMeshMaterialDetail(size_t index) const noexcept
@@ -37,13 +57,15 @@ public:
 private:
 	static void ProcessSceneNodeDetails(
 		aiNode const* node, std::vector<SceneNodeData>& sceneNodeData,
-		DirectX::XMMATRIX accumulatedTransform, aiMesh** meshes, std::uint32_t& childrenOffset,
+		DirectX::XMMATRIX accumulatedTransform, aiMesh** meshes,
+		std::span<const std::uint32_t> meshRemap, std::uint32_t& childrenOffset,
 		std::uint32_t& modelIndex
 	);
 	static void TraverseMeshHierarchyDetails(
 		aiNode const* node, DirectX::XMMATRIX accumulatedTransform,
-		std::vector<SceneNodeData>& sceneNodeData,
-		aiMesh** meshes, std::uint32_t& childrenOffset, std::uint32_t& modelIndex
+		std::vector<SceneNodeData>& sceneNodeData, aiMesh** meshes,
+		std::span<const std::uint32_t> meshRemap, std::uint32_t& childrenOffset,
+		std::uint32_t& modelIndex
 	);
 
 private:
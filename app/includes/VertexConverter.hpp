@@ -0,0 +1,62 @@
+#ifndef VERTEX_CONVERTER_HPP_
+#define VERTEX_CONVERTER_HPP_
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <MeshBundle.hpp>
+
+namespace Sol
+{
+namespace VertexConverter
+{
+	// The component types of the glTF attributes, which can be converted to floats.
+	enum class ComponentType : std::uint8_t
+	{
+		Float,
+		Int8,
+		UInt8,
+		Int16,
+		UInt16
+	};
+
+	// Elements with a byte stride between them, like the aiVector3D arrays or a glTF accessor.
+	// The positions and the normals must have 3 components and the uvs 2 at the start of each
+	// element. Without any data, the attribute of the default vertex is used.
+	struct AttributeStream
+	{
+		void const*   data          = nullptr;
+		size_t        stride        = 0u;
+		ComponentType componentType = ComponentType::Float;
+		// The integer components are mapped to [0, 1] or [-1, 1], instead of just being
+		// converted to floats.
+		bool          normalised    = false;
+	};
+
+	struct VertexStreams
+	{
+		AttributeStream positions;
+		AttributeStream normals;
+		AttributeStream uvs;
+	};
+
+	// Interleaves the streams into the vertices, which must already have their size. If the
+	// Zs are flipped, the Zs of the positions and the normals from the streams are negated,
+	// but not the ones of the default vertex. The float streams use SSE when DirectXMath does,
+	// and the common strides have their own loops. The other component types are decoded
+	// one element at a time.
+	void ConvertVertices(
+		std::span<Vertex> vertices, const VertexStreams& streams, bool flipZ,
+		const Vertex& defaultVertex
+	) noexcept;
+
+	// Converts the vertexCount vertices of the streams after the end of the vertices. They are
+	// converted in small batches on the stack and then inserted, so the new vertices don't
+	// have to be value initialised by a resize first. The vertices should have the capacity
+	// for them already.
+	void AppendVertices(
+		std::vector<Vertex>& vertices, size_t vertexCount, const VertexStreams& streams,
+		bool flipZ, const Vertex& defaultVertex
+	) noexcept;
+}
+}
+#endif
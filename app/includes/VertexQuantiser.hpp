@@ -0,0 +1,41 @@
+#ifndef VERTEX_QUANTISER_HPP_
+#define VERTEX_QUANTISER_HPP_
+#include <span>
+#include <vector>
+#include <MeshBundle.hpp>
+
+namespace Sol
+{
+namespace VertexQuantiser
+{
+	// The bounds of the positions and the uvs of the vertices.
+	[[nodiscard]]
+	VertexQuantisation GenerateQuantisation(std::span<const Vertex> vertices) noexcept;
+
+	// The positions and the uvs are stored as unorm16 relative to the bounds and the normals
+	// as octahedral snorm16. The quantised vertices must have the same size as the vertices.
+	void QuantiseVertices(
+		std::span<const Vertex> vertices, const VertexQuantisation& quantisation,
+		std::span<QuantisedVertex> quantisedVertices
+	) noexcept;
+	void DequantiseVertices(
+		std::span<const QuantisedVertex> quantisedVertices,
+		const VertexQuantisation& quantisation, std::span<Vertex> vertices
+	) noexcept;
+}
+
+// Replaces the vertices of the bundle with the quantised ones, each mesh with its own bounds.
+// The vertices of a mesh go from its vertexOffset to the next larger one. The meshes with the
+// same vertexOffset share their vertices and quantisation. Should be done after everything
+// else, as the bounds and the optimisations need the float vertices.
+void QuantiseMeshBundleVertices(MeshBundleTemporaryData& bundleData);
+// Returns the float vertices of the bundle, whichever layout it has.
+[[nodiscard]]
+std::vector<Vertex> DequantiseMeshBundleVertices(const MeshBundleTemporaryData& bundleData);
+
+// The shaders only read the float vertices so far, so the quantised bundles can only be
+// stored. Must be called before a bundle is given to the renderer. Throws, if the bundle
+// is quantised.
+void CheckRenderableVertexLayout(const MeshBundleTemporaryData& bundleData);
+}
+#endif
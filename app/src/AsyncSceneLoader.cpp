@@ -0,0 +1,201 @@
+#include <AsyncSceneLoader.hpp>
+#include <chrono>
+#include <SolException.hpp>
+
+namespace Sol
+{
+// The stages before the Ready.
+static constexpr float s_loadStageCount = 4.f;
+
+// Scene Load Handle
+SceneLoadHandle::~SceneLoadHandle() noexcept
+{
+	Cancel();
+	// The jthread will be joined here.
+}
+
+void SceneLoadHandle::Cancel() noexcept
+{
+	if (m_state)
+		m_state->stopSource.request_stop();
+}
+
+SceneLoadStage SceneLoadHandle::GetStage() const noexcept
+{
+	return m_state ? m_state->stage.load() : SceneLoadStage::Queued;
+}
+
+float SceneLoadHandle::GetProgress() const noexcept
+{
+	const SceneLoadStage stage = GetStage();
+
+	if (stage == SceneLoadStage::Ready)
+		return 1.f;
+
+	if (stage == SceneLoadStage::Queued || stage > SceneLoadStage::Ready)
+		return 0.f;
+
+	const auto finishedStageCount = static_cast<float>(
+		static_cast<std::uint32_t>(stage) - static_cast<std::uint32_t>(SceneLoadStage::Import)
+	);
+
+	return finishedStageCount / s_loadStageCount;
+}
+
+bool SceneLoadHandle::IsReady() const
+{
+	return m_result.valid()
+		&& m_result.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready;
+}
+
+SceneLoadResult SceneLoadHandle::Get()
+{
+	return m_result.get();
+}
+
+// Load Scene Async
+[[nodiscard]]
+static SceneLoadResult LoadScene(
+	const std::string& scenePath, const SceneLoadOptions& options,
+	const SceneLoadWorkSubmitter& submitWork, SceneLoadState& state
+) {
+	std::stop_token stopToken = state.stopSource.get_token();
+
+	auto StartStage = [&state, &stopToken](SceneLoadStage stage)
+	{
+		if (stopToken.stop_requested())
+			throw Exception{ "SceneLoadCancelled", "The scene load was cancelled." };
+
+		state.stage = stage;
+	};
+
+	SceneLoadResult result{};
+
+	StartStage(SceneLoadStage::Import);
+
+	std::string cachePath{};
+	MeshBundleCache::CacheKey cacheKey{};
+	std::optional<SceneCacheData> cachedData{};
+
+	const bool generateHierarchies = options.meshShader && options.meshOptions.generateHierarchy;
+
+	// The cache has everything else the scene is imported for, so a cached scene isn't
+	// imported, unless it needs the hierarchies.
+	if (options.useCache)
+	{
+		cachePath = MeshBundleCache::GetCachePath(scenePath);
+		cacheKey  = MeshBundleCache::GenerateCacheKey(
+			scenePath, options.meshShader, options.meshOptions, options.importFlags
+		);
+
+		if (!generateHierarchies)
+			cachedData = MeshBundleCache::ReadCache(cachePath, cacheKey);
+	}
+
+	if (!cachedData)
+		result.sceneProcessor = std::make_shared<SceneProcessor>(scenePath, options.importFlags);
+
+	StartStage(SceneLoadStage::Materials);
+
+	result.materialProcessor = std::make_unique<SceneMaterialProcessor>(result.sceneProcessor);
+
+	if (cachedData)
+		result.materialProcessor->ProcessCachedMaterialData(*cachedData, scenePath);
+	else
+		result.materialProcessor->ProcessMeshAndMaterialData();
+
+	StartStage(SceneLoadStage::Textures);
+
+	if (options.loadTextures)
+		result.materialProcessor->PrepareTextureAtlases();
+
+	StartStage(SceneLoadStage::Meshes);
+
+	if (cachedData)
+	{
+		result.sceneData = std::move(*cachedData);
+
+		return result;
+	}
+
+	SceneMeshProcessor meshProcessor{ result.sceneProcessor };
+
+	meshProcessor.SetOptions(options.meshOptions);
+	meshProcessor.SetParallelWork(
+		ParallelWork{ .submitWork = submitWork, .workerCount = options.workerCount }
+	);
+
+	SolScene nodeScene{};
+
+	nodeScene.SetSceneNodes(*result.sceneProcessor, options.meshOptions);
+
+	result.sceneData = SceneCacheData
+	{
+		.bundleData          = meshProcessor.GenerateTemporaryMeshData(options.meshShader),
+		.sceneNodeData       = nodeScene.GetSceneNodeData(),
+		.meshMaterialIndices = SolScene::GetMeshMaterialIndices(*result.sceneProcessor)
+	};
+
+	if (generateHierarchies)
+		result.meshletHierarchies = meshProcessor.GenerateMeshletHierarchies();
+
+	// A cache which couldn't be written will be processed again on the next load.
+	if (options.useCache)
+	{
+		result.materialProcessor->AddToCacheData(result.sceneData);
+
+		std::ignore = MeshBundleCache::WriteCache(cachePath, cacheKey, result.sceneData);
+	}
+
+	return result;
+}
+
+static void RunSceneLoad(
+	const std::string& scenePath, const SceneLoadOptions& options,
+	const SceneLoadWorkSubmitter& submitWork, SceneLoadState& state,
+	std::promise<SceneLoadResult>& result
+) {
+	try
+	{
+		SceneLoadResult loadResult = LoadScene(scenePath, options, submitWork, state);
+
+		state.stage = SceneLoadStage::Ready;
+
+		result.set_value(std::move(loadResult));
+	}
+	catch (...)
+	{
+		state.stage = state.stopSource.stop_requested()
+			? SceneLoadStage::Cancelled : SceneLoadStage::Failed;
+
+		result.set_exception(std::current_exception());
+	}
+}
+
+SceneLoadHandle LoadSceneAsync(
+	std::string scenePath, const SceneLoadOptions& options,
+	const SceneLoadWorkSubmitter& submitWork
+) {
+	auto state  = std::make_shared<SceneLoadState>();
+	// The submitted functions must be copyable, so the promise can't be moved into them.
+	auto result = std::make_shared<std::promise<SceneLoadResult>>();
+
+	std::future<SceneLoadResult> resultFuture = result->get_future();
+
+	auto work = [scenePath = std::move(scenePath), options, submitWork, state, result]
+	{
+		RunSceneLoad(scenePath, options, submitWork, *state, *result);
+	};
+
+	if (submitWork)
+	{
+		submitWork(std::move(work));
+
+		return SceneLoadHandle{ std::move(state), std::move(resultFuture), std::jthread{} };
+	}
+
+	return SceneLoadHandle{
+		std::move(state), std::move(resultFuture), std::jthread{ std::move(work) }
+	};
+}
+}
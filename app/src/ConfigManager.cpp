@@ -7,7 +7,9 @@ static const std::unordered_map<std::string, std::string> DEFAULTMODULES =
 	{"Renderer",     "Terra"},
 	{"RenderEngine", "IndividualDraw"},
 	{"Window",       "Luna"},
-	{"IO",           "Pluto"}
+	{"IO",           "Pluto"},
+	{"MeshletLimits", "64x126"},
+	{"SceneImportProfile", "fast"}
 };
 
 void ConfigManager::ReadConfigFile() noexcept
@@ -48,6 +50,24 @@ void ConfigManager::ReadConfigFile() noexcept
 		if (valueMap != std::end(DEFAULTMODULES))
 			m_parser.AddOrUpdateValue(systems, valueMap->first, valueMap->second);
 	}
+
+	if (std::string meshletLimits = "MeshletLimits";
+		!m_parser.DoesValueExist(meshletLimits, systems))
+	{
+		auto valueMap = DEFAULTMODULES.find(meshletLimits);
+
+		if (valueMap != std::end(DEFAULTMODULES))
+			m_parser.AddOrUpdateValue(systems, valueMap->first, valueMap->second);
+	}
+
+	if (std::string importProfile = "SceneImportProfile";
+		!m_parser.DoesValueExist(importProfile, systems))
+	{
+		auto valueMap = DEFAULTMODULES.find(importProfile);
+
+		if (valueMap != std::end(DEFAULTMODULES))
+			m_parser.AddOrUpdateValue(systems, valueMap->first, valueMap->second);
+	}
 }
 
 RendererModule ConfigManager::GetRendererModuleType() const noexcept
@@ -97,4 +117,57 @@ RenderEngineType ConfigManager::GetRenderEngineType() const noexcept
 
 	return renderEngineType;
 }
+
+MeshletLimitsType ConfigManager::GetMeshletLimitsType() const noexcept
+{
+	MeshletLimitsType limitsType = MeshletLimitsType::Vertex64Primitive126;
+
+	const std::string meshletLimits = GetMeshletLimits();
+
+	if (meshletLimits == "64x84")
+		limitsType = MeshletLimitsType::Vertex64Primitive84;
+	else if (meshletLimits == "128x128")
+		limitsType = MeshletLimitsType::Vertex128Primitive128;
+	else if (meshletLimits == "256x256")
+		limitsType = MeshletLimitsType::Vertex256Primitive256;
+
+	return limitsType;
+}
+
+SceneImportProfile ConfigManager::GetSceneImportProfileType() const noexcept
+{
+	SceneImportProfile profile = SceneImportProfile::Fast;
+
+	const std::string importProfile = GetSceneImportProfile();
+
+	if (importProfile == "full")
+		profile = SceneImportProfile::Full;
+	else if (importProfile == "cooked-source")
+		profile = SceneImportProfile::CookedSource;
+
+	return profile;
+}
+
+void ConfigManager::ReadSceneImportFlag(const std::string& flagName, bool& flag) const noexcept
+{
+	const std::string value = m_parser.GetValue(flagName, "SceneImport");
+
+	if (value == "true")
+		flag = true;
+	else if (value == "false")
+		flag = false;
+}
+
+SceneImportFlags ConfigManager::GetSceneImportFlags() const noexcept
+{
+	SceneImportFlags importFlags = SceneImportFlags::FromProfile(GetSceneImportProfileType());
+
+	ReadSceneImportFlag("CalcTangentSpace", importFlags.calcTangentSpace);
+	ReadSceneImportFlag("JoinIdenticalVertices", importFlags.joinIdenticalVertices);
+	ReadSceneImportFlag("GenNormals", importFlags.genNormals);
+	ReadSceneImportFlag("GenUVCoords", importFlags.genUVCoords);
+	ReadSceneImportFlag("RemoveRedundantMaterials", importFlags.removeRedundantMaterials);
+
+	return importFlags;
+}
 }
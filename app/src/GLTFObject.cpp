@@ -1,20 +1,190 @@
 #include <GLTFObject.hpp>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <SolException.hpp>
 
 namespace Sol
 {
-void GLTFObject::LoadFromFile(const char* fileName)
+// A .glb starts with a 12 bytes header and the JSON chunk. The binary chunk is optional and
+// comes after it. Every chunk has an 8 bytes header with its size and type.
+static constexpr std::uint32_t s_glbMagic           = 0x46546C67u; // glTF
+static constexpr std::uint32_t s_glbBinaryChunkType = 0x004E4942u; // BIN
+static constexpr size_t        s_glbHeaderSize      = 12u;
+static constexpr size_t        s_glbChunkHeaderSize = 8u;
+
+[[nodiscard]]
+static std::uint32_t ReadUInt32(GLTFBufferData data, size_t offset) noexcept
+{
+	std::uint32_t value = 0u;
+
+	memcpy(&value, std::data(data) + offset, sizeof(value));
+
+	return value;
+}
+
+[[nodiscard]]
+static bool IsBinaryGLTF(GLTFBufferData fileData) noexcept
+{
+	return std::size(fileData) >= s_glbHeaderSize && ReadUInt32(fileData, 0u) == s_glbMagic;
+}
+
+// Empty if the file doesn't have a binary chunk.
+[[nodiscard]]
+static GLTFBufferData GetBinaryChunk(GLTFBufferData fileData) noexcept
+{
+	if (!IsBinaryGLTF(fileData) || std::size(fileData) < s_glbHeaderSize + s_glbChunkHeaderSize)
+		return {};
+
+	const size_t binaryChunkOffset
+		= s_glbHeaderSize + s_glbChunkHeaderSize + ReadUInt32(fileData, s_glbHeaderSize);
+
+	if (binaryChunkOffset + s_glbChunkHeaderSize > std::size(fileData)
+		|| ReadUInt32(fileData, binaryChunkOffset + 4u) != s_glbBinaryChunkType)
+		return {};
+
+	const size_t binaryChunkSize = ReadUInt32(fileData, binaryChunkOffset);
+	const size_t binaryDataStart = binaryChunkOffset + s_glbChunkHeaderSize;
+
+	if (binaryDataStart + binaryChunkSize > std::size(fileData))
+		return {};
+
+	return fileData.subspan(binaryDataStart, binaryChunkSize);
+}
+
+void GLTFObject::Set(tinygltf::Model&& model) noexcept
+{
+	m_gltf = std::move(model);
+
+	m_mappedFiles.clear();
+	m_warning.clear();
+
+	SetBufferDataFromModel();
+}
+
+void GLTFObject::SetBufferDataFromModel()
 {
-	LoadFromFile(m_gltf, fileName);
+	m_bufferData.clear();
+	m_bufferData.reserve(std::size(m_gltf.buffers));
+
+	for (const tinygltf::Buffer& buffer : m_gltf.buffers)
+		m_bufferData.emplace_back(std::data(buffer.data), std::size(buffer.data));
 }
 
-void GLTFObject::LoadFromFile(tinygltf::Model& model, const char* fileName)
+void GLTFObject::LoadFromFile(const char* fileName, GLTFBufferMode bufferMode)
 {
-    tinygltf::TinyGLTF loader{};
-    std::string        error{};
-    std::string        warning{};
+	m_gltf = tinygltf::Model{};
+
+	m_bufferData.clear();
+	m_mappedFiles.clear();
+	m_warning.clear();
+
+	// tinygltf would read the whole file into a string or a vector first.
+	MappedFile sourceFile{};
+
+	if (!sourceFile.Open(fileName))
+		throw Exception{ "GLTFFileMissing", "The glTF file couldn't be opened." };
+
+	const GLTFBufferData fileData = sourceFile.GetData();
+
+	// The sizes tinygltf takes are 32 bits. A .glb can't be larger anyway.
+	if (std::size(fileData) > std::numeric_limits<std::uint32_t>::max())
+		throw Exception{ "GLTFFileTooLarge", "The glTF file is larger than 4GB." };
+
+	const auto fileSize             = static_cast<std::uint32_t>(std::size(fileData));
+	const std::string baseDirectory = std::filesystem::path{ fileName }.parent_path().string();
+
+	tinygltf::TinyGLTF loader{};
+	std::string        error{};
+
+	const bool isBinary = IsBinaryGLTF(fileData);
+	bool isLoaded       = false;
+
+	if (isBinary)
+		isLoaded = loader.LoadBinaryFromMemory(
+			&m_gltf, &error, &m_warning, std::data(fileData), fileSize, baseDirectory
+		);
+	else
+		isLoaded = loader.LoadASCIIFromString(
+			&m_gltf, &error, &m_warning, reinterpret_cast<char const*>(std::data(fileData)),
+			fileSize, baseDirectory
+		);
+
+	if (!isLoaded)
+		throw Exception{ "GLTFLoadError", error };
+
+	if (bufferMode == GLTFBufferMode::Copied)
+	{
+		SetBufferDataFromModel();
+
+		return;
+	}
+
+	const GLTFBufferData binaryChunk = isBinary ? GetBinaryChunk(fileData) : GLTFBufferData{};
+
+	bool isBinaryChunkMapped = false;
+
+	m_bufferData.reserve(std::size(m_gltf.buffers));
+
+	for (tinygltf::Buffer& buffer : m_gltf.buffers)
+	{
+		const GLTFBufferData mappedData = MapBuffer(buffer, binaryChunk, baseDirectory);
+
+		if (std::empty(mappedData))
+		{
+			m_bufferData.emplace_back(std::data(buffer.data), std::size(buffer.data));
+
+			continue;
+		}
+
+		if (std::data(mappedData) == std::data(binaryChunk))
+			isBinaryChunkMapped = true;
+
+		// Free the copy.
+		buffer.data = std::vector<unsigned char>{};
+
+		m_bufferData.emplace_back(mappedData);
+	}
+
+	if (isBinaryChunkMapped)
+		m_mappedFiles.emplace_back(std::move(sourceFile));
+}
+
+GLTFBufferData GLTFObject::MapBuffer(
+	const tinygltf::Buffer& buffer, GLTFBufferData binaryChunk, const std::string& baseDirectory
+) {
+	// tinygltf has already checked the sizes, and resized the data to the byteLength.
+	const size_t bufferSize = std::size(buffer.data);
+
+	if (bufferSize == 0u)
+		return {};
+
+	// The buffer without an uri is the binary chunk of a .glb.
+	if (std::empty(buffer.uri))
+	{
+		if (std::size(binaryChunk) < bufferSize)
+			return {};
+
+		return binaryChunk.first(bufferSize);
+	}
+
+	// The data uris are decoded into the copy, so there is nothing to map. And the escaped
+	// uris are left to tinygltf, as they would need to be decoded.
+	if (buffer.uri.starts_with("data:") || buffer.uri.find('%') != std::string::npos)
+		return {};
+
+	MappedFile bufferFile{};
+
+	const std::filesystem::path bufferPath = std::filesystem::path{ baseDirectory } / buffer.uri;
+
+	if (!bufferFile.Open(bufferPath.string()) || bufferFile.GetSize() < bufferSize)
+		return {};
+
+	const GLTFBufferData mappedData = bufferFile.GetData().first(bufferSize);
 
-    loader.LoadASCIIFromFile(&model, &error, &warning, fileName);
+	// The mapping doesn't move with the MappedFile.
+	m_mappedFiles.emplace_back(std::move(bufferFile));
 
-    // Should add logging here.
+	return mappedData;
 }
 }
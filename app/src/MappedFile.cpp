@@ -0,0 +1,124 @@
+#include <MappedFile.hpp>
+
+#ifdef SOL_WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Sol
+{
+MappedFile::~MappedFile() noexcept
+{
+	Close();
+}
+
+#ifdef SOL_WIN32
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	HANDLE fileHandle = CreateFileA(
+		filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+	);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize{};
+
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		CloseHandle(fileHandle);
+
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(
+		fileHandle, nullptr, PAGE_READONLY, 0u, 0u, nullptr
+	);
+
+	// The view keeps the file mapped, so the handles aren't needed after it has been made.
+	CloseHandle(fileHandle);
+
+	if (!mappingHandle)
+		return false;
+
+	void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0u, 0u, 0u);
+
+	CloseHandle(mappingHandle);
+
+	if (!view)
+		return false;
+
+	m_data = static_cast<std::uint8_t const*>(view);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+	if (m_data)
+		UnmapViewOfFile(m_data);
+
+	m_data = nullptr;
+	m_size = 0u;
+}
+#else
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	const int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+
+	if (fileDescriptor == -1)
+		return false;
+
+	struct stat fileStatus{};
+
+	if (fstat(fileDescriptor, &fileStatus) == -1 || fileStatus.st_size <= 0)
+	{
+		close(fileDescriptor);
+
+		return false;
+	}
+
+	const auto fileSize = static_cast<size_t>(fileStatus.st_size);
+
+	void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	// The mapping keeps the file open.
+	close(fileDescriptor);
+
+	if (view == MAP_FAILED)
+		return false;
+
+	madvise(view, fileSize, MADV_SEQUENTIAL);
+
+	m_data = static_cast<std::uint8_t const*>(view);
+	m_size = fileSize;
+
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+	if (m_data)
+		munmap(const_cast<std::uint8_t*>(m_data), m_size);
+
+	m_data = nullptr;
+	m_size = 0u;
+}
+#endif
+}
@@ -1,6 +1,9 @@
 #include <ranges>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <random>
 #include <MeshBoundImpl.hpp>
 #include <MeshletMaker.hpp>
 #include <DirectXPackedVector.h>
@@ -27,6 +30,14 @@ AxisAlignedBoundingBox AABBGenerator::GenerateAABB() const noexcept
 	XMFLOAT4& pAxes = aabb.maxAxes;
 	XMFLOAT4& nAxes = aabb.minAxes;
 
+	// If no position was processed, the AABB is empty at the origin.
+	if (XMVectorGetX(m_positiveAxes) < XMVectorGetX(m_negativeAxes))
+		return AxisAlignedBoundingBox
+		{
+			.maxAxes = XMFLOAT4{ 0.f, 0.f, 0.f, 1.f },
+			.minAxes = XMFLOAT4{ 0.f, 0.f, 0.f, 1.f }
+		};
+
 	XMStoreFloat4(&pAxes, m_positiveAxes);
 	XMStoreFloat4(&nAxes, m_negativeAxes);
 
@@ -44,6 +55,13 @@ void SphereBVGenerator::SetCentre(const AxisAlignedBoundingBox& aabb) noexcept
 	m_centre = (XMLoadFloat4(&aabb.maxAxes) + XMLoadFloat4(&aabb.minAxes)) * 0.5;
 }
 
+void SphereBVGenerator::SetCentre(const DirectX::XMFLOAT3& centre) noexcept
+{
+	using namespace DirectX;
+
+	m_centre = XMVectorSetW(XMLoadFloat3(&centre), 0.f);
+}
+
 void SphereBVGenerator::ProcessRadius(const DirectX::XMFLOAT3& position) noexcept
 {
 	using namespace DirectX;
@@ -54,6 +72,16 @@ void SphereBVGenerator::ProcessRadius(const DirectX::XMFLOAT3& position) noexcep
 	m_radius = std::max(m_radius, XMVectorGetX(distance));
 }
 
+void SphereBVGenerator::ProcessSphere(const SphereBoundingVolume& sphere) noexcept
+{
+	using namespace DirectX;
+
+	XMVECTOR sphereCentre = XMVectorSetW(XMLoadFloat4(&sphere.sphere), 0.f);
+	XMVECTOR distance     = XMVector3Length(m_centre - sphereCentre);
+
+	m_radius = std::max(m_radius, XMVectorGetX(distance) + sphere.sphere.w);
+}
+
 SphereBoundingVolume SphereBVGenerator::GenerateBV() const noexcept
 {
 	using namespace DirectX;
@@ -72,11 +100,20 @@ SphereBoundingVolume SphereBVGenerator::GenerateBV() const noexcept
 void NormalConeGenerator::SetNormalCentre(const SphereBoundingVolume& normalSphere) noexcept
 {
 	using namespace DirectX;
+	using namespace DirectX::PackedVector;
 
 	// The centre of the normals should be the cone normal.
-	m_normalCentre = XMVector3Normalize(XMLoadFloat4(&normalSphere.sphere));
+	const XMVECTOR normalCentre = XMVector3Normalize(XMLoadFloat4(&normalSphere.sphere));
+
+	// The culling normalises the unpacked axis, which can be a few degrees away from the
+	// centre. The apex offset is multiplied by that difference, so the long cones of the
+	// steep meshlets would end up in front of some triangles.
+	XMBYTEN4 snQuant{};
+	XMStoreByteN4(&snQuant, normalCentre);
+
 	// We don't need the W component as it is a normal vector.
-	m_normalCentre = XMVectorSetW(m_normalCentre, 0.f);
+	m_quantisedCentre = XMVectorSetW(XMLoadByteN4(&snQuant), 0.f);
+	m_normalCentre    = XMVector3Normalize(m_quantisedCentre);
 }
 
 void NormalConeGenerator::SetSpatialCentre(const SphereBoundingVolume& spatialSphere) noexcept
@@ -122,6 +159,58 @@ void NormalConeGenerator::ProcessApexOffset(
 	m_apexOffset = std::max(distance, m_apexOffset);
 }
 
+void NormalConeGenerator::ProcessTriangleBatch(const NormalConeTriangleBatch& batch) noexcept
+{
+	using namespace DirectX;
+
+	const XMVECTOR& normalX = batch.normal[0];
+	const XMVECTOR& normalY = batch.normal[1];
+	const XMVECTOR& normalZ = batch.normal[2];
+
+	XMVECTOR dotNormal = XMVectorMultiply(normalX, XMVectorSplatX(m_normalCentre));
+	dotNormal          = XMVectorMultiplyAdd(normalY, XMVectorSplatY(m_normalCentre), dotNormal);
+	dotNormal          = XMVectorMultiplyAdd(normalZ, XMVectorSplatZ(m_normalCentre), dotNormal);
+
+	{
+		// The minimum of the lanes, in every lane.
+		XMVECTOR minimumDot = XMVectorMin(dotNormal, XMVectorSwizzle<1, 0, 3, 2>(dotNormal));
+		minimumDot          = XMVectorMin(minimumDot, XMVectorSwizzle<2, 3, 0, 1>(minimumDot));
+
+		m_minimumDot = XMVectorMin(m_minimumDot, minimumDot);
+	}
+
+	// Same as the ProcessApexOffset. The triangles which face away from the axis only matter
+	// for the degenerate cones, where the apex offset is ignored.
+	const XMVECTOR facesAxis = XMVectorGreater(dotNormal, XMVectorZero());
+	const XMVECTOR safeDot   = XMVectorSelect(g_XMOne, dotNormal, facesAxis);
+
+	XMVECTOR apexOffset = XMVectorZero();
+
+	for (const std::array<XMVECTOR, 3u>& position : batch.positions)
+	{
+		XMVECTOR dotCentre = XMVectorMultiply(
+			XMVectorSubtract(XMVectorSplatX(m_spatialCentre), position[0]), normalX
+		);
+		dotCentre = XMVectorMultiplyAdd(
+			XMVectorSubtract(XMVectorSplatY(m_spatialCentre), position[1]), normalY, dotCentre
+		);
+		dotCentre = XMVectorMultiplyAdd(
+			XMVectorSubtract(XMVectorSplatZ(m_spatialCentre), position[2]), normalZ, dotCentre
+		);
+
+		const XMVECTOR distance = XMVectorSelect(
+			XMVectorZero(), XMVectorDivide(dotCentre, safeDot), facesAxis
+		);
+
+		apexOffset = XMVectorMax(apexOffset, distance);
+	}
+
+	apexOffset = XMVectorMax(apexOffset, XMVectorSwizzle<1, 0, 3, 2>(apexOffset));
+	apexOffset = XMVectorMax(apexOffset, XMVectorSwizzle<2, 3, 0, 1>(apexOffset));
+
+	m_apexOffset = std::max(m_apexOffset, XMVectorGetX(apexOffset));
+}
+
 bool NormalConeGenerator::IsConeDegenerate() const noexcept
 {
 	using namespace DirectX;
@@ -153,11 +242,10 @@ ClusterNormalCone NormalConeGenerator::GenerateNormalCone() const noexcept
 		XMVECTOR minimumDotSqr = XMVectorMultiply(m_minimumDot, m_minimumDot);
 		XMVECTOR coneCutoff    = XMVectorSqrt(XMVectorSubtract(g_XMOne, minimumDotSqr));
 
-		// Quantize the normal vector
-		// I think this needs to be done with signed int8 because the float value can be
-		// negative.
+		// The normal vector was already quantised, so storing it again is exact. It needs
+		// to be signed int8 because the float value can be negative.
 		XMBYTEN4 snQuant{};
-		XMStoreByteN4(&snQuant, m_normalCentre);
+		XMStoreByteN4(&snQuant, m_quantisedCentre);
 
 		std::uint8_t values[4]
 		{
@@ -167,17 +255,11 @@ ClusterNormalCone NormalConeGenerator::GenerateNormalCone() const noexcept
 			0u
 		};
 
-		// Bias
-		XMVECTOR deQuant = XMLoadByteN4(&snQuant);
-		XMVECTOR error   = XMVectorSum(XMVectorAbs(XMVectorSubtract(deQuant, m_normalCentre)));
-
-		coneCutoff = XMVectorAdd(coneCutoff, error);
-
-		// Quantize the normal cone spread to uint8 and bias upward.
-		XMUBYTEN4 nQuant{};
-		XMStoreUByteN4(&nQuant, coneCutoff);
+		// The minimum dot is already for the quantised axis, so only the spread needs a
+		// bias. Quantize it to uint8, rounding upward, as a smaller cutoff culls more.
+		const float cutoff = std::ceil(XMVectorGetX(coneCutoff) * 255.f);
 
-		values[3] = nQuant.x;
+		values[3] = static_cast<std::uint8_t>(std::clamp(cutoff, 0.f, 255.f));
 
 		memcpy(&normalCone.packedCone, values, sizeof(std::uint32_t));
 	}
@@ -248,6 +330,331 @@ SphereBoundingVolume GenerateSphereBV(const std::vector<DirectX::XMFLOAT3>& posi
 	return sphereBVGen.GenerateBV();
 }
 
+// The minimum sphere helpers use doubles, as the circumspheres of the nearly degenerate
+// point sets lose a lot of precision with floats.
+struct Double3
+{
+	double x;
+	double y;
+	double z;
+};
+
+[[nodiscard]]
+static Double3 operator+(const Double3& lhs, const Double3& rhs) noexcept
+{
+	return Double3{ .x = lhs.x + rhs.x, .y = lhs.y + rhs.y, .z = lhs.z + rhs.z };
+}
+
+[[nodiscard]]
+static Double3 operator-(const Double3& lhs, const Double3& rhs) noexcept
+{
+	return Double3{ .x = lhs.x - rhs.x, .y = lhs.y - rhs.y, .z = lhs.z - rhs.z };
+}
+
+[[nodiscard]]
+static Double3 operator*(const Double3& lhs, double rhs) noexcept
+{
+	return Double3{ .x = lhs.x * rhs, .y = lhs.y * rhs, .z = lhs.z * rhs };
+}
+
+[[nodiscard]]
+static double Dot(const Double3& lhs, const Double3& rhs) noexcept
+{
+	return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+[[nodiscard]]
+static Double3 Cross(const Double3& lhs, const Double3& rhs) noexcept
+{
+	return Double3
+	{
+		.x = lhs.y * rhs.z - lhs.z * rhs.y,
+		.y = lhs.z * rhs.x - lhs.x * rhs.z,
+		.z = lhs.x * rhs.y - lhs.y * rhs.x
+	};
+}
+
+[[nodiscard]]
+static Double3 GetDouble3(const DirectX::XMFLOAT3& position) noexcept
+{
+	return Double3{ .x = position.x, .y = position.y, .z = position.z };
+}
+
+struct DoubleSphere
+{
+	Double3 centre;
+	double  radius;
+};
+
+[[nodiscard]]
+static bool IsInSphere(const DoubleSphere& sphere, const Double3& point) noexcept
+{
+	// A bit of slack, so the points on the boundary don't restart the search because of the
+	// rounding. The final radius is taken from the actual distances anyway.
+	const double radius = sphere.radius * (1.0 + 1e-7) + 1e-12;
+
+	const Double3 offset = point - sphere.centre;
+
+	return Dot(offset, offset) <= radius * radius;
+}
+
+[[nodiscard]]
+static DoubleSphere GetSphere(const Double3& point0, const Double3& point1) noexcept
+{
+	const Double3 offset = point1 - point0;
+
+	return DoubleSphere
+	{
+		.centre = (point0 + point1) * 0.5,
+		.radius = std::sqrt(Dot(offset, offset)) * 0.5
+	};
+}
+
+// The smallest sphere with all the points on its boundary.
+[[nodiscard]]
+static DoubleSphere GetSphere(
+	const Double3& point0, const Double3& point1, const Double3& point2
+) noexcept {
+	const Double3 edge0  = point1 - point0;
+	const Double3 edge1  = point2 - point0;
+	const Double3 normal = Cross(edge0, edge1);
+
+	const double normalLengthSq = Dot(normal, normal);
+
+	// If the points are on a line, the sphere of the two farthest ones contains the third.
+	if (normalLengthSq <= 1e-18 * Dot(edge0, edge0) * Dot(edge1, edge1))
+	{
+		const DoubleSphere spheres[]
+		{
+			GetSphere(point0, point1), GetSphere(point0, point2), GetSphere(point1, point2)
+		};
+
+		return *std::ranges::max_element(spheres, {}, &DoubleSphere::radius);
+	}
+
+	const Double3 centreOffset = (
+		Cross(normal, edge0) * Dot(edge1, edge1) + Cross(edge1, normal) * Dot(edge0, edge0)
+	) * (0.5 / normalLengthSq);
+
+	return DoubleSphere
+	{
+		.centre = point0 + centreOffset,
+		.radius = std::sqrt(Dot(centreOffset, centreOffset))
+	};
+}
+
+[[nodiscard]]
+static DoubleSphere GetSphere(
+	const Double3& point0, const Double3& point1, const Double3& point2, const Double3& point3
+) noexcept {
+	const Double3 edge0 = point1 - point0;
+	const Double3 edge1 = point2 - point0;
+	const Double3 edge2 = point3 - point0;
+
+	const double determinant = Dot(edge0, Cross(edge1, edge2));
+
+	const double edgeLength = std::sqrt(
+		std::max({ Dot(edge0, edge0), Dot(edge1, edge1), Dot(edge2, edge2) })
+	);
+
+	// If the points are on a plane, there might not be a sphere with all of them on its
+	// boundary. So, use the smallest sphere of any two or three of them, which contains
+	// all of them.
+	if (std::abs(determinant) <= 1e-9 * edgeLength * edgeLength * edgeLength)
+	{
+		const Double3 points[]{ point0, point1, point2, point3 };
+
+		const DoubleSphere candidates[]
+		{
+			GetSphere(point0, point1), GetSphere(point0, point2), GetSphere(point0, point3),
+			GetSphere(point1, point2), GetSphere(point1, point3), GetSphere(point2, point3),
+			GetSphere(point0, point1, point2), GetSphere(point0, point1, point3),
+			GetSphere(point0, point2, point3), GetSphere(point1, point2, point3)
+		};
+
+		DoubleSphere bestSphere{ .centre = point0, .radius = std::numeric_limits<double>::max() };
+
+		for (const DoubleSphere& candidate : candidates)
+			if (candidate.radius < bestSphere.radius
+				&& std::ranges::all_of(
+					points, [&candidate](const Double3& point)
+					{
+						return IsInSphere(candidate, point);
+					}
+				))
+				bestSphere = candidate;
+
+		return bestSphere;
+	}
+
+	const Double3 centreOffset = (
+		Cross(edge1, edge2) * Dot(edge0, edge0) + Cross(edge2, edge0) * Dot(edge1, edge1)
+		+ Cross(edge0, edge1) * Dot(edge2, edge2)
+	) * (0.5 / determinant);
+
+	return DoubleSphere
+	{
+		.centre = point0 + centreOffset,
+		.radius = std::sqrt(Dot(centreOffset, centreOffset))
+	};
+}
+
+// Starts with the sphere of the farthest pair of the extreme points on the axes, and grows it
+// towards every point which is outside.
+[[nodiscard]]
+static DoubleSphere GenerateRitterSphere(std::span<const DirectX::XMFLOAT3> positions) noexcept
+{
+	std::array<size_t, 3u> minimumIndices{};
+	std::array<size_t, 3u> maximumIndices{};
+
+	const size_t positionCount = std::size(positions);
+
+	for (size_t index = 1u; index < positionCount; ++index)
+	{
+		const DirectX::XMFLOAT3& position = positions[index];
+
+		const std::array<float, 3u> components{ position.x, position.y, position.z };
+
+		for (size_t axis = 0u; axis < 3u; ++axis)
+		{
+			auto GetComponent = [positions, axis](size_t positionIndex)
+			{
+				const DirectX::XMFLOAT3& otherPosition = positions[positionIndex];
+
+				return axis == 0u ? otherPosition.x
+					: axis == 1u ? otherPosition.y : otherPosition.z;
+			};
+
+			if (components[axis] < GetComponent(minimumIndices[axis]))
+				minimumIndices[axis] = index;
+
+			if (components[axis] > GetComponent(maximumIndices[axis]))
+				maximumIndices[axis] = index;
+		}
+	}
+
+	DoubleSphere sphere{ .centre = GetDouble3(positions[0]), .radius = 0.0 };
+
+	for (size_t axis = 0u; axis < 3u; ++axis)
+	{
+		const DoubleSphere axisSphere = GetSphere(
+			GetDouble3(positions[minimumIndices[axis]]),
+			GetDouble3(positions[maximumIndices[axis]])
+		);
+
+		if (axisSphere.radius > sphere.radius)
+			sphere = axisSphere;
+	}
+
+	for (const DirectX::XMFLOAT3& position : positions)
+	{
+		const Double3 point  = GetDouble3(position);
+		const Double3 offset = point - sphere.centre;
+
+		const double distance = std::sqrt(Dot(offset, offset));
+
+		if (distance > sphere.radius)
+		{
+			const double newRadius = (sphere.radius + distance) * 0.5;
+
+			sphere.centre = sphere.centre + offset * ((newRadius - sphere.radius) / distance);
+			sphere.radius = newRadius;
+		}
+	}
+
+	return sphere;
+}
+
+// The incremental form of Welzl's algorithm. Whenever a point is outside, the sphere is
+// rebuilt from the points before it, with that point on the boundary. With the points in a
+// random order, the expected cost is linear.
+[[nodiscard]]
+static DoubleSphere GenerateWelzlSphere(std::span<const DirectX::XMFLOAT3> positions)
+{
+	std::vector<Double3> points{};
+	points.reserve(std::size(positions));
+
+	for (const DirectX::XMFLOAT3& position : positions)
+		points.emplace_back(GetDouble3(position));
+
+	// A fixed seed, so the same meshlet always gets the same sphere.
+	std::shuffle(std::begin(points), std::end(points), std::minstd_rand{ 1u });
+
+	const size_t pointCount = std::size(points);
+
+	DoubleSphere sphere{ .centre = points[0], .radius = 0.0 };
+
+	for (size_t index0 = 1u; index0 < pointCount; ++index0)
+	{
+		if (IsInSphere(sphere, points[index0]))
+			continue;
+
+		sphere = DoubleSphere{ .centre = points[index0], .radius = 0.0 };
+
+		for (size_t index1 = 0u; index1 < index0; ++index1)
+		{
+			if (IsInSphere(sphere, points[index1]))
+				continue;
+
+			sphere = GetSphere(points[index0], points[index1]);
+
+			for (size_t index2 = 0u; index2 < index1; ++index2)
+			{
+				if (IsInSphere(sphere, points[index2]))
+					continue;
+
+				sphere = GetSphere(points[index0], points[index1], points[index2]);
+
+				for (size_t index3 = 0u; index3 < index2; ++index3)
+					if (!IsInSphere(sphere, points[index3]))
+						sphere = GetSphere(
+							points[index0], points[index1], points[index2], points[index3]
+						);
+			}
+		}
+	}
+
+	return sphere;
+}
+
+SphereBoundingVolume GenerateSphereBV(
+	std::span<const DirectX::XMFLOAT3> positions, SphereBVAlgorithm algorithm
+) noexcept {
+	SphereBVGenerator sphereBVGen{};
+
+	if (std::empty(positions))
+		return sphereBVGen.GenerateBV();
+
+	if (algorithm == SphereBVAlgorithm::AABBCentre)
+	{
+		AABBGenerator aabbGen{};
+
+		for (const DirectX::XMFLOAT3& position : positions)
+			aabbGen.ProcessAxes(position);
+
+		sphereBVGen.SetCentre(aabbGen.GenerateAABB());
+	}
+	else
+	{
+		const DoubleSphere sphere = algorithm == SphereBVAlgorithm::Welzl
+			? GenerateWelzlSphere(positions) : GenerateRitterSphere(positions);
+
+		sphereBVGen.SetCentre(
+			DirectX::XMFLOAT3{
+				static_cast<float>(sphere.centre.x), static_cast<float>(sphere.centre.y),
+				static_cast<float>(sphere.centre.z)
+			}
+		);
+	}
+
+	// The radius is always taken from the float distances, so every position is inside, even
+	// after the centre has been rounded.
+	for (const DirectX::XMFLOAT3& position : positions)
+		sphereBVGen.ProcessRadius(position);
+
+	return sphereBVGen.GenerateBV();
+}
+
 // Vertex component getters.
 static DirectX::XMFLOAT3 GetPosition(const Vertex& vertex) noexcept
 {
@@ -263,7 +670,7 @@ static DirectX::XMFLOAT3 GetPosition(const aiVector3D& aiVertex) noexcept
 template<typename Vertex_t>
 [[nodiscard]]
 static AxisAlignedBoundingBox _generateAABB(
-	Vertex_t* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	Vertex_t* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet
 ) noexcept {
 	using namespace DirectX;
 
@@ -278,14 +685,14 @@ static AxisAlignedBoundingBox _generateAABB(
 }
 
 AxisAlignedBoundingBox GenerateAABB(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
 	const Meshlet& meshlet
 ) noexcept {
 	return _generateAABB(std::data(vertices), vertexIndices, meshlet);
 }
 
 AxisAlignedBoundingBox GenerateAABB(
-	aiVector3D* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	aiVector3D* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet
 ) noexcept {
 	return _generateAABB(vertices, vertexIndices, meshlet);
 }
@@ -294,16 +701,28 @@ AxisAlignedBoundingBox GenerateAABB(
 template<typename Vertex_t>
 [[nodiscard]]
 static SphereBoundingVolume _generateSphereBV(
-	Vertex_t* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	Vertex_t* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet,
+	SphereBVAlgorithm algorithm
 ) noexcept {
 	using namespace DirectX;
 
+	const auto vertexEnd = static_cast<size_t>(meshlet.indexOffset + meshlet.indexCount);
+
+	if (algorithm != SphereBVAlgorithm::AABBCentre)
+	{
+		std::vector<XMFLOAT3> positions{};
+		positions.reserve(meshlet.indexCount);
+
+		for (size_t index = meshlet.indexOffset; index < vertexEnd; ++index)
+			positions.emplace_back(GetPosition(vertices[vertexIndices[index]]));
+
+		return GenerateSphereBV(positions, algorithm);
+	}
+
 	SphereBVGenerator sphereBVGen{};
 
 	sphereBVGen.SetCentre(_generateAABB(vertices, vertexIndices, meshlet));
 
-	const auto vertexEnd = static_cast<size_t>(meshlet.indexOffset + meshlet.indexCount);
-
 	for (size_t index = meshlet.indexOffset; index < vertexEnd; ++index)
 		sphereBVGen.ProcessRadius(GetPosition(vertices[vertexIndices[index]]));
 
@@ -311,26 +730,249 @@ static SphereBoundingVolume _generateSphereBV(
 }
 
 SphereBoundingVolume GenerateSphereBV(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
-	const Meshlet& meshlet
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
+	const Meshlet& meshlet, SphereBVAlgorithm algorithm
 ) noexcept {
-	return _generateSphereBV(std::data(vertices), vertexIndices, meshlet);
+	return _generateSphereBV(std::data(vertices), vertexIndices, meshlet, algorithm);
 }
 
 SphereBoundingVolume GenerateSphereBV(
-	aiVector3D* vertices, const std::vector<std::uint32_t>& vertexIndices, const Meshlet& meshlet
+	aiVector3D* vertices, std::span<const std::uint32_t> vertexIndices, const Meshlet& meshlet,
+	SphereBVAlgorithm algorithm
 ) noexcept {
-	return _generateSphereBV(vertices, vertexIndices, meshlet);
+	return _generateSphereBV(vertices, vertexIndices, meshlet, algorithm);
+}
+
+// Face normal cones
+static constexpr size_t s_triangleBatchSize = 4u;
+
+// The unused lanes get the last triangle again, which doesn't change the minimum or the
+// maximum values.
+static void LoadTriangleBatchPositions(
+	std::span<const DirectX::XMFLOAT3> trianglePositions,
+	std::span<const std::uint32_t> batchTriangles, NormalConeTriangleBatch& batch
+) noexcept {
+	using namespace DirectX;
+
+	std::array<std::uint32_t, s_triangleBatchSize> laneTriangles{};
+
+	for (size_t lane = 0u; lane < s_triangleBatchSize; ++lane)
+		laneTriangles[lane] = batchTriangles[std::min(lane, std::size(batchTriangles) - 1u)];
+
+	for (size_t vertex = 0u; vertex < 3u; ++vertex)
+	{
+		auto GetPosition = [&](size_t lane) -> const XMFLOAT3&
+		{
+			return trianglePositions[laneTriangles[lane] * 3u + vertex];
+		};
+
+		const XMFLOAT3& position0 = GetPosition(0u);
+		const XMFLOAT3& position1 = GetPosition(1u);
+		const XMFLOAT3& position2 = GetPosition(2u);
+		const XMFLOAT3& position3 = GetPosition(3u);
+
+		batch.positions[vertex] =
+		{
+			XMVectorSet(position0.x, position1.x, position2.x, position3.x),
+			XMVectorSet(position0.y, position1.y, position2.y, position3.y),
+			XMVectorSet(position0.z, position1.z, position2.z, position3.z)
+		};
+	}
+}
+
+ClusterNormalCone GenerateFaceNormalCone(
+	std::span<const DirectX::XMFLOAT3> trianglePositions,
+	const SphereBoundingVolume& spatialSphere
+) noexcept {
+	using namespace DirectX;
+
+	const auto triangleCount = static_cast<std::uint32_t>(std::size(trianglePositions) / 3u);
+
+	std::vector<std::uint32_t> triangles(triangleCount);
+
+	for (std::uint32_t index = 0u; index < triangleCount; ++index)
+		triangles[index] = index;
+
+	// The degenerate triangles don't have a face normal and can't be culled anyway, so only
+	// the other triangles are kept.
+	std::vector<XMFLOAT3> faceNormals{};
+	std::vector<std::uint32_t> validTriangles{};
+
+	faceNormals.reserve(triangleCount);
+	validTriangles.reserve(triangleCount);
+
+	NormalConeTriangleBatch batch{};
+
+	for (std::uint32_t batchStart = 0u; batchStart < triangleCount;
+		batchStart += s_triangleBatchSize)
+	{
+		const size_t batchCount = std::min<size_t>(
+			s_triangleBatchSize, triangleCount - batchStart
+		);
+
+		LoadTriangleBatchPositions(
+			trianglePositions, std::span{ triangles }.subspan(batchStart, batchCount), batch
+		);
+
+		const std::array<XMVECTOR, 3u>& position0 = batch.positions[0];
+		const std::array<XMVECTOR, 3u>& position1 = batch.positions[1];
+		const std::array<XMVECTOR, 3u>& position2 = batch.positions[2];
+
+		const XMVECTOR edge0X = XMVectorSubtract(position1[0], position0[0]);
+		const XMVECTOR edge0Y = XMVectorSubtract(position1[1], position0[1]);
+		const XMVECTOR edge0Z = XMVectorSubtract(position1[2], position0[2]);
+
+		const XMVECTOR edge1X = XMVectorSubtract(position2[0], position0[0]);
+		const XMVECTOR edge1Y = XMVectorSubtract(position2[1], position0[1]);
+		const XMVECTOR edge1Z = XMVectorSubtract(position2[2], position0[2]);
+
+		const XMVECTOR crossX = XMVectorSubtract(
+			XMVectorMultiply(edge0Y, edge1Z), XMVectorMultiply(edge0Z, edge1Y)
+		);
+		const XMVECTOR crossY = XMVectorSubtract(
+			XMVectorMultiply(edge0Z, edge1X), XMVectorMultiply(edge0X, edge1Z)
+		);
+		const XMVECTOR crossZ = XMVectorSubtract(
+			XMVectorMultiply(edge0X, edge1Y), XMVectorMultiply(edge0Y, edge1X)
+		);
+
+		XMVECTOR lengthSq = XMVectorMultiply(crossX, crossX);
+		lengthSq          = XMVectorMultiplyAdd(crossY, crossY, lengthSq);
+		lengthSq          = XMVectorMultiplyAdd(crossZ, crossZ, lengthSq);
+
+		const XMVECTOR isValid       = XMVectorGreater(
+			lengthSq, XMVectorReplicate(std::numeric_limits<float>::min())
+		);
+		const XMVECTOR inverseLength = XMVectorSelect(
+			XMVectorZero(), XMVectorReciprocalSqrt(lengthSq), isValid
+		);
+
+		XMFLOAT4 normalX{};
+		XMFLOAT4 normalY{};
+		XMFLOAT4 normalZ{};
+		XMFLOAT4 inverseLengths{};
+
+		XMStoreFloat4(&normalX, XMVectorMultiply(crossX, inverseLength));
+		XMStoreFloat4(&normalY, XMVectorMultiply(crossY, inverseLength));
+		XMStoreFloat4(&normalZ, XMVectorMultiply(crossZ, inverseLength));
+		XMStoreFloat4(&inverseLengths, inverseLength);
+
+		const std::array<float, 4u> laneNormalX{ normalX.x, normalX.y, normalX.z, normalX.w };
+		const std::array<float, 4u> laneNormalY{ normalY.x, normalY.y, normalY.z, normalY.w };
+		const std::array<float, 4u> laneNormalZ{ normalZ.x, normalZ.y, normalZ.z, normalZ.w };
+		const std::array<float, 4u> laneInverseLengths
+		{
+			inverseLengths.x, inverseLengths.y, inverseLengths.z, inverseLengths.w
+		};
+
+		for (size_t lane = 0u; lane < batchCount; ++lane)
+			if (laneInverseLengths[lane] > 0.f)
+			{
+				faceNormals.emplace_back(laneNormalX[lane], laneNormalY[lane], laneNormalZ[lane]);
+				validTriangles.emplace_back(static_cast<std::uint32_t>(batchStart + lane));
+			}
+	}
+
+	NormalConeGenerator normalConeGen{};
+
+	if (std::empty(faceNormals))
+	{
+		// A zero normal makes the minimum dot zero, so the cone will be degenerate.
+		normalConeGen.ProcessNormalMinimumDot(XMFLOAT3{ 0.f, 0.f, 0.f });
+
+		return normalConeGen.GenerateNormalCone();
+	}
+
+	// The axis which needs the smallest cone angle is about the direction of the centre of
+	// the minimum sphere around the normals.
+	normalConeGen.SetNormalCentre(GenerateSphereBV(faceNormals, SphereBVAlgorithm::Welzl));
+	normalConeGen.SetSpatialCentre(spatialSphere);
+
+	const auto validTriangleCount = static_cast<std::uint32_t>(std::size(validTriangles));
+
+	for (std::uint32_t batchStart = 0u; batchStart < validTriangleCount;
+		batchStart += s_triangleBatchSize)
+	{
+		const size_t batchCount = std::min<size_t>(
+			s_triangleBatchSize, validTriangleCount - batchStart
+		);
+
+		LoadTriangleBatchPositions(
+			trianglePositions, std::span{ validTriangles }.subspan(batchStart, batchCount), batch
+		);
+
+		auto GetNormal = [&](size_t lane) -> const XMFLOAT3&
+		{
+			return faceNormals[batchStart + std::min(lane, batchCount - 1u)];
+		};
+
+		const XMFLOAT3& normal0 = GetNormal(0u);
+		const XMFLOAT3& normal1 = GetNormal(1u);
+		const XMFLOAT3& normal2 = GetNormal(2u);
+		const XMFLOAT3& normal3 = GetNormal(3u);
+
+		batch.normal =
+		{
+			XMVectorSet(normal0.x, normal1.x, normal2.x, normal3.x),
+			XMVectorSet(normal0.y, normal1.y, normal2.y, normal3.y),
+			XMVectorSet(normal0.z, normal1.z, normal2.z, normal3.z)
+		};
+
+		normalConeGen.ProcessTriangleBatch(batch);
+	}
+
+	return normalConeGen.GenerateNormalCone();
+}
+
+template<typename Vertex_t>
+[[nodiscard]]
+static ClusterNormalCone _generateFaceNormalCone(
+	Vertex_t* vertices, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices, const MeshletDetails& meshletDetails
+) noexcept {
+	const Meshlet& meshlet = meshletDetails.meshlet;
+
+	const auto indexOffset = static_cast<size_t>(meshlet.indexOffset);
+	const auto primOffset  = static_cast<size_t>(meshlet.primitiveOffset);
+	const auto primCount   = static_cast<size_t>(meshlet.primitiveCount);
+
+	std::vector<DirectX::XMFLOAT3> trianglePositions{};
+	trianglePositions.reserve(primCount * 3u);
+
+	for (size_t index = 0u; index < primCount; ++index)
+	{
+		const PrimitiveIndicesUnpacked unpackedIndices = UnpackPrim(
+			primIndices[primOffset + index]
+		);
+
+		const std::array<std::uint32_t, 3u> primVertices
+		{
+			unpackedIndices.firstIndex, unpackedIndices.secondIndex, unpackedIndices.thirdIndex
+		};
+
+		for (const std::uint32_t primVertex : primVertices)
+			trianglePositions.emplace_back(
+				GetPosition(vertices[vertexIndices[indexOffset + primVertex]])
+			);
+	}
+
+	return GenerateFaceNormalCone(trianglePositions, meshletDetails.sphereB);
 }
 
 // Cone normal for meshlets.
 ClusterNormalCone GenerateNormalCone(
-	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& vertexIndices,
-	const std::vector<std::uint32_t>& primIndices, const MeshletDetails& meshletDetails
+	std::span<const Vertex> vertices, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices, const MeshletDetails& meshletDetails,
+	NormalConeAlgorithm algorithm
 ) noexcept {
 	using namespace DirectX;
 	using namespace DirectX::PackedVector;
 
+	if (algorithm == NormalConeAlgorithm::FaceNormals)
+		return _generateFaceNormalCone(
+			std::data(vertices), vertexIndices, primIndices, meshletDetails
+		);
+
 	const Meshlet& meshlet = meshletDetails.meshlet;
 
 	const auto indexOffset = static_cast<size_t>(meshlet.indexOffset);
@@ -343,8 +985,7 @@ ClusterNormalCone GenerateNormalCone(
 	{
 		std::uint32_t packedPrimIndices = primIndices[primOffset + index];
 
-		MeshletMaker::PrimitiveIndicesUnpacked unpackedIndices =
-			MeshletMaker::UnpackPrim(packedPrimIndices);
+		PrimitiveIndicesUnpacked unpackedIndices = UnpackPrim(packedPrimIndices);
 
 		const Vertex& primVertex1
 			= vertices[vertexIndices[indexOffset + unpackedIndices.firstIndex]];
@@ -368,8 +1009,7 @@ ClusterNormalCone GenerateNormalCone(
 	{
 		std::uint32_t packedPrimIndices = primIndices[primOffset + index];
 
-		MeshletMaker::PrimitiveIndicesUnpacked unpackedIndices =
-			MeshletMaker::UnpackPrim(packedPrimIndices);
+		PrimitiveIndicesUnpacked unpackedIndices = UnpackPrim(packedPrimIndices);
 
 		const Vertex& primVertex1
 			= vertices[vertexIndices[indexOffset + unpackedIndices.firstIndex]];
@@ -382,12 +1022,17 @@ ClusterNormalCone GenerateNormalCone(
 }
 
 ClusterNormalCone GenerateNormalCone(
-	aiVector3D* vertices, aiVector3D* normals, const std::vector<std::uint32_t>& vertexIndices,
-	const std::vector<std::uint32_t>& primIndices, const MeshletDetails& meshletDetails
+	aiVector3D* vertices, aiVector3D* normals, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices, const MeshletDetails& meshletDetails,
+	NormalConeAlgorithm algorithm
 ) noexcept {
 	using namespace DirectX;
 	using namespace DirectX::PackedVector;
 
+	// A scene imported without generating the normals might not have any.
+	if (algorithm == NormalConeAlgorithm::FaceNormals || !normals)
+		return _generateFaceNormalCone(vertices, vertexIndices, primIndices, meshletDetails);
+
 	const Meshlet& meshlet = meshletDetails.meshlet;
 
 	const auto indexOffset = static_cast<size_t>(meshlet.indexOffset);
@@ -400,8 +1045,7 @@ ClusterNormalCone GenerateNormalCone(
 	{
 		std::uint32_t packedPrimIndices = primIndices[primOffset + index];
 
-		MeshletMaker::PrimitiveIndicesUnpacked unpackedIndices =
-			MeshletMaker::UnpackPrim(packedPrimIndices);
+		PrimitiveIndicesUnpacked unpackedIndices = UnpackPrim(packedPrimIndices);
 
 		XMFLOAT3 primNormal1 = GetXMFloat3(
 			normals[vertexIndices[indexOffset + unpackedIndices.firstIndex]]
@@ -426,8 +1070,7 @@ ClusterNormalCone GenerateNormalCone(
 	{
 		std::uint32_t packedPrimIndices = primIndices[primOffset + index];
 
-		MeshletMaker::PrimitiveIndicesUnpacked unpackedIndices =
-			MeshletMaker::UnpackPrim(packedPrimIndices);
+		PrimitiveIndicesUnpacked unpackedIndices = UnpackPrim(packedPrimIndices);
 
 		XMFLOAT3 primNormal1 = GetXMFloat3(
 			normals[vertexIndices[indexOffset + unpackedIndices.firstIndex]]
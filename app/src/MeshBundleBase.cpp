@@ -9,106 +9,185 @@
 #include <assimp/postprocess.h>
 #include <ConversionUtilities.hpp>
 #include <MeshletMaker.hpp>
+#include <MeshOptimiser.hpp>
+#include <VertexQuantiser.hpp>
+#include <MeshLod.hpp>
 
 namespace Sol
 {
+[[nodiscard]]
+static MeshBundleElementCounts GetMeshesElementCounts(
+	const std::vector<Mesh>& meshes, bool meshShader, MeshletLimitsType meshletLimits
+) noexcept {
+	MeshBundleElementCounts elementCounts{};
+
+	for (const Mesh& mesh : meshes)
+		elementCounts.AddMesh(
+			std::size(mesh.vertices), std::size(mesh.indices), meshShader, meshletLimits
+		);
+
+	return elementCounts;
+}
+
 // Mesh Bundle Temp Custom
 MeshBundleTemporaryData MeshBundleTempCustom::GenerateTemporaryData(bool meshShader)
 {
 	MeshBundleTemporaryData meshBundleTempData{};
 
 	if (meshShader)
-		GenerateMeshShaderData(m_tempMeshes, meshBundleTempData);
+		GenerateMeshShaderData(m_tempMeshes, m_options, meshBundleTempData);
 	else
-		GenerateVertexShaderData(m_tempMeshes, meshBundleTempData);
+		GenerateVertexShaderData(m_tempMeshes, m_options, meshBundleTempData);
 
 	m_tempMeshes = std::vector<Mesh>{};
 
+	GenerateMeshBundleLods(meshBundleTempData, m_options);
+
+	if (m_options.quantiseVertices)
+		QuantiseMeshBundleVertices(meshBundleTempData);
+
 	return meshBundleTempData;
 }
 
 void MeshBundleTempCustom::GenerateMeshShaderData(
-	std::vector<Mesh>& meshes, MeshBundleTemporaryData& meshBundleTemporaryData
+	std::vector<Mesh>& meshes, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) {
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsMS.reserve(std::size(meshes));
 
+	ReserveMeshBundleData(
+		meshBundleTemporaryData, GetMeshesElementCounts(meshes, true, options.meshletLimits)
+	);
+
 	for (Mesh& mesh : meshes)
-		ProcessMeshMS(mesh, meshBundleTemporaryData);
+		ProcessMeshMS(mesh, options, meshBundleTemporaryData);
+
+	TrimMeshBundleData(meshBundleTemporaryData);
 }
 
 void MeshBundleTempCustom::GenerateVertexShaderData(
-	std::vector<Mesh>& meshes, MeshBundleTemporaryData& meshBundleTemporaryData
+	std::vector<Mesh>& meshes, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) {
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsVS.reserve(std::size(meshes));
 
+	ReserveMeshBundleData(
+		meshBundleTemporaryData, GetMeshesElementCounts(meshes, false, options.meshletLimits)
+	);
+
 	for (Mesh& mesh : meshes)
-		ProcessMeshVS(mesh, meshBundleTemporaryData);
+		ProcessMeshVS(mesh, options, meshBundleTemporaryData);
 }
 
 void MeshBundleTempCustom::ProcessMeshVS(
-	Mesh& mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+	Mesh& mesh, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
+	if (options.optimiseVertexCache)
+		MeshOptimiser::OptimiseVertexCache(mesh.indices);
+
+	if (options.optimiseOverdraw)
+		MeshOptimiser::OptimiseOverdraw(mesh.indices, mesh.vertices);
+
+	if (options.optimiseVertexFetch)
+		MeshOptimiser::OptimiseVertexFetch(mesh.indices, mesh.vertices);
+
+	const auto vertexOffset = static_cast<std::uint32_t>(
+		std::size(meshBundleTemporaryData.vertices)
+	);
+
 	MeshTemporaryDetailsVS meshDetailsVS
 	{
 		.indexCount   = static_cast<std::uint32_t>(std::size(mesh.indices)),
 		.indexOffset  = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.indices)),
+		.vertexOffset = vertexOffset,
 		.aabb         = GenerateAABB(mesh.vertices)
 	};
 
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsVS.emplace_back(meshDetailsVS);
 
-	const auto vertexOffset = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.vertices));
-
 	CopyAndOffsetIndices(meshBundleTemporaryData.indices, mesh.indices, vertexOffset);
 	MemcpyIntoVector(meshBundleTemporaryData.vertices, mesh.vertices);
 }
 
 void MeshBundleTempCustom::ProcessMeshMS(
-	Mesh& mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+	Mesh& mesh, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
-	MeshletMaker meshletMaker{};
-	meshletMaker.GenerateMeshlets(mesh);
-
-	meshletMaker.LoadVertexIndices(mesh.indices);
+	// The meshlets are filled in the index order. So, the reordered indices should make
+	// the vertices in a meshlet more local as well.
+	if (options.optimiseVertexCache)
+		MeshOptimiser::OptimiseVertexCache(mesh.indices);
 
-	MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+	std::vector<MeshletDetails>& bundleMeshletDetails = meshBundleTemporaryData.meshletDetails;
+	std::vector<std::uint32_t>& bundleIndices         = meshBundleTemporaryData.indices;
+	std::vector<std::uint32_t>& bundlePrimIndices     = meshBundleTemporaryData.primIndices;
+	std::vector<Vertex>& bundleVertices               = meshBundleTemporaryData.vertices;
 
 	MeshTemporaryDetailsMS meshDetailsMS
 	{
-		.meshletCount    = static_cast<std::uint32_t>(std::size(extraMeshData.meshletDetails)),
-		.meshletOffset   = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.meshletDetails)),
-		.indexOffset     = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.indices)),
-		.primitiveOffset = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.primIndices)),
-		.vertexOffset    = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.vertices)),
+		.meshletOffset   = static_cast<std::uint32_t>(std::size(bundleMeshletDetails)),
+		.indexOffset     = static_cast<std::uint32_t>(std::size(bundleIndices)),
+		.primitiveOffset = static_cast<std::uint32_t>(std::size(bundlePrimIndices)),
+		.vertexOffset    = static_cast<std::uint32_t>(std::size(bundleVertices)),
 		.aabb            = GenerateAABB(mesh.vertices)
 	};
 
+	// The meshlets are made straight into the bundle containers, with their offsets relative
+	// to the mesh.
+	VisitMeshletLimits(
+		options.meshletLimits,
+		[&mesh, &options, &bundleIndices, &bundlePrimIndices, &bundleMeshletDetails]
+		<size_t vertexLimit_t, size_t primitiveLimit_t>
+		(MeshletLimits<vertexLimit_t, primitiveLimit_t>)
+		{
+			MeshletStreamMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{
+				bundleIndices, bundlePrimIndices, bundleMeshletDetails, options.meshletBuildMode
+			};
+
+			meshletMaker.GenerateMeshlets(
+				MeshletTriangleView{ mesh.indices }, std::data(mesh.vertices)
+			);
+		}
+	);
+
+	meshDetailsMS.meshletCount = static_cast<std::uint32_t>(
+		std::size(bundleMeshletDetails) - meshDetailsMS.meshletOffset
+	);
+
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsMS.emplace_back(meshDetailsMS);
 
+	std::span<std::uint32_t> vertexIndices
+		= std::span{ bundleIndices }.subspan(meshDetailsMS.indexOffset);
+
 	{
 		// Per meshlet Bounding Sphere
-		std::vector<MeshletDetails>& meshletDetails = extraMeshData.meshletDetails;
-
-		const size_t meshletCount = std::size(meshletDetails);
+		std::span<const std::uint32_t> primIndices
+			= std::span{ bundlePrimIndices }.subspan(meshDetailsMS.primitiveOffset);
+		std::span<MeshletDetails> meshletDetails
+			= std::span{ bundleMeshletDetails }.subspan(meshDetailsMS.meshletOffset);
 
-		for (size_t index = 0u; index < meshletCount; ++index)
+		for (MeshletDetails& meshletDetail : meshletDetails)
 		{
-			MeshletDetails& meshletDetail = meshletDetails[index];
-
 			meshletDetail.sphereB = GenerateSphereBV(
-				mesh.vertices, mesh.indices, meshletDetail.meshlet
+				mesh.vertices, vertexIndices, meshletDetail.meshlet, options.sphereBVAlgorithm
 			);
 
 			meshletDetail.coneNormal = GenerateNormalCone(
-				mesh.vertices, mesh.indices, extraMeshData.primIndices, meshletDetail
+				mesh.vertices, vertexIndices, primIndices, meshletDetail,
+				options.normalConeAlgorithm
 			);
 		}
 	}
 
-	MemcpyIntoVector(meshBundleTemporaryData.meshletDetails, extraMeshData.meshletDetails);
-	MemcpyIntoVector(meshBundleTemporaryData.primIndices, extraMeshData.primIndices);
-	MemcpyIntoVector(meshBundleTemporaryData.indices, mesh.indices);
-	MemcpyIntoVector(meshBundleTemporaryData.vertices, mesh.vertices);
+	MemcpyIntoVector(bundleVertices, mesh.vertices);
+
+	// The vertex indices of the meshlets are the indices now. The bounds have already been
+	// generated, and they don't depend on the vertex order.
+	if (options.optimiseVertexFetch)
+		MeshOptimiser::OptimiseVertexFetch(
+			vertexIndices, std::span{ bundleVertices }.subspan(meshDetailsMS.vertexOffset)
+		);
 }
 
 void MeshBundleTempCustom::AddMesh(Mesh&& mesh) noexcept
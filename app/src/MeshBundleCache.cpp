@@ -0,0 +1,722 @@
+#include <MeshBundleCache.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <filesystem>
+#include <string_view>
+#include <type_traits>
+#include <MappedFile.hpp>
+#include <MeshDeduplicator.hpp>
+#include <SolException.hpp>
+
+namespace Sol
+{
+namespace MeshBundleCache
+{
+	// SOLM
+	static constexpr std::uint32_t s_cacheMagic       = 0x4D4C4F53u;
+	static constexpr size_t        s_sectionCount     = 14u;
+	// Enough for the matrices of the scene nodes.
+	static constexpr size_t        s_sectionAlignment = 16u;
+
+	struct CacheHeader
+	{
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint64_t key;
+		std::uint32_t vertexLayout;
+		std::uint32_t sectionCount;
+	};
+
+	// The offset is from the start of the file.
+	struct CacheSection
+	{
+		std::uint64_t offset;
+		std::uint64_t byteCount;
+		std::uint64_t elementSize;
+	};
+
+	// Calls the function with every container of the key and of the scene data, in the order
+	// of the sections. The key's sections come first, so they can be read on their own.
+	template<typename CacheKey_t, typename SceneData_t, typename Function_t>
+	static void VisitSections(CacheKey_t& cacheKey, SceneData_t& sceneData, Function_t&& function)
+	{
+		auto& bundleData    = sceneData.bundleData;
+		auto& bundleDetails = bundleData.bundleDetails;
+
+		function(cacheKey.fileStamps);
+		function(cacheKey.referencedPaths);
+		function(bundleData.vertices);
+		function(bundleData.indices);
+		function(bundleData.primIndices);
+		function(bundleData.meshletDetails);
+		function(bundleDetails.meshTemporaryDetailsVS);
+		function(bundleDetails.meshTemporaryDetailsMS);
+		function(bundleData.quantisedVertices);
+		function(bundleData.vertexQuantisations);
+		function(sceneData.sceneNodeData);
+		function(sceneData.meshMaterialIndices);
+		function(sceneData.materials);
+		function(sceneData.materialStrings);
+	}
+
+	[[nodiscard]]
+	static constexpr size_t AlignSectionOffset(size_t offset) noexcept
+	{
+		return (offset + s_sectionAlignment - 1u) / s_sectionAlignment * s_sectionAlignment;
+	}
+
+	std::string GetCachePath(const std::string& sourcePath)
+	{
+		return sourcePath + ".solmesh";
+	}
+
+	// Checks the header and copies the section table.
+	[[nodiscard]]
+	static bool ReadSectionTable(
+		std::span<const std::uint8_t> cacheData, CacheHeader& header,
+		std::array<CacheSection, s_sectionCount>& sections
+	) noexcept {
+		if (std::size(cacheData) < sizeof(CacheHeader) + sizeof(sections))
+			return false;
+
+		std::memcpy(&header, std::data(cacheData), sizeof(header));
+
+		if (header.magic != s_cacheMagic || header.version != s_cacheVersion
+			|| header.sectionCount != s_sectionCount
+			|| header.vertexLayout > static_cast<std::uint32_t>(VertexLayout::Quantised))
+			return false;
+
+		std::memcpy(std::data(sections), std::data(cacheData) + sizeof(header), sizeof(sections));
+
+		return true;
+	}
+
+	// Returns false if the section is outside of the cache or has different elements.
+	template<typename T>
+	[[nodiscard]]
+	static bool ReadSection(
+		std::span<const std::uint8_t> cacheData, const CacheSection& section,
+		std::vector<T>& elements
+	) {
+		const size_t cacheSize = std::size(cacheData);
+
+		if (section.elementSize != sizeof(T) || section.byteCount % sizeof(T) != 0u
+			|| section.offset > cacheSize || section.byteCount > cacheSize - section.offset)
+			return false;
+
+		if (section.byteCount == 0u)
+			return true;
+
+		elements.resize(section.byteCount / sizeof(T));
+
+		std::memcpy(std::data(elements), std::data(cacheData) + section.offset, section.byteCount);
+
+		return true;
+	}
+
+	// Only the key's sections of an existing cache, which can have any key.
+	[[nodiscard]]
+	static std::optional<CacheKey> ReadStoredKey(const std::string& cachePath)
+	{
+		MappedFile cacheFile{};
+
+		if (!cacheFile.Open(cachePath))
+			return {};
+
+		const std::span<const std::uint8_t> cacheData = cacheFile.GetData();
+
+		CacheHeader header{};
+		std::array<CacheSection, s_sectionCount> sections{};
+
+		if (!ReadSectionTable(cacheData, header, sections))
+			return {};
+
+		CacheKey storedKey{ .hash = header.key };
+
+		if (!ReadSection(cacheData, sections[0], storedKey.fileStamps)
+			|| !ReadSection(cacheData, sections[1], storedKey.referencedPaths))
+			return {};
+
+		return storedKey;
+	}
+
+	[[nodiscard]]
+	static std::uint64_t HashPath(const std::string& path) noexcept
+	{
+		return MeshDeduplicator::HashBytes(std::data(path), std::size(path), s_cacheVersion);
+	}
+
+	// Doesn't hash the content. Returns nothing if the file doesn't exist.
+	[[nodiscard]]
+	static std::optional<CacheFileStamp> GetFileStamp(const std::string& path)
+	{
+		std::error_code errorCode{};
+
+		const std::uintmax_t byteCount = std::filesystem::file_size(path, errorCode);
+
+		if (errorCode)
+			return {};
+
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(
+			path, errorCode
+		);
+
+		if (errorCode)
+			return {};
+
+		return CacheFileStamp
+		{
+			.pathHash    = HashPath(path),
+			.byteCount   = byteCount,
+			.writeTime   = static_cast<std::int64_t>(writeTime.time_since_epoch().count()),
+			.contentHash = 0u
+		};
+	}
+
+	[[nodiscard]]
+	static bool IsSameFile(const CacheFileStamp& lhs, const CacheFileStamp& rhs) noexcept
+	{
+		return lhs.pathHash == rhs.pathHash && lhs.byteCount == rhs.byteCount
+			&& lhs.writeTime == rhs.writeTime;
+	}
+
+	[[nodiscard]]
+	static std::uint64_t HashContent(std::span<const std::uint8_t> data) noexcept
+	{
+		return MeshDeduplicator::HashBytes(std::data(data), std::size(data), s_cacheVersion);
+	}
+
+	// The content is only hashed if the file isn't the same as when it was stored. A missing
+	// file gets a stamp of its own, so the key changes once it is there.
+	[[nodiscard]]
+	static CacheFileStamp GenerateReferencedFileStamp(
+		const std::string& path, std::span<const CacheFileStamp> storedStamps
+	) {
+		std::optional<CacheFileStamp> fileStamp = GetFileStamp(path);
+
+		if (!fileStamp)
+			return CacheFileStamp
+			{
+				.pathHash    = HashPath(path),
+				.byteCount   = std::numeric_limits<std::uint64_t>::max(),
+				.writeTime   = 0,
+				.contentHash = 0u
+			};
+
+		const auto storedStamp = std::ranges::find_if(
+			storedStamps,
+			[&fileStamp](const CacheFileStamp& stamp) { return IsSameFile(stamp, *fileStamp); }
+		);
+
+		if (storedStamp != std::end(storedStamps))
+			fileStamp->contentHash = storedStamp->contentHash;
+		else
+		{
+			// An empty file can't be mapped.
+			MappedFile file{};
+
+			std::ignore = file.Open(path);
+
+			fileStamp->contentHash = HashContent(file.GetData());
+		}
+
+		return *fileStamp;
+	}
+
+	// Adds the path and a null to the referenced paths, relative to the source's directory.
+	static void AddReferencedPath(
+		const std::filesystem::path& sourceDirectory, std::string_view fileName,
+		std::vector<char>& referencedPaths
+	) {
+		if (std::empty(fileName))
+			return;
+
+		const std::string path = (sourceDirectory / std::filesystem::path{ fileName }).string();
+
+		referencedPaths.insert(std::end(referencedPaths), std::begin(path), std::end(path));
+		referencedPaths.emplace_back('\0');
+	}
+
+	[[nodiscard]]
+	static size_t SkipWhitespace(std::string_view text, size_t position) noexcept
+	{
+		while (position < std::size(text)
+			&& std::isspace(static_cast<unsigned char>(text[position])))
+			++position;
+
+		return position;
+	}
+
+	// The string starting at the quote at the position, with its escapes removed. The position
+	// is moved past the closing quote.
+	[[nodiscard]]
+	static std::string ReadJSONString(std::string_view json, size_t& position)
+	{
+		std::string value{};
+
+		for (++position; position < std::size(json) && json[position] != '"'; ++position)
+		{
+			if (json[position] == '\\' && position + 1u < std::size(json))
+				++position;
+
+			value += json[position];
+		}
+
+		++position;
+
+		return value;
+	}
+
+	// The %XX escapes of a URI.
+	[[nodiscard]]
+	static std::string DecodeURI(std::string_view uri)
+	{
+		std::string decodedURI{};
+
+		for (size_t index = 0u; index < std::size(uri); ++index)
+		{
+			if (uri[index] == '%' && index + 2u < std::size(uri)
+				&& std::isxdigit(static_cast<unsigned char>(uri[index + 1u]))
+				&& std::isxdigit(static_cast<unsigned char>(uri[index + 2u])))
+			{
+				decodedURI += static_cast<char>(
+					std::stoi(std::string{ uri.substr(index + 1u, 2u) }, nullptr, 16)
+				);
+
+				index += 2u;
+			}
+			else
+				decodedURI += uri[index];
+		}
+
+		return decodedURI;
+	}
+
+	// The uris of the objects in the buffers array of a glTF's JSON. Only the buffers array is
+	// looked at, so it doesn't need a full parser. The embedded data uris aren't files.
+	static void AddGLTFBufferPaths(
+		std::string_view json, const std::filesystem::path& sourceDirectory,
+		std::vector<char>& referencedPaths
+	) {
+		constexpr std::string_view buffersKey = "\"buffers\"";
+
+		size_t position = 0u;
+
+		for (; ; position += std::size(buffersKey))
+		{
+			position = json.find(buffersKey, position);
+
+			if (position == std::string_view::npos)
+				return;
+
+			const size_t colonPosition = SkipWhitespace(json, position + std::size(buffersKey));
+
+			if (colonPosition < std::size(json) && json[colonPosition] == ':')
+			{
+				const size_t arrayPosition = SkipWhitespace(json, colonPosition + 1u);
+
+				if (arrayPosition < std::size(json) && json[arrayPosition] == '[')
+				{
+					position = arrayPosition;
+
+					break;
+				}
+			}
+		}
+
+		// The uris are the members of the objects in the array, so at a depth of 2.
+		size_t depth = 0u;
+
+		while (position < std::size(json))
+		{
+			const char character = json[position];
+
+			if (character == '"')
+			{
+				const std::string key = ReadJSONString(json, position);
+
+				const size_t colonPosition = SkipWhitespace(json, position);
+
+				if (depth != 2u || key != "uri" || colonPosition >= std::size(json)
+					|| json[colonPosition] != ':')
+					continue;
+
+				position = SkipWhitespace(json, colonPosition + 1u);
+
+				if (position >= std::size(json) || json[position] != '"')
+					continue;
+
+				const std::string uri = ReadJSONString(json, position);
+
+				if (!uri.starts_with("data:"))
+					AddReferencedPath(sourceDirectory, DecodeURI(uri), referencedPaths);
+
+				continue;
+			}
+
+			if (character == '[' || character == '{')
+				++depth;
+			else if (character == ']' || character == '}')
+			{
+				--depth;
+
+				if (depth == 0u)
+					return;
+			}
+
+			++position;
+		}
+	}
+
+	// The files of the mtllib lines of an OBJ.
+	static void AddOBJMaterialPaths(
+		std::string_view obj, const std::filesystem::path& sourceDirectory,
+		std::vector<char>& referencedPaths
+	) {
+		constexpr std::string_view materialLibraryKey = "mtllib";
+
+		for (size_t lineStart = 0u; lineStart < std::size(obj); )
+		{
+			size_t lineEnd = obj.find('\n', lineStart);
+
+			if (lineEnd == std::string_view::npos)
+				lineEnd = std::size(obj);
+
+			std::string_view line = obj.substr(lineStart, lineEnd - lineStart);
+
+			line.remove_prefix(std::min(SkipWhitespace(line, 0u), std::size(line)));
+
+			const size_t keyLength = std::size(materialLibraryKey);
+
+			if (line.starts_with(materialLibraryKey) && std::size(line) > keyLength
+				&& std::isspace(static_cast<unsigned char>(line[keyLength])))
+			{
+				size_t position = keyLength;
+
+				while ((position = SkipWhitespace(line, position)) < std::size(line))
+				{
+					size_t nameEnd = position;
+
+					while (nameEnd < std::size(line)
+						&& !std::isspace(static_cast<unsigned char>(line[nameEnd])))
+						++nameEnd;
+
+					AddReferencedPath(
+						sourceDirectory, line.substr(position, nameEnd - position), referencedPaths
+					);
+
+					position = nameEnd;
+				}
+			}
+
+			lineStart = lineEnd + 1u;
+		}
+	}
+
+	// Only the glTF and the OBJ files can reference other files, which change their meshes.
+	static void AddReferencedPaths(
+		const std::string& sourcePath, std::span<const std::uint8_t> sourceData,
+		std::vector<char>& referencedPaths
+	) {
+		const std::filesystem::path sourceFilePath{ sourcePath };
+		const std::filesystem::path sourceDirectory = sourceFilePath.parent_path();
+
+		std::string extension = sourceFilePath.extension().string();
+
+		std::ranges::transform(
+			extension, std::begin(extension),
+			[](char character)
+			{
+				return static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+			}
+		);
+
+		std::string_view sourceText{
+			reinterpret_cast<char const*>(std::data(sourceData)), std::size(sourceData)
+		};
+
+		// The JSON of a .glb is its first chunk, after the 12 byte header and the chunk's
+		// length and type.
+		constexpr size_t glbJSONOffset = 20u;
+
+		if (sourceText.starts_with("glTF") && std::size(sourceData) >= glbJSONOffset)
+		{
+			std::uint32_t jsonByteCount = 0u;
+
+			std::memcpy(&jsonByteCount, std::data(sourceData) + 12u, sizeof(jsonByteCount));
+
+			AddGLTFBufferPaths(
+				sourceText.substr(glbJSONOffset, jsonByteCount), sourceDirectory, referencedPaths
+			);
+		}
+		else if (extension == ".gltf")
+			AddGLTFBufferPaths(sourceText, sourceDirectory, referencedPaths);
+		else if (extension == ".obj")
+			AddOBJMaterialPaths(sourceText, sourceDirectory, referencedPaths);
+	}
+
+	CacheKey GenerateCacheKey(
+		const std::string& sourcePath, bool meshShader, const MeshProcessingOptions& options,
+		const SceneImportFlags& importFlags
+	) {
+		std::optional<CacheFileStamp> sourceStamp = GetFileStamp(sourcePath);
+
+		if (!sourceStamp)
+			throw Exception{ "SceneFileMissing", "The scene file couldn't be found." };
+
+		const std::optional<CacheKey> storedKey = ReadStoredKey(GetCachePath(sourcePath));
+
+		std::span<const CacheFileStamp> storedStamps{};
+
+		if (storedKey)
+			storedStamps = storedKey->fileStamps;
+
+		CacheKey cacheKey{};
+
+		// An unchanged source references the same files, so it doesn't need to be read.
+		if (!std::empty(storedStamps) && IsSameFile(*sourceStamp, storedStamps.front()))
+		{
+			sourceStamp->contentHash = storedStamps.front().contentHash;
+			cacheKey.referencedPaths = storedKey->referencedPaths;
+		}
+		else
+		{
+			MappedFile sourceFile{};
+
+			if (!sourceFile.Open(sourcePath))
+				throw Exception{ "SceneFileMissing", "The scene file couldn't be found." };
+
+			sourceStamp->contentHash = HashContent(sourceFile.GetData());
+
+			AddReferencedPaths(sourcePath, sourceFile.GetData(), cacheKey.referencedPaths);
+		}
+
+		cacheKey.fileStamps.emplace_back(*sourceStamp);
+
+		for (size_t pathStart = 0u; pathStart < std::size(cacheKey.referencedPaths); )
+		{
+			const std::string path{ std::data(cacheKey.referencedPaths) + pathStart };
+
+			cacheKey.fileStamps.emplace_back(GenerateReferencedFileStamp(path, storedStamps));
+
+			pathStart += std::size(path) + 1u;
+		}
+
+		std::uint64_t fileHash = s_cacheVersion;
+
+		for (const CacheFileStamp& fileStamp : cacheKey.fileStamps)
+			fileHash = MeshDeduplicator::HashBytes(
+				&fileStamp.contentHash, sizeof(fileStamp.contentHash), fileHash
+			);
+
+		// The options are hashed field by field, as the padding of the structure isn't set.
+		const std::array<std::uint64_t, 17u> optionWords
+		{
+			meshShader,
+			static_cast<std::uint64_t>(options.meshletBuildMode),
+			static_cast<std::uint64_t>(options.meshletLimits),
+			options.optimiseVertexCache,
+			options.optimiseOverdraw,
+			options.optimiseVertexFetch,
+			static_cast<std::uint64_t>(options.sphereBVAlgorithm),
+			static_cast<std::uint64_t>(options.normalConeAlgorithm),
+			options.quantiseVertices,
+			options.deduplicateMeshes,
+			options.lodCount,
+			std::bit_cast<std::uint32_t>(options.lodTriangleRatio),
+			importFlags.calcTangentSpace,
+			importFlags.joinIdenticalVertices,
+			importFlags.genNormals,
+			importFlags.genUVCoords,
+			importFlags.removeRedundantMaterials
+		};
+
+		cacheKey.hash = MeshDeduplicator::HashBytes(
+			std::data(optionWords), sizeof(std::uint64_t) * std::size(optionWords), fileHash
+		);
+
+		return cacheKey;
+	}
+
+	bool WriteCache(
+		const std::string& cachePath, const CacheKey& cacheKey, const SceneCacheData& sceneData
+	) {
+		std::array<CacheSection, s_sectionCount> sections{};
+
+		size_t dataOffset = sizeof(CacheHeader) + sizeof(sections);
+
+		{
+			size_t sectionIndex = 0u;
+
+			VisitSections(
+				cacheKey, sceneData,
+				[&sections, &sectionIndex, &dataOffset]<typename T>(const std::vector<T>& elements)
+				{
+					static_assert(
+						std::is_trivially_copyable_v<T>, "The cached elements are copied as bytes."
+					);
+
+					dataOffset = AlignSectionOffset(dataOffset);
+
+					sections[sectionIndex] = CacheSection
+					{
+						.offset      = dataOffset,
+						.byteCount   = sizeof(T) * std::size(elements),
+						.elementSize = sizeof(T)
+					};
+
+					dataOffset += sections[sectionIndex].byteCount;
+					++sectionIndex;
+				}
+			);
+		}
+
+		const CacheHeader header
+		{
+			.magic        = s_cacheMagic,
+			.version      = s_cacheVersion,
+			.key          = cacheKey.hash,
+			.vertexLayout = static_cast<std::uint32_t>(sceneData.bundleData.vertexLayout),
+			.sectionCount = static_cast<std::uint32_t>(s_sectionCount)
+		};
+
+		const std::string temporaryPath = cachePath + ".tmp";
+
+		{
+			std::ofstream cacheFile{ temporaryPath, std::ios_base::binary | std::ios_base::trunc };
+
+			if (!cacheFile)
+				return false;
+
+			cacheFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			cacheFile.write(reinterpret_cast<char const*>(std::data(sections)), sizeof(sections));
+
+			size_t writtenByteCount = sizeof(header) + sizeof(sections);
+
+			VisitSections(
+				cacheKey, sceneData,
+				[&cacheFile, &writtenByteCount]<typename T>(const std::vector<T>& elements)
+				{
+					static constexpr std::array<char, s_sectionAlignment> padding{};
+
+					const size_t sectionOffset = AlignSectionOffset(writtenByteCount);
+
+					cacheFile.write(std::data(padding), sectionOffset - writtenByteCount);
+
+					const size_t byteCount = sizeof(T) * std::size(elements);
+
+					cacheFile.write(
+						reinterpret_cast<char const*>(std::data(elements)),
+						static_cast<std::streamsize>(byteCount)
+					);
+
+					writtenByteCount = sectionOffset + byteCount;
+				}
+			);
+
+			if (!cacheFile.flush())
+			{
+				cacheFile.close();
+
+				std::error_code errorCode{};
+				std::filesystem::remove(temporaryPath, errorCode);
+
+				return false;
+			}
+		}
+
+		std::error_code errorCode{};
+
+		std::filesystem::rename(temporaryPath, cachePath, errorCode);
+
+		if (errorCode)
+		{
+			std::filesystem::remove(temporaryPath, errorCode);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	// Writes the new stamps over the old ones, which must be as many.
+	static void RefreshFileStamps(
+		const std::string& cachePath, const CacheSection& stampSection,
+		std::span<const CacheFileStamp> fileStamps
+	) {
+		std::fstream cacheFile{
+			cachePath, std::ios_base::binary | std::ios_base::in | std::ios_base::out
+		};
+
+		if (!cacheFile)
+			return;
+
+		cacheFile.seekp(static_cast<std::streamoff>(stampSection.offset));
+		cacheFile.write(
+			reinterpret_cast<char const*>(std::data(fileStamps)),
+			static_cast<std::streamsize>(stampSection.byteCount)
+		);
+	}
+
+	std::optional<SceneCacheData> ReadCache(
+		const std::string& cachePath, const CacheKey& cacheKey
+	) {
+		MappedFile cacheFile{};
+
+		if (!cacheFile.Open(cachePath))
+			return {};
+
+		const std::span<const std::uint8_t> cacheData = cacheFile.GetData();
+
+		CacheHeader header{};
+		std::array<CacheSection, s_sectionCount> sections{};
+
+		if (!ReadSectionTable(cacheData, header, sections) || header.key != cacheKey.hash)
+			return {};
+
+		CacheKey storedKey{};
+		SceneCacheData sceneData{};
+
+		sceneData.bundleData.vertexLayout = static_cast<VertexLayout>(header.vertexLayout);
+
+		bool isValid        = true;
+		size_t sectionIndex = 0u;
+
+		VisitSections(
+			storedKey, sceneData,
+			[&sections, &sectionIndex, &isValid, &cacheData]<typename T>(std::vector<T>& elements)
+			{
+				isValid = isValid && ReadSection(cacheData, sections[sectionIndex], elements);
+
+				++sectionIndex;
+			}
+		);
+
+		if (!isValid)
+			return {};
+
+		cacheFile.Close();
+
+		// The files were only touched, as the content is the same. So, their new stamps are
+		// stored, otherwise they would be hashed on every load.
+		const std::vector<CacheFileStamp>& fileStamps = cacheKey.fileStamps;
+
+		if (std::size(fileStamps) == std::size(storedKey.fileStamps)
+			&& !std::ranges::equal(
+				fileStamps, storedKey.fileStamps,
+				[](const CacheFileStamp& lhs, const CacheFileStamp& rhs)
+				{
+					return IsSameFile(lhs, rhs);
+				}
+			))
+			RefreshFileStamps(cachePath, sections[0], fileStamps);
+
+		return sceneData;
+	}
+}
+}
@@ -0,0 +1,167 @@
+#include <MeshDeduplicator.hpp>
+#include <cstring>
+#include <unordered_map>
+
+namespace Sol
+{
+namespace MeshDeduplicator
+{
+	static constexpr std::uint64_t s_hashMultiplier = 0x9E3779B97F4A7C15ull;
+
+	// The splitmix64 finaliser, so every bit of the value affects every bit of the result.
+	[[nodiscard]]
+	static std::uint64_t Mix(std::uint64_t value) noexcept
+	{
+		value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+
+		return value ^ (value >> 31u);
+	}
+
+	std::uint64_t HashBytes(void const* data, size_t byteCount, std::uint64_t seed) noexcept
+	{
+		auto bytes         = static_cast<std::uint8_t const*>(data);
+		std::uint64_t hash = seed ^ (byteCount * s_hashMultiplier);
+
+		for (; byteCount >= sizeof(std::uint64_t); byteCount -= sizeof(std::uint64_t))
+		{
+			std::uint64_t word = 0u;
+			std::memcpy(&word, bytes, sizeof(std::uint64_t));
+
+			hash   = (hash ^ Mix(word)) * s_hashMultiplier;
+			bytes += sizeof(std::uint64_t);
+		}
+
+		if (byteCount)
+		{
+			std::uint64_t word = 0u;
+			std::memcpy(&word, bytes, byteCount);
+
+			hash = (hash ^ Mix(word)) * s_hashMultiplier;
+		}
+
+		return Mix(hash);
+	}
+
+	// The missing attributes are hashed as their presence only.
+	[[nodiscard]]
+	static std::uint64_t HashVectors(
+		aiVector3D const* vectors, size_t vectorCount, std::uint64_t seed
+	) noexcept {
+		if (!vectors)
+			return Mix(seed);
+
+		return HashBytes(vectors, sizeof(aiVector3D) * vectorCount, seed);
+	}
+
+	[[nodiscard]]
+	static bool AreVectorsEqual(
+		aiVector3D const* vectors1, aiVector3D const* vectors2, size_t vectorCount
+	) noexcept {
+		if (!vectors1 || !vectors2)
+			return vectors1 == vectors2;
+
+		return std::memcmp(vectors1, vectors2, sizeof(aiVector3D) * vectorCount) == 0;
+	}
+
+	std::uint64_t HashMeshGeometry(aiMesh const* mesh) noexcept
+	{
+		const size_t vertexCount = mesh->mNumVertices;
+
+		std::uint64_t hash = Mix(vertexCount);
+
+		hash = HashVectors(mesh->mVertices, vertexCount, hash);
+		hash = HashVectors(mesh->mNormals, vertexCount, hash);
+		hash = HashVectors(mesh->mTextureCoords[0], vertexCount, hash);
+
+		const size_t faceCount = mesh->mNumFaces;
+		aiFace const* faces    = mesh->mFaces;
+
+		for (size_t index = 0u; index < faceCount; ++index)
+		{
+			const aiFace& face = faces[index];
+
+			hash = HashBytes(face.mIndices, sizeof(unsigned int) * face.mNumIndices, hash);
+		}
+
+		return hash;
+	}
+
+	bool IsGeometryEqual(aiMesh const* mesh1, aiMesh const* mesh2) noexcept
+	{
+		const size_t vertexCount = mesh1->mNumVertices;
+		const size_t faceCount   = mesh1->mNumFaces;
+
+		if (vertexCount != mesh2->mNumVertices || faceCount != mesh2->mNumFaces)
+			return false;
+
+		if (!AreVectorsEqual(mesh1->mVertices, mesh2->mVertices, vertexCount)
+			|| !AreVectorsEqual(mesh1->mNormals, mesh2->mNormals, vertexCount)
+			|| !AreVectorsEqual(mesh1->mTextureCoords[0], mesh2->mTextureCoords[0], vertexCount))
+			return false;
+
+		for (size_t index = 0u; index < faceCount; ++index)
+		{
+			const aiFace& face1 = mesh1->mFaces[index];
+			const aiFace& face2 = mesh2->mFaces[index];
+
+			if (face1.mNumIndices != face2.mNumIndices)
+				return false;
+
+			if (std::memcmp(
+				face1.mIndices, face2.mIndices, sizeof(unsigned int) * face1.mNumIndices
+			) != 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	std::vector<std::uint32_t> GenerateMeshRemap(aiScene const* scene, bool matchMaterials)
+	{
+		aiMesh** meshes        = scene->mMeshes;
+		const size_t meshCount = scene->mNumMeshes;
+
+		std::vector<std::uint32_t> meshRemap(meshCount);
+
+		// The first meshes with each hash. There should rarely be more than one.
+		std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> uniqueMeshes{};
+		uniqueMeshes.reserve(meshCount);
+
+		for (size_t index = 0u; index < meshCount; ++index)
+		{
+			aiMesh const* mesh = meshes[index];
+
+			std::uint64_t hash = HashMeshGeometry(mesh);
+
+			if (matchMaterials)
+				hash = HashBytes(&mesh->mMaterialIndex, sizeof(mesh->mMaterialIndex), hash);
+
+			std::vector<std::uint32_t>& candidates = uniqueMeshes[hash];
+
+			const auto meshIndex = static_cast<std::uint32_t>(index);
+			meshRemap[index]     = meshIndex;
+
+			for (const std::uint32_t candidateIndex : candidates)
+			{
+				aiMesh const* candidate = meshes[candidateIndex];
+
+				if (matchMaterials && candidate->mMaterialIndex != mesh->mMaterialIndex)
+					continue;
+
+				if (IsGeometryEqual(candidate, mesh))
+				{
+					meshRemap[index] = candidateIndex;
+
+					break;
+				}
+			}
+
+			if (meshRemap[index] == meshIndex)
+				candidates.emplace_back(meshIndex);
+		}
+
+		return meshRemap;
+	}
+}
+}
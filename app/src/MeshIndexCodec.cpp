@@ -0,0 +1,516 @@
+#include <MeshIndexCodec.hpp>
+#include <MeshletMaker.hpp>
+#include <array>
+#include <cassert>
+
+namespace Sol
+{
+namespace IndexCodec
+{
+	// Both FIFOs have 16 slots, but the last code of a nibble is reserved. So, only the 15
+	// latest edges and the 14 latest vertices can be referenced.
+	static constexpr size_t s_fifoSize            = 16u;
+	static constexpr std::uint32_t s_noEdgeCode   = 15u;
+	// The vertex codes. The ones in between are the vertex FIFO distances plus 1.
+	static constexpr std::uint32_t s_nextCode     = 0u;
+	static constexpr std::uint32_t s_explicitCode = 15u;
+	// A U32 takes 5 bytes at most as 7 bit groups.
+	static constexpr size_t s_maxVarIntSize       = 5u;
+
+	struct Edge
+	{
+		std::uint32_t first;
+		std::uint32_t second;
+	};
+
+	// The encoder and the decoder must update it in the same way.
+	class CodecState
+	{
+	public:
+		CodecState()
+			: m_edges{}, m_vertices{}, m_edgeOffset{ 0u }, m_vertexOffset{ 0u },
+			m_next{ 0u }, m_last{ 0u }
+		{
+			// The index which is the least likely to be used.
+			m_edges.fill(Edge{ .first = ~0u, .second = ~0u });
+			m_vertices.fill(~0u);
+		}
+
+		void PushEdge(std::uint32_t first, std::uint32_t second) noexcept
+		{
+			m_edges[m_edgeOffset] = Edge{ .first = first, .second = second };
+
+			m_edgeOffset = (m_edgeOffset + 1u) % s_fifoSize;
+		}
+
+		void PushVertex(std::uint32_t vertex) noexcept
+		{
+			m_vertices[m_vertexOffset] = vertex;
+
+			m_vertexOffset = (m_vertexOffset + 1u) % s_fifoSize;
+		}
+
+		// The distance of the latest edge is 0.
+		[[nodiscard]]
+		const Edge& GetEdge(size_t distance) const noexcept
+		{
+			return m_edges[(m_edgeOffset + s_fifoSize - 1u - distance) % s_fifoSize];
+		}
+		[[nodiscard]]
+		std::uint32_t GetVertex(size_t distance) const noexcept
+		{
+			return m_vertices[(m_vertexOffset + s_fifoSize - 1u - distance) % s_fifoSize];
+		}
+
+		[[nodiscard]]
+		size_t FindEdge(std::uint32_t first, std::uint32_t second) const noexcept
+		{
+			for (size_t distance = 0u; distance < s_noEdgeCode; ++distance)
+			{
+				const Edge& edge = GetEdge(distance);
+
+				if (edge.first == first && edge.second == second)
+					return distance;
+			}
+
+			return s_noEdgeCode;
+		}
+
+		// Returns the code of the vertex, and updates the state as the decoder would.
+		[[nodiscard]]
+		std::uint32_t EncodeVertex(std::uint32_t vertex) noexcept
+		{
+			if (vertex == m_next)
+			{
+				PushNewVertex(vertex);
+
+				return s_nextCode;
+			}
+
+			for (std::uint32_t distance = 0u; distance < s_explicitCode - 1u; ++distance)
+				if (GetVertex(distance) == vertex)
+					return distance + 1u;
+
+			PushNewVertex(vertex);
+
+			return s_explicitCode;
+		}
+
+		// The explicit vertices need their delta to be read first.
+		[[nodiscard]]
+		std::uint32_t DecodeVertex(std::uint32_t code) noexcept
+		{
+			if (code == s_nextCode)
+			{
+				const std::uint32_t vertex = m_next;
+
+				PushNewVertex(vertex);
+
+				return vertex;
+			}
+
+			return GetVertex(code - 1u);
+		}
+
+		[[nodiscard]]
+		std::uint32_t DecodeExplicitVertex(std::uint32_t zigZagDelta) noexcept
+		{
+			const std::uint32_t vertex = m_last + static_cast<std::uint32_t>(
+				(zigZagDelta >> 1u) ^ (0u - (zigZagDelta & 1u))
+			);
+
+			PushNewVertex(vertex);
+
+			return vertex;
+		}
+
+		[[nodiscard]]
+		std::uint32_t GetZigZagDelta(std::uint32_t vertex) const noexcept
+		{
+			const auto delta = static_cast<std::int32_t>(vertex - m_last);
+
+			return (static_cast<std::uint32_t>(delta) << 1u)
+				^ static_cast<std::uint32_t>(delta >> 31);
+		}
+
+	private:
+		// The new vertices after an explicit one are expected to follow it. That is the case
+		// at the start of each mesh, after the vertex fetch optimisation.
+		void PushNewVertex(std::uint32_t vertex) noexcept
+		{
+			PushVertex(vertex);
+
+			m_next = vertex + 1u;
+			m_last = vertex;
+		}
+
+	private:
+		std::array<Edge, s_fifoSize>          m_edges;
+		std::array<std::uint32_t, s_fifoSize> m_vertices;
+		size_t                                m_edgeOffset;
+		size_t                                m_vertexOffset;
+		std::uint32_t                         m_next;
+		std::uint32_t                         m_last;
+	};
+
+	static void WriteVarInt(std::uint32_t value, std::vector<std::uint8_t>& data) noexcept
+	{
+		while (value >= 0x80u)
+		{
+			data.emplace_back(static_cast<std::uint8_t>(value | 0x80u));
+
+			value >>= 7u;
+		}
+
+		data.emplace_back(static_cast<std::uint8_t>(value));
+	}
+
+	class ByteReader
+	{
+	public:
+		ByteReader(std::span<const std::uint8_t> data)
+			: m_data{ std::data(data) }, m_offset{ 0u }, m_size{ std::size(data) }
+		{}
+
+		// Every read after the data is exhausted returns 0, so it only needs to be checked
+		// once in a while.
+		[[nodiscard]]
+		std::uint32_t ReadByte() noexcept
+		{
+			if (m_offset < m_size)
+				return m_data[m_offset++];
+
+			m_offset = m_size + 1u;
+
+			return 0u;
+		}
+
+		[[nodiscard]]
+		std::uint32_t ReadVarInt() noexcept
+		{
+			std::uint32_t value = 0u;
+
+			// The fast path, when there are enough bytes left for the largest varint.
+			if (m_offset + s_maxVarIntSize <= m_size)
+			{
+				for (std::uint32_t shift = 0u; shift < 35u; shift += 7u)
+				{
+					const std::uint32_t byte = m_data[m_offset++];
+
+					value |= (byte & 0x7Fu) << shift;
+
+					if (byte < 0x80u)
+						break;
+				}
+
+				return value;
+			}
+
+			for (std::uint32_t shift = 0u; shift < 35u; shift += 7u)
+			{
+				const std::uint32_t byte = ReadByte();
+
+				value |= (byte & 0x7Fu) << shift;
+
+				if (byte < 0x80u)
+					break;
+			}
+
+			return value;
+		}
+
+		[[nodiscard]]
+		bool IsOverrun() const noexcept { return m_offset > m_size; }
+		[[nodiscard]]
+		size_t GetOffset() const noexcept { return m_offset; }
+
+	private:
+		std::uint8_t const* m_data;
+		size_t              m_offset;
+		size_t              m_size;
+	};
+
+	void EncodeTriangles(std::span<const std::uint32_t> indices, std::vector<std::uint8_t>& data)
+	{
+		assert(std::size(indices) % 3u == 0u && "The indices aren't a triangle list.");
+
+		const size_t triangleCount = std::size(indices) / 3u;
+
+		CodecState state{};
+
+		for (size_t index = 0u; index < triangleCount; ++index)
+		{
+			const std::array<std::uint32_t, 3u> triangle
+			{
+				indices[index * 3u + 0u], indices[index * 3u + 1u], indices[index * 3u + 2u]
+			};
+
+			// Rotate the triangle, so a shared edge, if there is one, comes first.
+			size_t edgeDistance = s_noEdgeCode;
+			size_t rotation     = 0u;
+
+			for (; rotation < 3u && edgeDistance == s_noEdgeCode; ++rotation)
+				edgeDistance = state.FindEdge(triangle[rotation], triangle[(rotation + 1u) % 3u]);
+
+			if (edgeDistance != s_noEdgeCode)
+			{
+				--rotation;
+
+				const std::uint32_t vertex0 = triangle[rotation];
+				const std::uint32_t vertex1 = triangle[(rotation + 1u) % 3u];
+				const std::uint32_t vertex2 = triangle[(rotation + 2u) % 3u];
+
+				const std::uint32_t zigZagDelta = state.GetZigZagDelta(vertex2);
+				const std::uint32_t code        = state.EncodeVertex(vertex2);
+
+				data.emplace_back(static_cast<std::uint8_t>((edgeDistance << 4u) | code));
+
+				if (code == s_explicitCode)
+					WriteVarInt(zigZagDelta, data);
+
+				// The adjacent triangles would go through the new edges the other way.
+				state.PushEdge(vertex2, vertex1);
+				state.PushEdge(vertex0, vertex2);
+
+				continue;
+			}
+
+			std::array<std::uint32_t, 3u> zigZagDeltas{};
+			std::array<std::uint32_t, 3u> codes{};
+
+			for (size_t index1 = 0u; index1 < 3u; ++index1)
+			{
+				zigZagDeltas[index1] = state.GetZigZagDelta(triangle[index1]);
+				codes[index1]        = state.EncodeVertex(triangle[index1]);
+			}
+
+			data.emplace_back(static_cast<std::uint8_t>((s_noEdgeCode << 4u) | codes[0]));
+			data.emplace_back(static_cast<std::uint8_t>((codes[1] << 4u) | codes[2]));
+
+			for (size_t index1 = 0u; index1 < 3u; ++index1)
+				if (codes[index1] == s_explicitCode)
+					WriteVarInt(zigZagDeltas[index1], data);
+
+			state.PushEdge(triangle[1], triangle[0]);
+			state.PushEdge(triangle[2], triangle[1]);
+			state.PushEdge(triangle[0], triangle[2]);
+		}
+	}
+
+	[[nodiscard]]
+	static std::uint32_t DecodeVertex(
+		std::uint32_t code, CodecState& state, ByteReader& reader
+	) noexcept {
+		if (code == s_explicitCode)
+			return state.DecodeExplicitVertex(reader.ReadVarInt());
+
+		return state.DecodeVertex(code);
+	}
+
+	size_t DecodeTriangles(
+		std::span<const std::uint8_t> data, std::span<std::uint32_t> indices
+	) noexcept {
+		const size_t triangleCount = std::size(indices) / 3u;
+
+		ByteReader reader{ data };
+		CodecState state{};
+
+		for (size_t index = 0u; index < triangleCount; ++index)
+		{
+			std::uint32_t* triangle = std::data(indices) + index * 3u;
+
+			const std::uint32_t code         = reader.ReadByte();
+			const std::uint32_t edgeDistance = code >> 4u;
+
+			if (edgeDistance != s_noEdgeCode)
+			{
+				const Edge edge = state.GetEdge(edgeDistance);
+
+				const std::uint32_t vertex2 = DecodeVertex(code & 0xFu, state, reader);
+
+				triangle[0] = edge.first;
+				triangle[1] = edge.second;
+				triangle[2] = vertex2;
+
+				state.PushEdge(vertex2, edge.second);
+				state.PushEdge(edge.first, vertex2);
+
+				continue;
+			}
+
+			const std::uint32_t codes12 = reader.ReadByte();
+
+			triangle[0] = DecodeVertex(code & 0xFu, state, reader);
+			triangle[1] = DecodeVertex(codes12 >> 4u, state, reader);
+			triangle[2] = DecodeVertex(codes12 & 0xFu, state, reader);
+
+			state.PushEdge(triangle[1], triangle[0]);
+			state.PushEdge(triangle[2], triangle[1]);
+			state.PushEdge(triangle[0], triangle[2]);
+		}
+
+		return reader.IsOverrun() ? 0u : reader.GetOffset();
+	}
+
+	void EncodeSequence(std::span<const std::uint32_t> indices, std::vector<std::uint8_t>& data)
+	{
+		std::uint32_t previousIndex = 0u;
+
+		for (const std::uint32_t index : indices)
+		{
+			const auto delta = static_cast<std::int32_t>(index - previousIndex);
+
+			WriteVarInt(
+				(static_cast<std::uint32_t>(delta) << 1u) ^ static_cast<std::uint32_t>(delta >> 31),
+				data
+			);
+
+			previousIndex = index;
+		}
+	}
+
+	size_t DecodeSequence(
+		std::span<const std::uint8_t> data, std::span<std::uint32_t> indices
+	) noexcept {
+		ByteReader reader{ data };
+
+		std::uint32_t previousIndex = 0u;
+
+		for (std::uint32_t& index : indices)
+		{
+			const std::uint32_t zigZagDelta = reader.ReadVarInt();
+
+			previousIndex += (zigZagDelta >> 1u) ^ (0u - (zigZagDelta & 1u));
+
+			index = previousIndex;
+		}
+
+		return reader.IsOverrun() ? 0u : reader.GetOffset();
+	}
+}
+
+// The meshlet triangles are local to their meshlet, so the codec is restarted for each of
+// them. Otherwise, the first vertices of each meshlet wouldn't be the next ones.
+template<typename Function_t>
+static void ForEachMeshletTriangles(
+	const MeshBundleTemporaryData& bundleData, Function_t&& function
+) {
+	const std::vector<MeshTemporaryDetailsMS>& meshDetails
+		= bundleData.bundleDetails.meshTemporaryDetailsMS;
+
+	for (const MeshTemporaryDetailsMS& meshDetail : meshDetails)
+	{
+		const size_t meshletEnd = meshDetail.meshletOffset + meshDetail.meshletCount;
+
+		for (size_t index = meshDetail.meshletOffset; index < meshletEnd; ++index)
+		{
+			const Meshlet& meshlet = bundleData.meshletDetails[index].meshlet;
+
+			function(meshDetail.primitiveOffset + meshlet.primitiveOffset, meshlet.primitiveCount);
+		}
+	}
+}
+
+EncodedMeshBundleIndices EncodeMeshBundleIndices(const MeshBundleTemporaryData& bundleData)
+{
+	EncodedMeshBundleIndices encodedIndices
+	{
+		.indexCount     = static_cast<std::uint32_t>(std::size(bundleData.indices)),
+		.primIndexCount = static_cast<std::uint32_t>(std::size(bundleData.primIndices))
+	};
+
+	// Most triangles and sequence indices should take a byte or two.
+	encodedIndices.indices.reserve(std::size(bundleData.indices));
+	encodedIndices.primIndices.reserve(std::size(bundleData.primIndices) * 2u);
+
+	if (std::empty(bundleData.bundleDetails.meshTemporaryDetailsMS))
+	{
+		IndexCodec::EncodeTriangles(bundleData.indices, encodedIndices.indices);
+
+		return encodedIndices;
+	}
+
+	IndexCodec::EncodeSequence(bundleData.indices, encodedIndices.indices);
+
+	std::vector<std::uint32_t> meshletTriangles{};
+
+	ForEachMeshletTriangles(
+		bundleData,
+		[&bundleData, &encodedIndices, &meshletTriangles]
+		(size_t primitiveOffset, size_t primitiveCount)
+		{
+			meshletTriangles.clear();
+
+			for (size_t index = 0u; index < primitiveCount; ++index)
+			{
+				const PrimitiveIndicesUnpacked unpackedPrim
+					= UnpackPrim(bundleData.primIndices[primitiveOffset + index]);
+
+				meshletTriangles.emplace_back(unpackedPrim.firstIndex);
+				meshletTriangles.emplace_back(unpackedPrim.secondIndex);
+				meshletTriangles.emplace_back(unpackedPrim.thirdIndex);
+			}
+
+			IndexCodec::EncodeTriangles(meshletTriangles, encodedIndices.primIndices);
+		}
+	);
+
+	return encodedIndices;
+}
+
+bool DecodeMeshBundleIndices(
+	const EncodedMeshBundleIndices& encodedIndices, MeshBundleTemporaryData& bundleData
+) {
+	bundleData.indices.resize(encodedIndices.indexCount);
+	bundleData.primIndices.resize(encodedIndices.primIndexCount);
+
+	if (std::empty(bundleData.bundleDetails.meshTemporaryDetailsMS))
+		return encodedIndices.indexCount == 0u
+			|| IndexCodec::DecodeTriangles(encodedIndices.indices, bundleData.indices) != 0u;
+
+	if (encodedIndices.indexCount != 0u
+		&& IndexCodec::DecodeSequence(encodedIndices.indices, bundleData.indices) == 0u)
+		return false;
+
+	std::span<const std::uint8_t> primData = encodedIndices.primIndices;
+	std::vector<std::uint32_t> meshletTriangles{};
+	bool isTruncated                       = false;
+
+	ForEachMeshletTriangles(
+		bundleData,
+		[&bundleData, &primData, &meshletTriangles, &isTruncated]
+		(size_t primitiveOffset, size_t primitiveCount)
+		{
+			if (isTruncated || primitiveCount == 0u)
+				return;
+
+			meshletTriangles.resize(primitiveCount * 3u);
+
+			const size_t readSize = IndexCodec::DecodeTriangles(primData, meshletTriangles);
+
+			if (readSize == 0u)
+			{
+				isTruncated = true;
+
+				return;
+			}
+
+			primData = primData.subspan(readSize);
+
+			for (size_t index = 0u; index < primitiveCount; ++index)
+			{
+				const PrimitiveIndicesUnpacked unpackedPrim
+				{
+					.firstIndex  = meshletTriangles[index * 3u + 0u],
+					.secondIndex = meshletTriangles[index * 3u + 1u],
+					.thirdIndex  = meshletTriangles[index * 3u + 2u]
+				};
+
+				bundleData.primIndices[primitiveOffset + index] = PackPrim(unpackedPrim);
+			}
+		}
+	);
+
+	return !isTruncated;
+}
+}
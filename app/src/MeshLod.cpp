@@ -0,0 +1,385 @@
+#include <MeshLod.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <MeshSimplifier.hpp>
+#include <MeshOptimiser.hpp>
+#include <MeshletMaker.hpp>
+#include <MeshBoundImpl.hpp>
+
+namespace Sol
+{
+// A level which keeps more of its previous level's triangles than this is stuck.
+static constexpr float s_stuckReductionRatio = 0.95f;
+
+[[nodiscard]]
+static float GetMeshSize(
+	std::span<const std::uint32_t> indices, std::span<const Vertex> vertices
+) noexcept {
+	using namespace DirectX;
+
+	if (std::empty(indices))
+		return 0.f;
+
+	XMVECTOR positionMin = XMVectorReplicate(std::numeric_limits<float>::max());
+	XMVECTOR positionMax = XMVectorReplicate(-std::numeric_limits<float>::max());
+
+	for (const std::uint32_t vertexIndex : indices)
+	{
+		const XMVECTOR position = XMLoadFloat3(&vertices[vertexIndex].position);
+
+		positionMin = XMVectorMin(positionMin, position);
+		positionMax = XMVectorMax(positionMax, position);
+	}
+
+	return XMVectorGetX(XMVector3Length(positionMax - positionMin));
+}
+
+std::vector<MeshLodLevel> GenerateMeshLods(
+	std::span<const std::uint32_t> indices, std::span<const Vertex> vertices, size_t lodCount,
+	float triangleRatio
+) {
+	std::vector<MeshLodLevel> levels{};
+
+	const float meshSize = GetMeshSize(indices, vertices);
+
+	const MeshSimplifier::SimplificationOptions simplificationOptions
+	{
+		.normalWeight = s_lodNormalWeight * meshSize,
+		.uvWeight     = s_lodUVWeight * meshSize,
+		.lockBorders  = false
+	};
+
+	std::vector<std::uint32_t> levelIndices{ std::begin(indices), std::end(indices) };
+	float levelError = 0.f;
+
+	for (size_t level = 0u; level < lodCount; ++level)
+	{
+		const size_t previousIndexCount = std::size(levelIndices);
+
+		const auto targetIndexCount = static_cast<size_t>(
+			static_cast<float>(previousIndexCount / 3u) * triangleRatio
+		) * 3u;
+
+		// Each level is simplified from the previous one, like the groups of the meshlet
+		// hierarchy. So, its error includes the previous level's.
+		const float simplificationError = MeshSimplifier::Simplify(
+			levelIndices, vertices, targetIndexCount, std::numeric_limits<float>::max(), {},
+			simplificationOptions
+		);
+
+		const size_t levelIndexCount = std::size(levelIndices);
+
+		if (levelIndexCount == 0u
+			|| static_cast<float>(levelIndexCount)
+				> static_cast<float>(previousIndexCount) * s_stuckReductionRatio)
+			break;
+
+		levelError += simplificationError;
+
+		levels.emplace_back(MeshLodLevel{ .indices = levelIndices, .error = levelError });
+	}
+
+	return levels;
+}
+
+// The vertices from the vertexOffset to the largest vertex index, with the indices local to
+// them.
+[[nodiscard]]
+static Mesh GetLocalMesh(
+	std::vector<std::uint32_t>&& localIndices, const std::vector<Vertex>& bundleVertices,
+	size_t vertexOffset
+) {
+	size_t vertexCount = 0u;
+
+	for (const std::uint32_t vertexIndex : localIndices)
+		vertexCount = std::max(vertexCount, size_t{ vertexIndex } + 1u);
+
+	auto meshVertices = std::begin(bundleVertices) + vertexOffset;
+
+	return Mesh
+	{
+		.vertices = std::vector<Vertex>{ meshVertices, meshVertices + vertexCount },
+		.indices  = std::move(localIndices)
+	};
+}
+
+[[nodiscard]]
+static Mesh GetLocalMesh(
+	const MeshTemporaryDetailsVS& meshDetails, const MeshBundleTemporaryData& bundleData
+) {
+	std::vector<std::uint32_t> localIndices(meshDetails.indexCount);
+
+	std::ranges::transform(
+		std::span{ bundleData.indices }.subspan(meshDetails.indexOffset, meshDetails.indexCount),
+		std::begin(localIndices),
+		[vertexOffset = meshDetails.vertexOffset](std::uint32_t vertexIndex)
+		{
+			return vertexIndex - vertexOffset;
+		}
+	);
+
+	return GetLocalMesh(std::move(localIndices), bundleData.vertices, meshDetails.vertexOffset);
+}
+
+[[nodiscard]]
+static Mesh GetLocalMesh(
+	const MeshTemporaryDetailsMS& meshDetails, const MeshBundleTemporaryData& bundleData
+) {
+	std::vector<std::uint32_t> localIndices{};
+
+	for (size_t index = 0u; index < meshDetails.meshletCount; ++index)
+	{
+		const Meshlet& meshlet
+			= bundleData.meshletDetails[meshDetails.meshletOffset + index].meshlet;
+
+		const size_t indexStart     = size_t{ meshDetails.indexOffset } + meshlet.indexOffset;
+		const size_t primitiveStart
+			= size_t{ meshDetails.primitiveOffset } + meshlet.primitiveOffset;
+
+		for (size_t primIndex = 0u; primIndex < meshlet.primitiveCount; ++primIndex)
+		{
+			const PrimitiveIndicesUnpacked unpackedPrim = UnpackPrim(
+				bundleData.primIndices[primitiveStart + primIndex]
+			);
+
+			localIndices.emplace_back(bundleData.indices[indexStart + unpackedPrim.firstIndex]);
+			localIndices.emplace_back(bundleData.indices[indexStart + unpackedPrim.secondIndex]);
+			localIndices.emplace_back(bundleData.indices[indexStart + unpackedPrim.thirdIndex]);
+		}
+	}
+
+	return GetLocalMesh(std::move(localIndices), bundleData.vertices, meshDetails.vertexOffset);
+}
+
+static void AddLodVS(
+	std::vector<std::uint32_t>& levelIndices, float levelError,
+	const MeshTemporaryDetailsVS& meshDetails, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& bundleData
+) {
+	if (options.optimiseVertexCache)
+		MeshOptimiser::OptimiseVertexCache(levelIndices);
+
+	std::vector<std::uint32_t>& bundleIndices = bundleData.indices;
+
+	bundleData.bundleDetails.meshTemporaryDetailsVS.emplace_back(
+		MeshTemporaryDetailsVS
+		{
+			.indexCount   = static_cast<std::uint32_t>(std::size(levelIndices)),
+			.indexOffset  = static_cast<std::uint32_t>(std::size(bundleIndices)),
+			.vertexOffset = meshDetails.vertexOffset,
+			.aabb         = meshDetails.aabb,
+			.lodError     = levelError
+		}
+	);
+
+	std::ranges::transform(
+		levelIndices, std::back_inserter(bundleIndices),
+		[vertexOffset = meshDetails.vertexOffset](std::uint32_t vertexIndex)
+		{
+			return vertexOffset + vertexIndex;
+		}
+	);
+}
+
+static void AddLodMS(
+	std::vector<std::uint32_t>& levelIndices, float levelError, const Mesh& localMesh,
+	const MeshTemporaryDetailsMS& meshDetails, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& bundleData
+) {
+	if (options.optimiseVertexCache)
+		MeshOptimiser::OptimiseVertexCache(levelIndices);
+
+	std::vector<MeshletDetails>& bundleMeshletDetails = bundleData.meshletDetails;
+	std::vector<std::uint32_t>& bundleIndices         = bundleData.indices;
+	std::vector<std::uint32_t>& bundlePrimIndices     = bundleData.primIndices;
+
+	MeshTemporaryDetailsMS levelDetails
+	{
+		.meshletOffset   = static_cast<std::uint32_t>(std::size(bundleMeshletDetails)),
+		.indexOffset     = static_cast<std::uint32_t>(std::size(bundleIndices)),
+		.primitiveOffset = static_cast<std::uint32_t>(std::size(bundlePrimIndices)),
+		.vertexOffset    = meshDetails.vertexOffset,
+		.aabb            = meshDetails.aabb,
+		.lodError        = levelError
+	};
+
+	VisitMeshletLimits(
+		options.meshletLimits,
+		[&localMesh, &levelIndices, &options, &bundleIndices, &bundlePrimIndices,
+			&bundleMeshletDetails]
+		<size_t vertexLimit_t, size_t primitiveLimit_t>
+		(MeshletLimits<vertexLimit_t, primitiveLimit_t>)
+		{
+			MeshletStreamMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{
+				bundleIndices, bundlePrimIndices, bundleMeshletDetails, options.meshletBuildMode
+			};
+
+			meshletMaker.GenerateMeshlets(
+				MeshletTriangleView{ levelIndices }, std::data(localMesh.vertices)
+			);
+		}
+	);
+
+	levelDetails.meshletCount = static_cast<std::uint32_t>(
+		std::size(bundleMeshletDetails) - levelDetails.meshletOffset
+	);
+
+	std::span<const std::uint32_t> vertexIndices
+		= std::span{ bundleIndices }.subspan(levelDetails.indexOffset);
+	std::span<const std::uint32_t> primIndices
+		= std::span{ bundlePrimIndices }.subspan(levelDetails.primitiveOffset);
+	std::span<MeshletDetails> meshletDetails
+		= std::span{ bundleMeshletDetails }.subspan(levelDetails.meshletOffset);
+
+	for (MeshletDetails& meshletDetail : meshletDetails)
+	{
+		meshletDetail.sphereB = GenerateSphereBV(
+			localMesh.vertices, vertexIndices, meshletDetail.meshlet, options.sphereBVAlgorithm
+		);
+
+		meshletDetail.coneNormal = GenerateNormalCone(
+			localMesh.vertices, vertexIndices, primIndices, meshletDetail,
+			options.normalConeAlgorithm
+		);
+	}
+
+	bundleData.bundleDetails.meshTemporaryDetailsMS.emplace_back(levelDetails);
+}
+
+// The index range of a mesh on the vertex shader path and the meshlet range on the mesh
+// shader path.
+[[nodiscard]]
+static std::uint64_t GetRangeKey(const MeshTemporaryDetailsVS& meshDetails) noexcept
+{
+	return static_cast<std::uint64_t>(meshDetails.indexOffset) << 32u | meshDetails.indexCount;
+}
+
+[[nodiscard]]
+static std::uint64_t GetRangeKey(const MeshTemporaryDetailsMS& meshDetails) noexcept
+{
+	return static_cast<std::uint64_t>(meshDetails.meshletOffset) << 32u
+		| meshDetails.meshletCount;
+}
+
+// The meshes with the same range as an earlier mesh are copies of it, so they share its
+// levels as well.
+template<typename MeshDetails_t, typename AddLod_t>
+static void GenerateLods(
+	std::vector<MeshDetails_t>& meshDetails, MeshBundleTemporaryData& bundleData,
+	const MeshProcessingOptions& options, AddLod_t&& addLod
+) {
+	const size_t meshCount = std::size(meshDetails);
+
+	std::unordered_map<std::uint64_t, size_t> firstMeshIndices{};
+
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		const MeshDetails_t currentDetails = meshDetails[index];
+
+		const auto [firstMesh, isFirst] = firstMeshIndices.try_emplace(
+			GetRangeKey(currentDetails), index
+		);
+
+		if (!isFirst)
+		{
+			const MeshDetails_t& firstDetails = meshDetails[firstMesh->second];
+
+			meshDetails[index].lodOffset = firstDetails.lodOffset;
+			meshDetails[index].lodCount  = firstDetails.lodCount;
+
+			continue;
+		}
+
+		Mesh localMesh = GetLocalMesh(currentDetails, bundleData);
+
+		std::vector<MeshLodLevel> levels = GenerateMeshLods(
+			localMesh.indices, localMesh.vertices, options.lodCount, options.lodTriangleRatio
+		);
+
+		const auto lodOffset = static_cast<std::uint32_t>(std::size(meshDetails));
+
+		for (MeshLodLevel& level : levels)
+			addLod(level, localMesh, currentDetails);
+
+		// Adding the levels could have reallocated the details.
+		meshDetails[index].lodOffset = lodOffset;
+		meshDetails[index].lodCount  = static_cast<std::uint32_t>(std::size(levels));
+	}
+}
+
+void GenerateMeshBundleLods(
+	MeshBundleTemporaryData& bundleData, const MeshProcessingOptions& options
+) {
+	assert(
+		bundleData.vertexLayout == VertexLayout::Float
+		&& "The levels must be made from the float vertices."
+	);
+
+	if (options.lodCount == 0u)
+		return;
+
+	MeshBundleTemporaryDetails& bundleDetails = bundleData.bundleDetails;
+
+	GenerateLods(
+		bundleDetails.meshTemporaryDetailsVS, bundleData, options,
+		[&options, &bundleData]
+		(MeshLodLevel& level, const Mesh&, const MeshTemporaryDetailsVS& meshDetails)
+		{
+			AddLodVS(level.indices, level.error, meshDetails, options, bundleData);
+		}
+	);
+
+	GenerateLods(
+		bundleDetails.meshTemporaryDetailsMS, bundleData, options,
+		[&options, &bundleData]
+		(MeshLodLevel& level, const Mesh& localMesh, const MeshTemporaryDetailsMS& meshDetails)
+		{
+			AddLodMS(level.indices, level.error, localMesh, meshDetails, options, bundleData);
+		}
+	);
+}
+
+template<typename MeshDetails_t>
+[[nodiscard]]
+static std::uint32_t SelectLod(
+	std::span<const MeshDetails_t> meshDetails, std::uint32_t meshIndex, float distance,
+	float errorThreshold
+) noexcept {
+	const MeshDetails_t& baseDetails = meshDetails[meshIndex];
+
+	const float allowedError = errorThreshold * std::max(distance, 0.f);
+
+	std::uint32_t selectedIndex = meshIndex;
+
+	// The errors only grow down the chain.
+	for (std::uint32_t level = 0u; level < baseDetails.lodCount; ++level)
+	{
+		const std::uint32_t levelIndex = baseDetails.lodOffset + level;
+
+		if (meshDetails[levelIndex].lodError > allowedError)
+			break;
+
+		selectedIndex = levelIndex;
+	}
+
+	return selectedIndex;
+}
+
+std::uint32_t SelectMeshLod(
+	std::span<const MeshTemporaryDetailsVS> meshDetails, std::uint32_t meshIndex,
+	float distance, float errorThreshold
+) noexcept {
+	return SelectLod(meshDetails, meshIndex, distance, errorThreshold);
+}
+
+std::uint32_t SelectMeshLod(
+	std::span<const MeshTemporaryDetailsMS> meshDetails, std::uint32_t meshIndex,
+	float distance, float errorThreshold
+) noexcept {
+	return SelectLod(meshDetails, meshIndex, distance, errorThreshold);
+}
+}
@@ -0,0 +1,671 @@
+#include <MeshOptimiser.hpp>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <DirectXMath.h>
+
+namespace Sol
+{
+namespace MeshOptimiser
+{
+	struct VertexTriangleAdjacency
+	{
+		// The triangles which use a vertex are stored contiguously, from the vertex's offset
+		// to the next vertex's offset.
+		std::vector<std::uint32_t> triangleOffsets;
+		std::vector<std::uint32_t> triangles;
+		std::vector<std::uint32_t> liveTriangleCounts;
+	};
+
+	[[nodiscard]]
+	static VertexTriangleAdjacency GenerateAdjacency(
+		std::span<const std::uint32_t> indices, size_t vertexCount
+	) {
+		const size_t indexCount = std::size(indices) / 3u * 3u;
+
+		VertexTriangleAdjacency adjacency
+		{
+			.triangleOffsets    = std::vector<std::uint32_t>(vertexCount + 1u, 0u),
+			.triangles          = std::vector<std::uint32_t>(indexCount, 0u),
+			.liveTriangleCounts = std::vector<std::uint32_t>(vertexCount, 0u)
+		};
+
+		for (size_t index = 0u; index < indexCount; ++index)
+			++adjacency.liveTriangleCounts[indices[index]];
+
+		for (size_t index = 0u; index < vertexCount; ++index)
+			adjacency.triangleOffsets[index + 1u]
+				= adjacency.triangleOffsets[index] + adjacency.liveTriangleCounts[index];
+
+		std::vector<std::uint32_t> writeOffsets = adjacency.triangleOffsets;
+
+		for (size_t index = 0u; index < indexCount; ++index)
+			adjacency.triangles[writeOffsets[indices[index]]++]
+				= static_cast<std::uint32_t>(index / 3u);
+
+		return adjacency;
+	}
+
+	void OptimiseVertexCache(std::span<std::uint32_t> indices, size_t cacheSize)
+	{
+		constexpr auto invalidVertex = std::numeric_limits<std::uint32_t>::max();
+
+		const size_t triangleCount = std::size(indices) / 3u;
+		const size_t indexCount    = triangleCount * 3u;
+		const size_t vertexCount   = GetVertexCount(indices.first(indexCount));
+
+		if (triangleCount < 2u)
+			return;
+
+		VertexTriangleAdjacency adjacency = GenerateAdjacency(indices, vertexCount);
+
+		std::vector<std::uint32_t>& liveTriangleCounts = adjacency.liveTriangleCounts;
+
+		// When a vertex was last put into the cache. A vertex is in the cache if it was put
+		// in less than cacheSize transforms ago.
+		std::vector<size_t> cacheTimestamps(vertexCount, 0u);
+		size_t currentTimestamp = cacheSize + 1u;
+
+		std::vector<std::uint8_t> isTriangleEmitted(triangleCount, 0u);
+
+		// The vertices of the recently emitted triangles. Used to find the next fanning
+		// vertex, when the current one's triangles have all been emitted.
+		std::vector<std::uint32_t> deadEndStack{};
+		std::vector<std::uint32_t> candidates{};
+
+		std::vector<std::uint32_t> optimisedIndices{};
+		optimisedIndices.reserve(indexCount);
+
+		std::uint32_t fanningVertex = indices[0];
+		// The next vertex in the input order, which might still have live triangles. Starts
+		// at the first vertex, as it doesn't have to be the first index.
+		std::uint32_t vertexCursor  = 0u;
+
+		while (fanningVertex != invalidVertex)
+		{
+			candidates.clear();
+
+			const std::uint32_t adjacencyStart = adjacency.triangleOffsets[fanningVertex];
+			const std::uint32_t adjacencyEnd   = adjacency.triangleOffsets[fanningVertex + 1u];
+
+			for (std::uint32_t index = adjacencyStart; index < adjacencyEnd; ++index)
+			{
+				const std::uint32_t triangle = adjacency.triangles[index];
+
+				if (isTriangleEmitted[triangle])
+					continue;
+
+				isTriangleEmitted[triangle] = 1u;
+
+				for (size_t index1 = 0u; index1 < 3u; ++index1)
+				{
+					const std::uint32_t vertex = indices[triangle * 3u + index1];
+
+					optimisedIndices.emplace_back(vertex);
+					deadEndStack.emplace_back(vertex);
+					candidates.emplace_back(vertex);
+
+					--liveTriangleCounts[vertex];
+
+					if (currentTimestamp - cacheTimestamps[vertex] > cacheSize)
+					{
+						cacheTimestamps[vertex] = currentTimestamp;
+						++currentTimestamp;
+					}
+				}
+			}
+
+			// Pick the candidate which will still be in the cache after its remaining
+			// triangles have been emitted and has been in the cache the longest.
+			fanningVertex = invalidVertex;
+
+			size_t bestPriority = 0u;
+
+			for (const std::uint32_t candidate : candidates)
+			{
+				if (!liveTriangleCounts[candidate])
+					continue;
+
+				size_t priority = 0u;
+
+				const size_t cacheAge = currentTimestamp - cacheTimestamps[candidate];
+
+				if (cacheAge + 2u * liveTriangleCounts[candidate] <= cacheSize)
+					priority = cacheAge;
+
+				if (priority > bestPriority || fanningVertex == invalidVertex)
+				{
+					bestPriority  = priority;
+					fanningVertex = candidate;
+				}
+			}
+
+			// Dead end. Try the most recently used vertices first, as they might still be
+			// in the cache and then any vertex with live triangles.
+			while (fanningVertex == invalidVertex && !std::empty(deadEndStack))
+			{
+				const std::uint32_t vertex = deadEndStack.back();
+				deadEndStack.pop_back();
+
+				if (liveTriangleCounts[vertex])
+					fanningVertex = vertex;
+			}
+
+			while (fanningVertex == invalidVertex && vertexCursor < vertexCount)
+			{
+				if (liveTriangleCounts[vertexCursor])
+					fanningVertex = vertexCursor;
+
+				++vertexCursor;
+			}
+		}
+
+		assert(
+			std::size(optimisedIndices) == indexCount && "Some triangles weren't emitted."
+		);
+
+		std::ranges::copy(optimisedIndices, std::begin(indices));
+	}
+
+	void OptimiseVertexFetch(
+		std::span<std::uint32_t> indices, std::span<Vertex> vertices, std::uint32_t vertexOffset
+	) {
+		constexpr auto invalidVertex = std::numeric_limits<std::uint32_t>::max();
+
+		const size_t vertexCount = std::size(vertices);
+
+		// The new position of each vertex.
+		std::vector<std::uint32_t> vertexRemap(vertexCount, invalidVertex);
+
+		std::uint32_t nextVertex = 0u;
+
+		for (std::uint32_t& index : indices)
+		{
+			std::uint32_t& newVertex = vertexRemap[index - vertexOffset];
+
+			if (newVertex == invalidVertex)
+				newVertex = nextVertex++;
+
+			index = vertexOffset + newVertex;
+		}
+
+		for (std::uint32_t& newVertex : vertexRemap)
+			if (newVertex == invalidVertex)
+				newVertex = nextVertex++;
+
+		// Since the remap is a permutation, it would only be sorted if nothing moves.
+		if (std::ranges::is_sorted(vertexRemap))
+			return;
+
+		std::vector<Vertex> oldVertices(std::begin(vertices), std::end(vertices));
+
+		for (size_t index = 0u; index < vertexCount; ++index)
+			vertices[vertexRemap[index]] = oldVertices[index];
+	}
+
+	// A FIFO post transform cache. A vertex is in the cache if it was put in less than
+	// cacheSize transforms ago.
+	class VertexCacheSimulator
+	{
+	public:
+		VertexCacheSimulator(size_t vertexCount, size_t cacheSize)
+			: m_cacheTimestamps(vertexCount, 0u), m_currentTimestamp{ cacheSize + 1u },
+			m_cacheSize{ cacheSize }
+		{}
+
+		// Returns the number of vertices which had to be transformed.
+		[[nodiscard]]
+		size_t TransformTriangle(const std::uint32_t* triangleIndices) noexcept
+		{
+			size_t missCount = 0u;
+
+			for (size_t index = 0u; index < 3u; ++index)
+			{
+				size_t& cacheTimestamp = m_cacheTimestamps[triangleIndices[index]];
+
+				if (m_currentTimestamp - cacheTimestamp > m_cacheSize)
+				{
+					cacheTimestamp = m_currentTimestamp;
+					++m_currentTimestamp;
+					++missCount;
+				}
+			}
+
+			return missCount;
+		}
+
+		void Flush() noexcept { m_currentTimestamp += m_cacheSize + 1u; }
+
+	private:
+		std::vector<size_t> m_cacheTimestamps;
+		size_t              m_currentTimestamp;
+		size_t              m_cacheSize;
+	};
+
+	// Returns the first triangle of each cluster. The indices must be local.
+	[[nodiscard]]
+	static std::vector<std::uint32_t> GenerateTriangleClusters(
+		std::span<const std::uint32_t> indices, size_t vertexCount, float threshold
+	) {
+		const size_t triangleCount = std::size(indices) / 3u;
+
+		VertexCacheSimulator cache{ vertexCount, s_defaultVertexCacheSize };
+
+		// The vertex cache optimisation only misses with all three vertices of a triangle,
+		// when it has to jump to a different part of the mesh. So, those are always the
+		// start of a new cluster. The first triangle is always one of them.
+		std::vector<std::uint32_t> hardClusterOffsets{};
+
+		for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+			if (cache.TransformTriangle(&indices[triangle * 3u]) == 3u)
+				hardClusterOffsets.emplace_back(static_cast<std::uint32_t>(triangle));
+
+		const size_t hardClusterCount = std::size(hardClusterOffsets);
+
+		std::vector<std::uint32_t> clusterOffsets{};
+
+		// Each hard cluster is split further, whenever its leading triangles have reached
+		// a cache miss ratio close enough to the whole hard cluster's. Each cluster is
+		// measured as if it were drawn on its own, since they will be sorted.
+		for (size_t index = 0u; index < hardClusterCount; ++index)
+		{
+			const size_t clusterStart = hardClusterOffsets[index];
+			const size_t clusterEnd
+				= index + 1u < hardClusterCount ? hardClusterOffsets[index + 1u] : triangleCount;
+
+			size_t clusterMissCount = 0u;
+
+			cache.Flush();
+
+			for (size_t triangle = clusterStart; triangle < clusterEnd; ++triangle)
+				clusterMissCount += cache.TransformTriangle(&indices[triangle * 3u]);
+
+			const float clusterThreshold = threshold * static_cast<float>(clusterMissCount)
+				/ static_cast<float>(clusterEnd - clusterStart);
+
+			const size_t firstOffset = std::size(clusterOffsets);
+
+			clusterOffsets.emplace_back(static_cast<std::uint32_t>(clusterStart));
+
+			size_t runningMissCount     = 0u;
+			size_t runningTriangleCount = 0u;
+
+			cache.Flush();
+
+			for (size_t triangle = clusterStart; triangle < clusterEnd; ++triangle)
+			{
+				runningMissCount += cache.TransformTriangle(&indices[triangle * 3u]);
+				++runningTriangleCount;
+
+				if (static_cast<float>(runningMissCount)
+					<= clusterThreshold * static_cast<float>(runningTriangleCount))
+				{
+					clusterOffsets.emplace_back(static_cast<std::uint32_t>(triangle + 1u));
+
+					runningMissCount     = 0u;
+					runningTriangleCount = 0u;
+
+					cache.Flush();
+				}
+			}
+
+			// The last offset is either the end of the hard cluster or the start of the
+			// triangles which didn't reach the threshold. Those are merged into the previous
+			// cluster.
+			if (std::size(clusterOffsets) - firstOffset > 1u)
+				clusterOffsets.pop_back();
+		}
+
+		return clusterOffsets;
+	}
+
+	void OptimiseOverdraw(
+		std::span<std::uint32_t> indices, std::span<const Vertex> vertices,
+		std::uint32_t vertexOffset, float threshold
+	) {
+		using namespace DirectX;
+
+		const size_t triangleCount = std::size(indices) / 3u;
+		const size_t indexCount    = triangleCount * 3u;
+
+		if (triangleCount < 2u)
+			return;
+
+		std::vector<std::uint32_t> localIndices(
+			std::begin(indices), std::begin(indices) + indexCount
+		);
+
+		for (std::uint32_t& index : localIndices)
+			index -= vertexOffset;
+
+		const std::vector<std::uint32_t> clusterOffsets = GenerateTriangleClusters(
+			localIndices, std::size(vertices), threshold
+		);
+
+		const size_t clusterCount = std::size(clusterOffsets);
+
+		if (clusterCount < 2u)
+			return;
+
+		// The centroids are weighted by the triangle areas, so the tessellation doesn't move
+		// them. The length of an unnormalised face normal is twice the area.
+		std::vector<XMFLOAT3> clusterCentroids(clusterCount);
+		std::vector<XMFLOAT3> clusterNormals(clusterCount);
+
+		XMVECTOR meshCentroid = XMVectorZero();
+		float meshArea        = 0.f;
+
+		for (size_t index = 0u; index < clusterCount; ++index)
+		{
+			const size_t clusterEnd
+				= index + 1u < clusterCount ? clusterOffsets[index + 1u] : triangleCount;
+
+			XMVECTOR centroid = XMVectorZero();
+			XMVECTOR normal   = XMVectorZero();
+			float area        = 0.f;
+
+			for (size_t triangle = clusterOffsets[index]; triangle < clusterEnd; ++triangle)
+			{
+				const std::uint32_t* triangleIndices = &localIndices[triangle * 3u];
+
+				const XMVECTOR position0 = XMLoadFloat3(&vertices[triangleIndices[0]].position);
+				const XMVECTOR position1 = XMLoadFloat3(&vertices[triangleIndices[1]].position);
+				const XMVECTOR position2 = XMLoadFloat3(&vertices[triangleIndices[2]].position);
+
+				const XMVECTOR faceNormal = XMVector3Cross(
+					position1 - position0, position2 - position0
+				);
+				const float faceArea      = XMVectorGetX(XMVector3Length(faceNormal));
+
+				centroid += (position0 + position1 + position2) * (faceArea / 3.f);
+				normal   += faceNormal;
+				area     += faceArea;
+			}
+
+			meshCentroid += centroid;
+			meshArea     += area;
+
+			if (area > 0.f)
+				centroid /= area;
+
+			XMStoreFloat3(&clusterCentroids[index], centroid);
+			XMStoreFloat3(&clusterNormals[index], XMVector3Normalize(normal));
+		}
+
+		// Everything is degenerate.
+		if (meshArea <= 0.f)
+			return;
+
+		meshCentroid /= meshArea;
+
+		std::vector<float> clusterSortKeys(clusterCount);
+
+		for (size_t index = 0u; index < clusterCount; ++index)
+			clusterSortKeys[index] = XMVectorGetX(
+				XMVector3Dot(
+					XMLoadFloat3(&clusterCentroids[index]) - meshCentroid,
+					XMLoadFloat3(&clusterNormals[index])
+				)
+			);
+
+		std::vector<std::uint32_t> clusterOrder(clusterCount);
+
+		std::iota(std::begin(clusterOrder), std::end(clusterOrder), 0u);
+
+		std::ranges::stable_sort(
+			clusterOrder,
+			[&clusterSortKeys](std::uint32_t lhs, std::uint32_t rhs)
+			{
+				return clusterSortKeys[lhs] > clusterSortKeys[rhs];
+			}
+		);
+
+		auto indexOutput = std::begin(indices);
+
+		for (const std::uint32_t cluster : clusterOrder)
+		{
+			const size_t clusterEnd
+				= cluster + 1u < clusterCount ? clusterOffsets[cluster + 1u] : triangleCount;
+
+			for (size_t index = clusterOffsets[cluster] * 3u; index < clusterEnd * 3u; ++index)
+				*indexOutput++ = localIndices[index] + vertexOffset;
+		}
+	}
+
+	VertexCacheStatistics AnalyseVertexCache(
+		std::span<const std::uint32_t> indices, size_t cacheSize
+	) {
+		const size_t triangleCount = std::size(indices) / 3u;
+		const size_t indexCount    = triangleCount * 3u;
+		const size_t vertexCount   = GetVertexCount(indices.first(indexCount));
+
+		VertexCacheStatistics statistics{};
+
+		if (!triangleCount)
+			return statistics;
+
+		// The transform count, when a vertex was last put into the cache. Like the simulator of
+		// the optimisation, a vertex is in the FIFO cache if it is one of the last cacheSize
+		// vertices put into it.
+		constexpr auto neverTransformed = std::numeric_limits<size_t>::max();
+
+		std::vector<size_t> cacheTimestamps(vertexCount, neverTransformed);
+
+		size_t uniqueVertexCount = 0u;
+
+		for (size_t index = 0u; index < indexCount; ++index)
+		{
+			const std::uint32_t vertex = indices[index];
+			const size_t timestamp     = cacheTimestamps[vertex];
+
+			if (timestamp == neverTransformed)
+				++uniqueVertexCount;
+
+			if (timestamp == neverTransformed
+				|| statistics.vertexTransformCount - timestamp > cacheSize)
+			{
+				cacheTimestamps[vertex] = statistics.vertexTransformCount;
+				++statistics.vertexTransformCount;
+			}
+		}
+
+		const auto transformCount = static_cast<float>(statistics.vertexTransformCount);
+
+		statistics.acmr = transformCount / static_cast<float>(triangleCount);
+		statistics.atvr = transformCount / static_cast<float>(uniqueVertexCount);
+
+		return statistics;
+	}
+
+	static constexpr size_t s_overdrawViewportSize = 256u;
+
+	// The xy of the positions are in pixels and the z is the depth, where the larger depths
+	// are nearer. Only the triangles with a positive area are drawn. Returns the shaded
+	// pixel count.
+	[[nodiscard]]
+	static size_t RasteriseTriangle(
+		std::span<float> depthBuffer, const std::array<float, 3u>& position0,
+		const std::array<float, 3u>& position1, const std::array<float, 3u>& position2
+	) noexcept {
+		const auto [x0, y0, z0] = position0;
+		const auto [x1, y1, z1] = position1;
+		const auto [x2, y2, z2] = position2;
+
+		const float area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+
+		if (area <= 0.f)
+			return 0u;
+
+		const float inverseArea = 1.f / area;
+
+		constexpr auto maxPixel = static_cast<float>(s_overdrawViewportSize - 1u);
+
+		const auto minX = static_cast<size_t>(
+			std::max(std::floor(std::min({ x0, x1, x2 })), 0.f)
+		);
+		const auto minY = static_cast<size_t>(
+			std::max(std::floor(std::min({ y0, y1, y2 })), 0.f)
+		);
+		const auto maxX = static_cast<size_t>(
+			std::min(std::ceil(std::max({ x0, x1, x2 })), maxPixel)
+		);
+		const auto maxY = static_cast<size_t>(
+			std::min(std::ceil(std::max({ y0, y1, y2 })), maxPixel)
+		);
+
+		size_t shadedPixelCount = 0u;
+
+		for (size_t y = minY; y <= maxY; ++y)
+			for (size_t x = minX; x <= maxX; ++x)
+			{
+				const float pixelX = static_cast<float>(x) + 0.5f;
+				const float pixelY = static_cast<float>(y) + 0.5f;
+
+				const float weight0 = ((x2 - x1) * (pixelY - y1) - (y2 - y1) * (pixelX - x1))
+					* inverseArea;
+				const float weight1 = ((x0 - x2) * (pixelY - y2) - (y0 - y2) * (pixelX - x2))
+					* inverseArea;
+				const float weight2 = 1.f - weight0 - weight1;
+
+				if (weight0 < 0.f || weight1 < 0.f || weight2 < 0.f)
+					continue;
+
+				const float depth = weight0 * z0 + weight1 * z1 + weight2 * z2;
+				float& pixelDepth = depthBuffer[y * s_overdrawViewportSize + x];
+
+				if (depth > pixelDepth)
+				{
+					pixelDepth = depth;
+					++shadedPixelCount;
+				}
+			}
+
+		return shadedPixelCount;
+	}
+
+	OverdrawStatistics AnalyseOverdraw(
+		std::span<const std::uint32_t> indices, std::span<const Vertex> vertices
+	) {
+		const size_t triangleCount = std::size(indices) / 3u;
+		const size_t vertexCount   = std::size(vertices);
+
+		OverdrawStatistics statistics{};
+
+		if (!triangleCount || !vertexCount)
+			return statistics;
+
+		// The positions are scaled uniformly to fit the viewport.
+		std::array<float, 3u> positionMin{};
+		std::array<float, 3u> positionMax{};
+
+		positionMin.fill(std::numeric_limits<float>::max());
+		positionMax.fill(-std::numeric_limits<float>::max());
+
+		std::vector<std::array<float, 3u>> positions(vertexCount);
+
+		for (size_t index = 0u; index < vertexCount; ++index)
+		{
+			const DirectX::XMFLOAT3& position = vertices[index].position;
+
+			positions[index] = { position.x, position.y, position.z };
+
+			for (size_t axis = 0u; axis < 3u; ++axis)
+			{
+				positionMin[axis] = std::min(positionMin[axis], positions[index][axis]);
+				positionMax[axis] = std::max(positionMax[axis], positions[index][axis]);
+			}
+		}
+
+		const float extent = std::max(
+			{
+				positionMax[0] - positionMin[0], positionMax[1] - positionMin[1],
+				positionMax[2] - positionMin[2]
+			}
+		);
+
+		if (extent <= 0.f)
+			return statistics;
+
+		const float scale = static_cast<float>(s_overdrawViewportSize - 1u) / extent;
+
+		for (std::array<float, 3u>& position : positions)
+			for (size_t axis = 0u; axis < 3u; ++axis)
+				position[axis] = (position[axis] - positionMin[axis]) * scale;
+
+		constexpr size_t pixelCount = s_overdrawViewportSize * s_overdrawViewportSize;
+		constexpr float clearDepth  = -std::numeric_limits<float>::max();
+
+		// One for the view from the positive side of an axis and one for the negative.
+		std::vector<float> depthBuffers(pixelCount * 2u);
+
+		std::span<float> positiveDepthBuffer = std::span{ depthBuffers }.first(pixelCount);
+		std::span<float> negativeDepthBuffer = std::span{ depthBuffers }.last(pixelCount);
+
+		for (size_t axis = 0u; axis < 3u; ++axis)
+		{
+			std::ranges::fill(depthBuffers, clearDepth);
+
+			// The other axes are taken in the cyclic order, so a triangle which faces the
+			// positive side of the axis has a positive area.
+			const size_t axisX = (axis + 1u) % 3u;
+			const size_t axisY = (axis + 2u) % 3u;
+
+			for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+			{
+				std::array<std::array<float, 3u>, 3u> projected{};
+
+				for (size_t index = 0u; index < 3u; ++index)
+				{
+					const std::array<float, 3u>& position
+						= positions[indices[triangle * 3u + index]];
+
+					projected[index] = { position[axisX], position[axisY], position[axis] };
+				}
+
+				statistics.pixelsShaded += RasteriseTriangle(
+					positiveDepthBuffer, projected[0], projected[1], projected[2]
+				);
+
+				// From the negative side, the winding and the depths are flipped.
+				for (std::array<float, 3u>& position : projected)
+					position[2] = -position[2];
+
+				statistics.pixelsShaded += RasteriseTriangle(
+					negativeDepthBuffer, projected[0], projected[2], projected[1]
+				);
+			}
+
+			statistics.pixelsCovered += static_cast<size_t>(
+				std::ranges::count_if(
+					depthBuffers, [](float depth) { return depth != clearDepth; }
+				)
+			);
+		}
+
+		if (statistics.pixelsCovered)
+			statistics.overdraw = static_cast<float>(statistics.pixelsShaded)
+				/ static_cast<float>(statistics.pixelsCovered);
+
+		return statistics;
+	}
+
+	size_t GetVertexCount(std::span<const std::uint32_t> indices) noexcept
+	{
+		if (std::empty(indices))
+			return 0u;
+
+		return static_cast<size_t>(std::ranges::max(indices)) + 1u;
+	}
+
+	void OffsetIndices(std::span<std::uint32_t> indices, std::uint32_t offset) noexcept
+	{
+		if (offset)
+			for (std::uint32_t& index : indices)
+				index += offset;
+	}
+}
+}
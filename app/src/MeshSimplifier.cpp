@@ -0,0 +1,675 @@
+#include <MeshSimplifier.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace Sol
+{
+namespace MeshSimplifier
+{
+	// How much more moving a vertex off an unlocked border costs, than moving it off the
+	// surface.
+	static constexpr double s_borderPlaneWeight = 10.0;
+
+	// The symmetric 4x4 matrix of the sum of the squared distances to a set of planes. Only
+	// the upper triangle is stored.
+	struct Quadric
+	{
+		double a00 = 0.0;
+		double a01 = 0.0;
+		double a02 = 0.0;
+		double a03 = 0.0;
+		double a11 = 0.0;
+		double a12 = 0.0;
+		double a13 = 0.0;
+		double a22 = 0.0;
+		double a23 = 0.0;
+		double a33 = 0.0;
+
+		// The plane is n.p + d = 0, with a unit normal.
+		void AddPlane(double nX, double nY, double nZ, double d) noexcept
+		{
+			a00 += nX * nX;
+			a01 += nX * nY;
+			a02 += nX * nZ;
+			a03 += nX * d;
+			a11 += nY * nY;
+			a12 += nY * nZ;
+			a13 += nY * d;
+			a22 += nZ * nZ;
+			a23 += nZ * d;
+			a33 += d * d;
+		}
+
+		void Add(const Quadric& other) noexcept
+		{
+			a00 += other.a00;
+			a01 += other.a01;
+			a02 += other.a02;
+			a03 += other.a03;
+			a11 += other.a11;
+			a12 += other.a12;
+			a13 += other.a13;
+			a22 += other.a22;
+			a23 += other.a23;
+			a33 += other.a33;
+		}
+
+		[[nodiscard]]
+		double Evaluate(const DirectX::XMFLOAT3& position) const noexcept
+		{
+			const double x = position.x;
+			const double y = position.y;
+			const double z = position.z;
+
+			return a00 * x * x + a11 * y * y + a22 * z * z
+				+ 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+				+ 2.0 * (a03 * x + a13 * y + a23 * z)
+				+ a33;
+		}
+	};
+
+	// The normal and the uv of a vertex, scaled with their weights.
+	using Attributes = std::array<double, 5u>;
+
+	// The sum of the squared differences from the attributes of the vertices which have been
+	// collapsed into a vertex, to the attributes they are evaluated at.
+	struct AttributeQuadric
+	{
+		double     count      = 0.0;
+		Attributes sum        = {};
+		double     squaredSum = 0.0;
+
+		void AddAttributes(const Attributes& attributes) noexcept
+		{
+			count += 1.0;
+
+			for (size_t index = 0u; index < std::size(attributes); ++index)
+			{
+				sum[index] += attributes[index];
+				squaredSum += attributes[index] * attributes[index];
+			}
+		}
+
+		void Add(const AttributeQuadric& other) noexcept
+		{
+			count      += other.count;
+			squaredSum += other.squaredSum;
+
+			for (size_t index = 0u; index < std::size(sum); ++index)
+				sum[index] += other.sum[index];
+		}
+
+		[[nodiscard]]
+		double Evaluate(const Attributes& attributes) const noexcept
+		{
+			double error = squaredSum;
+
+			for (size_t index = 0u; index < std::size(attributes); ++index)
+				error += attributes[index] * (count * attributes[index] - 2.0 * sum[index]);
+
+			// The rounding could make it slightly negative.
+			return std::max(error, 0.0);
+		}
+	};
+
+	[[nodiscard]]
+	static Attributes GetAttributes(
+		const Vertex& vertex, const SimplificationOptions& options
+	) noexcept {
+		const double normalWeight = options.normalWeight;
+		const double uvWeight     = options.uvWeight;
+
+		return Attributes
+		{
+			vertex.normal.x * normalWeight, vertex.normal.y * normalWeight,
+			vertex.normal.z * normalWeight, vertex.uv.x * uvWeight, vertex.uv.y * uvWeight
+		};
+	}
+
+	struct EdgeCollapse
+	{
+		std::uint32_t from;
+		std::uint32_t to;
+		double        cost;
+		double        positionCost;
+	};
+
+	struct TriangleNormal
+	{
+		double x;
+		double y;
+		double z;
+	};
+
+	[[nodiscard]]
+	static TriangleNormal GetTriangleNormal(
+		const DirectX::XMFLOAT3& position0, const DirectX::XMFLOAT3& position1,
+		const DirectX::XMFLOAT3& position2
+	) noexcept {
+		const double edge0X = static_cast<double>(position1.x) - position0.x;
+		const double edge0Y = static_cast<double>(position1.y) - position0.y;
+		const double edge0Z = static_cast<double>(position1.z) - position0.z;
+
+		const double edge1X = static_cast<double>(position2.x) - position0.x;
+		const double edge1Y = static_cast<double>(position2.y) - position0.y;
+		const double edge1Z = static_cast<double>(position2.z) - position0.z;
+
+		// Not normalised. Its length is twice the area of the triangle.
+		return TriangleNormal
+		{
+			.x = edge0Y * edge1Z - edge0Z * edge1Y,
+			.y = edge0Z * edge1X - edge0X * edge1Z,
+			.z = edge0X * edge1Y - edge0Y * edge1X
+		};
+	}
+
+	[[nodiscard]]
+	static std::uint64_t GetEdgeKey(std::uint32_t vertex0, std::uint32_t vertex1) noexcept
+	{
+		const std::uint32_t lowVertex  = std::min(vertex0, vertex1);
+		const std::uint32_t highVertex = std::max(vertex0, vertex1);
+
+		return static_cast<std::uint64_t>(lowVertex) << 32u | highVertex;
+	}
+
+	[[nodiscard]]
+	static std::vector<std::uint64_t> GetEdgeKeys(const std::vector<std::uint32_t>& indices)
+	{
+		const size_t indexCount = std::size(indices);
+
+		std::vector<std::uint64_t> edgeKeys{};
+		edgeKeys.reserve(indexCount);
+
+		for (size_t index = 0u; index < indexCount; index += 3u)
+		{
+			const std::uint32_t vertex0 = indices[index + 0u];
+			const std::uint32_t vertex1 = indices[index + 1u];
+			const std::uint32_t vertex2 = indices[index + 2u];
+
+			edgeKeys.emplace_back(GetEdgeKey(vertex0, vertex1));
+			edgeKeys.emplace_back(GetEdgeKey(vertex1, vertex2));
+			edgeKeys.emplace_back(GetEdgeKey(vertex2, vertex0));
+		}
+
+		std::ranges::sort(edgeKeys);
+
+		return edgeKeys;
+	}
+
+	// Calls the function with every unique edge key of the sorted keys and if the edge is only
+	// used by a single triangle, which means it is on an open border.
+	template<typename Function_t>
+	static void ForEachEdge(std::span<const std::uint64_t> edgeKeys, Function_t&& function)
+	{
+		const size_t edgeKeyCount = std::size(edgeKeys);
+
+		for (size_t index = 0u; index < edgeKeyCount;)
+		{
+			size_t runEnd = index + 1u;
+
+			while (runEnd < edgeKeyCount && edgeKeys[runEnd] == edgeKeys[index])
+				++runEnd;
+
+			function(edgeKeys[index], runEnd - index == 1u);
+
+			index = runEnd;
+		}
+	}
+
+	// Locks the vertices which are on the open borders, or share their position with another
+	// vertex. Moving those would open a hole in the mesh or tear it apart on a seam. If the
+	// borders aren't locked, their vertices are only marked.
+	static void LockBorderVertices(
+		const std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices,
+		bool lockBorders, std::vector<std::uint8_t>& lockedVertices,
+		std::vector<std::uint8_t>& borderVertices
+	) {
+		{
+			std::vector<std::uint8_t>& borderFlags = lockBorders ? lockedVertices : borderVertices;
+
+			ForEachEdge(
+				GetEdgeKeys(indices),
+				[&borderFlags](std::uint64_t edgeKey, bool isBorderEdge)
+				{
+					if (isBorderEdge)
+					{
+						borderFlags[static_cast<std::uint32_t>(edgeKey >> 32u)] = 1u;
+						borderFlags[static_cast<std::uint32_t>(edgeKey)]        = 1u;
+					}
+				}
+			);
+		}
+
+		{
+			// Sorting by the bits of the positions, so only the exact duplicates are found.
+			auto GetPositionKey = [vertices](std::uint32_t vertexIndex)
+			{
+				const DirectX::XMFLOAT3& position = vertices[vertexIndex].position;
+
+				return std::array<std::uint32_t, 3u>
+				{
+					std::bit_cast<std::uint32_t>(position.x),
+					std::bit_cast<std::uint32_t>(position.y),
+					std::bit_cast<std::uint32_t>(position.z)
+				};
+			};
+
+			const auto vertexCount = static_cast<std::uint32_t>(std::size(vertices));
+
+			std::vector<std::uint32_t> sortedVertices(vertexCount);
+
+			for (std::uint32_t index = 0u; index < vertexCount; ++index)
+				sortedVertices[index] = index;
+
+			std::ranges::sort(sortedVertices, {}, GetPositionKey);
+
+			for (std::uint32_t index = 1u; index < vertexCount; ++index)
+				if (GetPositionKey(sortedVertices[index])
+					== GetPositionKey(sortedVertices[index - 1u]))
+				{
+					lockedVertices[sortedVertices[index]]      = 1u;
+					lockedVertices[sortedVertices[index - 1u]] = 1u;
+				}
+		}
+	}
+
+	[[nodiscard]]
+	static std::vector<Quadric> GenerateQuadrics(
+		const std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices
+	) {
+		std::vector<Quadric> quadrics(std::size(vertices));
+
+		const size_t indexCount = std::size(indices);
+
+		for (size_t index = 0u; index < indexCount; index += 3u)
+		{
+			const std::uint32_t vertex0 = indices[index + 0u];
+			const std::uint32_t vertex1 = indices[index + 1u];
+			const std::uint32_t vertex2 = indices[index + 2u];
+
+			const DirectX::XMFLOAT3& position0 = vertices[vertex0].position;
+
+			const TriangleNormal normal = GetTriangleNormal(
+				position0, vertices[vertex1].position, vertices[vertex2].position
+			);
+
+			const double normalLength = std::sqrt(
+				normal.x * normal.x + normal.y * normal.y + normal.z * normal.z
+			);
+
+			// A degenerate triangle doesn't have a plane.
+			if (normalLength <= 0.0)
+				continue;
+
+			const double nX = normal.x / normalLength;
+			const double nY = normal.y / normalLength;
+			const double nZ = normal.z / normalLength;
+			const double d  = -(nX * position0.x + nY * position0.y + nZ * position0.z);
+
+			Quadric plane{};
+			plane.AddPlane(nX, nY, nZ, d);
+
+			quadrics[vertex0].Add(plane);
+			quadrics[vertex1].Add(plane);
+			quadrics[vertex2].Add(plane);
+		}
+
+		return quadrics;
+	}
+
+	// Adds a plane through each open border edge, perpendicular to its triangle, to the
+	// quadrics of the edge's vertices. So, moving a border vertex away from the border's
+	// outline costs as much as moving it off the surface.
+	static void AddBorderQuadrics(
+		const std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices,
+		std::vector<Quadric>& quadrics
+	) {
+		std::vector<std::uint64_t> borderEdgeKeys{};
+
+		ForEachEdge(
+			GetEdgeKeys(indices),
+			[&borderEdgeKeys](std::uint64_t edgeKey, bool isBorderEdge)
+			{
+				if (isBorderEdge)
+					borderEdgeKeys.emplace_back(edgeKey);
+			}
+		);
+
+		if (std::empty(borderEdgeKeys))
+			return;
+
+		const size_t indexCount = std::size(indices);
+
+		for (size_t index = 0u; index < indexCount; index += 3u)
+		{
+			std::uint32_t const* triangle = std::data(indices) + index;
+
+			const TriangleNormal normal = GetTriangleNormal(
+				vertices[triangle[0]].position, vertices[triangle[1]].position,
+				vertices[triangle[2]].position
+			);
+
+			for (size_t edgeIndex = 0u; edgeIndex < 3u; ++edgeIndex)
+			{
+				const std::uint32_t vertex0 = triangle[edgeIndex];
+				const std::uint32_t vertex1 = triangle[(edgeIndex + 1u) % 3u];
+
+				if (!std::ranges::binary_search(borderEdgeKeys, GetEdgeKey(vertex0, vertex1)))
+					continue;
+
+				const DirectX::XMFLOAT3& position0 = vertices[vertex0].position;
+				const DirectX::XMFLOAT3& position1 = vertices[vertex1].position;
+
+				const double edgeX = static_cast<double>(position1.x) - position0.x;
+				const double edgeY = static_cast<double>(position1.y) - position0.y;
+				const double edgeZ = static_cast<double>(position1.z) - position0.z;
+
+				const double planeX = edgeY * normal.z - edgeZ * normal.y;
+				const double planeY = edgeZ * normal.x - edgeX * normal.z;
+				const double planeZ = edgeX * normal.y - edgeY * normal.x;
+
+				const double planeLength = std::sqrt(
+					planeX * planeX + planeY * planeY + planeZ * planeZ
+				);
+
+				if (planeLength <= 0.0)
+					continue;
+
+				// Scaling the plane scales its squared distances with the square.
+				const double scale = std::sqrt(s_borderPlaneWeight) / planeLength;
+
+				const double nX = planeX * scale;
+				const double nY = planeY * scale;
+				const double nZ = planeZ * scale;
+				const double d  = -(nX * position0.x + nY * position0.y + nZ * position0.z);
+
+				Quadric plane{};
+				plane.AddPlane(nX, nY, nZ, d);
+
+				quadrics[vertex0].Add(plane);
+				quadrics[vertex1].Add(plane);
+			}
+		}
+	}
+
+	float Simplify(
+		std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices,
+		size_t targetIndexCount, float targetError, std::span<const std::uint8_t> lockedVertices,
+		const SimplificationOptions& options
+	) {
+		indices.resize(std::size(indices) / 3u * 3u);
+
+		const size_t vertexCount = std::size(vertices);
+
+		if (std::size(indices) <= targetIndexCount || vertexCount == 0u)
+			return 0.f;
+
+		std::vector<std::uint8_t> isVertexLocked(vertexCount, 0u);
+
+		std::ranges::copy(
+			lockedVertices.first(std::min(std::size(lockedVertices), vertexCount)),
+			std::begin(isVertexLocked)
+		);
+
+		std::vector<std::uint8_t> isVertexOnBorder(vertexCount, 0u);
+
+		LockBorderVertices(
+			indices, vertices, options.lockBorders, isVertexLocked, isVertexOnBorder
+		);
+
+		std::vector<Quadric> quadrics = GenerateQuadrics(indices, vertices);
+
+		if (!options.lockBorders)
+			AddBorderQuadrics(indices, vertices, quadrics);
+
+		const bool hasAttributes = options.normalWeight > 0.f || options.uvWeight > 0.f;
+
+		std::vector<AttributeQuadric> attributeQuadrics{};
+
+		if (hasAttributes)
+		{
+			attributeQuadrics.resize(vertexCount);
+
+			for (size_t index = 0u; index < vertexCount; ++index)
+				attributeQuadrics[index].AddAttributes(GetAttributes(vertices[index], options));
+		}
+
+		const size_t targetTriangleCount = targetIndexCount / 3u;
+		const double targetCost
+			= static_cast<double>(targetError) * static_cast<double>(targetError);
+
+		double resultCost = 0.0;
+
+		std::vector<std::uint32_t> remap(vertexCount);
+		// The vertices which have been collapsed or whose triangles have been changed in the
+		// current pass. Their collapse costs and flip checks are stale until the next pass.
+		std::vector<std::uint8_t> isVertexTouched(vertexCount, 0u);
+		std::vector<EdgeCollapse> collapses{};
+
+		// Every pass collapses a set of independent edges, the cheapest ones first, and then
+		// rebuilds the indices. So the adjacency and the costs only need to be generated once
+		// per pass.
+		while (std::size(indices) > targetIndexCount)
+		{
+			collapses.clear();
+
+			ForEachEdge(
+				GetEdgeKeys(indices),
+				[&](std::uint64_t edgeKey, bool isBorderEdge)
+				{
+					const auto vertex0 = static_cast<std::uint32_t>(edgeKey >> 32u);
+					const auto vertex1 = static_cast<std::uint32_t>(edgeKey);
+
+					// A border vertex can only be moved along its border, onto another
+					// border vertex.
+					auto CanMove = [&](std::uint32_t from, std::uint32_t to)
+					{
+						return !isVertexLocked[from]
+							&& (!isVertexOnBorder[from] || (isBorderEdge && isVertexOnBorder[to]));
+					};
+
+					const bool canMove0 = CanMove(vertex0, vertex1);
+					const bool canMove1 = CanMove(vertex1, vertex0);
+
+					if (!canMove0 && !canMove1)
+						return;
+
+					Quadric edgeQuadric = quadrics[vertex0];
+					edgeQuadric.Add(quadrics[vertex1]);
+
+					AttributeQuadric edgeAttributeQuadric{};
+
+					if (hasAttributes)
+					{
+						edgeAttributeQuadric = attributeQuadrics[vertex0];
+						edgeAttributeQuadric.Add(attributeQuadrics[vertex1]);
+					}
+
+					// The collapsed vertices take the position and the attributes of the
+					// vertex they are collapsed onto.
+					auto GetCollapse = [&](std::uint32_t from, std::uint32_t to)
+					{
+						const double positionCost = edgeQuadric.Evaluate(vertices[to].position);
+
+						double cost = positionCost;
+
+						if (hasAttributes)
+							cost += edgeAttributeQuadric.Evaluate(
+								GetAttributes(vertices[to], options)
+							);
+
+						return EdgeCollapse
+						{
+							.from = from, .to = to, .cost = cost, .positionCost = positionCost
+						};
+					};
+
+					if (!canMove1)
+						collapses.emplace_back(GetCollapse(vertex0, vertex1));
+					else if (!canMove0)
+						collapses.emplace_back(GetCollapse(vertex1, vertex0));
+					else
+						collapses.emplace_back(
+							std::min(
+								GetCollapse(vertex0, vertex1), GetCollapse(vertex1, vertex0),
+								[](const EdgeCollapse& collapse0, const EdgeCollapse& collapse1)
+								{
+									return collapse0.cost < collapse1.cost;
+								}
+							)
+						);
+				}
+			);
+
+			std::ranges::sort(collapses, {}, &EdgeCollapse::cost);
+
+			const size_t triangleCount = std::size(indices) / 3u;
+
+			// The vertex to triangle adjacency of the current indices.
+			std::vector<std::uint32_t> triangleOffsets(vertexCount + 1u, 0u);
+			std::vector<std::uint32_t> adjacentTriangles(std::size(indices));
+
+			for (const std::uint32_t vertexIndex : indices)
+				++triangleOffsets[vertexIndex + 1u];
+
+			for (size_t index = 0u; index < vertexCount; ++index)
+				triangleOffsets[index + 1u] += triangleOffsets[index];
+
+			{
+				std::vector<std::uint32_t> writeOffsets = triangleOffsets;
+
+				const size_t indexCount = std::size(indices);
+
+				for (size_t index = 0u; index < indexCount; ++index)
+					adjacentTriangles[writeOffsets[indices[index]]++]
+						= static_cast<std::uint32_t>(index / 3u);
+			}
+
+			for (size_t index = 0u; index < vertexCount; ++index)
+				remap[index] = static_cast<std::uint32_t>(index);
+
+			std::ranges::fill(isVertexTouched, std::uint8_t{ 0u });
+
+			size_t remainingTriangleCount = triangleCount;
+			size_t collapseCount          = 0u;
+
+			for (const EdgeCollapse& collapse : collapses)
+			{
+				if (remainingTriangleCount <= targetTriangleCount)
+					break;
+
+				if (collapse.positionCost > targetCost
+					|| isVertexTouched[collapse.from] || isVertexTouched[collapse.to])
+					continue;
+
+				const std::uint32_t adjacencyStart = triangleOffsets[collapse.from];
+				const std::uint32_t adjacencyEnd   = triangleOffsets[collapse.from + 1u];
+
+				// The collapse shouldn't flip any of the triangles which will remain.
+				bool doesFlip               = false;
+				size_t removedTriangleCount = 0u;
+
+				for (std::uint32_t index = adjacencyStart; index < adjacencyEnd; ++index)
+				{
+					std::uint32_t const* triangle
+						= std::data(indices) + adjacentTriangles[index] * 3u;
+
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to
+						|| triangle[2] == collapse.to)
+					{
+						++removedTriangleCount;
+
+						continue;
+					}
+
+					auto GetPosition = [&](std::uint32_t vertexIndex, bool isCollapsed)
+					{
+						const std::uint32_t positionIndex
+							= isCollapsed && vertexIndex == collapse.from ? collapse.to
+							: vertexIndex;
+
+						return vertices[positionIndex].position;
+					};
+
+					const TriangleNormal oldNormal = GetTriangleNormal(
+						GetPosition(triangle[0], false), GetPosition(triangle[1], false),
+						GetPosition(triangle[2], false)
+					);
+					const TriangleNormal newNormal = GetTriangleNormal(
+						GetPosition(triangle[0], true), GetPosition(triangle[1], true),
+						GetPosition(triangle[2], true)
+					);
+
+					const double normalDot = oldNormal.x * newNormal.x
+						+ oldNormal.y * newNormal.y + oldNormal.z * newNormal.z;
+
+					if (normalDot <= 0.0)
+					{
+						doesFlip = true;
+
+						break;
+					}
+				}
+
+				if (doesFlip)
+					continue;
+
+				remap[collapse.from] = collapse.to;
+
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+
+				if (hasAttributes)
+					attributeQuadrics[collapse.to].Add(attributeQuadrics[collapse.from]);
+
+				// The vertices of the changed triangles can't be collapsed in this pass, as
+				// their flip checks were done with the old triangles.
+				for (std::uint32_t index = adjacencyStart; index < adjacencyEnd; ++index)
+				{
+					std::uint32_t const* triangle
+						= std::data(indices) + adjacentTriangles[index] * 3u;
+
+					isVertexTouched[triangle[0]] = 1u;
+					isVertexTouched[triangle[1]] = 1u;
+					isVertexTouched[triangle[2]] = 1u;
+				}
+
+				resultCost = std::max(resultCost, collapse.positionCost);
+
+				remainingTriangleCount -= std::min(removedTriangleCount, remainingTriangleCount);
+				++collapseCount;
+			}
+
+			if (!collapseCount)
+				break;
+
+			// The collapsed vertices are only ever remapped once per pass, as the target
+			// vertices are touched and can't be collapsed themselves.
+			size_t writeIndex       = 0u;
+			const size_t indexCount = std::size(indices);
+
+			for (size_t index = 0u; index < indexCount; index += 3u)
+			{
+				const std::uint32_t vertex0 = remap[indices[index + 0u]];
+				const std::uint32_t vertex1 = remap[indices[index + 1u]];
+				const std::uint32_t vertex2 = remap[indices[index + 2u]];
+
+				if (vertex0 == vertex1 || vertex1 == vertex2 || vertex2 == vertex0)
+					continue;
+
+				indices[writeIndex + 0u] = vertex0;
+				indices[writeIndex + 1u] = vertex1;
+				indices[writeIndex + 2u] = vertex2;
+
+				writeIndex += 3u;
+			}
+
+			indices.resize(writeIndex);
+		}
+
+		return static_cast<float>(std::sqrt(resultCost));
+	}
+}
+}
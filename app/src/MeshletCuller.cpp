@@ -0,0 +1,338 @@
+#include <MeshletCuller.hpp>
+#include <array>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace Sol
+{
+namespace MeshletCuller
+{
+	using namespace DirectX;
+
+	// With the packed cone, a w of 1 means it is degenerate.
+	static constexpr std::uint8_t s_degenerateConeCutoff = 255u;
+
+	[[nodiscard]]
+	static std::array<XMFLOAT4, 6u> GetFrustumPlanes(const Frustum& frustum) noexcept
+	{
+		return {
+			frustum.leftP, frustum.rightP, frustum.bottomP, frustum.topP, frustum.nearP,
+			frustum.farP
+		};
+	}
+
+	// The spheres and the apex offsets are in the model space, so they need to be scaled
+	// by the largest scale of the model matrix.
+	[[nodiscard]]
+	static float GetLargestScale(const XMMATRIX& modelMatrix) noexcept
+	{
+		const XMVECTOR scaleSquared = XMVectorMax(
+			XMVector3LengthSq(modelMatrix.r[0]),
+			XMVectorMax(
+				XMVector3LengthSq(modelMatrix.r[1]), XMVector3LengthSq(modelMatrix.r[2])
+			)
+		);
+
+		return std::sqrt(XMVectorGetX(scaleSquared));
+	}
+
+	static void AddVisibleMeshlet(
+		std::vector<MeshletRange>& visibleRanges, size_t firstRange, std::uint32_t meshletIndex,
+		std::uint32_t modelIndex
+	) {
+		// Only the ranges which were added in the same call can be merged.
+		if (std::size(visibleRanges) > firstRange)
+		{
+			MeshletRange& lastRange = visibleRanges.back();
+
+			if (lastRange.meshletOffset + lastRange.meshletCount == meshletIndex)
+			{
+				++lastRange.meshletCount;
+
+				return;
+			}
+		}
+
+		visibleRanges.emplace_back(
+			MeshletRange{
+				.meshletOffset = meshletIndex, .meshletCount = 1u, .modelIndex = modelIndex
+			}
+		);
+	}
+
+	NormalCone UnpackNormalCone(const ClusterNormalCone& packedCone) noexcept
+	{
+		std::uint8_t values[4]{};
+
+		memcpy(values, &packedCone.packedCone, sizeof(std::uint32_t));
+
+		// The axis was stored as snorm8 and then biased to unsigned.
+		auto unpackAxis = [](std::uint8_t value)
+		{
+			return static_cast<float>(static_cast<std::int32_t>(value) - 128) / 127.f;
+		};
+
+		return NormalCone
+		{
+			.axis         = XMFLOAT3{
+				unpackAxis(values[0]), unpackAxis(values[1]), unpackAxis(values[2])
+			},
+			.cutoff       = static_cast<float>(values[3]) / 255.f,
+			.isDegenerate = values[3] == s_degenerateConeCutoff
+		};
+	}
+
+	bool IsMeshletVisible(
+		const MeshletDetails& meshletDetails, const XMMATRIX& modelMatrix,
+		const Frustum& frustum, const XMFLOAT3& cameraPosition
+	) noexcept {
+		const float scale = GetLargestScale(modelMatrix);
+
+		const XMFLOAT4& sphere = meshletDetails.sphereB.sphere;
+
+		const XMVECTOR centre = XMVector3Transform(
+			XMVectorSet(sphere.x, sphere.y, sphere.z, 1.f), modelMatrix
+		);
+		const float radius    = sphere.w * scale;
+
+		for (const XMFLOAT4& plane : GetFrustumPlanes(frustum))
+			if (XMVectorGetX(XMPlaneDotCoord(XMLoadFloat4(&plane), centre)) < -radius)
+				return false;
+
+		const NormalCone cone = UnpackNormalCone(meshletDetails.coneNormal);
+
+		if (cone.isDegenerate)
+			return true;
+
+		const XMVECTOR axis = XMVector3Normalize(
+			XMVector3TransformNormal(XMLoadFloat3(&cone.axis), modelMatrix)
+		);
+		const XMVECTOR apex = centre - axis * (meshletDetails.coneNormal.apexOffset * scale);
+		const XMVECTOR view = XMLoadFloat3(&cameraPosition) - apex;
+
+		// Same as normalising the view direction and checking if the dot is larger than the
+		// cutoff, but without the division.
+		return XMVectorGetX(XMVector3Dot(view, -axis))
+			<= cone.cutoff * XMVectorGetX(XMVector3Length(view));
+	}
+
+	// The model matrix and the view, with each element splatted to every lane.
+	struct CullingConstants
+	{
+		std::array<std::array<XMVECTOR, 4u>, 4u> modelMatrix;
+		std::array<std::array<XMVECTOR, 4u>, 6u> planes;
+		std::array<XMVECTOR, 3u>                 cameraPosition;
+		XMVECTOR                                 scale;
+	};
+
+	[[nodiscard]]
+	static CullingConstants GetCullingConstants(
+		const XMMATRIX& modelMatrix, const Frustum& frustum, const XMFLOAT3& cameraPosition
+	) noexcept {
+		CullingConstants constants
+		{
+			.cameraPosition = {
+				XMVectorReplicate(cameraPosition.x), XMVectorReplicate(cameraPosition.y),
+				XMVectorReplicate(cameraPosition.z)
+			},
+			.scale          = XMVectorReplicate(GetLargestScale(modelMatrix))
+		};
+
+		for (size_t row = 0u; row < 4u; ++row)
+		{
+			const XMVECTOR matrixRow = modelMatrix.r[row];
+
+			constants.modelMatrix[row] = {
+				XMVectorSplatX(matrixRow), XMVectorSplatY(matrixRow),
+				XMVectorSplatZ(matrixRow), XMVectorSplatW(matrixRow)
+			};
+		}
+
+		const std::array<XMFLOAT4, 6u> planes = GetFrustumPlanes(frustum);
+
+		for (size_t index = 0u; index < 6u; ++index)
+		{
+			const XMFLOAT4& plane = planes[index];
+
+			constants.planes[index] = {
+				XMVectorReplicate(plane.x), XMVectorReplicate(plane.y),
+				XMVectorReplicate(plane.z), XMVectorReplicate(plane.w)
+			};
+		}
+
+		return constants;
+	}
+
+	// Returns all bits set in the lanes of the visible meshlets. The unused lanes should have
+	// copies of a used lane.
+	[[nodiscard]]
+	static XMVECTOR GetVisibleMask(
+		const std::array<const MeshletDetails*, 4u>& meshletDetails,
+		const CullingConstants& constants
+	) noexcept {
+		const std::array<std::array<XMVECTOR, 4u>, 4u>& matrix = constants.modelMatrix;
+
+		// The transposed spheres have the centre's x, y, z and the radius in the rows.
+		const XMMATRIX spheres = XMMatrixTranspose(
+			XMMATRIX{
+				XMLoadFloat4(&meshletDetails[0]->sphereB.sphere),
+				XMLoadFloat4(&meshletDetails[1]->sphereB.sphere),
+				XMLoadFloat4(&meshletDetails[2]->sphereB.sphere),
+				XMLoadFloat4(&meshletDetails[3]->sphereB.sphere)
+			}
+		);
+
+		std::array<XMVECTOR, 3u> centre{};
+
+		for (size_t axis = 0u; axis < 3u; ++axis)
+		{
+			centre[axis] = XMVectorMultiplyAdd(spheres.r[0], matrix[0][axis], matrix[3][axis]);
+			centre[axis] = XMVectorMultiplyAdd(spheres.r[1], matrix[1][axis], centre[axis]);
+			centre[axis] = XMVectorMultiplyAdd(spheres.r[2], matrix[2][axis], centre[axis]);
+		}
+
+		const XMVECTOR negativeRadius = -(spheres.r[3] * constants.scale);
+
+		XMVECTOR isVisible = XMVectorTrueInt();
+
+		for (const std::array<XMVECTOR, 4u>& plane : constants.planes)
+		{
+			XMVECTOR distance = XMVectorMultiplyAdd(centre[0], plane[0], plane[3]);
+			distance          = XMVectorMultiplyAdd(centre[1], plane[1], distance);
+			distance          = XMVectorMultiplyAdd(centre[2], plane[2], distance);
+
+			isVisible = XMVectorAndCInt(isVisible, XMVectorLess(distance, negativeRadius));
+		}
+
+		// The transposed cones have the axis's x, y, z and the cutoff in the rows.
+		std::array<XMFLOAT4, 4u> unpackedCones{};
+		std::array<float, 4u> apexOffsets{};
+		std::array<std::uint32_t, 4u> isCullable{};
+
+		for (size_t index = 0u; index < 4u; ++index)
+		{
+			const NormalCone cone = UnpackNormalCone(meshletDetails[index]->coneNormal);
+
+			unpackedCones[index] = XMFLOAT4{
+				cone.axis.x, cone.axis.y, cone.axis.z, cone.cutoff
+			};
+			apexOffsets[index]   = meshletDetails[index]->coneNormal.apexOffset;
+			isCullable[index]    = cone.isDegenerate ? 0u : 0xFFFFFFFFu;
+		}
+
+		const XMMATRIX cones = XMMatrixTranspose(
+			XMMATRIX{
+				XMLoadFloat4(&unpackedCones[0]), XMLoadFloat4(&unpackedCones[1]),
+				XMLoadFloat4(&unpackedCones[2]), XMLoadFloat4(&unpackedCones[3])
+			}
+		);
+
+		std::array<XMVECTOR, 3u> coneAxis{};
+
+		for (size_t axis = 0u; axis < 3u; ++axis)
+		{
+			coneAxis[axis] = XMVectorMultiply(cones.r[0], matrix[0][axis]);
+			coneAxis[axis] = XMVectorMultiplyAdd(cones.r[1], matrix[1][axis], coneAxis[axis]);
+			coneAxis[axis] = XMVectorMultiplyAdd(cones.r[2], matrix[2][axis], coneAxis[axis]);
+		}
+
+		{
+			XMVECTOR axisLengthSq = XMVectorMultiply(coneAxis[0], coneAxis[0]);
+			axisLengthSq          = XMVectorMultiplyAdd(coneAxis[1], coneAxis[1], axisLengthSq);
+			axisLengthSq          = XMVectorMultiplyAdd(coneAxis[2], coneAxis[2], axisLengthSq);
+
+			const XMVECTOR inverseAxisLength = XMVectorReciprocal(XMVectorSqrt(axisLengthSq));
+
+			for (XMVECTOR& axisComponent : coneAxis)
+				axisComponent = XMVectorMultiply(axisComponent, inverseAxisLength);
+		}
+
+		const XMVECTOR apexOffset = XMVectorMultiply(
+			XMVectorSet(apexOffsets[0], apexOffsets[1], apexOffsets[2], apexOffsets[3]),
+			constants.scale
+		);
+
+		XMVECTOR viewLengthSq = XMVectorZero();
+		XMVECTOR viewDot      = XMVectorZero();
+
+		for (size_t axis = 0u; axis < 3u; ++axis)
+		{
+			const XMVECTOR apex = XMVectorNegativeMultiplySubtract(
+				coneAxis[axis], apexOffset, centre[axis]
+			);
+			const XMVECTOR view = XMVectorSubtract(constants.cameraPosition[axis], apex);
+
+			viewLengthSq = XMVectorMultiplyAdd(view, view, viewLengthSq);
+			viewDot      = XMVectorNegativeMultiplySubtract(view, coneAxis[axis], viewDot);
+		}
+
+		const XMVECTOR isBackfacing = XMVectorGreater(
+			viewDot, XMVectorMultiply(cones.r[3], XMVectorSqrt(viewLengthSq))
+		);
+
+		return XMVectorAndCInt(
+			isVisible, XMVectorAndInt(isBackfacing, XMLoadInt4(std::data(isCullable)))
+		);
+	}
+
+	void CullMeshlets(
+		std::span<const MeshletDetails> meshletDetails, const XMMATRIX& modelMatrix,
+		const Frustum& frustum, const XMFLOAT3& cameraPosition, std::uint32_t meshletOffset,
+		std::vector<MeshletRange>& visibleRanges, std::uint32_t modelIndex
+	) {
+		const size_t meshletCount = std::size(meshletDetails);
+
+		if (!meshletCount)
+			return;
+
+		const CullingConstants constants = GetCullingConstants(
+			modelMatrix, frustum, cameraPosition
+		);
+
+		const size_t firstRange = std::size(visibleRanges);
+
+		for (size_t batchStart = 0u; batchStart < meshletCount; batchStart += 4u)
+		{
+			const size_t batchCount = std::min(meshletCount - batchStart, size_t{ 4u });
+
+			// The unused lanes are filled with the last meshlet.
+			std::array<const MeshletDetails*, 4u> batch{};
+
+			for (size_t index = 0u; index < 4u; ++index)
+				batch[index] = &meshletDetails[batchStart + std::min(index, batchCount - 1u)];
+
+			std::array<std::uint32_t, 4u> visibleMask{};
+
+			XMStoreInt4(std::data(visibleMask), GetVisibleMask(batch, constants));
+
+			for (size_t index = 0u; index < batchCount; ++index)
+				if (visibleMask[index])
+					AddVisibleMeshlet(
+						visibleRanges, firstRange,
+						meshletOffset + static_cast<std::uint32_t>(batchStart + index),
+						modelIndex
+					);
+		}
+	}
+
+	void CullMeshlets(
+		std::span<const MeshletDetails> bundleMeshletDetails,
+		std::span<const MeshletCullingModel> models, const Frustum& frustum,
+		const XMFLOAT3& cameraPosition, std::vector<MeshletRange>& visibleRanges
+	) {
+		const size_t modelCount = std::size(models);
+
+		for (size_t index = 0u; index < modelCount; ++index)
+		{
+			const MeshletCullingModel& model = models[index];
+
+			CullMeshlets(
+				bundleMeshletDetails.subspan(model.meshletOffset, model.meshletCount),
+				model.modelMatrix, frustum, cameraPosition, model.meshletOffset, visibleRanges,
+				static_cast<std::uint32_t>(index)
+			);
+		}
+	}
+}
+}
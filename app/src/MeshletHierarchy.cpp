@@ -0,0 +1,600 @@
+#include <MeshletHierarchy.hpp>
+#include <MeshletMaker.hpp>
+#include <MeshSimplifier.hpp>
+#include <MeshBoundImpl.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace Sol
+{
+// The number of meshlets which are simplified together. Half of the triangles of a group are
+// removed, so a group of four makes about two parents, and the meshlet count of the levels
+// roughly halves.
+static constexpr size_t s_groupMeshletCount = 4u;
+// If a group can't be simplified below this ratio of its triangles, because most of its
+// vertices are locked, its meshlets aren't simplified any further.
+static constexpr float s_stuckReductionRatio = 0.85f;
+static constexpr std::uint32_t s_maxLevelCount = 32u;
+
+static constexpr auto s_invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+[[nodiscard]]
+static std::uint64_t GetPairKey(std::uint32_t first, std::uint32_t second) noexcept
+{
+	return static_cast<std::uint64_t>(first) << 32u | second;
+}
+
+// Maps each vertex to the first vertex with the same position, so the meshlets which are
+// split by the UV seams are still neighbours.
+[[nodiscard]]
+static std::vector<std::uint32_t> GeneratePositionRemap(const std::vector<Vertex>& vertices)
+{
+	auto GetPositionKey = [&vertices](std::uint32_t vertexIndex)
+	{
+		const DirectX::XMFLOAT3& position = vertices[vertexIndex].position;
+
+		return std::array<std::uint32_t, 3u>
+		{
+			std::bit_cast<std::uint32_t>(position.x),
+			std::bit_cast<std::uint32_t>(position.y),
+			std::bit_cast<std::uint32_t>(position.z)
+		};
+	};
+
+	const auto vertexCount = static_cast<std::uint32_t>(std::size(vertices));
+
+	std::vector<std::uint32_t> sortedVertices(vertexCount);
+
+	for (std::uint32_t index = 0u; index < vertexCount; ++index)
+		sortedVertices[index] = index;
+
+	std::ranges::stable_sort(sortedVertices, {}, GetPositionKey);
+
+	std::vector<std::uint32_t> positionRemap(vertexCount);
+
+	for (std::uint32_t index = 0u; index < vertexCount; ++index)
+	{
+		const std::uint32_t vertexIndex = sortedVertices[index];
+
+		if (index && GetPositionKey(sortedVertices[index - 1u]) == GetPositionKey(vertexIndex))
+			positionRemap[vertexIndex] = positionRemap[sortedVertices[index - 1u]];
+		else
+			positionRemap[vertexIndex] = vertexIndex;
+	}
+
+	return positionRemap;
+}
+
+// The unique remapped vertices of a meshlet, sorted.
+[[nodiscard]]
+static std::vector<std::uint32_t> GetMeshletPositions(
+	const MeshletHierarchy& hierarchy, std::uint32_t meshletIndex,
+	const std::vector<std::uint32_t>& positionRemap
+) {
+	const Meshlet& meshlet = hierarchy.meshletDetails[meshletIndex].meshlet;
+
+	std::vector<std::uint32_t> positions{};
+	positions.reserve(meshlet.indexCount);
+
+	for (size_t index = 0u; index < meshlet.indexCount; ++index)
+		positions.emplace_back(
+			positionRemap[hierarchy.vertexIndices[meshlet.indexOffset + index]]
+		);
+
+	std::ranges::sort(positions);
+
+	positions.erase(std::ranges::unique(positions).begin(), std::end(positions));
+
+	return positions;
+}
+
+// Groups the meshlets with the neighbours they share the most vertices with. The returned
+// indices are into the levelMeshlets.
+[[nodiscard]]
+static std::vector<std::vector<std::uint32_t>> GroupMeshlets(
+	const std::vector<std::vector<std::uint32_t>>& meshletPositions
+) {
+	const auto meshletCount = static_cast<std::uint32_t>(std::size(meshletPositions));
+
+	// The pairs of the meshlets which share a position. The number of the times a pair
+	// exists is the number of the positions they share.
+	std::vector<std::uint64_t> meshletPairs{};
+
+	{
+		std::vector<std::uint64_t> positionMeshlets{};
+
+		for (std::uint32_t index = 0u; index < meshletCount; ++index)
+			for (const std::uint32_t position : meshletPositions[index])
+				positionMeshlets.emplace_back(GetPairKey(position, index));
+
+		std::ranges::sort(positionMeshlets);
+
+		const size_t positionMeshletCount = std::size(positionMeshlets);
+
+		for (size_t index = 0u; index < positionMeshletCount;)
+		{
+			size_t runEnd = index + 1u;
+
+			while (runEnd < positionMeshletCount
+				&& positionMeshlets[runEnd] >> 32u == positionMeshlets[index] >> 32u)
+				++runEnd;
+
+			for (size_t index1 = index; index1 < runEnd; ++index1)
+				for (size_t index2 = index1 + 1u; index2 < runEnd; ++index2)
+				{
+					const auto meshlet1 = static_cast<std::uint32_t>(positionMeshlets[index1]);
+					const auto meshlet2 = static_cast<std::uint32_t>(positionMeshlets[index2]);
+
+					meshletPairs.emplace_back(GetPairKey(meshlet1, meshlet2));
+					meshletPairs.emplace_back(GetPairKey(meshlet2, meshlet1));
+				}
+
+			index = runEnd;
+		}
+	}
+
+	std::ranges::sort(meshletPairs);
+
+	struct MeshletNeighbour
+	{
+		std::uint32_t meshletIndex;
+		std::uint32_t sharedPositionCount;
+	};
+
+	// The neighbours of a meshlet are stored contiguously, as the pairs are sorted by the
+	// first meshlet.
+	std::vector<std::uint32_t> neighbourOffsets(meshletCount + 1u, 0u);
+	std::vector<MeshletNeighbour> neighbours{};
+
+	{
+		const size_t meshletPairCount = std::size(meshletPairs);
+
+		for (size_t index = 0u; index < meshletPairCount;)
+		{
+			size_t runEnd = index + 1u;
+
+			while (runEnd < meshletPairCount && meshletPairs[runEnd] == meshletPairs[index])
+				++runEnd;
+
+			const auto meshlet1 = static_cast<std::uint32_t>(meshletPairs[index] >> 32u);
+
+			neighbours.emplace_back(
+				MeshletNeighbour
+				{
+					.meshletIndex        = static_cast<std::uint32_t>(meshletPairs[index]),
+					.sharedPositionCount = static_cast<std::uint32_t>(runEnd - index)
+				}
+			);
+
+			++neighbourOffsets[meshlet1 + 1u];
+
+			index = runEnd;
+		}
+
+		for (std::uint32_t index = 0u; index < meshletCount; ++index)
+			neighbourOffsets[index + 1u] += neighbourOffsets[index];
+	}
+
+	std::vector<std::uint8_t> isMeshletGrouped(meshletCount, 0u);
+	std::vector<std::vector<std::uint32_t>> groups{};
+
+	// The spatial builder makes the meshlets next to each other one after another, so the
+	// groups are started in the meshlet order.
+	for (std::uint32_t index = 0u; index < meshletCount; ++index)
+	{
+		if (isMeshletGrouped[index])
+			continue;
+
+		std::vector<std::uint32_t>& group = groups.emplace_back();
+
+		group.emplace_back(index);
+		isMeshletGrouped[index] = 1u;
+
+		while (std::size(group) < s_groupMeshletCount)
+		{
+			std::uint32_t bestNeighbour   = s_invalidIndex;
+			std::uint32_t bestSharedCount = 0u;
+
+			for (const std::uint32_t groupMeshlet : group)
+				for (std::uint32_t index1 = neighbourOffsets[groupMeshlet];
+					index1 < neighbourOffsets[groupMeshlet + 1u]; ++index1)
+				{
+					const MeshletNeighbour& neighbour = neighbours[index1];
+
+					if (!isMeshletGrouped[neighbour.meshletIndex]
+						&& neighbour.sharedPositionCount > bestSharedCount)
+					{
+						bestNeighbour   = neighbour.meshletIndex;
+						bestSharedCount = neighbour.sharedPositionCount;
+					}
+				}
+
+			if (bestNeighbour == s_invalidIndex)
+				break;
+
+			group.emplace_back(bestNeighbour);
+			isMeshletGrouped[bestNeighbour] = 1u;
+		}
+	}
+
+	return groups;
+}
+
+// Makes the meshlets of the indices and adds them with their bounds to the hierarchy. The
+// indices of the mesh are local to its vertices, and the vertexRemap maps them to the
+// vertices of the hierarchy's mesh. An empty remap means they are the same.
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+static void AddMeshlets(
+	const Mesh& mesh, const std::vector<std::uint32_t>& vertexRemap,
+	const std::vector<Vertex>& hierarchyVertices, SphereBVAlgorithm sphereBVAlgorithm,
+	NormalConeAlgorithm normalConeAlgorithm, MeshletHierarchy& hierarchy
+) {
+	const auto indexOffset     = static_cast<std::uint32_t>(std::size(hierarchy.vertexIndices));
+	const auto primitiveOffset = static_cast<std::uint32_t>(std::size(hierarchy.primIndices));
+	const size_t meshletOffset = std::size(hierarchy.meshletDetails);
+
+	{
+		MeshletStreamMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{
+			hierarchy.vertexIndices, hierarchy.primIndices, hierarchy.meshletDetails,
+			MeshletBuildMode::Spatial
+		};
+
+		meshletMaker.GenerateMeshlets(
+			MeshletTriangleView{ mesh.indices }, std::data(mesh.vertices)
+		);
+	}
+
+	std::span<std::uint32_t> newVertexIndices
+		= std::span{ hierarchy.vertexIndices }.subspan(indexOffset);
+	std::span<MeshletDetails> newMeshletDetails
+		= std::span{ hierarchy.meshletDetails }.subspan(meshletOffset);
+
+	if (!std::empty(vertexRemap))
+		for (std::uint32_t& vertexIndex : newVertexIndices)
+			vertexIndex = vertexRemap[vertexIndex];
+
+	// The offsets of the hierarchy's meshlets are relative to the start of the containers
+	// instead of the mesh.
+	for (MeshletDetails& meshletDetail : newMeshletDetails)
+	{
+		meshletDetail.meshlet.indexOffset     += indexOffset;
+		meshletDetail.meshlet.primitiveOffset += primitiveOffset;
+
+		meshletDetail.sphereB = GenerateSphereBV(
+			hierarchyVertices, hierarchy.vertexIndices, meshletDetail.meshlet, sphereBVAlgorithm
+		);
+
+		meshletDetail.coneNormal = GenerateNormalCone(
+			hierarchyVertices, hierarchy.vertexIndices, hierarchy.primIndices, meshletDetail,
+			normalConeAlgorithm
+		);
+	}
+}
+
+[[nodiscard]]
+static float ProjectError(
+	float error, const SphereBoundingVolume& bounds, const DirectX::XMFLOAT3& viewPosition
+) noexcept {
+	using namespace DirectX;
+
+	if (error <= 0.f)
+		return 0.f;
+
+	const float distance = XMVectorGetX(
+		XMVector3Length(XMLoadFloat4(&bounds.sphere) - XMLoadFloat3(&viewPosition))
+	) - bounds.sphere.w;
+
+	// Inside the bounds, any error is too large.
+	if (distance <= 0.f)
+		return std::numeric_limits<float>::max();
+
+	return error / distance;
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+static void BuildMeshletHierarchy(
+	const Mesh& mesh, SphereBVAlgorithm sphereBVAlgorithm, NormalConeAlgorithm normalConeAlgorithm,
+	MeshletHierarchy& hierarchy
+) {
+	const std::vector<Vertex>& vertices = mesh.vertices;
+
+	const size_t vertexCount = std::size(vertices);
+
+	AddMeshlets<vertexLimit_t, primitiveLimit_t>(
+		mesh, {}, vertices, sphereBVAlgorithm, normalConeAlgorithm, hierarchy
+	);
+
+	const auto firstLevelMeshletCount
+		= static_cast<std::uint32_t>(std::size(hierarchy.meshletDetails));
+
+	hierarchy.firstLevelMeshletCount = firstLevelMeshletCount;
+	hierarchy.levelCount             = 1u;
+
+	hierarchy.lodDetails.reserve(firstLevelMeshletCount * 2u);
+
+	for (const MeshletDetails& meshletDetail : hierarchy.meshletDetails)
+		hierarchy.lodDetails.emplace_back(
+			MeshletLodDetails
+			{
+				.lodBounds       = meshletDetail.sphereB,
+				.error           = 0.f,
+				.parentLodBounds = meshletDetail.sphereB,
+				.parentError     = std::numeric_limits<float>::max(),
+				.parentOffset    = 0u,
+				.parentCount     = 0u,
+				.childOffset     = 0u,
+				.childCount      = 0u,
+				.level           = 0u
+			}
+		);
+
+	const std::vector<std::uint32_t> positionRemap = GeneratePositionRemap(vertices);
+
+	// The vertex to local vertex map of a group. Reset after each group, so the cost of a
+	// group only depends on its size.
+	std::vector<std::uint32_t> localVertexIndices(vertexCount, s_invalidIndex);
+	// The group which uses a position, or the sharedPosition if there are multiple.
+	std::vector<std::uint32_t> positionGroups(vertexCount, s_invalidIndex);
+
+	constexpr std::uint32_t sharedPosition = s_invalidIndex - 1u;
+
+	std::vector<std::uint32_t> levelMeshlets(firstLevelMeshletCount);
+
+	for (std::uint32_t index = 0u; index < firstLevelMeshletCount; ++index)
+		levelMeshlets[index] = index;
+
+	for (std::uint32_t level = 1u; level < s_maxLevelCount && std::size(levelMeshlets) > 1u;
+		++level)
+	{
+		std::vector<std::vector<std::uint32_t>> meshletPositions{};
+		meshletPositions.reserve(std::size(levelMeshlets));
+
+		for (const std::uint32_t meshletIndex : levelMeshlets)
+			meshletPositions.emplace_back(
+				GetMeshletPositions(hierarchy, meshletIndex, positionRemap)
+			);
+
+		const std::vector<std::vector<std::uint32_t>> groups = GroupMeshlets(meshletPositions);
+
+		const auto groupCount = static_cast<std::uint32_t>(std::size(groups));
+
+		// The positions which are used by multiple groups are on the borders of the groups
+		// and must be locked, so the neighbouring groups still fit together.
+		for (std::uint32_t groupIndex = 0u; groupIndex < groupCount; ++groupIndex)
+			for (const std::uint32_t groupMeshlet : groups[groupIndex])
+				for (const std::uint32_t position : meshletPositions[groupMeshlet])
+				{
+					std::uint32_t& positionGroup = positionGroups[position];
+
+					if (positionGroup == s_invalidIndex)
+						positionGroup = groupIndex;
+					else if (positionGroup != groupIndex)
+						positionGroup = sharedPosition;
+				}
+
+		std::vector<std::uint32_t> nextLevelMeshlets{};
+
+		bool isAnyGroupSimplified = false;
+
+		for (const std::vector<std::uint32_t>& group : groups)
+		{
+			Mesh groupMesh{};
+			// The local vertex to vertex map.
+			std::vector<std::uint32_t> groupVertices{};
+			std::vector<std::uint8_t> lockedVertices{};
+
+			float childError = 0.f;
+
+			for (const std::uint32_t groupMeshlet : group)
+			{
+				const std::uint32_t meshletIndex = levelMeshlets[groupMeshlet];
+				const Meshlet& meshlet           = hierarchy.meshletDetails[meshletIndex].meshlet;
+
+				childError = std::max(childError, hierarchy.lodDetails[meshletIndex].error);
+
+				for (size_t index = 0u; index < meshlet.primitiveCount; ++index)
+				{
+					const PrimitiveIndicesUnpacked unpackedPrim = UnpackPrim(
+						hierarchy.primIndices[meshlet.primitiveOffset + index]
+					);
+
+					const std::array<std::uint32_t, 3u> primVertices
+					{
+						unpackedPrim.firstIndex, unpackedPrim.secondIndex,
+						unpackedPrim.thirdIndex
+					};
+
+					for (const std::uint32_t primVertex : primVertices)
+					{
+						const std::uint32_t vertexIndex
+							= hierarchy.vertexIndices[meshlet.indexOffset + primVertex];
+
+						std::uint32_t& localVertexIndex = localVertexIndices[vertexIndex];
+
+						if (localVertexIndex == s_invalidIndex)
+						{
+							localVertexIndex = static_cast<std::uint32_t>(
+								std::size(groupVertices)
+							);
+
+							groupVertices.emplace_back(vertexIndex);
+							groupMesh.vertices.emplace_back(vertices[vertexIndex]);
+							lockedVertices.emplace_back(
+								positionGroups[positionRemap[vertexIndex]] == sharedPosition
+							);
+						}
+
+						groupMesh.indices.emplace_back(localVertexIndex);
+					}
+				}
+			}
+
+			for (const std::uint32_t vertexIndex : groupVertices)
+				localVertexIndices[vertexIndex] = s_invalidIndex;
+
+			const size_t groupIndexCount = std::size(groupMesh.indices);
+
+			const float simplificationError = MeshSimplifier::Simplify(
+				groupMesh.indices, groupMesh.vertices, groupIndexCount / 6u * 3u,
+				std::numeric_limits<float>::max(), lockedVertices
+			);
+
+			const size_t simplifiedIndexCount = std::size(groupMesh.indices);
+
+			// The meshlets of a stuck group are carried into the next level, so their
+			// positions still lock the borders of their neighbours there, and they can be
+			// grouped with other meshlets.
+			if (simplifiedIndexCount == 0u
+				|| static_cast<float>(simplifiedIndexCount)
+					> static_cast<float>(groupIndexCount) * s_stuckReductionRatio)
+			{
+				for (const std::uint32_t groupMeshlet : group)
+					nextLevelMeshlets.emplace_back(levelMeshlets[groupMeshlet]);
+
+				continue;
+			}
+
+			isAnyGroupSimplified = true;
+
+			// The errors and the bounds must grow up the hierarchy. So, the group's error
+			// includes its children's and its bounds enclose theirs.
+			const float groupError = childError + simplificationError;
+
+			SphereBoundingVolume groupBounds{};
+
+			{
+				using namespace DirectX;
+
+				XMVECTOR centreSum = XMVectorZero();
+
+				for (const std::uint32_t groupMeshlet : group)
+					centreSum += XMLoadFloat4(
+						&hierarchy.lodDetails[levelMeshlets[groupMeshlet]].lodBounds.sphere
+					);
+
+				XMFLOAT3 groupCentre{};
+				XMStoreFloat3(&groupCentre, centreSum / static_cast<float>(std::size(group)));
+
+				SphereBVGenerator sphereBVGen{};
+
+				sphereBVGen.SetCentre(groupCentre);
+
+				for (const std::uint32_t groupMeshlet : group)
+					sphereBVGen.ProcessSphere(
+						hierarchy.lodDetails[levelMeshlets[groupMeshlet]].lodBounds
+					);
+
+				groupBounds = sphereBVGen.GenerateBV();
+			}
+
+			const auto parentOffset
+				= static_cast<std::uint32_t>(std::size(hierarchy.meshletDetails));
+
+			AddMeshlets<vertexLimit_t, primitiveLimit_t>(
+				groupMesh, groupVertices, vertices, sphereBVAlgorithm, normalConeAlgorithm,
+				hierarchy
+			);
+
+			const auto parentCount = static_cast<std::uint32_t>(
+				std::size(hierarchy.meshletDetails) - parentOffset
+			);
+
+			const auto childOffset
+				= static_cast<std::uint32_t>(std::size(hierarchy.childMeshletIndices));
+
+			for (const std::uint32_t groupMeshlet : group)
+			{
+				const std::uint32_t meshletIndex = levelMeshlets[groupMeshlet];
+
+				MeshletLodDetails& childLodDetails = hierarchy.lodDetails[meshletIndex];
+
+				childLodDetails.parentLodBounds = groupBounds;
+				childLodDetails.parentError     = groupError;
+				childLodDetails.parentOffset    = parentOffset;
+				childLodDetails.parentCount     = parentCount;
+
+				hierarchy.childMeshletIndices.emplace_back(meshletIndex);
+			}
+
+			for (std::uint32_t index = 0u; index < parentCount; ++index)
+			{
+				hierarchy.lodDetails.emplace_back(
+					MeshletLodDetails
+					{
+						.lodBounds       = groupBounds,
+						.error           = groupError,
+						.parentLodBounds = groupBounds,
+						.parentError     = std::numeric_limits<float>::max(),
+						.parentOffset    = 0u,
+						.parentCount     = 0u,
+						.childOffset     = childOffset,
+						.childCount      = static_cast<std::uint32_t>(std::size(group)),
+						.level           = level
+					}
+				);
+
+				nextLevelMeshlets.emplace_back(parentOffset + index);
+			}
+		}
+
+		for (const std::vector<std::uint32_t>& positions : meshletPositions)
+			for (const std::uint32_t position : positions)
+				positionGroups[position] = s_invalidIndex;
+
+		// Every group was stuck, so the next level would be the same.
+		if (!isAnyGroupSimplified)
+			break;
+
+		hierarchy.levelCount = level + 1u;
+
+		levelMeshlets = std::move(nextLevelMeshlets);
+	}
+}
+
+MeshletHierarchy GenerateMeshletHierarchy(
+	const Mesh& mesh, MeshletLimitsType limitsType, SphereBVAlgorithm sphereBVAlgorithm,
+	NormalConeAlgorithm normalConeAlgorithm
+) {
+	MeshletHierarchy hierarchy{};
+
+	VisitMeshletLimits(
+		limitsType,
+		[&mesh, sphereBVAlgorithm, normalConeAlgorithm, &hierarchy]
+		<size_t vertexLimit_t, size_t primitiveLimit_t>
+		(MeshletLimits<vertexLimit_t, primitiveLimit_t>)
+		{
+			BuildMeshletHierarchy<vertexLimit_t, primitiveLimit_t>(
+				mesh, sphereBVAlgorithm, normalConeAlgorithm, hierarchy
+			);
+		}
+	);
+
+	return hierarchy;
+}
+
+void SelectMeshlets(
+	const MeshletHierarchy& hierarchy, const DirectX::XMFLOAT3& viewPosition,
+	float errorThreshold, std::vector<std::uint32_t>& selectedMeshlets
+) {
+	const auto meshletCount = static_cast<std::uint32_t>(std::size(hierarchy.lodDetails));
+
+	for (std::uint32_t index = 0u; index < meshletCount; ++index)
+	{
+		const MeshletLodDetails& lodDetails = hierarchy.lodDetails[index];
+
+		const float error       = ProjectError(
+			lodDetails.error, lodDetails.lodBounds, viewPosition
+		);
+		const float parentError = ProjectError(
+			lodDetails.parentError, lodDetails.parentLodBounds, viewPosition
+		);
+
+		if (error <= errorThreshold && parentError > errorThreshold)
+			selectedMeshlets.emplace_back(index);
+	}
+}
+}
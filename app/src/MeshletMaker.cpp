@@ -1,36 +1,155 @@
 #include <MeshletMaker.hpp>
+#include <ConversionUtilities.hpp>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
 
 namespace Sol
 {
+static_assert(
+	sizeof(PrimitiveIndicesUnpacked) == sizeof(std::uint32_t),
+	"The size of Primitive Indices Unpacked and U32 should be the same."
+);
+
+// The first index is in the lowest bits, like the bit-field. The bits above the third index
+// aren't a part of the bit-field, so they would be uninitialised if it were copied.
+std::uint32_t PackPrim(const PrimitiveIndicesUnpacked& unpackedIndices) noexcept
+{
+	return unpackedIndices.firstIndex
+		| (unpackedIndices.secondIndex << s_primIndexBitCount)
+		| (unpackedIndices.thirdIndex << (s_primIndexBitCount * 2u));
+}
+
+PrimitiveIndicesUnpacked UnpackPrim(std::uint32_t packedIndices) noexcept
+{
+	constexpr std::uint32_t indexMask = (1u << s_primIndexBitCount) - 1u;
+
+	return PrimitiveIndicesUnpacked
+	{
+		.firstIndex  = packedIndices & indexMask,
+		.secondIndex = (packedIndices >> s_primIndexBitCount) & indexMask,
+		.thirdIndex  = (packedIndices >> (s_primIndexBitCount * 2u)) & indexMask
+	};
+}
+
+// Reserving the exact size for every meshlet or mesh would reallocate the containers each
+// time, as they are appended to. So, they should still grow geometrically.
+template<typename T>
+static void ReserveAdditional(std::vector<T>& elements, size_t additionalCount) noexcept
+{
+	const size_t requiredCount = std::size(elements) + additionalCount;
+
+	if (requiredCount > elements.capacity())
+		elements.reserve(std::max(requiredCount, elements.capacity() * 2u));
+}
+
+size_t GetMeshletCountUpperBound(size_t triangleCount, MeshletLimitsType limitsType) noexcept
+{
+	const size_t minimumTriangleCount = VisitMeshletLimits(
+		limitsType,
+		[]<typename Limits_t>(Limits_t)
+		{
+			return std::min(Limits_t::s_primitiveLimit, Limits_t::s_vertexLimit / 3u);
+		}
+	);
+
+	return triangleCount / minimumTriangleCount + 1u;
+}
+
+// Meshlet Triangle View
+MeshletTriangleView::MeshletTriangleView(std::span<const std::uint32_t> indices) noexcept
+	: m_source{ std::data(indices) }, m_triangleCount{ std::size(indices) / 3u },
+	m_sourceType{ SourceType::Index32 }
+{}
+
+MeshletTriangleView::MeshletTriangleView(std::span<const std::uint16_t> indices) noexcept
+	: m_source{ std::data(indices) }, m_triangleCount{ std::size(indices) / 3u },
+	m_sourceType{ SourceType::Index16 }
+{}
+
+MeshletTriangleView::MeshletTriangleView(std::span<const std::uint8_t> indices) noexcept
+	: m_source{ std::data(indices) }, m_triangleCount{ std::size(indices) / 3u },
+	m_sourceType{ SourceType::Index8 }
+{}
+
+MeshletTriangleView::MeshletTriangleView(aiFace const* faces, size_t faceCount) noexcept
+	: m_source{ faces }, m_triangleCount{ faceCount }, m_sourceType{ SourceType::Face }
+{}
+
+template<typename T>
+[[nodiscard]]
+static MeshletPrimTriangle GetIndexTriangle(void const* source, size_t triangleIndex) noexcept
+{
+	T const* indices = static_cast<T const*>(source) + triangleIndex * 3u;
+
+	return MeshletPrimTriangle
+	{
+		.vertex0 = indices[0],
+		.vertex1 = indices[1],
+		.vertex2 = indices[2]
+	};
+}
+
+MeshletPrimTriangle MeshletTriangleView::GetTriangle(size_t triangleIndex) const noexcept
+{
+	// A view only ever has a single source type, so the branch is always predicted.
+	switch (m_sourceType)
+	{
+	case SourceType::Index16:
+		return GetIndexTriangle<std::uint16_t>(m_source, triangleIndex);
+	case SourceType::Index8:
+		return GetIndexTriangle<std::uint8_t>(m_source, triangleIndex);
+	case SourceType::Face:
+	{
+		const aiFace& face = static_cast<aiFace const*>(m_source)[triangleIndex];
+
+		return MeshletPrimTriangle
+		{
+			.vertex0 = face.mIndices[0],
+			.vertex1 = face.mIndices[1],
+			.vertex2 = face.mIndices[2]
+		};
+	}
+	default:
+		return GetIndexTriangle<std::uint32_t>(m_source, triangleIndex);
+	}
+}
+
 // Meshlet Generator
-MeshletGenerator::MeshletGenerator(
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+MeshletGenerator<vertexLimit_t, primitiveLimit_t>::MeshletGenerator(
 	std::vector<std::uint32_t>& vertexIndices,
 	std::vector<std::uint32_t>& primitiveIndices
 ) : m_vertexIndices{ vertexIndices },
 	m_vertexIndexOffset{ std::size(vertexIndices) },
 	m_primitiveIndices{ primitiveIndices },
 	m_primitiveIndexOffset{ std::size(primitiveIndices) },
-	m_primitiveIndexMap{}
+	m_localVertexIndices{}, m_localVertexCount{ 0u }
 {
-	m_vertexIndices.reserve(m_vertexIndexOffset + s_meshletVertexLimit);
-	m_primitiveIndices.reserve(m_primitiveIndexOffset + s_meshletPrimitiveLimit);
+	ReserveAdditional(m_vertexIndices, s_meshletVertexLimit);
+	ReserveAdditional(m_primitiveIndices, s_meshletPrimitiveLimit);
 }
 
-size_t MeshletGenerator::GetMeshletVertexIndexCount() const noexcept
-{
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+size_t MeshletGenerator<vertexLimit_t, primitiveLimit_t>::GetMeshletVertexIndexCount(
+) const noexcept {
 	// Since there will be the previous vertex indices from other meshlets.
 	return std::size(m_vertexIndices) - m_vertexIndexOffset;
 }
 
-size_t MeshletGenerator::GetMeshletPrimitiveIndexCount() const noexcept
-{
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+size_t MeshletGenerator<vertexLimit_t, primitiveLimit_t>::GetMeshletPrimitiveIndexCount(
+) const noexcept {
 	// Since there will be the previous primtive indices from other meshlets.
 	return std::size(m_primitiveIndices) - m_primitiveIndexOffset;
 }
 
 
-bool MeshletGenerator::IsMeshletLimitReached(const PrimTriangle& primitive) const noexcept
-{
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+bool MeshletGenerator<vertexLimit_t, primitiveLimit_t>::IsMeshletLimitReached(
+	const PrimTriangle& primitive
+) const noexcept {
 	const size_t vertexIndexCount    = GetMeshletVertexIndexCount();
 	const size_t primitiveIndexCount = GetMeshletPrimitiveIndexCount();
 
@@ -43,8 +162,10 @@ bool MeshletGenerator::IsMeshletLimitReached(const PrimTriangle& primitive) cons
 		|| newPrimitiveIndexCount > s_meshletPrimitiveLimit;
 }
 
-void MeshletGenerator::ProcessPrimitive(const PrimTriangle& primitive)
-{
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletGenerator<vertexLimit_t, primitiveLimit_t>::ProcessPrimitive(
+	const PrimTriangle& primitive
+) {
 	// The prim indices are the local vertex indices. As in, they are local to the meshlet.
 	// We are assuming each primitive would be a triangle. Each prim index actually has the
 	// three local vertex indices which create that triangle. So, actually the primIndices
@@ -64,19 +185,11 @@ void MeshletGenerator::ProcessPrimitive(const PrimTriangle& primitive)
 		.thirdIndex  = primIndexThree
 	};
 
-	std::uint32_t packedPrim = 0u;
-
-	static_assert(
-		sizeof(PrimitiveIndicesUnpacked) == sizeof(std::uint32_t),
-		"The size of Primitive Indices Unpacked and U32 should be the same."
-	);
-
-	memcpy(&packedPrim, &unpackedPrim, sizeof(std::uint32_t));
-
-	m_primitiveIndices.emplace_back(packedPrim);
+	m_primitiveIndices.emplace_back(PackPrim(unpackedPrim));
 }
 
-Meshlet MeshletGenerator::GenerateMeshlet(
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+Meshlet MeshletGenerator<vertexLimit_t, primitiveLimit_t>::GenerateMeshlet(
 	size_t vertexIndexMeshOffset, size_t primitiveIndexMeshOffset
 ) const noexcept
 {
@@ -95,169 +208,589 @@ Meshlet MeshletGenerator::GenerateMeshlet(
 		};
 }
 
-bool MeshletGenerator::IsInMap(std::uint32_t vertexIndex) const noexcept
-{
-	return m_primitiveIndexMap.find(vertexIndex) != std::end(m_primitiveIndexMap);
+std::uint32_t FindLocalVertexIndexScalar(
+	std::span<const std::uint32_t> localVertexIndices, std::uint32_t localVertexCount,
+	std::uint32_t vertexIndex
+) noexcept {
+	for (std::uint32_t index = 0u; index < localVertexCount; ++index)
+		if (localVertexIndices[index] == vertexIndex)
+			return index;
+
+	return std::numeric_limits<std::uint32_t>::max();
+}
+
+std::uint32_t FindLocalVertexIndex(
+	std::span<const std::uint32_t> localVertexIndices, std::uint32_t localVertexCount,
+	std::uint32_t vertexIndex
+) noexcept {
+#if defined(_XM_SSE_INTRINSICS_)
+	assert(std::size(localVertexIndices) % 4u == 0u && "The table size isn't a multiple of 4.");
+
+	std::uint32_t const* localIndices = std::data(localVertexIndices);
+
+	// The slots after the local vertex count might have the indices of a previous meshlet,
+	// but the valid slots come first. So, if the first match is after the count, there
+	// isn't a valid match.
+	const __m128i vertexIndexV = _mm_set1_epi32(static_cast<int>(vertexIndex));
+
+	for (std::uint32_t index = 0u; index < localVertexCount; index += 4u)
+	{
+		const __m128i slots = _mm_load_si128(
+			reinterpret_cast<__m128i const*>(localIndices + index)
+		);
+
+		const int matchMask = _mm_movemask_ps(
+			_mm_castsi128_ps(_mm_cmpeq_epi32(slots, vertexIndexV))
+		);
+
+		if (matchMask)
+		{
+			const auto localIndex = index + static_cast<std::uint32_t>(
+				std::countr_zero(static_cast<std::uint32_t>(matchMask))
+			);
+
+			return localIndex < localVertexCount
+				? localIndex : std::numeric_limits<std::uint32_t>::max();
+		}
+	}
+
+	return std::numeric_limits<std::uint32_t>::max();
+#else
+	return FindLocalVertexIndexScalar(localVertexIndices, localVertexCount, vertexIndex);
+#endif
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+std::uint32_t MeshletGenerator<vertexLimit_t, primitiveLimit_t>::FindLocalIndex(
+	std::uint32_t vertexIndex
+) const noexcept {
+	static_assert(s_meshletVertexLimit % 4u == 0u, "The vertex limit must be a multiple of 4.");
+
+	return FindLocalVertexIndex(m_localVertexIndices, m_localVertexCount, vertexIndex);
 }
 
-size_t MeshletGenerator::GetAddableVertexIndexCount(
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+size_t MeshletGenerator<vertexLimit_t, primitiveLimit_t>::GetAddableVertexIndexCount(
 	const PrimTriangle& primitive
 ) const noexcept {
 	size_t addableIndexCount = 0u;
 
-	if (!IsInMap(primitive.vertex0))
+	if (FindLocalIndex(primitive.vertex0) == s_invalidLocalIndex)
 		++addableIndexCount;
 
-	if (!IsInMap(primitive.vertex1))
+	// If a triangle has the same vertex index multiple times, it should only be counted once.
+	if (primitive.vertex1 != primitive.vertex0
+		&& FindLocalIndex(primitive.vertex1) == s_invalidLocalIndex)
 		++addableIndexCount;
 
-	if (!IsInMap(primitive.vertex2))
+	if (primitive.vertex2 != primitive.vertex0 && primitive.vertex2 != primitive.vertex1
+		&& FindLocalIndex(primitive.vertex2) == s_invalidLocalIndex)
 		++addableIndexCount;
 
 	return addableIndexCount;
 }
 
-std::uint32_t MeshletGenerator::GetOrAddPrimitiveIndex(std::uint32_t vertexIndex) noexcept
-{
-	if (!IsInMap(vertexIndex))
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+std::uint32_t MeshletGenerator<vertexLimit_t, primitiveLimit_t>::GetOrAddPrimitiveIndex(
+	std::uint32_t vertexIndex
+) noexcept {
+	std::uint32_t localIndex = FindLocalIndex(vertexIndex);
+
+	if (localIndex == s_invalidLocalIndex)
 	{
-		m_primitiveIndexMap.emplace(
-			vertexIndex, static_cast<std::uint32_t>(GetMeshletVertexIndexCount())
-		);
+		localIndex = m_localVertexCount;
+
+		m_localVertexIndices[localIndex] = vertexIndex;
+		++m_localVertexCount;
+
 		m_vertexIndices.emplace_back(vertexIndex);
 	}
 
-	return m_primitiveIndexMap[vertexIndex];
+	return localIndex;
 }
 
-MeshletGenerator::PrimitiveIndicesUnpacked MeshletGenerator::UnpackPrim(
-	std::uint32_t packedIndices
-) noexcept {
-	PrimitiveIndicesUnpacked unpackedIndices{ 0u, 0u, 0u };
-
-	memcpy(&unpackedIndices, &packedIndices, sizeof(std::uint32_t));
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletGenerator<vertexLimit_t, primitiveLimit_t>::StartNewMeshlet() noexcept
+{
+	m_vertexIndexOffset    = std::size(m_vertexIndices);
+	m_primitiveIndexOffset = std::size(m_primitiveIndices);
+	m_localVertexCount     = 0u;
 
-	return unpackedIndices;
+	ReserveAdditional(m_vertexIndices, s_meshletVertexLimit);
+	ReserveAdditional(m_primitiveIndices, s_meshletPrimitiveLimit);
 }
 
-// Meshlet Maker
-MeshletMaker::MeshletMaker() : m_vertexIndices{}, m_primitiveIndices{}, m_meshletDetails{} {}
-
-void MeshletMaker::GenerateMeshlets(const Mesh& mesh) noexcept
+// Spatial Meshlet building helpers
+[[nodiscard]]
+static DirectX::XMFLOAT3 GetPosition(const Vertex& vertex) noexcept
 {
-	MakeMeshlets(mesh.indices);
+	return vertex.position;
 }
 
-void MeshletMaker::GenerateMeshlets(aiMesh const* mesh) noexcept
+[[nodiscard]]
+static DirectX::XMFLOAT3 GetPosition(const aiVector3D& aiVertex) noexcept
 {
-	MakeMeshlets(mesh->mFaces, mesh->mNumFaces);
+	return GetXMFloat3(aiVertex);
 }
 
-void MeshletMaker::LoadVertexIndices(std::vector<std::uint32_t>& vertexIndices) noexcept
+struct TriangleAdjacency
 {
-	vertexIndices = std::move(m_vertexIndices);
-}
+	// The triangles which use a vertex are stored contiguously. A vertex's offset is where
+	// its triangles start and the next vertex's offset is where they end.
+	std::vector<std::uint32_t> triangleOffsets;
+	std::vector<std::uint32_t> triangles;
+	// The number of the triangles of a vertex, which haven't been added to a meshlet yet.
+	std::vector<std::uint32_t> liveTriangleCounts;
+};
+
+[[nodiscard]]
+static TriangleAdjacency GenerateTriangleAdjacency(
+	const MeshletTriangleView& triangles
+) noexcept {
+	const auto triangleCount = static_cast<std::uint32_t>(triangles.GetTriangleCount());
 
-MeshExtraForMesh MeshletMaker::GenerateExtraMeshData() noexcept
-{
-	return MeshExtraForMesh
+	std::uint32_t vertexCount = 0u;
+
+	for (std::uint32_t index = 0u; index < triangleCount; ++index)
 	{
-		.primIndices    = std::move(m_primitiveIndices),
-		.meshletDetails = std::move(m_meshletDetails)
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(index);
+
+		vertexCount = std::max(
+			{ vertexCount, triangle.vertex0 + 1u, triangle.vertex1 + 1u, triangle.vertex2 + 1u }
+		);
+	}
+
+	TriangleAdjacency adjacency
+	{
+		.triangleOffsets    = std::vector<std::uint32_t>(vertexCount + 1u, 0u),
+		.triangles          = std::vector<std::uint32_t>(triangleCount * 3u, 0u),
+		.liveTriangleCounts = std::vector<std::uint32_t>(vertexCount, 0u)
 	};
-}
 
-void MeshletMaker::MakeMeshlets(const std::vector<std::uint32_t>& indices) noexcept
-{
-	MeshletGenerator meshletGen{ m_vertexIndices, m_primitiveIndices };
+	for (std::uint32_t index = 0u; index < triangleCount; ++index)
+	{
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(index);
 
-	const size_t indexCount = std::size(indices);
+		++adjacency.liveTriangleCounts[triangle.vertex0];
+		++adjacency.liveTriangleCounts[triangle.vertex1];
+		++adjacency.liveTriangleCounts[triangle.vertex2];
+	}
+
+	for (std::uint32_t index = 0u; index < vertexCount; ++index)
+		adjacency.triangleOffsets[index + 1u]
+			= adjacency.triangleOffsets[index] + adjacency.liveTriangleCounts[index];
 
-	bool isMeshletLimitReached = false;
+	// Use a copy of the offsets as the write cursors.
+	std::vector<std::uint32_t> writeOffsets = adjacency.triangleOffsets;
 
-	for (size_t index = 0u; index + 2u < indexCount; index += 3u)
+	for (std::uint32_t index = 0u; index < triangleCount; ++index)
 	{
-		MeshletGenerator::PrimTriangle triangle
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(index);
+
+		adjacency.triangles[writeOffsets[triangle.vertex0]++] = index;
+		adjacency.triangles[writeOffsets[triangle.vertex1]++] = index;
+		adjacency.triangles[writeOffsets[triangle.vertex2]++] = index;
+	}
+
+	return adjacency;
+}
+
+// Meshlet Stream Maker
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::MeshletStreamMaker(
+	std::vector<std::uint32_t>& vertexIndices, std::vector<std::uint32_t>& primitiveIndices,
+	std::vector<MeshletDetails>& meshletDetails, MeshletBuildMode buildMode
+) : m_buildMode{ buildMode }, m_vertexIndices{ vertexIndices },
+	m_primitiveIndices{ primitiveIndices }, m_meshletDetails{ meshletDetails },
+	m_vertexIndexMeshOffset{ std::size(vertexIndices) },
+	m_primitiveIndexMeshOffset{ std::size(primitiveIndices) }
+{}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::GenerateMeshlets(
+	const MeshletTriangleView& triangles, Vertex const* vertices
+) noexcept {
+	if (m_buildMode == MeshletBuildMode::Spatial)
+		MakeMeshletsSpatial(vertices, triangles);
+	else
+		MakeMeshlets(triangles);
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::GenerateMeshlets(
+	const MeshletTriangleView& triangles, aiVector3D const* vertices
+) noexcept {
+	if (m_buildMode == MeshletBuildMode::Spatial)
+		MakeMeshletsSpatial(vertices, triangles);
+	else
+		MakeMeshlets(triangles);
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::AddMeshlet(
+	const MeshletGenerator_t& meshletGen
+) noexcept {
+	m_meshletDetails.emplace_back(
+		MeshletDetails
 		{
-			.vertex0 = indices[index + 0u],
-			.vertex1 = indices[index + 1u],
-			.vertex2 = indices[index + 2u]
-		};
+			.meshlet = meshletGen.GenerateMeshlet(
+				m_vertexIndexMeshOffset, m_primitiveIndexMeshOffset
+			)
+		}
+	);
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::MakeMeshlets(
+	const MeshletTriangleView& triangles
+) noexcept {
+	const size_t triangleCount = triangles.GetTriangleCount();
+
+	// Every triangle is a primitive, and every meshlet but the last one should be mostly full.
+	ReserveAdditional(m_primitiveIndices, triangleCount);
+	ReserveAdditional(m_meshletDetails, triangleCount / primitiveLimit_t + 1u);
+
+	MeshletGenerator_t meshletGen{ m_vertexIndices, m_primitiveIndices };
+
+	for (size_t index = 0u; index < triangleCount; ++index)
+	{
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(index);
 
 		if (meshletGen.IsMeshletLimitReached(triangle))
 		{
-			m_meshletDetails.emplace_back(
-				MeshletDetails
-				{
-					// Since the indices containers are per mesh, the offsets are zero.
-					.meshlet = meshletGen.GenerateMeshlet(0u, 0u)
-				}
-			);
+			AddMeshlet(meshletGen);
 
-			meshletGen = MeshletGenerator{ m_vertexIndices, m_primitiveIndices };
+			meshletGen.StartNewMeshlet();
 		}
 
 		meshletGen.ProcessPrimitive(triangle);
 	}
 
-	if (!isMeshletLimitReached)
-		m_meshletDetails.emplace_back(
-			MeshletDetails
-			{
-				.meshlet = meshletGen.GenerateMeshlet(0u, 0u)
-			}
-		);
+	// The last meshlet is never full, so it must be added here. There will always be at least
+	// a single meshlet.
+	AddMeshlet(meshletGen);
 }
 
-void MeshletMaker::MakeMeshlets(aiFace* faces, size_t faceCount) noexcept
-{
-	MeshletGenerator meshletGen{ m_vertexIndices, m_primitiveIndices };
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+template<typename Vertex_t>
+void MeshletStreamMaker<vertexLimit_t, primitiveLimit_t>::MakeMeshletsSpatial(
+	Vertex_t const* vertices, const MeshletTriangleView& triangles
+) noexcept {
+	using namespace DirectX;
+
+	// The weights of the terms of a candidate triangle's score. The lower the score, the
+	// better the candidate.
+	constexpr float newVertexWeight = 1.f;
+	constexpr float distanceWeight  = 0.5f;
+	constexpr float normalWeight    = 1.f;
+
+	constexpr auto invalidTriangle = std::numeric_limits<std::uint32_t>::max();
+
+	const auto triangleCount = static_cast<std::uint32_t>(triangles.GetTriangleCount());
+
+	ReserveAdditional(m_primitiveIndices, triangleCount);
+	ReserveAdditional(m_meshletDetails, triangleCount / primitiveLimit_t + 1u);
+
+	TriangleAdjacency adjacency = GenerateTriangleAdjacency(triangles);
+
+	std::vector<XMFLOAT3> triangleCentres(triangleCount);
+	std::vector<XMFLOAT3> triangleNormals(triangleCount);
+
+	// The average distance from the centre of a triangle to its vertices. It is used to
+	// make the distance term independent of the scale of the mesh.
+	float averageTriangleRadius = 0.f;
+
+	for (std::uint32_t index = 0u; index < triangleCount; ++index)
+	{
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(index);
+
+		const XMFLOAT3 position0 = GetPosition(vertices[triangle.vertex0]);
+		const XMFLOAT3 position1 = GetPosition(vertices[triangle.vertex1]);
+		const XMFLOAT3 position2 = GetPosition(vertices[triangle.vertex2]);
+
+		XMVECTOR vertex0 = XMLoadFloat3(&position0);
+		XMVECTOR vertex1 = XMLoadFloat3(&position1);
+		XMVECTOR vertex2 = XMLoadFloat3(&position2);
+
+		XMVECTOR centre  = (vertex0 + vertex1 + vertex2) / 3.f;
+
+		// A degenerate triangle will have a zero normal, so it won't affect the meshlet
+		// normal.
+		XMVECTOR normal  = XMVector3Normalize(
+			XMVector3Cross(vertex1 - vertex0, vertex2 - vertex0)
+		);
+
+		XMStoreFloat3(&triangleCentres[index], centre);
+		XMStoreFloat3(&triangleNormals[index], normal);
+
+		averageTriangleRadius += XMVectorGetX(XMVector3Length(vertex0 - centre));
+	}
+
+	if (triangleCount)
+		averageTriangleRadius /= static_cast<float>(triangleCount);
+
+	averageTriangleRadius = std::max(
+		averageTriangleRadius, std::numeric_limits<float>::epsilon()
+	);
+
+	// Using bytes instead of bools, as the bool vector specialisation is slower to access.
+	std::vector<std::uint8_t> isTriangleAdded(triangleCount, 0u);
+	std::vector<std::uint32_t> candidates{};
+
+	std::uint32_t addedTriangleCount = 0u;
+	// The first triangle which might not have been added yet. Used as the seed, when there
+	// isn't any adjacent triangle left.
+	std::uint32_t seedCursor         = 0u;
+
+	MeshletGenerator_t meshletGen{ m_vertexIndices, m_primitiveIndices };
 
-	bool isMeshletLimitReached = false;
+	XMVECTOR meshletCentreSum          = XMVectorZero();
+	XMVECTOR meshletNormalSum          = XMVectorZero();
+	std::uint32_t meshletTriangleCount = 0u;
 
-	for (size_t index = 0u; index < faceCount; ++index)
+	auto AddTriangle = [&](std::uint32_t triangleIndex)
 	{
-		const aiFace& face = faces[index];
+		const MeshletPrimTriangle triangle = triangles.GetTriangle(triangleIndex);
 
-		MeshletGenerator::PrimTriangle triangle
+		const size_t oldVertexIndexCount = std::size(m_vertexIndices);
+
+		meshletGen.ProcessPrimitive(triangle);
+
+		isTriangleAdded[triangleIndex] = 1u;
+		++addedTriangleCount;
+
+		--adjacency.liveTriangleCounts[triangle.vertex0];
+		--adjacency.liveTriangleCounts[triangle.vertex1];
+		--adjacency.liveTriangleCounts[triangle.vertex2];
+
+		// The triangles which use the newly added vertices are the new candidates.
+		const size_t newVertexIndexCount = std::size(m_vertexIndices);
+
+		for (size_t index = oldVertexIndexCount; index < newVertexIndexCount; ++index)
 		{
-			.vertex0 = face.mIndices[0],
-			.vertex1 = face.mIndices[1],
-			.vertex2 = face.mIndices[2]
-		};
+			const std::uint32_t vertexIndex = m_vertexIndices[index];
 
-		if (meshletGen.IsMeshletLimitReached(triangle))
+			const std::uint32_t adjacencyStart = adjacency.triangleOffsets[vertexIndex];
+			const std::uint32_t adjacencyEnd   = adjacency.triangleOffsets[vertexIndex + 1u];
+
+			for (std::uint32_t index1 = adjacencyStart; index1 < adjacencyEnd; ++index1)
+			{
+				const std::uint32_t adjacentTriangle = adjacency.triangles[index1];
+
+				if (!isTriangleAdded[adjacentTriangle])
+					candidates.emplace_back(adjacentTriangle);
+			}
+		}
+
+		meshletCentreSum += XMLoadFloat3(&triangleCentres[triangleIndex]);
+		meshletNormalSum += XMLoadFloat3(&triangleNormals[triangleIndex]);
+		++meshletTriangleCount;
+	};
+
+	auto GetNextUnaddedTriangle = [&]() -> std::uint32_t
+	{
+		while (seedCursor < triangleCount && isTriangleAdded[seedCursor])
+			++seedCursor;
+
+		return seedCursor < triangleCount ? seedCursor : invalidTriangle;
+	};
+
+	while (addedTriangleCount < triangleCount)
+	{
+		std::uint32_t bestCandidate = invalidTriangle;
+
+		if (meshletTriangleCount)
 		{
-			m_meshletDetails.emplace_back(
-				MeshletDetails
+			const auto triangleCountF = static_cast<float>(meshletTriangleCount);
+
+			XMVECTOR meshletCentre = meshletCentreSum / triangleCountF;
+			XMVECTOR meshletNormal = XMVector3Normalize(meshletNormalSum);
+
+			// The radius of a meshlet grows roughly with the square root of its triangle count.
+			const float distanceScale
+				= 1.f / (averageTriangleRadius * (1.f + std::sqrt(triangleCountF)));
+
+			float bestScore = std::numeric_limits<float>::max();
+
+			size_t liveCandidateCount = 0u;
+
+			for (const std::uint32_t candidate : candidates)
+			{
+				// Remove the candidates which have been added since they were found.
+				if (isTriangleAdded[candidate])
+					continue;
+
+				candidates[liveCandidateCount] = candidate;
+				++liveCandidateCount;
+
+				const MeshletPrimTriangle triangle = triangles.GetTriangle(candidate);
+
+				if (meshletGen.IsMeshletLimitReached(triangle))
+					continue;
+
+				const auto newVertexCount
+					= static_cast<float>(meshletGen.GetAddableVertexIndexCount(triangle));
+
+				const float distance = XMVectorGetX(
+					XMVector3Length(XMLoadFloat3(&triangleCentres[candidate]) - meshletCentre)
+				);
+
+				const float normalDeviation = 1.f - XMVectorGetX(
+					XMVector3Dot(XMLoadFloat3(&triangleNormals[candidate]), meshletNormal)
+				);
+
+				const float score = newVertexCount * newVertexWeight
+					+ distance * distanceScale * distanceWeight
+					+ normalDeviation * normalWeight;
+
+				if (score < bestScore)
 				{
-					// Since the indices containers are per mesh, the offsets are zero.
-					.meshlet = meshletGen.GenerateMeshlet(0u, 0u)
+					bestScore     = score;
+					bestCandidate = candidate;
 				}
-			);
+			}
+
+			candidates.resize(liveCandidateCount);
+
+			// If there are no adjacent triangles left, the next triangle in the index order
+			// is used if it fits. So disconnected pieces of the mesh can still fill a meshlet.
+			if (bestCandidate == invalidTriangle && std::empty(candidates))
+			{
+				const std::uint32_t nextTriangle = GetNextUnaddedTriangle();
 
-			meshletGen = MeshletGenerator{ m_vertexIndices, m_primitiveIndices };
+				if (!meshletGen.IsMeshletLimitReached(triangles.GetTriangle(nextTriangle)))
+					bestCandidate = nextTriangle;
+			}
 		}
 
-		meshletGen.ProcessPrimitive(triangle);
-	}
+		if (bestCandidate != invalidTriangle)
+		{
+			AddTriangle(bestCandidate);
+
+			continue;
+		}
+
+		// Either the meshlet is full or it is the first meshlet.
+		if (meshletTriangleCount)
+		{
+			AddMeshlet(meshletGen);
+
+			meshletGen.StartNewMeshlet();
+
+			meshletCentreSum     = XMVectorZero();
+			meshletNormalSum     = XMVectorZero();
+			meshletTriangleCount = 0u;
+		}
 
-	if (!isMeshletLimitReached)
-		m_meshletDetails.emplace_back(
-			MeshletDetails
+		// Seed the new meshlet with the remaining candidate, which has the least unadded
+		// neighbours. That should be on the border of the unadded triangles, so the next
+		// meshlet will be next to the last one and won't cut the remaining area in two.
+		std::uint32_t seedTriangle   = invalidTriangle;
+		std::uint32_t leastLiveCount = std::numeric_limits<std::uint32_t>::max();
+
+		for (const std::uint32_t candidate : candidates)
+		{
+			if (isTriangleAdded[candidate])
+				continue;
+
+			const MeshletPrimTriangle triangle = triangles.GetTriangle(candidate);
+
+			const std::uint32_t liveCount = adjacency.liveTriangleCounts[triangle.vertex0]
+				+ adjacency.liveTriangleCounts[triangle.vertex1]
+				+ adjacency.liveTriangleCounts[triangle.vertex2];
+
+			if (liveCount < leastLiveCount)
 			{
-				.meshlet = meshletGen.GenerateMeshlet(0u, 0u)
+				leastLiveCount = liveCount;
+				seedTriangle   = candidate;
 			}
-		);
+		}
+
+		if (seedTriangle == invalidTriangle)
+			seedTriangle = GetNextUnaddedTriangle();
+
+		// The candidates were adjacent to the last meshlet. The new one will find its own.
+		candidates.clear();
+
+		AddTriangle(seedTriangle);
+	}
+
+	// Keeping the same behaviour as the index order mode, there will always be at least a
+	// single meshlet.
+	if (meshletTriangleCount || !triangleCount)
+		AddMeshlet(meshletGen);
+}
+
+// Meshlet Maker
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+MeshletMaker<vertexLimit_t, primitiveLimit_t>::MeshletMaker(MeshletBuildMode buildMode)
+	: m_buildMode{ buildMode }, m_vertexIndices{}, m_primitiveIndices{}, m_meshletDetails{}
+{}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletMaker<vertexLimit_t, primitiveLimit_t>::GenerateMeshlets(const Mesh& mesh) noexcept
+{
+	MeshletStreamMaker_t meshletMaker{
+		m_vertexIndices, m_primitiveIndices, m_meshletDetails, m_buildMode
+	};
+
+	meshletMaker.GenerateMeshlets(MeshletTriangleView{ mesh.indices }, std::data(mesh.vertices));
 }
 
-MeshletMaker::PrimitiveIndicesUnpacked MeshletMaker::UnpackPrim(
-	std::uint32_t packedIndices
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletMaker<vertexLimit_t, primitiveLimit_t>::GenerateMeshlets(
+	aiMesh const* mesh, const std::vector<std::uint32_t>& indices
 ) noexcept {
-	PrimitiveIndicesUnpacked unpackedIndices{ 0u, 0u, 0u };
+	MeshletStreamMaker_t meshletMaker{
+		m_vertexIndices, m_primitiveIndices, m_meshletDetails, m_buildMode
+	};
 
-	memcpy(&unpackedIndices, &packedIndices, sizeof(std::uint32_t));
+	meshletMaker.GenerateMeshlets(MeshletTriangleView{ indices }, mesh->mVertices);
+}
 
-	return unpackedIndices;
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletMaker<vertexLimit_t, primitiveLimit_t>::GenerateMeshlets(aiMesh const* mesh) noexcept
+{
+	MeshletStreamMaker_t meshletMaker{
+		m_vertexIndices, m_primitiveIndices, m_meshletDetails, m_buildMode
+	};
+
+	meshletMaker.GenerateMeshlets(
+		MeshletTriangleView{ mesh->mFaces, mesh->mNumFaces }, mesh->mVertices
+	);
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+void MeshletMaker<vertexLimit_t, primitiveLimit_t>::LoadVertexIndices(
+	std::vector<std::uint32_t>& vertexIndices
+) noexcept {
+	vertexIndices = std::move(m_vertexIndices);
 }
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+MeshExtraForMesh MeshletMaker<vertexLimit_t, primitiveLimit_t>::GenerateExtraMeshData() noexcept
+{
+	return MeshExtraForMesh
+	{
+		.primIndices    = std::move(m_primitiveIndices),
+		.meshletDetails = std::move(m_meshletDetails)
+	};
+}
+
+// The limits the meshlet builders can be used with. Should be the same as the ones in
+// VisitMeshletLimits.
+template class MeshletGenerator<64u, 126u>;
+template class MeshletGenerator<64u, 84u>;
+template class MeshletGenerator<128u, 128u>;
+template class MeshletGenerator<256u, 256u>;
+
+template class MeshletStreamMaker<64u, 126u>;
+template class MeshletStreamMaker<64u, 84u>;
+template class MeshletStreamMaker<128u, 128u>;
+template class MeshletStreamMaker<256u, 256u>;
+
+template class MeshletMaker<64u, 126u>;
+template class MeshletMaker<64u, 84u>;
+template class MeshletMaker<128u, 128u>;
+template class MeshletMaker<256u, 256u>;
 }
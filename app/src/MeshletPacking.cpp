@@ -0,0 +1,200 @@
+#include <MeshletPacking.hpp>
+#include <MeshletMaker.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace Sol
+{
+static void AlignToFourBytes(std::vector<std::uint8_t>& data) noexcept
+{
+	data.resize((std::size(data) + 3u) & ~size_t{ 3u }, 0u);
+}
+
+template<typename T>
+static void AppendBytes(std::vector<std::uint8_t>& data, T value) noexcept
+{
+	const size_t oldSize = std::size(data);
+
+	data.resize(oldSize + sizeof(T));
+
+	memcpy(std::data(data) + oldSize, &value, sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]]
+static T ReadBytes(const std::vector<std::uint8_t>& data, size_t offset) noexcept
+{
+	T value{};
+
+	memcpy(&value, std::data(data) + offset, sizeof(T));
+
+	return value;
+}
+
+PackedMeshletData PackMeshlets(
+	std::span<const MeshletDetails> meshletDetails, std::span<const std::uint32_t> vertexIndices,
+	std::span<const std::uint32_t> primIndices
+) {
+	PackedMeshletData packedData{};
+
+	packedData.meshletDetails.reserve(std::size(meshletDetails));
+	// The upper bounds, when every meshlet uses 16 bit references. The alignment padding
+	// isn't counted.
+	packedData.vertexReferences.reserve(std::size(vertexIndices) * sizeof(std::uint16_t));
+	packedData.primitives.reserve(std::size(primIndices) * 3u);
+
+	for (const MeshletDetails& meshletDetail : meshletDetails)
+	{
+		const Meshlet& meshlet = meshletDetail.meshlet;
+
+		std::span<const std::uint32_t> meshletVertexIndices = vertexIndices.subspan(
+			meshlet.indexOffset, meshlet.indexCount
+		);
+
+		std::uint32_t baseVertex = 0u;
+		std::uint32_t maxVertex  = 0u;
+
+		if (!std::empty(meshletVertexIndices))
+		{
+			auto [minIt, maxIt] = std::ranges::minmax_element(meshletVertexIndices);
+
+			baseVertex = *minIt;
+			maxVertex  = *maxIt;
+		}
+
+		const bool canUseShortReferences
+			= maxVertex - baseVertex <= std::numeric_limits<std::uint16_t>::max();
+
+		AlignToFourBytes(packedData.vertexReferences);
+		AlignToFourBytes(packedData.primitives);
+
+		PackedMeshlet packedMeshlet
+		{
+			.baseVertex            = canUseShortReferences ? baseVertex : 0u,
+			.vertexReferenceOffset
+				= static_cast<std::uint32_t>(std::size(packedData.vertexReferences)),
+			.primitiveOffset       = static_cast<std::uint32_t>(std::size(packedData.primitives)),
+			.vertexCount           = static_cast<std::uint16_t>(meshlet.indexCount),
+			.primitiveCount        = static_cast<std::uint16_t>(meshlet.primitiveCount),
+			.vertexReferenceSize   = canUseShortReferences ? 2u : 4u
+		};
+
+		for (const std::uint32_t vertexIndex : meshletVertexIndices)
+			if (canUseShortReferences)
+				AppendBytes(
+					packedData.vertexReferences,
+					static_cast<std::uint16_t>(vertexIndex - baseVertex)
+				);
+			else
+				AppendBytes(packedData.vertexReferences, vertexIndex);
+
+		std::span<const std::uint32_t> meshletPrimIndices = primIndices.subspan(
+			meshlet.primitiveOffset, meshlet.primitiveCount
+		);
+
+		for (const std::uint32_t packedPrim : meshletPrimIndices)
+		{
+			const PrimitiveIndicesUnpacked unpackedPrim = UnpackPrim(packedPrim);
+
+			assert(
+				std::max<std::uint32_t>({
+					unpackedPrim.firstIndex, unpackedPrim.secondIndex, unpackedPrim.thirdIndex
+				}) <= std::numeric_limits<std::uint8_t>::max()
+				&& "The local vertex indices don't fit in a byte."
+			);
+
+			const std::array<std::uint8_t, 3u> triangle
+			{
+				static_cast<std::uint8_t>(unpackedPrim.firstIndex),
+				static_cast<std::uint8_t>(unpackedPrim.secondIndex),
+				static_cast<std::uint8_t>(unpackedPrim.thirdIndex)
+			};
+
+			packedData.primitives.insert(
+				std::end(packedData.primitives), std::begin(triangle), std::end(triangle)
+			);
+		}
+
+		packedData.meshletDetails.emplace_back(
+			PackedMeshletDetails
+			{
+				.meshlet    = packedMeshlet,
+				.sphereB    = meshletDetail.sphereB,
+				.coneNormal = meshletDetail.coneNormal
+			}
+		);
+	}
+
+	return packedData;
+}
+
+void UnpackMeshlets(
+	const PackedMeshletData& packedData, std::vector<std::uint32_t>& vertexIndices,
+	MeshExtraForMesh& extraMeshData
+) {
+	std::vector<std::uint32_t>& primIndices     = extraMeshData.primIndices;
+	std::vector<MeshletDetails>& meshletDetails = extraMeshData.meshletDetails;
+
+	meshletDetails.reserve(std::size(meshletDetails) + std::size(packedData.meshletDetails));
+
+	for (const PackedMeshletDetails& packedMeshletDetail : packedData.meshletDetails)
+	{
+		const PackedMeshlet& packedMeshlet = packedMeshletDetail.meshlet;
+
+		const Meshlet meshlet
+		{
+			.indexCount      = packedMeshlet.vertexCount,
+			.indexOffset     = static_cast<std::uint32_t>(std::size(vertexIndices)),
+			.primitiveCount  = packedMeshlet.primitiveCount,
+			.primitiveOffset = static_cast<std::uint32_t>(std::size(primIndices))
+		};
+
+		const size_t vertexCount = packedMeshlet.vertexCount;
+		size_t referenceOffset   = packedMeshlet.vertexReferenceOffset;
+
+		for (size_t index = 0u; index < vertexCount; ++index)
+		{
+			if (packedMeshlet.vertexReferenceSize == 2u)
+				vertexIndices.emplace_back(
+					packedMeshlet.baseVertex
+					+ ReadBytes<std::uint16_t>(packedData.vertexReferences, referenceOffset)
+				);
+			else
+				vertexIndices.emplace_back(
+					ReadBytes<std::uint32_t>(packedData.vertexReferences, referenceOffset)
+				);
+
+			referenceOffset += packedMeshlet.vertexReferenceSize;
+		}
+
+		const size_t primitiveCount = packedMeshlet.primitiveCount;
+		std::uint8_t const* triangles
+			= std::data(packedData.primitives) + packedMeshlet.primitiveOffset;
+
+		for (size_t index = 0u; index < primitiveCount; ++index)
+		{
+			std::uint8_t const* triangle = triangles + index * 3u;
+
+			const PrimitiveIndicesUnpacked unpackedPrim
+			{
+				.firstIndex  = triangle[0],
+				.secondIndex = triangle[1],
+				.thirdIndex  = triangle[2]
+			};
+
+			primIndices.emplace_back(PackPrim(unpackedPrim));
+		}
+
+		meshletDetails.emplace_back(
+			MeshletDetails
+			{
+				.meshlet    = meshlet,
+				.sphereB    = packedMeshletDetail.sphereB,
+				.coneNormal = packedMeshletDetail.coneNormal
+			}
+		);
+	}
+}
+}
@@ -0,0 +1,446 @@
+#include <MeshletValidator.hpp>
+#include <MeshletCuller.hpp>
+#include <VertexQuantiser.hpp>
+#include <algorithm>
+#include <format>
+#include <cmath>
+
+namespace Sol
+{
+namespace MeshletValidator
+{
+	using namespace DirectX;
+
+	// The bounds are made with floats, so allow them to be a bit off.
+	static constexpr float s_sphereTolerance       = 1e-4f;
+	static constexpr float s_coneTolerance         = 1e-3f;
+	// The apex is placed with the float axis, but the culling uses the 8 bit one. So, it can
+	// move by the length of half a step on each axis, times the apex offset.
+	static constexpr float s_axisQuantisationError = 0.5f / 127.f * 1.7320508f;
+
+	static void AddError(MeshReport& report, std::string&& error)
+	{
+		if (report.errorCount < s_maximumErrorCount)
+			report.errors.emplace_back(std::move(error));
+
+		++report.errorCount;
+	}
+
+	[[nodiscard]]
+	static bool IsSphereConservative(
+		const SphereBoundingVolume& sphereB, std::span<const Vertex> meshVertices,
+		std::span<const std::uint32_t> vertexIndices
+	) noexcept {
+		const XMVECTOR centre = XMVectorSetW(XMLoadFloat4(&sphereB.sphere), 0.f);
+		const float radius    = sphereB.sphere.w;
+		const float maxRadius = radius + s_sphereTolerance * std::max(radius, 1.f);
+
+		for (const std::uint32_t vertexIndex : vertexIndices)
+		{
+			const XMVECTOR position = XMLoadFloat3(&meshVertices[vertexIndex].position);
+
+			if (XMVectorGetX(XMVector3Length(position - centre)) > maxRadius)
+				return false;
+		}
+
+		return true;
+	}
+
+	// A cone only culls a meshlet from the cameras, which are behind the apex and inside the
+	// inverted cone. So, all of the triangles face away from those, if each face normal is
+	// inside the cone and the apex is behind each triangle.
+	[[nodiscard]]
+	static bool IsConeConservative(
+		const MeshletDetails& meshletDetails, std::span<const Vertex> meshVertices,
+		std::span<const std::uint32_t> vertexIndices, std::span<const std::uint32_t> primIndices
+	) noexcept {
+		const MeshletCuller::NormalCone cone = MeshletCuller::UnpackNormalCone(
+			meshletDetails.coneNormal
+		);
+
+		if (cone.isDegenerate)
+			return true;
+
+		const XMVECTOR axis    = XMVector3Normalize(XMLoadFloat3(&cone.axis));
+		const float apexOffset = meshletDetails.coneNormal.apexOffset;
+		const XMVECTOR apex    = XMVectorSetW(XMLoadFloat4(&meshletDetails.sphereB.sphere), 0.f)
+			- axis * apexOffset;
+
+		// The cutoff is the sine of the cone's angle.
+		const float minimumDot    = std::sqrt(std::max(1.f - cone.cutoff * cone.cutoff, 0.f));
+		const float apexTolerance = apexOffset * s_axisQuantisationError
+			+ s_coneTolerance * std::max(meshletDetails.sphereB.sphere.w + apexOffset, 1.f);
+
+		for (const std::uint32_t packedPrim : primIndices)
+		{
+			const PrimitiveIndicesUnpacked prim = UnpackPrim(packedPrim);
+
+			const XMVECTOR position0
+				= XMLoadFloat3(&meshVertices[vertexIndices[prim.firstIndex]].position);
+			const XMVECTOR position1
+				= XMLoadFloat3(&meshVertices[vertexIndices[prim.secondIndex]].position);
+			const XMVECTOR position2
+				= XMLoadFloat3(&meshVertices[vertexIndices[prim.thirdIndex]].position);
+
+			const XMVECTOR faceNormal = XMVector3Cross(
+				position1 - position0, position2 - position0
+			);
+
+			// The degenerate triangles can't be seen anyway.
+			if (XMVectorGetX(XMVector3LengthSq(faceNormal)) == 0.f)
+				continue;
+
+			const XMVECTOR unitNormal = XMVector3Normalize(faceNormal);
+
+			if (XMVectorGetX(XMVector3Dot(unitNormal, axis)) < minimumDot - s_coneTolerance)
+				return false;
+
+			if (XMVectorGetX(XMVector3Dot(apex - position0, unitNormal)) > apexTolerance)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void SetSphereRadiusDistribution(MeshReport& report, std::vector<float>& radii)
+	{
+		if (std::empty(radii))
+			return;
+
+		std::ranges::sort(radii);
+
+		float radiusSum = 0.f;
+
+		for (const float radius : radii)
+			radiusSum += radius;
+
+		report.minimumSphereRadius = radii.front();
+		report.maximumSphereRadius = radii.back();
+		report.medianSphereRadius  = radii[std::size(radii) / 2u];
+		report.averageSphereRadius = radiusSum / static_cast<float>(std::size(radii));
+	}
+
+	[[nodiscard]]
+	static MeshReport ValidateMeshMS(
+		const MeshTemporaryDetailsMS& meshDetails, const MeshBundleTemporaryData& bundleData,
+		std::span<const Vertex> vertices, size_t vertexLimit, size_t primitiveLimit
+	) {
+		MeshReport report{ .isMeshShader = true, .meshletCount = meshDetails.meshletCount };
+
+		const std::vector<MeshletDetails>& bundleMeshletDetails = bundleData.meshletDetails;
+
+		if (size_t{ meshDetails.meshletOffset } + meshDetails.meshletCount
+			> std::size(bundleMeshletDetails))
+		{
+			AddError(report, "The meshlets are outside of the bundle.");
+
+			return report;
+		}
+
+		if (meshDetails.vertexOffset > std::size(vertices))
+		{
+			AddError(report, "The vertices are outside of the bundle.");
+
+			return report;
+		}
+
+		std::span<const Vertex> meshVertices = vertices.subspan(meshDetails.vertexOffset);
+
+		// The triangles of all the meshlets, to simulate the vertex cache with.
+		std::vector<std::uint32_t> meshIndices{};
+		std::vector<float> sphereRadii{};
+
+		size_t vertexIndexCount    = 0u;
+		size_t degenerateConeCount = 0u;
+
+		for (size_t index = 0u; index < meshDetails.meshletCount; ++index)
+		{
+			const MeshletDetails& meshletDetails
+				= bundleMeshletDetails[meshDetails.meshletOffset + index];
+			const Meshlet& meshlet = meshletDetails.meshlet;
+
+			if (meshlet.indexCount > vertexLimit || meshlet.primitiveCount > primitiveLimit)
+				AddError(
+					report,
+					std::format(
+						"Meshlet {}: {} vertices and {} primitives are over the limits.", index,
+						meshlet.indexCount, meshlet.primitiveCount
+					)
+				);
+
+			const size_t indexStart
+				= size_t{ meshDetails.indexOffset } + meshlet.indexOffset;
+			const size_t primitiveStart
+				= size_t{ meshDetails.primitiveOffset } + meshlet.primitiveOffset;
+
+			if (indexStart + meshlet.indexCount > std::size(bundleData.indices))
+			{
+				AddError(report, std::format("Meshlet {}: The indices are outside.", index));
+
+				continue;
+			}
+
+			if (primitiveStart + meshlet.primitiveCount > std::size(bundleData.primIndices))
+			{
+				AddError(report, std::format("Meshlet {}: The primitives are outside.", index));
+
+				continue;
+			}
+
+			std::span<const std::uint32_t> vertexIndices
+				= std::span{ bundleData.indices }.subspan(indexStart, meshlet.indexCount);
+			std::span<const std::uint32_t> primIndices
+				= std::span{ bundleData.primIndices }.subspan(
+					primitiveStart, meshlet.primitiveCount
+				);
+
+			if (std::ranges::any_of(
+				vertexIndices,
+				[vertexCount = std::size(meshVertices)](std::uint32_t vertexIndex)
+				{
+					return vertexIndex >= vertexCount;
+				}
+			)) {
+				AddError(report, std::format("Meshlet {}: A vertex is outside.", index));
+
+				continue;
+			}
+
+			if (std::ranges::any_of(
+				primIndices,
+				[indexCount = meshlet.indexCount](std::uint32_t packedPrim)
+				{
+					const PrimitiveIndicesUnpacked prim = UnpackPrim(packedPrim);
+
+					return prim.firstIndex >= indexCount || prim.secondIndex >= indexCount
+						|| prim.thirdIndex >= indexCount;
+				}
+			)) {
+				AddError(
+					report, std::format("Meshlet {}: A primitive index is outside.", index)
+				);
+
+				continue;
+			}
+
+			for (const std::uint32_t packedPrim : primIndices)
+			{
+				const PrimitiveIndicesUnpacked prim = UnpackPrim(packedPrim);
+
+				meshIndices.emplace_back(vertexIndices[prim.firstIndex]);
+				meshIndices.emplace_back(vertexIndices[prim.secondIndex]);
+				meshIndices.emplace_back(vertexIndices[prim.thirdIndex]);
+			}
+
+			vertexIndexCount += meshlet.indexCount;
+
+			sphereRadii.emplace_back(meshletDetails.sphereB.sphere.w);
+
+			if (MeshletCuller::UnpackNormalCone(meshletDetails.coneNormal).isDegenerate)
+				++degenerateConeCount;
+
+			if (!IsSphereConservative(meshletDetails.sphereB, meshVertices, vertexIndices))
+			{
+				++report.nonConservativeSphereCount;
+
+				AddError(
+					report, std::format("Meshlet {}: The sphere misses some vertices.", index)
+				);
+			}
+
+			if (!IsConeConservative(meshletDetails, meshVertices, vertexIndices, primIndices))
+			{
+				++report.nonConservativeConeCount;
+
+				AddError(
+					report,
+					std::format(
+						"Meshlet {}: The cone would cull front facing triangles.", index
+					)
+				);
+			}
+		}
+
+		report.triangleCount = std::size(meshIndices) / 3u;
+		report.vertexCache   = MeshOptimiser::AnalyseVertexCache(meshIndices);
+
+		if (report.meshletCount)
+		{
+			const auto meshletCount = static_cast<float>(report.meshletCount);
+
+			report.vertexUtilisation    = static_cast<float>(vertexIndexCount)
+				/ (meshletCount * static_cast<float>(vertexLimit));
+			report.primitiveUtilisation = static_cast<float>(report.triangleCount)
+				/ (meshletCount * static_cast<float>(primitiveLimit));
+			report.degenerateConeRatio  = static_cast<float>(degenerateConeCount) / meshletCount;
+		}
+
+		SetSphereRadiusDistribution(report, sphereRadii);
+
+		return report;
+	}
+
+	[[nodiscard]]
+	static MeshReport ValidateMeshVS(
+		const MeshTemporaryDetailsVS& meshDetails, const MeshBundleTemporaryData& bundleData,
+		size_t vertexCount
+	) {
+		MeshReport report{ .isMeshShader = false };
+
+		if (meshDetails.indexCount % 3u)
+			AddError(report, "The index count isn't a multiple of 3.");
+
+		if (size_t{ meshDetails.indexOffset } + meshDetails.indexCount
+			> std::size(bundleData.indices))
+		{
+			AddError(report, "The indices are outside of the bundle.");
+
+			return report;
+		}
+
+		std::vector<std::uint32_t> meshIndices(
+			std::begin(bundleData.indices) + meshDetails.indexOffset,
+			std::begin(bundleData.indices) + meshDetails.indexOffset + meshDetails.indexCount
+		);
+
+		// The indices have been offset with the first vertex of the mesh.
+		for (std::uint32_t& index : meshIndices)
+		{
+			if (index < meshDetails.vertexOffset || index >= vertexCount)
+			{
+				AddError(report, "A vertex is outside of the mesh.");
+
+				return report;
+			}
+
+			index -= meshDetails.vertexOffset;
+		}
+
+		report.triangleCount = std::size(meshIndices) / 3u;
+		report.vertexCache   = MeshOptimiser::AnalyseVertexCache(meshIndices);
+
+		return report;
+	}
+
+	bool MeshBundleReport::IsValid() const noexcept
+	{
+		return std::empty(errors) && std::ranges::all_of(
+			meshReports, [](const MeshReport& report) { return report.errorCount == 0u; }
+		);
+	}
+
+	MeshBundleReport ValidateMeshBundle(
+		const MeshBundleTemporaryData& bundleData, MeshletLimitsType limitsType
+	) {
+		MeshBundleReport bundleReport{};
+
+		const MeshBundleTemporaryDetails& bundleDetails = bundleData.bundleDetails;
+
+		const size_t meshCount = std::size(bundleDetails.meshTemporaryDetailsMS)
+			+ std::size(bundleDetails.meshTemporaryDetailsVS);
+
+		if (bundleData.vertexLayout == VertexLayout::Quantised
+			&& std::size(bundleData.vertexQuantisations) != meshCount)
+		{
+			bundleReport.errors.emplace_back(
+				std::format(
+					"There are {} vertex quantisations for {} meshes.",
+					std::size(bundleData.vertexQuantisations), meshCount
+				)
+			);
+
+			return bundleReport;
+		}
+
+		if (bundleData.vertexLayout == VertexLayout::Quantised)
+		{
+			// The quantised vertices are decoded per mesh, from each mesh's first vertex to
+			// the next larger offset.
+			auto isOutside = [quantisedVertexCount = std::size(bundleData.quantisedVertices)]
+				(const auto& meshDetails)
+				{
+					return meshDetails.vertexOffset > quantisedVertexCount;
+				};
+
+			if (std::ranges::any_of(bundleDetails.meshTemporaryDetailsMS, isOutside)
+				|| std::ranges::any_of(bundleDetails.meshTemporaryDetailsVS, isOutside))
+			{
+				bundleReport.errors.emplace_back(
+					"The vertex offsets of the quantised meshes are outside of the vertices."
+				);
+
+				return bundleReport;
+			}
+		}
+
+		// The bounds are checked against the float vertices.
+		const std::vector<Vertex> vertices = DequantiseMeshBundleVertices(bundleData);
+
+		const auto [vertexLimit, primitiveLimit] = VisitMeshletLimits(
+			limitsType,
+			[]<typename Limits_t>(Limits_t)
+			{
+				return std::pair{ Limits_t::s_vertexLimit, Limits_t::s_primitiveLimit };
+			}
+		);
+
+		bundleReport.meshReports.reserve(meshCount);
+
+		for (const MeshTemporaryDetailsMS& meshDetails : bundleDetails.meshTemporaryDetailsMS)
+			bundleReport.meshReports.emplace_back(
+				ValidateMeshMS(meshDetails, bundleData, vertices, vertexLimit, primitiveLimit)
+			);
+
+		for (const MeshTemporaryDetailsVS& meshDetails : bundleDetails.meshTemporaryDetailsVS)
+			bundleReport.meshReports.emplace_back(
+				ValidateMeshVS(meshDetails, bundleData, std::size(vertices))
+			);
+
+		return bundleReport;
+	}
+
+	std::string FormatReport(const MeshBundleReport& report)
+	{
+		std::string formattedReport{};
+
+		for (const std::string& error : report.errors)
+			formattedReport += std::format("Error: {}\n", error);
+
+		const size_t meshCount = std::size(report.meshReports);
+
+		for (size_t index = 0u; index < meshCount; ++index)
+		{
+			const MeshReport& meshReport = report.meshReports[index];
+
+			formattedReport += std::format(
+				"Mesh {}: {} triangles, ACMR {:.3f}, ATVR {:.3f}", index,
+				meshReport.triangleCount, meshReport.vertexCache.acmr,
+				meshReport.vertexCache.atvr
+			);
+
+			if (meshReport.isMeshShader)
+				formattedReport += std::format(
+					", {} meshlets, vertex utilisation {:.1f}%, primitive utilisation {:.1f}%"
+					", sphere radius min {:.4g} median {:.4g} average {:.4g} max {:.4g}"
+					", degenerate cones {:.1f}%",
+					meshReport.meshletCount, meshReport.vertexUtilisation * 100.f,
+					meshReport.primitiveUtilisation * 100.f, meshReport.minimumSphereRadius,
+					meshReport.medianSphereRadius, meshReport.averageSphereRadius,
+					meshReport.maximumSphereRadius, meshReport.degenerateConeRatio * 100.f
+				);
+
+			formattedReport += '\n';
+
+			for (const std::string& error : meshReport.errors)
+				formattedReport += std::format("\tError: {}\n", error);
+
+			if (meshReport.errorCount > std::size(meshReport.errors))
+				formattedReport += std::format(
+					"\t{} more errors.\n", meshReport.errorCount - std::size(meshReport.errors)
+				);
+		}
+
+		return formattedReport;
+	}
+}
+}
@@ -3,10 +3,21 @@
 #include <array>
 #include <ranges>
 #include <algorithm>
+#include <string_view>
 #include <assimp/GltfMaterial.h>
 
 namespace Sol
 {
+[[nodiscard]]
+static std::uint32_t GetMaterialPipelineIndex(bool isTransparent) noexcept
+{
+	using ShaderType = PSOStorage::ShaderType;
+
+	return PSOStorage::GetPipelineIndex(
+		isTransparent ? ShaderType::TransparentLight : ShaderType::OpaqueLight
+	);
+}
+
 // Scene Material Processor
 void SceneMaterialProcessor::ProcessMeshAndMaterialData()
 {
@@ -56,15 +67,11 @@ void SceneMaterialProcessor::ProcessMeshAndMaterialData()
 			}
 		);
 
-		using ShaderType = PSOStorage::ShaderType;
-
 		MaterialDetails materialDetails
 		{
 			.name          = name.C_Str(),
 			.materialIndex = static_cast<std::uint32_t>(index),
-			.pipelineIndex = PSOStorage::GetPipelineIndex(
-				isTransparent ? ShaderType::TransparentLight : ShaderType::OpaqueLight
-			)
+			.pipelineIndex = GetMaterialPipelineIndex(isTransparent)
 		};
 
 		TexturePaths texturePaths{};
@@ -81,6 +88,157 @@ void SceneMaterialProcessor::ProcessMeshAndMaterialData()
 	}
 }
 
+void SceneMaterialProcessor::ProcessCachedMaterialData(
+	const SceneCacheData& sceneData, const std::string& scenePath
+) {
+	const std::vector<SceneMaterialData>& materials = sceneData.materials;
+	const std::vector<char>& materialStrings        = sceneData.materialStrings;
+
+	const size_t materialCount      = std::size(materials);
+	const std::string fileDirectory = SceneProcessor::GetFileDirectory(scenePath);
+
+	m_materialData.reserve(materialCount);
+	m_materialDetails.reserve(materialCount);
+	m_texturePaths.reserve(materialCount);
+
+	// A string without its null ends at the end of the strings, so a broken cache can't be
+	// read past.
+	size_t stringOffset = 0u;
+
+	auto ReadString = [&materialStrings, &stringOffset]
+	{
+		const auto stringStart = std::begin(materialStrings) + stringOffset;
+		const auto stringEnd   = std::find(stringStart, std::end(materialStrings), '\0');
+
+		stringOffset = std::min(
+			static_cast<size_t>(stringEnd - std::begin(materialStrings)) + 1u,
+			std::size(materialStrings)
+		);
+
+		return std::string{ stringStart, stringEnd };
+	};
+
+	auto ReadTexturePaths = [&ReadString, &fileDirectory](
+		std::uint32_t textureCount, std::vector<TexturePath>& texturePaths
+	) {
+		texturePaths.reserve(textureCount);
+
+		for (std::uint32_t index = 0u; index < textureCount; ++index)
+		{
+			TexturePath path{ .path = fileDirectory + ReadString() };
+
+			path.name = SceneProcessor::GetFileName(path.path);
+
+			texturePaths.emplace_back(std::move(path));
+		}
+	};
+
+	for (size_t index = 0u; index < materialCount; ++index)
+	{
+		const SceneMaterialData& material = materials[index];
+
+		m_materialData.emplace_back(
+			BlinnPhongMaterial
+			{
+				.ambient   = material.ambient,
+				.diffuse   = material.diffuse,
+				.specular  = material.specular,
+				.shininess = material.shininess
+			}
+		);
+
+		m_materialDetails.emplace_back(
+			MaterialDetails
+			{
+				.name          = ReadString(),
+				.materialIndex = static_cast<std::uint32_t>(index),
+				.pipelineIndex = GetMaterialPipelineIndex(material.isTransparent != 0u)
+			}
+		);
+
+		TexturePaths texturePaths{};
+
+		ReadTexturePaths(material.diffuseTextureCount, texturePaths.diffusePaths);
+		ReadTexturePaths(material.specularTextureCount, texturePaths.specularPaths);
+
+		m_texturePaths.emplace_back(std::move(texturePaths));
+	}
+}
+
+void SceneMaterialProcessor::AddToCacheData(SceneCacheData& sceneData) const
+{
+	std::vector<char>& materialStrings = sceneData.materialStrings;
+
+	const size_t materialCount      = std::size(m_materialData);
+	const std::string fileDirectory = m_scene->GetFileDirectory();
+
+	sceneData.materials.reserve(materialCount);
+
+	auto AddString = [&materialStrings](std::string_view value)
+	{
+		materialStrings.insert(std::end(materialStrings), std::begin(value), std::end(value));
+		materialStrings.emplace_back('\0');
+	};
+
+	// The texture paths are stored relative to the scene's directory, so the scene and its
+	// cache can be moved together.
+	auto AddTexturePaths = [&AddString, &fileDirectory](
+		const std::vector<TexturePath>& texturePaths
+	) {
+		for (const TexturePath& texturePath : texturePaths)
+			AddString(std::string_view{ texturePath.path }.substr(std::size(fileDirectory)));
+	};
+
+	for (size_t index = 0u; index < materialCount; ++index)
+	{
+		const BlinnPhongMaterial& material     = m_materialData[index];
+		const MaterialDetails& materialDetails = m_materialDetails[index];
+		const TexturePaths& texturePaths       = m_texturePaths[index];
+
+		sceneData.materials.emplace_back(
+			SceneMaterialData
+			{
+				.ambient              = material.ambient,
+				.diffuse              = material.diffuse,
+				.specular             = material.specular,
+				.shininess            = material.shininess,
+				.isTransparent        = materialDetails.pipelineIndex
+					== GetMaterialPipelineIndex(true),
+				.diffuseTextureCount  = static_cast<std::uint32_t>(
+					std::size(texturePaths.diffusePaths)
+				),
+				.specularTextureCount = static_cast<std::uint32_t>(
+					std::size(texturePaths.specularPaths)
+				)
+			}
+		);
+
+		AddString(materialDetails.name);
+		AddTexturePaths(texturePaths.diffusePaths);
+		AddTexturePaths(texturePaths.specularPaths);
+	}
+}
+
+void SceneMaterialProcessor::PrepareTextureAtlases()
+{
+	// Maybe later I will make it so there are multiple atlas and only a certain number of
+	// textures are put into a single atlas. As the precision would decrease the more textures
+	// we put in one.
+	for (const TexturePaths& texturePath : m_texturePaths)
+		for (const TexturePath& diffuseTexturePath : texturePath.diffusePaths)
+			m_diffuseAtlas.AddTexture(diffuseTexturePath.name, diffuseTexturePath.path);
+
+	for (const TexturePaths& texturePath : m_texturePaths)
+		for (const TexturePath& specularTexturePath : texturePath.specularPaths)
+			m_specularAtlas.AddTexture(specularTexturePath.name, specularTexturePath.path);
+
+	if (m_diffuseAtlas.DoUnprocessedTexturesExist())
+		m_diffuseAtlas.CreateAtlas();
+
+	if (m_specularAtlas.DoUnprocessedTexturesExist())
+		m_specularAtlas.CreateAtlas();
+}
+
 void SceneMaterialProcessor::ProcessMaterialTexture(
 	aiTextureType textureType, aiMaterial const* material,
 	std::vector<TexturePath>& texturePaths, const std::string& fileDirectory
@@ -1,178 +1,616 @@
 #include <SceneMeshProcessor.hpp>
 #include <MeshBoundImpl.hpp>
 #include <MeshletMaker.hpp>
+#include <ParallelUtility.hpp>
+#include <MeshOptimiser.hpp>
+#include <VertexQuantiser.hpp>
+#include <MeshDeduplicator.hpp>
+#include <MeshLod.hpp>
+#include <VertexConverter.hpp>
+#include <algorithm>
+#include <numeric>
 #include <concepts>
 #include <type_traits>
 
 namespace Sol
 {
+// The indices from the indexOffset to the end should only reference the vertices from the
+// vertexOffset to the end.
+static void OptimiseVertexFetch(
+	std::vector<std::uint32_t>& indices, size_t indexOffset, std::vector<Vertex>& vertices,
+	size_t vertexOffset, std::uint32_t indexVertexOffset
+) {
+	std::span<std::uint32_t> meshIndices{
+		std::data(indices) + indexOffset, std::size(indices) - indexOffset
+	};
+	std::span<Vertex> meshVertices{
+		std::data(vertices) + vertexOffset, std::size(vertices) - vertexOffset
+	};
+
+	MeshOptimiser::OptimiseVertexFetch(meshIndices, meshVertices, indexVertexOffset);
+}
+
+[[nodiscard]]
+static MeshBundleElementCounts GetMeshElementCounts(
+	aiMesh const* mesh, bool meshShader, MeshletLimitsType meshletLimits
+) noexcept {
+	MeshBundleElementCounts elementCounts{};
+
+	// Should be all triangles.
+	elementCounts.AddMesh(mesh->mNumVertices, mesh->mNumFaces * 3u, meshShader, meshletLimits);
+
+	return elementCounts;
+}
+
+// Only the first mesh of the duplicates is added to the bundle.
+[[nodiscard]]
+static MeshBundleElementCounts GetSceneElementCounts(
+	aiScene const* scene, std::span<const std::uint32_t> meshRemap, bool meshShader,
+	MeshletLimitsType meshletLimits
+) noexcept {
+	MeshBundleElementCounts elementCounts{};
+
+	aiMesh** meshes        = scene->mMeshes;
+	const size_t meshCount = scene->mNumMeshes;
+
+	for (size_t index = 0u; index < meshCount; ++index)
+		if (meshRemap[index] == index)
+			elementCounts.AddMesh(
+				meshes[index]->mNumVertices, meshes[index]->mNumFaces * 3u, meshShader,
+				meshletLimits
+			);
+
+	return elementCounts;
+}
+
 MeshBundleTemporaryData SceneMeshProcessor::GenerateTemporaryMeshData(bool meshShader)
 {
 	MeshBundleTemporaryData meshBundleTempData{};
 
 	aiScene const* scene = m_scene->GetScene();
 
-	if (meshShader)
-		meshBundleTempData = GenerateMeshShaderData(scene);
+	if (m_parallelWork.workerCount > 1u && m_parallelWork.submitWork)
+	{
+		if (meshShader)
+			meshBundleTempData = GenerateMeshShaderDataParallel(scene, m_options, m_parallelWork);
+		else
+			meshBundleTempData = GenerateVertexShaderDataParallel(
+				scene, m_options, m_parallelWork
+			);
+	}
 	else
-		meshBundleTempData = GenerateVertexShaderData(scene);
+	{
+		if (meshShader)
+			meshBundleTempData = GenerateMeshShaderData(scene, m_options);
+		else
+			meshBundleTempData = GenerateVertexShaderData(scene, m_options);
+	}
+
+	GenerateMeshBundleLods(meshBundleTempData, m_options);
+
+	if (m_options.quantiseVertices)
+		QuantiseMeshBundleVertices(meshBundleTempData);
 
 	return meshBundleTempData;
 }
 
+std::vector<MeshletHierarchy> SceneMeshProcessor::GenerateMeshletHierarchies() const
+{
+	aiScene const* scene = m_scene->GetScene();
+
+	aiMesh** meshes        = scene->mMeshes;
+	const size_t meshCount = scene->mNumMeshes;
+
+	std::vector<MeshletHierarchy> hierarchies(meshCount);
+
+	ParallelFor(
+		meshCount, m_parallelWork,
+		[meshes, &hierarchies, &options = m_options](size_t index)
+		{
+			aiMesh* mesh = meshes[index];
+
+			MeshBundleTemporaryData meshTempData{};
+
+			ReserveMeshBundleData(
+				meshTempData, GetMeshElementCounts(mesh, false, options.meshletLimits)
+			);
+
+			ProcessMeshVertices(mesh, meshTempData);
+			ProcessMeshFaces(mesh, 0u, false, meshTempData);
+
+			const Mesh localMesh
+			{
+				.vertices = std::move(meshTempData.vertices),
+				.indices  = std::move(meshTempData.indices)
+			};
+
+			hierarchies[index] = GenerateMeshletHierarchy(
+				localMesh, options.meshletLimits, options.sphereBVAlgorithm,
+				options.normalConeAlgorithm
+			);
+		}
+	);
+
+	return hierarchies;
+}
+
 void SceneMeshProcessor::SetSceneProcessor(std::shared_ptr<SceneProcessor> scene)
 {
 	m_scene = std::move(scene);
 }
 
-MeshBundleTemporaryData SceneMeshProcessor::GenerateMeshShaderData(aiScene const* scene)
-{
+std::vector<std::uint32_t> SceneMeshProcessor::GenerateNodeMeshRemap(
+	aiScene const* scene, const MeshProcessingOptions& options
+) {
+	return GenerateMeshRemap(scene, options, true);
+}
+
+std::vector<std::uint32_t> SceneMeshProcessor::GenerateMeshRemap(
+	aiScene const* scene, const MeshProcessingOptions& options, bool matchMaterials
+) {
+	if (options.deduplicateMeshes)
+		return MeshDeduplicator::GenerateMeshRemap(scene, matchMaterials);
+
+	std::vector<std::uint32_t> meshRemap(scene->mNumMeshes);
+
+	std::iota(std::begin(meshRemap), std::end(meshRemap), 0u);
+
+	return meshRemap;
+}
+
+MeshBundleTemporaryData SceneMeshProcessor::GenerateMeshShaderData(
+	aiScene const* scene, const MeshProcessingOptions& options
+) {
 	MeshBundleTemporaryData meshBundleTempData{};
 
 	aiMesh** meshes        = scene->mMeshes;
 	const size_t meshCount = scene->mNumMeshes;
 
-	meshBundleTempData.bundleDetails.meshTemporaryDetailsMS.reserve(meshCount);
+	const std::vector<std::uint32_t> meshRemap = GenerateMeshRemap(scene, options);
+
+	std::vector<MeshTemporaryDetailsMS>& meshDetails
+		= meshBundleTempData.bundleDetails.meshTemporaryDetailsMS;
+
+	meshDetails.reserve(meshCount);
+
+	ReserveMeshBundleData(
+		meshBundleTempData,
+		GetSceneElementCounts(scene, meshRemap, true, options.meshletLimits)
+	);
 
 	for (size_t index = 0u; index < meshCount; ++index)
-		ProcessMeshMS(meshes[index], meshBundleTempData);
+	{
+		// A duplicate mesh uses the data of the first one, which has already been added.
+		if (meshRemap[index] != index)
+		{
+			const MeshTemporaryDetailsMS firstMeshDetails = meshDetails[meshRemap[index]];
+
+			meshDetails.emplace_back(firstMeshDetails);
+		}
+		else
+			ProcessMeshMS(meshes[index], options, meshBundleTempData);
+	}
+
+	TrimMeshBundleData(meshBundleTempData);
 
 	return meshBundleTempData;
 }
 
-MeshBundleTemporaryData SceneMeshProcessor::GenerateVertexShaderData(aiScene const* scene)
-{
+MeshBundleTemporaryData SceneMeshProcessor::GenerateVertexShaderData(
+	aiScene const* scene, const MeshProcessingOptions& options
+) {
 	MeshBundleTemporaryData meshBundleTempData{};
 
 	aiMesh** meshes        = scene->mMeshes;
 	const size_t meshCount = scene->mNumMeshes;
 
-	meshBundleTempData.bundleDetails.meshTemporaryDetailsVS.reserve(meshCount);
+	const std::vector<std::uint32_t> meshRemap = GenerateMeshRemap(scene, options);
+
+	std::vector<MeshTemporaryDetailsVS>& meshDetails
+		= meshBundleTempData.bundleDetails.meshTemporaryDetailsVS;
+
+	meshDetails.reserve(meshCount);
+
+	ReserveMeshBundleData(
+		meshBundleTempData,
+		GetSceneElementCounts(scene, meshRemap, false, options.meshletLimits)
+	);
+
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		if (meshRemap[index] != index)
+		{
+			const MeshTemporaryDetailsVS firstMeshDetails = meshDetails[meshRemap[index]];
+
+			meshDetails.emplace_back(firstMeshDetails);
+		}
+		else
+			ProcessMeshVS(meshes[index], options, meshBundleTempData);
+	}
+
+	return meshBundleTempData;
+}
+
+MeshBundleTemporaryData SceneMeshProcessor::GenerateMeshShaderDataParallel(
+	aiScene const* scene, const MeshProcessingOptions& options,
+	const ParallelWork& parallelWork
+) {
+	aiMesh** meshes        = scene->mMeshes;
+	const size_t meshCount = scene->mNumMeshes;
+
+	const std::vector<std::uint32_t> meshRemap = GenerateMeshRemap(scene, options);
+
+	std::vector<MeshBundleTemporaryData> perMeshData(meshCount);
+
+	ParallelFor(
+		meshCount, parallelWork,
+		[meshes, &options, &perMeshData, &meshRemap](size_t index)
+		{
+			if (meshRemap[index] != index)
+				return;
+
+			ReserveMeshBundleData(
+				perMeshData[index],
+				GetMeshElementCounts(meshes[index], true, options.meshletLimits)
+			);
+
+			ProcessMeshMS(meshes[index], options, perMeshData[index]);
+		}
+	);
+
+	return ConcatenateMeshShaderData(perMeshData, meshRemap, parallelWork);
+}
+
+MeshBundleTemporaryData SceneMeshProcessor::GenerateVertexShaderDataParallel(
+	aiScene const* scene, const MeshProcessingOptions& options,
+	const ParallelWork& parallelWork
+) {
+	aiMesh** meshes        = scene->mMeshes;
+	const size_t meshCount = scene->mNumMeshes;
+
+	const std::vector<std::uint32_t> meshRemap = GenerateMeshRemap(scene, options);
+
+	std::vector<MeshBundleTemporaryData> perMeshData(meshCount);
+
+	ParallelFor(
+		meshCount, parallelWork,
+		[meshes, &options, &perMeshData, &meshRemap](size_t index)
+		{
+			if (meshRemap[index] != index)
+				return;
+
+			ReserveMeshBundleData(
+				perMeshData[index],
+				GetMeshElementCounts(meshes[index], false, options.meshletLimits)
+			);
+
+			ProcessMeshVS(meshes[index], options, perMeshData[index]);
+		}
+	);
+
+	return ConcatenateVertexShaderData(perMeshData, meshRemap, parallelWork);
+}
+
+MeshBundleTemporaryData SceneMeshProcessor::ConcatenateMeshShaderData(
+	std::vector<MeshBundleTemporaryData>& perMeshData, std::span<const std::uint32_t> meshRemap,
+	const ParallelWork& parallelWork
+) {
+	MeshBundleTemporaryData meshBundleTempData{};
+
+	const size_t meshCount = std::size(perMeshData);
+
+	std::vector<MeshTemporaryDetailsMS>& meshDetails
+		= meshBundleTempData.bundleDetails.meshTemporaryDetailsMS;
+
+	meshDetails.reserve(meshCount);
+
+	size_t vertexCount    = 0u;
+	size_t indexCount     = 0u;
+	size_t primitiveCount = 0u;
+	size_t meshletCount   = 0u;
+
+	// The offsets of a mesh are the sum of the sizes of the meshes before it.
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		if (meshRemap[index] != index)
+		{
+			const MeshTemporaryDetailsMS firstMeshDetails = meshDetails[meshRemap[index]];
+
+			meshDetails.emplace_back(firstMeshDetails);
+
+			continue;
+		}
+
+		const MeshBundleTemporaryData& meshData = perMeshData[index];
+
+		MeshTemporaryDetailsMS meshDetailsMS
+			= meshData.bundleDetails.meshTemporaryDetailsMS.front();
+
+		meshDetailsMS.vertexOffset    = static_cast<std::uint32_t>(vertexCount);
+		meshDetailsMS.indexOffset     = static_cast<std::uint32_t>(indexCount);
+		meshDetailsMS.primitiveOffset = static_cast<std::uint32_t>(primitiveCount);
+		meshDetailsMS.meshletOffset   = static_cast<std::uint32_t>(meshletCount);
+
+		meshDetails.emplace_back(meshDetailsMS);
+
+		vertexCount    += std::size(meshData.vertices);
+		indexCount     += std::size(meshData.indices);
+		primitiveCount += std::size(meshData.primIndices);
+		meshletCount   += std::size(meshData.meshletDetails);
+	}
+
+	// Each container is sized once with its exact count, so the meshes can be copied into it
+	// on different threads. The containers are std::vectors shared with the renderers, so the
+	// sizing zeroes them, which is a single memset for these trivial elements.
+	meshBundleTempData.vertices.resize(vertexCount);
+	meshBundleTempData.indices.resize(indexCount);
+	meshBundleTempData.primIndices.resize(primitiveCount);
+	meshBundleTempData.meshletDetails.resize(meshletCount);
+
+	ParallelFor(
+		meshCount, parallelWork,
+		[&perMeshData, &meshBundleTempData, &meshDetails, meshRemap](size_t index)
+		{
+			if (meshRemap[index] != index)
+				return;
+
+			MeshBundleTemporaryData& meshData     = perMeshData[index];
+			const MeshTemporaryDetailsMS& offsets = meshDetails[index];
+
+			// The meshlet and the vertex indices are relative to the mesh, so they can be
+			// copied as they are.
+			std::ranges::copy(
+				meshData.vertices,
+				std::begin(meshBundleTempData.vertices) + offsets.vertexOffset
+			);
+			std::ranges::copy(
+				meshData.indices, std::begin(meshBundleTempData.indices) + offsets.indexOffset
+			);
+			std::ranges::copy(
+				meshData.primIndices,
+				std::begin(meshBundleTempData.primIndices) + offsets.primitiveOffset
+			);
+			std::ranges::copy(
+				meshData.meshletDetails,
+				std::begin(meshBundleTempData.meshletDetails) + offsets.meshletOffset
+			);
+
+			// Free the memory of the mesh as soon as it has been copied.
+			meshData = MeshBundleTemporaryData{};
+		}
+	);
+
+	return meshBundleTempData;
+}
+
+MeshBundleTemporaryData SceneMeshProcessor::ConcatenateVertexShaderData(
+	std::vector<MeshBundleTemporaryData>& perMeshData, std::span<const std::uint32_t> meshRemap,
+	const ParallelWork& parallelWork
+) {
+	MeshBundleTemporaryData meshBundleTempData{};
+
+	const size_t meshCount = std::size(perMeshData);
+
+	std::vector<MeshTemporaryDetailsVS>& meshDetails
+		= meshBundleTempData.bundleDetails.meshTemporaryDetailsVS;
+
+	meshDetails.reserve(meshCount);
+
+	// The Input Assembler can't offset the vertices, so the indices of a mesh must be
+	// offset by the vertex count of the meshes before it.
+	std::vector<std::uint32_t> vertexOffsets(meshCount, 0u);
+
+	size_t vertexCount = 0u;
+	size_t indexCount  = 0u;
 
 	for (size_t index = 0u; index < meshCount; ++index)
-		ProcessMeshVS(meshes[index], meshBundleTempData);
+	{
+		if (meshRemap[index] != index)
+		{
+			const MeshTemporaryDetailsVS firstMeshDetails = meshDetails[meshRemap[index]];
+
+			meshDetails.emplace_back(firstMeshDetails);
+
+			continue;
+		}
+
+		const MeshBundleTemporaryData& meshData = perMeshData[index];
+
+		MeshTemporaryDetailsVS meshDetailsVS
+			= meshData.bundleDetails.meshTemporaryDetailsVS.front();
+
+		meshDetailsVS.indexOffset  = static_cast<std::uint32_t>(indexCount);
+		meshDetailsVS.vertexOffset = static_cast<std::uint32_t>(vertexCount);
+
+		meshDetails.emplace_back(meshDetailsVS);
+
+		vertexOffsets[index] = static_cast<std::uint32_t>(vertexCount);
+
+		vertexCount += std::size(meshData.vertices);
+		indexCount  += std::size(meshData.indices);
+	}
+
+	meshBundleTempData.vertices.resize(vertexCount);
+	meshBundleTempData.indices.resize(indexCount);
+
+	ParallelFor(
+		meshCount, parallelWork,
+		[&perMeshData, &meshBundleTempData, &meshDetails, &vertexOffsets, meshRemap](size_t index)
+		{
+			if (meshRemap[index] != index)
+				return;
+
+			MeshBundleTemporaryData& meshData = perMeshData[index];
+			const std::uint32_t vertexOffset  = vertexOffsets[index];
+
+			std::ranges::copy(
+				meshData.vertices, std::begin(meshBundleTempData.vertices) + vertexOffset
+			);
+			std::ranges::transform(
+				meshData.indices,
+				std::begin(meshBundleTempData.indices) + meshDetails[index].indexOffset,
+				[vertexOffset](std::uint32_t vertexIndex) { return vertexOffset + vertexIndex; }
+			);
+
+			meshData = MeshBundleTemporaryData{};
+		}
+	);
 
 	return meshBundleTempData;
 }
 
 void SceneMeshProcessor::ProcessMeshVS(
-	aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+	aiMesh* mesh, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
+	const auto vertexOffset = static_cast<std::uint32_t>(
+		std::size(meshBundleTemporaryData.vertices)
+	);
+
 	MeshTemporaryDetailsVS meshDetailsVS
 	{
 		// Should be all triangles.
 		.indexCount   = mesh->mNumFaces * 3u,
 		.indexOffset  = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.indices)),
+		.vertexOffset = vertexOffset,
 		.aabb         = GetAABB(mesh->mAABB)
 	};
 
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsVS.emplace_back(meshDetailsVS);
 
-	const auto vertexOffset = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.vertices));
-
 	ProcessMeshVertices(mesh, meshBundleTemporaryData);
 
-	ProcessMeshFaces(mesh, vertexOffset, meshBundleTemporaryData);
+	ProcessMeshFaces(mesh, vertexOffset, options.optimiseVertexCache, meshBundleTemporaryData);
+
+	if (options.optimiseOverdraw)
+		MeshOptimiser::OptimiseOverdraw(
+			std::span{ meshBundleTemporaryData.indices }.subspan(meshDetailsVS.indexOffset),
+			std::span{ meshBundleTemporaryData.vertices }.subspan(vertexOffset), vertexOffset
+		);
+
+	if (options.optimiseVertexFetch)
+		OptimiseVertexFetch(
+			meshBundleTemporaryData.indices, meshDetailsVS.indexOffset,
+			meshBundleTemporaryData.vertices, vertexOffset, vertexOffset
+		);
 }
 
 void SceneMeshProcessor::ProcessMeshMS(
-	aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
+	aiMesh* mesh, const MeshProcessingOptions& options,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
-	MeshletMaker meshletMaker{};
+	std::vector<std::uint32_t> meshIndices{};
+
+	if (options.optimiseVertexCache)
+	{
+		const size_t faceCount = mesh->mNumFaces;
+		aiFace const* faces    = mesh->mFaces;
 
-	meshletMaker.GenerateMeshlets(mesh);
+		meshIndices.reserve(faceCount * 3u);
+
+		for (size_t index = 0u; index < faceCount; ++index)
+		{
+			const aiFace& face = faces[index];
 
-	std::vector<std::uint32_t> vertexIndices{};
+			meshIndices.emplace_back(face.mIndices[0]);
+			meshIndices.emplace_back(face.mIndices[1]);
+			meshIndices.emplace_back(face.mIndices[2]);
+		}
 
-	meshletMaker.LoadVertexIndices(vertexIndices);
+		MeshOptimiser::OptimiseVertexCache(meshIndices);
+	}
 
-	MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+	std::vector<MeshletDetails>& bundleMeshletDetails = meshBundleTemporaryData.meshletDetails;
+	std::vector<std::uint32_t>& bundleIndices         = meshBundleTemporaryData.indices;
+	std::vector<std::uint32_t>& bundlePrimIndices     = meshBundleTemporaryData.primIndices;
 
 	MeshTemporaryDetailsMS meshDetailsMS
 	{
-		.meshletCount    = static_cast<std::uint32_t>(std::size(extraMeshData.meshletDetails)),
-		.meshletOffset   = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.meshletDetails)),
-		.indexOffset     = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.indices)),
-		.primitiveOffset = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.primIndices)),
+		.meshletOffset   = static_cast<std::uint32_t>(std::size(bundleMeshletDetails)),
+		.indexOffset     = static_cast<std::uint32_t>(std::size(bundleIndices)),
+		.primitiveOffset = static_cast<std::uint32_t>(std::size(bundlePrimIndices)),
 		.vertexOffset    = static_cast<std::uint32_t>(std::size(meshBundleTemporaryData.vertices)),
 		.aabb            = GetAABB(mesh->mAABB)
 	};
 
+	// The meshlets are made straight into the bundle containers, with their offsets relative
+	// to the mesh.
+	VisitMeshletLimits(
+		options.meshletLimits,
+		[mesh, &options, &meshIndices, &bundleIndices, &bundlePrimIndices, &bundleMeshletDetails]
+		<size_t vertexLimit_t, size_t primitiveLimit_t>
+		(MeshletLimits<vertexLimit_t, primitiveLimit_t>)
+		{
+			MeshletStreamMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{
+				bundleIndices, bundlePrimIndices, bundleMeshletDetails, options.meshletBuildMode
+			};
+
+			if (options.optimiseVertexCache)
+				meshletMaker.GenerateMeshlets(MeshletTriangleView{ meshIndices }, mesh->mVertices);
+			else
+				meshletMaker.GenerateMeshlets(
+					MeshletTriangleView{ mesh->mFaces, mesh->mNumFaces }, mesh->mVertices
+				);
+		}
+	);
+
+	meshDetailsMS.meshletCount = static_cast<std::uint32_t>(
+		std::size(bundleMeshletDetails) - meshDetailsMS.meshletOffset
+	);
+
 	meshBundleTemporaryData.bundleDetails.meshTemporaryDetailsMS.emplace_back(meshDetailsMS);
 
 	{
 		// Per meshlet Bounding Sphere
-		std::vector<MeshletDetails>& meshletDetails = extraMeshData.meshletDetails;
-
-		const size_t meshletCount = std::size(meshletDetails);
-
-		for (size_t index1 = 0u; index1 < meshletCount; ++index1)
+		std::span<const std::uint32_t> vertexIndices
+			= std::span{ bundleIndices }.subspan(meshDetailsMS.indexOffset);
+		std::span<const std::uint32_t> primIndices
+			= std::span{ bundlePrimIndices }.subspan(meshDetailsMS.primitiveOffset);
+		std::span<MeshletDetails> meshletDetails
+			= std::span{ bundleMeshletDetails }.subspan(meshDetailsMS.meshletOffset);
+
+		for (MeshletDetails& meshletDetail : meshletDetails)
 		{
-			MeshletDetails& meshletDetail = meshletDetails[index1];
-
 			meshletDetail.sphereB = GenerateSphereBV(
-				mesh->mVertices, vertexIndices, meshletDetail.meshlet
+				mesh->mVertices, vertexIndices, meshletDetail.meshlet, options.sphereBVAlgorithm
 			);
 
 			meshletDetail.coneNormal = GenerateNormalCone(
-				mesh->mVertices, mesh->mNormals, vertexIndices, extraMeshData.primIndices,
-				meshletDetail
+				mesh->mVertices, mesh->mNormals, vertexIndices, primIndices, meshletDetail,
+				options.normalConeAlgorithm
 			);
 		}
 	}
 
-	MemcpyIntoVector(meshBundleTemporaryData.meshletDetails, extraMeshData.meshletDetails);
-	MemcpyIntoVector(meshBundleTemporaryData.primIndices, extraMeshData.primIndices);
-	MemcpyIntoVector(meshBundleTemporaryData.indices, vertexIndices);
-
 	ProcessMeshVertices(mesh, meshBundleTemporaryData);
+
+	// The bounds have already been generated, and they don't depend on the vertex order.
+	if (options.optimiseVertexFetch)
+		OptimiseVertexFetch(
+			meshBundleTemporaryData.indices, meshDetailsMS.indexOffset,
+			meshBundleTemporaryData.vertices, meshDetailsMS.vertexOffset, 0u
+		);
 }
 
 void SceneMeshProcessor::ProcessMeshVertices(
 	aiMesh* mesh, MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
-	size_t newVertexCount = mesh->mNumVertices;
-	aiVector3D* vertices  = mesh->mVertices;
-	// Only using the first coordinates.
-	aiVector3D* uvs       = mesh->mTextureCoords[0];
-	aiVector3D* normals   = mesh->mNormals;
-
-	std::vector<Vertex>& bundleVertices = meshBundleTemporaryData.vertices;
-
-	bundleVertices.reserve(std::size(bundleVertices) + newVertexCount);
-
-	if (mesh->HasTextureCoords(0))
-	{
-		for (size_t index = 0u; index < newVertexCount; ++index)
-		{
-			Vertex vertex
-			{
-				.position = GetXMFloat3(vertices[index]),
-				.normal   = GetXMFloat3(normals[index]),
-				.uv       = DirectX::XMFLOAT2{ uvs[index].x, uvs[index].y }
-			};
-
-			bundleVertices.emplace_back(vertex);
-		}
-	}
-	else
+	// Only using the first coordinates. The missing uvs will be 0.
+	const VertexConverter::VertexStreams streams
 	{
-		for (size_t index = 0u; index < newVertexCount; ++index)
-		{
-			Vertex vertex
-			{
-				.position = GetXMFloat3(vertices[index]),
-				.normal   = GetXMFloat3(normals[index]),
-				.uv       = DirectX::XMFLOAT2{ 0.f, 0.f }
-			};
+		.positions = { .data = mesh->mVertices, .stride = sizeof(aiVector3D) },
+		.normals   = { .data = mesh->mNormals, .stride = sizeof(aiVector3D) },
+		.uvs       = { .data = mesh->mTextureCoords[0], .stride = sizeof(aiVector3D) }
+	};
 
-			bundleVertices.emplace_back(vertex);
-		}
-	}
+	VertexConverter::AppendVertices(
+		meshBundleTemporaryData.vertices, mesh->mNumVertices, streams, false, Vertex{}
+	);
 }
 
 void SceneMeshProcessor::ProcessMeshFaces(
-	aiMesh* mesh, std::uint32_t vertexOffset, MeshBundleTemporaryData& meshBundleTemporaryData
+	aiMesh* mesh, std::uint32_t vertexOffset, bool optimiseVertexCache,
+	MeshBundleTemporaryData& meshBundleTemporaryData
 ) noexcept {
 	size_t faceCount           = mesh->mNumFaces;
 	const size_t newIndexCount = faceCount * 3u;
@@ -180,229 +618,191 @@ void SceneMeshProcessor::ProcessMeshFaces(
 
 	std::vector<std::uint32_t>& bundleIndices = meshBundleTemporaryData.indices;
 
-	bundleIndices.reserve(std::size(bundleIndices) + newIndexCount);
+	const size_t oldIndexCount = std::size(bundleIndices);
+
+	// The optimiser needs the indices to be local to the mesh. So, offset them afterwards.
+	const std::uint32_t faceVertexOffset = optimiseVertexCache ? 0u : vertexOffset;
 
 	for (size_t index = 0u; index < faceCount; ++index)
 	{
 		const aiFace& face = faces[index];
 
 		// Should be all triangles.
-		std::uint32_t vIndex0 = vertexOffset + face.mIndices[0];
-		std::uint32_t vIndex1 = vertexOffset + face.mIndices[1];
-		std::uint32_t vIndex2 = vertexOffset + face.mIndices[2];
+		std::uint32_t vIndex0 = faceVertexOffset + face.mIndices[0];
+		std::uint32_t vIndex1 = faceVertexOffset + face.mIndices[1];
+		std::uint32_t vIndex2 = faceVertexOffset + face.mIndices[2];
 
 		bundleIndices.emplace_back(vIndex0);
 		bundleIndices.emplace_back(vIndex1);
 		bundleIndices.emplace_back(vIndex2);
 	}
+
+	if (optimiseVertexCache)
+	{
+		std::span<std::uint32_t> meshIndices{
+			std::data(bundleIndices) + oldIndexCount, newIndexCount
+		};
+
+		MeshOptimiser::OptimiseVertexCache(meshIndices);
+		MeshOptimiser::OffsetIndices(meshIndices, vertexOffset);
+	}
 }
 
 // Scene Mesh Processor
 namespace SceneMeshProcessor1
 {
+	// Unlike the vertex attributes, the buffer views of the indices can't have a stride, so
+	// the indices are always tightly packed.
 	template<std::integral T>
 	static void CopyIndices(
 		std::vector<std::uint32_t>& indices, const tinygltf::Accessor& indicesAccessor,
-		const tinygltf::BufferView& indexBufferView, const tinygltf::Buffer& indexBuffer,
-		size_t oldOffset, std::uint32_t vertexOffset
+		const tinygltf::BufferView& indexBufferView, GLTFBufferData indexBuffer,
+		std::uint32_t vertexOffset
 	) {
 		const size_t indexCount = indicesAccessor.count;
 
 		auto srcIndexData = reinterpret_cast<T const*>(
-			std::data(indexBuffer.data) + indexBufferView.byteOffset + indicesAccessor.byteOffset
+			std::data(indexBuffer) + indexBufferView.byteOffset + indicesAccessor.byteOffset
 		);
 
+		// The indices should have been reserved, so they are appended without a resize.
 		for (size_t index = 0u; index < indexCount; ++index)
-			indices[oldOffset + index] = vertexOffset + srcIndexData[index];
+			indices.emplace_back(vertexOffset + srcIndexData[index]);
 	}
 
-	template<typename T>
-	static void CopyVertices(
-		std::vector<Vertex>& vertices, size_t attributeIndex,
-		const std::vector<tinygltf::Accessor>& accessors,
-		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, size_t oldOffset,
-		T Vertex::* vertexMember, bool flipZ
-	) {
-		if (attributeIndex != std::numeric_limits<size_t>::max())
-		{
-			const tinygltf::Accessor& accessor     = accessors[attributeIndex];
-
-			const size_t vertexCount               = accessor.count;
-
-			const tinygltf::BufferView& bufferView = bufferViews[accessor.bufferView];
-
-			const tinygltf::Buffer& buffer         = buffers[bufferView.buffer];
-
-			auto srcData = reinterpret_cast<T const*>(
-				std::data(buffer.data) + bufferView.byteOffset + accessor.byteOffset
-			);
-
-			const float zMultiplier = flipZ ? -1.f : 1.f;
+	// Only the triangle primitives are added to the bundle.
+	[[nodiscard]]
+	static MeshBundleElementCounts GetModelElementCounts(
+		const tinygltf::Model& gltf, bool meshShader, MeshletLimitsType meshletLimits
+	) noexcept {
+		MeshBundleElementCounts elementCounts{};
 
-			for (size_t index = 0u; index < vertexCount; ++index)
+		for (const tinygltf::Mesh& mesh : gltf.meshes)
+			for (const tinygltf::Primitive& primitive : mesh.primitives)
 			{
-				vertices[oldOffset + index].*vertexMember = srcData[index];
+				if (primitive.mode != TINYGLTF_MODE_TRIANGLES)
+					continue;
 
-				if constexpr (std::is_same_v<T, DirectX::XMFLOAT3>)
-					(vertices[oldOffset + index].*vertexMember).z *= zMultiplier;
-			}
-		}
-	}
+				auto position = primitive.attributes.find("POSITION");
 
-	// Returns true if a meshlet is ready to be processed.
-	[[nodiscard]]
-	static void ProcessTriangle(
-		std::vector<Vertex>& vertices, size_t vertexOffset,
-		const MeshletGenerator::PrimTriangle& triangle, MeshletGenerator& meshletGen,
-		AABBGenerator& meshletSpatialAabbGen, AABBGenerator& meshletNormalAabbGen
-	) {
-		const Vertex& vertex0 = vertices[vertexOffset + triangle.vertex0];
-		const Vertex& vertex1 = vertices[vertexOffset + triangle.vertex1];
-		const Vertex& vertex2 = vertices[vertexOffset + triangle.vertex2];
+				if (position == std::end(primitive.attributes))
+					continue;
 
-		meshletSpatialAabbGen.ProcessAxes(vertex0.position);
-		meshletSpatialAabbGen.ProcessAxes(vertex1.position);
-		meshletSpatialAabbGen.ProcessAxes(vertex2.position);
-
-		meshletNormalAabbGen.ProcessAxes(vertex0.normal);
-		meshletNormalAabbGen.ProcessAxes(vertex1.normal);
-		meshletNormalAabbGen.ProcessAxes(vertex2.normal);
+				elementCounts.AddMesh(
+					gltf.accessors[position->second].count,
+					gltf.accessors[primitive.indices].count, meshShader, meshletLimits
+				);
+			}
 
-		meshletGen.ProcessPrimitive(triangle);
+		return elementCounts;
 	}
 
-	[[nodiscard]]
-	static MeshletDetails ProcessMeshlet(
-		const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
-		size_t meshVertexOffset, size_t meshIndexOffset, const Meshlet& meshlet,
-		const AxisAlignedBoundingBox& meshletSpatialAabb,
-		const AxisAlignedBoundingBox& meshletNormalAabb
-	) {
-		SphereBVGenerator spatialSphereBVGen{};
-
-		spatialSphereBVGen.SetCentre(meshletSpatialAabb);
-
-		NormalConeGenerator normalConeGen{};
+	struct VertexComponentType
+	{
+		VertexConverter::ComponentType type;
+		size_t                         size;
+	};
 
-		// We don't need to wait for the radius computation. We only need
-		// the centre.
-		normalConeGen.SetSpatialCentre(spatialSphereBVGen.GenerateBV());
+	// The component types the vertex attributes can have, with the quantised meshes.
+	[[nodiscard]]
+	static VertexComponentType GetVertexComponentType(int componentType) noexcept
+	{
+		using enum VertexConverter::ComponentType;
 
+		switch (componentType)
 		{
-			SphereBVGenerator normalSphereBVGen{};
+		case TINYGLTF_COMPONENT_TYPE_BYTE:
+			return VertexComponentType{ .type = Int8, .size = 1u };
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+			return VertexComponentType{ .type = UInt8, .size = 1u };
+		case TINYGLTF_COMPONENT_TYPE_SHORT:
+			return VertexComponentType{ .type = Int16, .size = 2u };
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+			return VertexComponentType{ .type = UInt16, .size = 2u };
+		default:
+			return VertexComponentType{ .type = Float, .size = sizeof(float) };
+		}
+	}
 
-			normalSphereBVGen.SetCentre(meshletNormalAabb);
+	// A stream without any data, if there isn't an accessor. The elements can be interleaved
+	// with the other attributes, so the stride of the buffer view is used if it has one.
+	[[nodiscard]]
+	static VertexConverter::AttributeStream GetAttributeStream(
+		size_t accessorIndex, const std::vector<tinygltf::Accessor>& accessors,
+		const std::vector<tinygltf::BufferView>& bufferViews,
+		std::span<const GLTFBufferData> buffers, size_t componentCount
+	) noexcept {
+		if (accessorIndex == std::numeric_limits<size_t>::max())
+			return VertexConverter::AttributeStream{};
 
-			normalConeGen.SetNormalCentre(normalSphereBVGen.GenerateBV());
-		}
+		const tinygltf::Accessor& accessor = accessors[accessorIndex];
 
-		const size_t meshletIndexOffset = meshlet.indexOffset;
-		const size_t indexOffset        = meshIndexOffset + meshletIndexOffset;
+		// An accessor without a buffer view is all zeros or sparse, neither of which is
+		// supported. So, the attribute of the default vertex is used instead.
+		if (accessor.bufferView < 0)
+			return VertexConverter::AttributeStream{};
 
-		const size_t meshletIndexCount  = meshlet.indexCount;
+		const tinygltf::BufferView& bufferView = bufferViews[accessor.bufferView];
 
-		// Going through all the vertices of the meshlet.
-		for (size_t index = indexOffset; index < meshletIndexCount; ++index)
-		{
-			const Vertex& vertex = vertices[meshVertexOffset + indices[index]];
+		const GLTFBufferData buffer            = buffers[bufferView.buffer];
 
-			spatialSphereBVGen.ProcessRadius(vertex.position);
+		const VertexComponentType componentType = GetVertexComponentType(accessor.componentType);
 
-			normalConeGen.ProcessNormalMinimumDot(vertex.normal);
-			normalConeGen.ProcessApexOffset(vertex.position, vertex.normal);
-		}
+		const size_t stride = bufferView.byteStride
+			? bufferView.byteStride : componentType.size * componentCount;
 
-		return MeshletDetails
+		return VertexConverter::AttributeStream
 		{
-			.meshlet    = meshlet,
-			.sphereB    = spatialSphereBVGen.GenerateBV(),
-			.coneNormal = normalConeGen.GenerateNormalCone()
+			.data          = std::data(buffer) + bufferView.byteOffset + accessor.byteOffset,
+			.stride        = stride,
+			.componentType = componentType.type,
+			.normalised    = accessor.normalized
 		};
 	}
 
-	template<std::integral T>
-	static void ProcessIndicesMS(
-		const MeshTemporaryDetailsMS& meshDetails, std::vector<Vertex>& vertices,
-		std::vector<std::uint32_t>& indices, std::vector<std::uint32_t>& primIndices,
-		std::vector<MeshletDetails>& meshletDetails, const tinygltf::Accessor& indicesAccessor,
-		const tinygltf::BufferView& indexBufferView, const tinygltf::Buffer& indexBuffer
+	// The indices of a primitive are local to its vertices, but the meshlets' vertex indices
+	// must be local to the mesh. So, the indices of every primitive after the first one are
+	// copied and offset.
+	template<std::integral T, typename MeshletStreamMaker_t>
+	static void MakeMeshletsMS(
+		MeshletStreamMaker_t& meshletMaker, Vertex const* meshVertices,
+		std::uint32_t primitiveVertexOffset, const tinygltf::Accessor& indicesAccessor,
+		const tinygltf::BufferView& indexBufferView, GLTFBufferData indexBuffer,
+		bool optimiseVertexCache
 	) {
 		const size_t indexCount = indicesAccessor.count;
 
-		auto srcIndexData = reinterpret_cast<T const*>(
-			std::data(indexBuffer.data) + indexBufferView.byteOffset
-			+ indicesAccessor.byteOffset
-		);
-
-		MeshletGenerator meshletGen{ indices, primIndices };
-
-		AABBGenerator meshletSpatialAabbGen{};
-		AABBGenerator meshletNormalAabbGen{};
-
-		bool isMeshletLimitReached = false;
+		std::span<const T> srcIndices{
+			reinterpret_cast<T const*>(
+				std::data(indexBuffer) + indexBufferView.byteOffset
+				+ indicesAccessor.byteOffset
+			),
+			indexCount
+		};
 
-		for (size_t index = 0u; index + 2u < indexCount; index += 3u)
+		if (!optimiseVertexCache && primitiveVertexOffset == 0u)
 		{
-			MeshletGenerator::PrimTriangle triangle
-			{
-				.vertex0 = srcIndexData[index + 0u],
-				.vertex1 = srcIndexData[index + 1u],
-				.vertex2 = srcIndexData[index + 2u]
-			};
+			meshletMaker.GenerateMeshlets(MeshletTriangleView{ srcIndices }, meshVertices);
 
-			if (meshletGen.IsMeshletLimitReached(triangle))
-			{
-				// Since the indices containers are per mesh bundle here, we must
-				// set the correct mesh offsets.
-				const Meshlet meshlet = meshletGen.GenerateMeshlet(
-					meshDetails.indexOffset, meshDetails.primitiveOffset
-				);
-
-				meshletDetails.emplace_back(
-					ProcessMeshlet(
-						vertices, indices,
-						meshDetails.vertexOffset, meshDetails.indexOffset,
-						meshlet, meshletSpatialAabbGen.GenerateAABB(),
-						meshletNormalAabbGen.GenerateAABB()
-					)
-				);
+			return;
+		}
 
-				// Reset the per meshlet generators.
-				meshletSpatialAabbGen = AABBGenerator{};
-				meshletNormalAabbGen  = AABBGenerator{};
-				meshletGen            = MeshletGenerator{ indices, primIndices };
-			}
+		std::vector<std::uint32_t> primitiveIndices(std::begin(srcIndices), std::end(srcIndices));
 
-			ProcessTriangle(
-				vertices, meshDetails.vertexOffset, triangle, meshletGen, meshletSpatialAabbGen,
-				meshletNormalAabbGen
-			);
-		}
+		// The optimiser needs the indices to be local to the primitive.
+		if (optimiseVertexCache)
+			MeshOptimiser::OptimiseVertexCache(primitiveIndices);
 
-		// If the meshlet limit wasn't reached on the last iteration, create a meshlet with
-		// the currently processed vertices.
-		if (!isMeshletLimitReached)
-		{
-			const Meshlet meshlet = meshletGen.GenerateMeshlet(
-				meshDetails.indexOffset, meshDetails.primitiveOffset
-			);
+		MeshOptimiser::OffsetIndices(primitiveIndices, primitiveVertexOffset);
 
-			meshletDetails.emplace_back(
-				ProcessMeshlet(
-					vertices, indices,
-					meshDetails.vertexOffset, meshDetails.indexOffset,
-					meshlet, meshletSpatialAabbGen.GenerateAABB(),
-					meshletNormalAabbGen.GenerateAABB()
-				)
-			);
-		}
+		meshletMaker.GenerateMeshlets(MeshletTriangleView{ primitiveIndices }, meshVertices);
 	}
 
 	static void ProcessIndices(
 		std::uint32_t vertexOffset, const tinygltf::Accessor& indicesAccessor,
 		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, std::vector<std::uint32_t>& indices
+		std::span<const GLTFBufferData> buffers, std::vector<std::uint32_t>& indices,
+		bool optimiseVertexCache
 	) {
 		const size_t indexCount = indicesAccessor.count;
 
@@ -410,77 +810,73 @@ namespace SceneMeshProcessor1
 
 		const size_t oldIndexCount = std::size(indices);
 
-		indices.resize(oldIndexCount + indexCount);
-
 		const tinygltf::BufferView& indexBufferView = bufferViews[indicesAccessor.bufferView];
 
-		const tinygltf::Buffer& indexBuffer         = buffers[indexBufferView.buffer];
+		const GLTFBufferData indexBuffer            = buffers[indexBufferView.buffer];
+
+		// The optimiser needs the indices to be local to the mesh. So, offset them afterwards.
+		const std::uint32_t copyVertexOffset = optimiseVertexCache ? 0u : vertexOffset;
 
 		if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
 			CopyIndices<std::uint32_t>(
-				indices, indicesAccessor, indexBufferView, indexBuffer, oldIndexCount,
-				vertexOffset
+				indices, indicesAccessor, indexBufferView, indexBuffer, copyVertexOffset
 			);
 		else if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
 			CopyIndices<std::uint16_t>(
-				indices, indicesAccessor, indexBufferView, indexBuffer, oldIndexCount,
-				vertexOffset
+				indices, indicesAccessor, indexBufferView, indexBuffer, copyVertexOffset
 			);
 		else if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
 			CopyIndices<std::uint8_t>(
-				indices, indicesAccessor, indexBufferView, indexBuffer, oldIndexCount,
-				vertexOffset
+				indices, indicesAccessor, indexBufferView, indexBuffer, copyVertexOffset
 			);
+
+		if (optimiseVertexCache)
+		{
+			std::span<std::uint32_t> primitiveIndices{
+				std::data(indices) + oldIndexCount, indexCount
+			};
+
+			MeshOptimiser::OptimiseVertexCache(primitiveIndices);
+			MeshOptimiser::OffsetIndices(primitiveIndices, vertexOffset);
+		}
 	}
 
+	template<typename MeshletStreamMaker_t>
 	static void ProcessIndicesMS(
-		const MeshTemporaryDetailsMS& meshDetails, const tinygltf::Accessor& indicesAccessor,
+		MeshletStreamMaker_t& meshletMaker, Vertex const* meshVertices,
+		std::uint32_t primitiveVertexOffset, const tinygltf::Accessor& indicesAccessor,
 		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, std::vector<Vertex>& vertices,
-		std::vector<std::uint32_t>& indices, std::vector<std::uint32_t>& primIndices,
-		std::vector<MeshletDetails>& meshletDetails
+		std::span<const GLTFBufferData> buffers, bool optimiseVertexCache
 	) {
-		const size_t indexCount = indicesAccessor.count;
-
 		assert(
 			indicesAccessor.type == TINYGLTF_TYPE_SCALAR && "Indices type isn't scalar."
 		);
 
-		{
-			const size_t currentMeshletDetailsCount = std::size(meshletDetails);
-			const size_t potentialNewMeshletDetailsCount
-				= indexCount / MeshletGenerator::s_meshletVertexLimit + 1u;
-
-			meshletDetails.reserve(
-				currentMeshletDetailsCount + potentialNewMeshletDetailsCount
-			);
-		}
-
 		const tinygltf::BufferView& indexBufferView = bufferViews[indicesAccessor.bufferView];
 
-		const tinygltf::Buffer& indexBuffer         = buffers[indexBufferView.buffer];
+		const GLTFBufferData indexBuffer            = buffers[indexBufferView.buffer];
 
 		if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
-			ProcessIndicesMS<std::uint32_t>(
-				meshDetails, vertices, indices, primIndices, meshletDetails, indicesAccessor,
-				indexBufferView, indexBuffer
+			MakeMeshletsMS<std::uint32_t>(
+				meshletMaker, meshVertices, primitiveVertexOffset, indicesAccessor,
+				indexBufferView, indexBuffer, optimiseVertexCache
 			);
 		else if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-			ProcessIndicesMS<std::uint16_t>(
-				meshDetails, vertices, indices, primIndices, meshletDetails, indicesAccessor,
-				indexBufferView, indexBuffer
+			MakeMeshletsMS<std::uint16_t>(
+				meshletMaker, meshVertices, primitiveVertexOffset, indicesAccessor,
+				indexBufferView, indexBuffer, optimiseVertexCache
 			);
 		else if (indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-			ProcessIndicesMS<std::uint8_t>(
-				meshDetails, vertices, indices, primIndices, meshletDetails, indicesAccessor,
-				indexBufferView, indexBuffer
+			MakeMeshletsMS<std::uint8_t>(
+				meshletMaker, meshVertices, primitiveVertexOffset, indicesAccessor,
+				indexBufferView, indexBuffer, optimiseVertexCache
 			);
 	}
 
 	static void ProcessVertices(
 		const tinygltf::Primitive& primitive, const std::vector<tinygltf::Accessor>& accessors,
 		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, std::vector<Vertex>& vertices,
+		std::span<const GLTFBufferData> buffers, std::vector<Vertex>& vertices,
 		AxisAlignedBoundingBox& aabb
 	) {
 		auto positionIndex = std::numeric_limits<size_t>::max();
@@ -506,61 +902,44 @@ namespace SceneMeshProcessor1
 
 		// Since the normal vector can't be zero. As that doesn't define any directions.
 		// Setting the default normal to face negative Z.
-		Vertex vertex
+		const Vertex defaultVertex
 		{
 			.position = DirectX::XMFLOAT3{ 0.f, 0.f, 0.f },
 			.normal   = DirectX::XMFLOAT3{ 0.f, 0.f, -1.f },
 			.uv       = DirectX::XMFLOAT2{ 0.f, 0.f }
 		};
 
-		vertices.resize(oldVertexCount + vertexCount, vertex);
-
 		// Flip Zs, as gltf is based on openGL which uses a Right Hand Coordinate system.
-
+		const VertexConverter::VertexStreams streams
 		{
-			const tinygltf::BufferView& positionBufferView
-				= bufferViews[positionAccessor.bufferView];
-
-			const tinygltf::Buffer& positionBuffer = buffers[positionBufferView.buffer];
-
-			auto srcPositionData = reinterpret_cast<DirectX::XMFLOAT3 const*>(
-				std::data(positionBuffer.data) + positionBufferView.byteOffset
-				+ positionAccessor.byteOffset
-			);
-
-			AABBGenerator aabbGen{};
-
-			for (size_t index = 0u; index < vertexCount; ++index)
-			{
-				DirectX::XMFLOAT3& position = vertices[oldVertexCount + index].position;
+			.positions = GetAttributeStream(
+				positionIndex, accessors, bufferViews, buffers, 3u
+			),
+			.normals   = GetAttributeStream(
+				normalIndex, accessors, bufferViews, buffers, 3u
+			),
+			.uvs       = GetAttributeStream(
+				uvIndex, accessors, bufferViews, buffers, 2u
+			)
+		};
 
-				position    = srcPositionData[index];
+		VertexConverter::AppendVertices(vertices, vertexCount, streams, true, defaultVertex);
 
-				position.z *= -1.f;
+		AABBGenerator aabbGen{};
 
-				aabbGen.ProcessAxes(position);
-			}
-
-			aabb = aabbGen.GenerateAABB();
-		}
+		for (const Vertex& newVertex : std::span{ vertices }.subspan(oldVertexCount))
+			aabbGen.ProcessAxes(newVertex.position);
 
-		CopyVertices(
-			vertices, normalIndex, accessors, bufferViews, buffers, oldVertexCount,
-			&Vertex::normal, true
-		);
-		CopyVertices(
-			vertices, uvIndex, accessors, bufferViews, buffers, oldVertexCount,
-			&Vertex::uv, false
-		);
+		aabb = aabbGen.GenerateAABB();
 	}
 
 	static void ProcessMeshMS(
 		const tinygltf::Mesh& mesh, const std::vector<tinygltf::Accessor>& accessors,
 		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, std::vector<Vertex>& vertices,
+		std::span<const GLTFBufferData> buffers, std::vector<Vertex>& vertices,
 		std::vector<std::uint32_t>& indices, std::vector<std::uint32_t>& primIndices,
 		std::vector<MeshletDetails>& meshletDetails,
-		std::vector<MeshTemporaryDetailsMS>& meshDetails
+		std::vector<MeshTemporaryDetailsMS>& meshDetails, const MeshProcessingOptions& options
 	) {
 		MeshTemporaryDetailsMS meshDetailsMS
 		{
@@ -572,35 +951,84 @@ namespace SceneMeshProcessor1
 
 		AxisAlignedBoundingBox meshAabb{};
 
-		for (const tinygltf::Primitive& primitive : mesh.primitives)
-		{
-			// For now only process Triangles.
-			if (primitive.mode != TINYGLTF_MODE_TRIANGLES)
-				continue;
+		VisitMeshletLimits(
+			options.meshletLimits,
+			[&]<size_t vertexLimit_t, size_t primitiveLimit_t>
+			(MeshletLimits<vertexLimit_t, primitiveLimit_t>)
+			{
+				MeshletStreamMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{
+					indices, primIndices, meshletDetails, options.meshletBuildMode
+				};
+
+				for (const tinygltf::Primitive& primitive : mesh.primitives)
+				{
+					// For now only process Triangles.
+					if (primitive.mode != TINYGLTF_MODE_TRIANGLES)
+						continue;
+
+					const auto primitiveVertexOffset = static_cast<std::uint32_t>(
+						std::size(vertices) - meshDetailsMS.vertexOffset
+					);
+
+					// Process the vertices first, as the spatial mode needs them.
+					ProcessVertices(
+						primitive, accessors, bufferViews, buffers, vertices, meshAabb
+					);
+
+					ProcessIndicesMS(
+						meshletMaker, std::data(vertices) + meshDetailsMS.vertexOffset,
+						primitiveVertexOffset, accessors[primitive.indices], bufferViews,
+						buffers, options.optimiseVertexCache
+					);
+				}
+			}
+		);
 
-			// Process the vertices first, as we would want to generate Bounding Volumes
-			// with them.
-			ProcessVertices(primitive, accessors, bufferViews, buffers, vertices, meshAabb);
+		meshDetailsMS.aabb = meshAabb;
+		meshDetailsMS.meshletCount
+			= static_cast<std::uint32_t>(std::size(meshletDetails) - meshDetailsMS.meshletOffset);
 
-			const tinygltf::Accessor& indicesAccessor = accessors[primitive.indices];
+		{
+			// The meshlets of all the primitives are local to the vertices of the mesh.
+			std::span<const Vertex> meshVertices
+				= std::span{ vertices }.subspan(meshDetailsMS.vertexOffset);
+			std::span<const std::uint32_t> vertexIndices
+				= std::span{ indices }.subspan(meshDetailsMS.indexOffset);
+			std::span<const std::uint32_t> meshPrimIndices
+				= std::span{ primIndices }.subspan(meshDetailsMS.primitiveOffset);
+
+			for (MeshletDetails& meshletDetail
+				: std::span{ meshletDetails }.subspan(meshDetailsMS.meshletOffset))
+			{
+				meshletDetail.sphereB = GenerateSphereBV(
+					meshVertices, vertexIndices, meshletDetail.meshlet, options.sphereBVAlgorithm
+				);
 
-			ProcessIndicesMS(
-				meshDetailsMS, indicesAccessor, bufferViews, buffers, vertices, indices,
-				primIndices, meshletDetails
-			);
-			// Hopefully, there can't be multiple instances of the same mode?
+				meshletDetail.coneNormal = GenerateNormalCone(
+					meshVertices, vertexIndices, meshPrimIndices, meshletDetail,
+					options.normalConeAlgorithm
+				);
+			}
 		}
 
-		meshDetailsMS.aabb = meshAabb;
-		meshDetailsMS.meshletCount
-			= static_cast<std::uint32_t>(std::size(meshletDetails) - meshDetailsMS.meshletOffset);
+		// The meshlet bounds have already been generated, and they don't depend on the
+		// vertex order.
+		if (options.optimiseVertexFetch)
+			OptimiseVertexFetch(
+				indices, meshDetailsMS.indexOffset, vertices, meshDetailsMS.vertexOffset, 0u
+			);
 
 		meshDetails.emplace_back(meshDetailsMS);
 	}
 
 	static void GenerateMeshShaderData(
-		const tinygltf::Model& gltf, MeshBundleTemporaryData& meshBundleTempData
+		const GLTFObject& gltfObj, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTempData
 	) {
+		const tinygltf::Model& gltf             = gltfObj.Get();
+		// The mapped buffers aren't in the model.
+		std::span<const GLTFBufferData> buffers = gltfObj.GetBufferData();
+
 		const size_t meshCount = std::size(gltf.meshes);
 
 		std::vector<Vertex>& vertices               = meshBundleTempData.vertices;
@@ -613,23 +1041,33 @@ namespace SceneMeshProcessor1
 
 		meshDetails.reserve(meshCount);
 
+		ReserveMeshBundleData(
+			meshBundleTempData, GetModelElementCounts(gltf, true, options.meshletLimits)
+		);
+
 		for (size_t index = 0u; index < meshCount; ++index)
 			ProcessMeshMS(
-				gltf.meshes[index], gltf.accessors, gltf.bufferViews, gltf.buffers,
-				vertices, indices, primIndices, meshletDetails, meshDetails
+				gltf.meshes[index], gltf.accessors, gltf.bufferViews, buffers,
+				vertices, indices, primIndices, meshletDetails, meshDetails, options
 			);
+
+		TrimMeshBundleData(meshBundleTempData);
 	}
 
 	static void ProcessMeshVS(
 		const tinygltf::Mesh& mesh, const std::vector<tinygltf::Accessor>& accessors,
 		const std::vector<tinygltf::BufferView>& bufferViews,
-		const std::vector<tinygltf::Buffer>& buffers, std::vector<Vertex>& vertices,
-		std::vector<std::uint32_t>& indices, std::vector<MeshTemporaryDetailsVS>& meshDetails
+		std::span<const GLTFBufferData> buffers, std::vector<Vertex>& vertices,
+		std::vector<std::uint32_t>& indices, std::vector<MeshTemporaryDetailsVS>& meshDetails,
+		const MeshProcessingOptions& options
 	) {
+		const auto meshVertexOffset = static_cast<std::uint32_t>(std::size(vertices));
+
 		MeshTemporaryDetailsVS meshDetailsVS
 		{
 			// Should be all triangles.
-			.indexOffset = static_cast<std::uint32_t>(std::size(indices)),
+			.indexOffset  = static_cast<std::uint32_t>(std::size(indices)),
+			.vertexOffset = meshVertexOffset
 		};
 
 		AxisAlignedBoundingBox aabb{};
@@ -642,12 +1080,24 @@ namespace SceneMeshProcessor1
 
 			const tinygltf::Accessor& indicesAccessor = accessors[primitive.indices];
 
-			const auto vertexOffset = static_cast<std::uint32_t>(std::size(vertices));
+			const auto vertexOffset  = static_cast<std::uint32_t>(std::size(vertices));
+			const size_t indexOffset = std::size(indices);
 
-			ProcessIndices(vertexOffset, indicesAccessor, bufferViews, buffers, indices);
+			ProcessIndices(
+				vertexOffset, indicesAccessor, bufferViews, buffers, indices,
+				options.optimiseVertexCache
+			);
 
 			ProcessVertices(primitive, accessors, bufferViews, buffers, vertices, aabb);
 			// Hopefully, there can't be multiple instances of the same mode?
+
+			// The overdraw optimisation needs the vertices, which are only added after the
+			// indices.
+			if (options.optimiseOverdraw)
+				MeshOptimiser::OptimiseOverdraw(
+					std::span{ indices }.subspan(indexOffset),
+					std::span{ vertices }.subspan(vertexOffset), vertexOffset
+				);
 		}
 
 		meshDetailsVS.aabb = aabb;
@@ -655,12 +1105,22 @@ namespace SceneMeshProcessor1
 		meshDetailsVS.indexCount
 			= static_cast<std::uint32_t>(std::size(indices) - meshDetailsVS.indexOffset);
 
+		if (options.optimiseVertexFetch)
+			OptimiseVertexFetch(
+				indices, meshDetailsVS.indexOffset, vertices, meshVertexOffset, meshVertexOffset
+			);
+
 		meshDetails.emplace_back(meshDetailsVS);
 	}
 
 	static void GenerateVertexShaderData(
-		const tinygltf::Model& gltf, MeshBundleTemporaryData& meshBundleTempData
+		const GLTFObject& gltfObj, const MeshProcessingOptions& options,
+		MeshBundleTemporaryData& meshBundleTempData
 	) {
+		const tinygltf::Model& gltf             = gltfObj.Get();
+		// The mapped buffers aren't in the model.
+		std::span<const GLTFBufferData> buffers = gltfObj.GetBufferData();
+
 		const size_t meshCount = std::size(gltf.meshes);
 
 		std::vector<Vertex>& vertices       = meshBundleTempData.vertices;
@@ -671,23 +1131,31 @@ namespace SceneMeshProcessor1
 
 		meshDetails.reserve(meshCount);
 
+		ReserveMeshBundleData(
+			meshBundleTempData, GetModelElementCounts(gltf, false, options.meshletLimits)
+		);
+
 		for (size_t index = 0u; index < meshCount; ++index)
 			ProcessMeshVS(
-				gltf.meshes[index], gltf.accessors, gltf.bufferViews, gltf.buffers,
-				vertices, indices, meshDetails
+				gltf.meshes[index], gltf.accessors, gltf.bufferViews, buffers,
+				vertices, indices, meshDetails, options
 			);
 	}
 
-	MeshBundleTemporaryData GenerateTemporaryMeshData(const GLTFObject& gltfObj, bool meshShader)
-	{
+	MeshBundleTemporaryData GenerateTemporaryMeshData(
+		const GLTFObject& gltfObj, bool meshShader, const MeshProcessingOptions& options
+	) {
 		MeshBundleTemporaryData meshBundleTempData{};
 
-		const tinygltf::Model& gltf = gltfObj.Get();
-
 		if (meshShader)
-			GenerateMeshShaderData(gltf, meshBundleTempData);
+			GenerateMeshShaderData(gltfObj, options, meshBundleTempData);
 		else
-			GenerateVertexShaderData(gltf, meshBundleTempData);
+			GenerateVertexShaderData(gltfObj, options, meshBundleTempData);
+
+		GenerateMeshBundleLods(meshBundleTempData, options);
+
+		if (options.quantiseVertices)
+			QuantiseMeshBundleVertices(meshBundleTempData);
 
 		return meshBundleTempData;
 	}
@@ -1,34 +1,57 @@
 #include <SceneProcessor.hpp>
 #include <SolException.hpp>
+#include <TimeManager.hpp>
 #include <assimp/cimport.h>
 #include <assimp/postprocess.h>
 
 namespace Sol
 {
-SceneProcessor::SceneProcessor(const std::string& scenePath)
-	: m_scene{
-		aiImportFile(
-			scenePath.c_str(),
-			static_cast<std::uint32_t>(
-			aiProcess_CalcTangentSpace         |
-			aiProcess_Triangulate              |
-			aiProcess_JoinIdenticalVertices    |
-			aiProcess_MakeLeftHanded           |
-			aiProcess_FlipUVs                  |
-			aiProcess_FlipWindingOrder         |
-			aiProcess_GenBoundingBoxes         |
-			aiProcess_GenNormals               |
-			aiProcess_GenUVCoords              |
-			aiProcess_SortByPType              |
-			aiProcess_RemoveRedundantMaterials
-			)
-		)
-	}, m_filePath{ scenePath }
+SceneProcessor::SceneProcessor(const std::string& scenePath, const SceneImportFlags& importFlags)
+	: m_scene{ nullptr }, m_filePath{ scenePath }, m_importFlags{ importFlags }, m_importTime{}
 {
+	Timer importTimer{};
+
+	importTimer.SetTimer();
+
+	m_scene      = aiImportFile(scenePath.c_str(), GetPostProcessFlags(importFlags));
+
+	m_importTime = importTimer.GetDurationNano();
+
 	if (!m_scene)
 		throw Exception{ "SceneFileMissing", "The scene file couldn't be found." };
 }
 
+std::uint32_t SceneProcessor::GetPostProcessFlags(const SceneImportFlags& importFlags) noexcept
+{
+	// The mesh processing only handles the triangles and uses the bounding boxes of the meshes.
+	auto postProcessFlags = static_cast<std::uint32_t>(
+		aiProcess_Triangulate              |
+		aiProcess_MakeLeftHanded           |
+		aiProcess_FlipUVs                  |
+		aiProcess_FlipWindingOrder         |
+		aiProcess_GenBoundingBoxes         |
+		aiProcess_SortByPType
+	);
+
+	if (importFlags.calcTangentSpace)
+		postProcessFlags |= aiProcess_CalcTangentSpace;
+
+	if (importFlags.joinIdenticalVertices)
+		postProcessFlags |= aiProcess_JoinIdenticalVertices;
+
+	// Only generates the normals of the meshes which don't have them.
+	if (importFlags.genNormals)
+		postProcessFlags |= aiProcess_GenNormals;
+
+	if (importFlags.genUVCoords)
+		postProcessFlags |= aiProcess_GenUVCoords;
+
+	if (importFlags.removeRedundantMaterials)
+		postProcessFlags |= aiProcess_RemoveRedundantMaterials;
+
+	return postProcessFlags;
+}
+
 SceneProcessor::~SceneProcessor() noexcept
 {
 	if (m_scene)
@@ -1,4 +1,7 @@
 #include <SolMeshUtility.hpp>
+#include <algorithm>
+#include <iterator>
+#include <MeshletMaker.hpp>
 
 namespace Sol
 {
@@ -7,15 +10,54 @@ static MeshTextureDetails s_defaultTextureDetails{};
 void CopyAndOffsetIndices(
 	std::vector<std::uint32_t>& dst, const std::vector<std::uint32_t>& src, std::uint32_t offset
 ) noexcept {
-	const size_t srcElementCount = std::size(src);
-	const size_t dstElementCount = std::size(dst);
+	std::ranges::transform(
+		src, std::back_inserter(dst), [offset](std::uint32_t index) { return offset + index; }
+	);
+}
 
-	const size_t dstDataStart    = dstElementCount;
+// Mesh Bundle Element Counts
+void MeshBundleElementCounts::AddMesh(
+	size_t meshVertexCount, size_t meshIndexCount, bool meshShader,
+	MeshletLimitsType meshletLimits
+) noexcept {
+	vertexCount += meshVertexCount;
+	// A meshlet can't have more unique vertex indices than the indices of its triangles.
+	indexCount  += meshIndexCount;
 
-	dst.resize(srcElementCount + dstElementCount);
+	if (meshShader)
+	{
+		const size_t triangleCount = meshIndexCount / 3u;
 
-	for (size_t index = 0u; index < srcElementCount; ++index)
-		dst[index + dstDataStart] = offset + src[index];
+		// The meshlet generators keep the space for a full meshlet after the current one, so
+		// the last meshlet of a mesh could reserve that much more.
+		const auto [vertexLimit, primitiveLimit] = VisitMeshletLimits(
+			meshletLimits,
+			[]<typename Limits_t>(Limits_t)
+			{
+				return std::pair{ Limits_t::s_vertexLimit, Limits_t::s_primitiveLimit };
+			}
+		);
+
+		indexCount     += vertexLimit;
+		primitiveCount += triangleCount + primitiveLimit;
+		meshletCount   += GetMeshletCountUpperBound(triangleCount, meshletLimits);
+	}
+}
+
+void ReserveMeshBundleData(
+	MeshBundleTemporaryData& meshBundleTempData, const MeshBundleElementCounts& elementCounts
+) {
+	meshBundleTempData.vertices.reserve(elementCounts.vertexCount);
+	meshBundleTempData.indices.reserve(elementCounts.indexCount);
+	meshBundleTempData.primIndices.reserve(elementCounts.primitiveCount);
+	meshBundleTempData.meshletDetails.reserve(elementCounts.meshletCount);
+}
+
+void TrimMeshBundleData(MeshBundleTemporaryData& meshBundleTempData)
+{
+	ReallocateToSize(meshBundleTempData.indices);
+	ReallocateToSize(meshBundleTempData.primIndices);
+	ReallocateToSize(meshBundleTempData.meshletDetails);
 }
 
 void SetDefaultTextureDetails(std::uint32_t textureIndex, std::uint32_t bindingIndex) noexcept
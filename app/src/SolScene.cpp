@@ -3,8 +3,9 @@
 
 namespace Sol
 {
-void SolScene::SetSceneNodes(const SceneProcessor& sceneProcessor)
-{
+void SolScene::SetSceneNodes(
+	const SceneProcessor& sceneProcessor, const MeshProcessingOptions& meshOptions
+) {
 	using namespace DirectX;
 
 	aiScene const* scene   = sceneProcessor.GetScene();
@@ -19,12 +20,20 @@ void SolScene::SetSceneNodes(const SceneProcessor& sceneProcessor)
 
 	std::uint32_t modelIndex = 0u;
 
+	// With the deduplication, the nodes reference the first mesh with the same geometry and
+	// material, so the models of a mesh which was exported multiple times can be drawn as
+	// instances.
+	const std::vector<std::uint32_t> meshRemap = SceneMeshProcessor::GenerateNodeMeshRemap(
+		scene, meshOptions
+	);
+
 	// There can be more nodes than the mesh count, but can't get that value here. So, in some
 	// cases this might cause no extra allocations?
 	m_sceneNodeData.reserve(meshCount);
 
 	ProcessSceneNodeDetails(
-		rootNode, m_sceneNodeData, accumulatedTransform, meshes, childrenOffset, modelIndex
+		rootNode, m_sceneNodeData, accumulatedTransform, meshes, meshRemap, childrenOffset,
+		modelIndex
 	);
 
 	// Calculate the transform for the root.
@@ -33,24 +42,25 @@ void SolScene::SetSceneNodes(const SceneProcessor& sceneProcessor)
 		accumulatedTransform * XMMatrixTranspose(GetXMMatrix(rootNode->mTransformation));
 
 	TraverseMeshHierarchyDetails(
-		rootNode, accumulatedTransform, m_sceneNodeData, meshes, childrenOffset, modelIndex
+		rootNode, accumulatedTransform, m_sceneNodeData, meshes, meshRemap, childrenOffset,
+		modelIndex
 	);
 }
 
 void SolScene::SetMeshMaterialDetails(
 	const SceneProcessor& sceneProcessor, const SceneMaterialProcessor& materialProcessor
 ) {
-	aiScene const* scene   = sceneProcessor.GetScene();
-
-	aiMesh** meshes        = scene->mMeshes;
-	const size_t meshCount = scene->mNumMeshes;
+	SetMeshMaterialDetails(GetMeshMaterialIndices(sceneProcessor), materialProcessor);
+}
 
-	m_meshMaterialDetails.reserve(meshCount);
+void SolScene::SetMeshMaterialDetails(
+	std::span<const std::uint32_t> meshMaterialIndices,
+	const SceneMaterialProcessor& materialProcessor
+) {
+	m_meshMaterialDetails.reserve(std::size(meshMaterialIndices));
 
-	for (size_t index = 0u; index < meshCount; ++index)
+	for (const std::uint32_t materialIndex : meshMaterialIndices)
 	{
-		const size_t materialIndex = meshes[index]->mMaterialIndex;
-
 		const SceneMaterialProcessor::MaterialDetails& tempMaterialDetails
 			= materialProcessor.GetMaterialDetails(materialIndex);
 
@@ -66,9 +76,25 @@ void SolScene::SetMeshMaterialDetails(
 	}
 }
 
+std::vector<std::uint32_t> SolScene::GetMeshMaterialIndices(const SceneProcessor& sceneProcessor)
+{
+	aiScene const* scene   = sceneProcessor.GetScene();
+
+	aiMesh** meshes        = scene->mMeshes;
+	const size_t meshCount = scene->mNumMeshes;
+
+	std::vector<std::uint32_t> meshMaterialIndices(meshCount);
+
+	for (size_t index = 0u; index < meshCount; ++index)
+		meshMaterialIndices[index] = meshes[index]->mMaterialIndex;
+
+	return meshMaterialIndices;
+}
+
 void SolScene::ProcessSceneNodeDetails(
 	aiNode const* node, std::vector<SceneNodeData>& sceneNodeData,
-	DirectX::XMMATRIX accumulatedTransform, aiMesh** meshes, std::uint32_t& childrenOffset,
+	DirectX::XMMATRIX accumulatedTransform, aiMesh** meshes,
+	std::span<const std::uint32_t> meshRemap, std::uint32_t& childrenOffset,
 	std::uint32_t& modelIndex
 ) {
 	const std::uint32_t childCount = node->mNumChildren;
@@ -93,7 +119,7 @@ void SolScene::ProcessSceneNodeDetails(
 				continue;
 
 			// Multiple meshes per node isn't supported yet.
-			meshIndex = static_cast<std::uint32_t>(currentMeshIndex);
+			meshIndex = meshRemap[currentMeshIndex];
 
 			currentModelIndex = modelIndex;
 			++modelIndex;
@@ -126,8 +152,9 @@ void SolScene::ProcessSceneNodeDetails(
 
 void SolScene::TraverseMeshHierarchyDetails(
 	aiNode const* node, DirectX::XMMATRIX accumulatedTransform,
-	std::vector<SceneNodeData>& sceneNodeData,
-	aiMesh** meshes, std::uint32_t& childrenOffset, std::uint32_t& modelIndex
+	std::vector<SceneNodeData>& sceneNodeData, aiMesh** meshes,
+	std::span<const std::uint32_t> meshRemap, std::uint32_t& childrenOffset,
+	std::uint32_t& modelIndex
 ) {
 	using namespace DirectX;
 
@@ -136,8 +163,8 @@ void SolScene::TraverseMeshHierarchyDetails(
 
 	for (size_t index = 0u; index < childCount; ++index)
 		ProcessSceneNodeDetails(
-			children[index], sceneNodeData, accumulatedTransform, meshes, childrenOffset,
-			modelIndex
+			children[index], sceneNodeData, accumulatedTransform, meshes, meshRemap,
+			childrenOffset, modelIndex
 		);
 
 	for (size_t index = 0u; index < childCount; ++index)
@@ -150,7 +177,8 @@ void SolScene::TraverseMeshHierarchyDetails(
 			tempAccumulatedTransform * XMMatrixTranspose(GetXMMatrix(child->mTransformation));
 
 		TraverseMeshHierarchyDetails(
-			child, tempAccumulatedTransform, sceneNodeData, meshes, childrenOffset, modelIndex
+			child, tempAccumulatedTransform, sceneNodeData, meshes, meshRemap, childrenOffset,
+			modelIndex
 		);
 	}
 }
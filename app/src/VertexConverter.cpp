@@ -0,0 +1,304 @@
+#include <VertexConverter.hpp>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+namespace Sol
+{
+namespace VertexConverter
+{
+	static_assert(
+		sizeof(Vertex) == sizeof(float) * 8u && offsetof(Vertex, normal) == sizeof(float) * 3u
+		&& offsetof(Vertex, uv) == sizeof(float) * 6u,
+		"The vertices are written as 8 tightly packed floats."
+	);
+
+	// The stream of a missing attribute is the attribute of the fallback vertex without a
+	// stride, so the loops don't have to check the attributes.
+	[[nodiscard]]
+	static AttributeStream GetStream(const AttributeStream& stream, void const* fallback) noexcept
+	{
+		if (stream.data)
+			return stream;
+
+		return AttributeStream{ .data = fallback, .stride = 0u };
+	}
+
+	// The stream from the element at the index.
+	[[nodiscard]]
+	static AttributeStream OffsetStream(const AttributeStream& stream, size_t index) noexcept
+	{
+		if (!stream.data)
+			return stream;
+
+		AttributeStream offsetStream = stream;
+
+		offsetStream.data = static_cast<std::uint8_t const*>(stream.data) + stream.stride * index;
+
+		return offsetStream;
+	}
+
+	[[nodiscard]]
+	static float const* GetElement(void const* data, size_t stride, size_t index) noexcept
+	{
+		return reinterpret_cast<float const*>(
+			static_cast<std::uint8_t const*>(data) + stride * index
+		);
+	}
+
+	// Flips the sign bit like the SSE path does, instead of multiplying, so a NaN comes out the
+	// same from both paths.
+	[[nodiscard]]
+	static float FlipSign(float value, std::uint32_t signMask) noexcept
+	{
+		return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) ^ signMask);
+	}
+
+	// The strides which aren't 0 are known at compile time, so the addresses of the elements
+	// don't need a multiplication with a runtime stride.
+	template<size_t positionStride_t, size_t normalStride_t, size_t uvStride_t>
+	static void ConvertFloatVertices(
+		std::span<Vertex> vertices, const AttributeStream& positions,
+		const AttributeStream& normals, const AttributeStream& uvs, bool flipZ
+	) noexcept {
+		const size_t positionStride = positionStride_t ? positionStride_t : positions.stride;
+		const size_t normalStride   = normalStride_t ? normalStride_t : normals.stride;
+		const size_t uvStride       = uvStride_t ? uvStride_t : uvs.stride;
+
+		const size_t vertexCount = std::size(vertices);
+
+		size_t index = 0u;
+
+#if defined(_XM_SSE_INTRINSICS_)
+		const __m128 signMask = flipZ ? _mm_set_ps(0.f, -0.f, 0.f, 0.f) : _mm_setzero_ps();
+
+		// The positions and the normals are loaded as 4 floats. So, the last vertex is done
+		// by the scalar loop, as the fourth float could be after the end of its stream.
+		const size_t vectorVertexCount = vertexCount ? vertexCount - 1u : 0u;
+
+		for (; index < vectorVertexCount; ++index)
+		{
+			const __m128 position = _mm_xor_ps(
+				_mm_loadu_ps(GetElement(positions.data, positionStride, index)), signMask
+			);
+			const __m128 normal   = _mm_xor_ps(
+				_mm_loadu_ps(GetElement(normals.data, normalStride, index)), signMask
+			);
+			const __m128 uv       = _mm_castpd_ps(
+				_mm_load_sd(
+					reinterpret_cast<double const*>(GetElement(uvs.data, uvStride, index))
+				)
+			);
+
+			// [pz, pz, nx, nx]
+			const __m128 positionZNormalX = _mm_shuffle_ps(
+				position, normal, _MM_SHUFFLE(0, 0, 2, 2)
+			);
+			// [px, py, pz, nx]
+			const __m128 firstHalf  = _mm_shuffle_ps(
+				position, positionZNormalX, _MM_SHUFFLE(2, 0, 1, 0)
+			);
+			// [ny, nz, u, v]
+			const __m128 secondHalf = _mm_shuffle_ps(normal, uv, _MM_SHUFFLE(1, 0, 2, 1));
+
+			auto vertexData = reinterpret_cast<float*>(std::data(vertices) + index);
+
+			_mm_storeu_ps(vertexData, firstHalf);
+			_mm_storeu_ps(vertexData + 4u, secondHalf);
+		}
+#endif
+
+		const std::uint32_t zSignMask = flipZ ? 0x8000'0000u : 0u;
+
+		for (; index < vertexCount; ++index)
+		{
+			float const* position = GetElement(positions.data, positionStride, index);
+			float const* normal   = GetElement(normals.data, normalStride, index);
+			float const* uv       = GetElement(uvs.data, uvStride, index);
+
+			vertices[index] = Vertex
+			{
+				.position = DirectX::XMFLOAT3{
+					position[0], position[1], FlipSign(position[2], zSignMask)
+				},
+				.normal   = DirectX::XMFLOAT3{
+					normal[0], normal[1], FlipSign(normal[2], zSignMask)
+				},
+				.uv       = DirectX::XMFLOAT2{ uv[0], uv[1] }
+			};
+		}
+	}
+
+	// Like the glTF spec, the normalised signed components are clamped at -1, as their
+	// minimum would go slightly below it.
+	template<typename Component_t>
+	[[nodiscard]]
+	static float DecodeComponent(std::uint8_t const* componentData, bool normalised) noexcept
+	{
+		Component_t component{};
+
+		memcpy(&component, componentData, sizeof(Component_t));
+
+		const auto value = static_cast<float>(component);
+
+		if constexpr (std::is_floating_point_v<Component_t>)
+			return value;
+		else
+		{
+			if (!normalised)
+				return value;
+
+			const float normalisedValue
+				= value / static_cast<float>(std::numeric_limits<Component_t>::max());
+
+			if constexpr (std::is_signed_v<Component_t>)
+				return std::max(normalisedValue, -1.f);
+			else
+				return normalisedValue;
+		}
+	}
+
+	template<typename Component_t, size_t componentCount_t>
+	static void DecodeElement(
+		std::uint8_t const* elementData, bool normalised, float* output
+	) noexcept {
+		for (size_t index = 0u; index < componentCount_t; ++index)
+			output[index] = DecodeComponent<Component_t>(
+				elementData + sizeof(Component_t) * index, normalised
+			);
+	}
+
+	using DecodeElementFunction = void(*)(std::uint8_t const*, bool, float*) noexcept;
+
+	template<size_t componentCount_t>
+	[[nodiscard]]
+	static DecodeElementFunction GetDecodeFunction(ComponentType componentType) noexcept
+	{
+		switch (componentType)
+		{
+		case ComponentType::Int8:
+			return &DecodeElement<std::int8_t, componentCount_t>;
+		case ComponentType::UInt8:
+			return &DecodeElement<std::uint8_t, componentCount_t>;
+		case ComponentType::Int16:
+			return &DecodeElement<std::int16_t, componentCount_t>;
+		case ComponentType::UInt16:
+			return &DecodeElement<std::uint16_t, componentCount_t>;
+		default:
+			return &DecodeElement<float, componentCount_t>;
+		}
+	}
+
+	// Every attribute is decoded straight into its vertex, so the vertices are still written
+	// in a single pass.
+	static void ConvertDecodedVertices(
+		std::span<Vertex> vertices, const AttributeStream& positions,
+		const AttributeStream& normals, const AttributeStream& uvs, bool flipZ
+	) noexcept {
+		const DecodeElementFunction decodePosition = GetDecodeFunction<3u>(
+			positions.componentType
+		);
+		const DecodeElementFunction decodeNormal   = GetDecodeFunction<3u>(normals.componentType);
+		const DecodeElementFunction decodeUV       = GetDecodeFunction<2u>(uvs.componentType);
+
+		auto positionData = static_cast<std::uint8_t const*>(positions.data);
+		auto normalData   = static_cast<std::uint8_t const*>(normals.data);
+		auto uvData       = static_cast<std::uint8_t const*>(uvs.data);
+
+		const std::uint32_t zSignMask = flipZ ? 0x8000'0000u : 0u;
+
+		for (Vertex& vertex : vertices)
+		{
+			decodePosition(positionData, positions.normalised, &vertex.position.x);
+			decodeNormal(normalData, normals.normalised, &vertex.normal.x);
+			decodeUV(uvData, uvs.normalised, &vertex.uv.x);
+
+			vertex.position.z = FlipSign(vertex.position.z, zSignMask);
+			vertex.normal.z   = FlipSign(vertex.normal.z, zSignMask);
+
+			positionData += positions.stride;
+			normalData   += normals.stride;
+			uvData       += uvs.stride;
+		}
+	}
+
+	void ConvertVertices(
+		std::span<Vertex> vertices, const VertexStreams& streams, bool flipZ,
+		const Vertex& defaultVertex
+	) noexcept {
+		// The fallback attributes are flipped beforehand, so flipping them again keeps them
+		// as the default ones.
+		Vertex fallbackVertex = defaultVertex;
+
+		if (flipZ)
+		{
+			fallbackVertex.position.z = -fallbackVertex.position.z;
+			fallbackVertex.normal.z   = -fallbackVertex.normal.z;
+		}
+
+		const AttributeStream positions = GetStream(streams.positions, &fallbackVertex.position);
+		const AttributeStream normals   = GetStream(streams.normals, &fallbackVertex.normal);
+		const AttributeStream uvs       = GetStream(streams.uvs, &fallbackVertex.uv);
+
+		const bool areFloats = positions.componentType == ComponentType::Float
+			&& normals.componentType == ComponentType::Float
+			&& uvs.componentType == ComponentType::Float;
+
+		if (!areFloats)
+		{
+			ConvertDecodedVertices(vertices, positions, normals, uvs, flipZ);
+
+			return;
+		}
+
+		const size_t positionStride = positions.stride;
+		const bool isInterleaved    = positionStride == normals.stride
+			&& positionStride == uvs.stride;
+
+		// The separate tightly packed streams and the common interleaved layouts. Like the
+		// positions, normals and uvs, with the tangents as well, or with some padding.
+		if (positionStride == 12u && normals.stride == 12u && uvs.stride == 8u)
+			ConvertFloatVertices<12u, 12u, 8u>(vertices, positions, normals, uvs, flipZ);
+		else if (isInterleaved && positionStride == 24u)
+			ConvertFloatVertices<24u, 24u, 24u>(vertices, positions, normals, uvs, flipZ);
+		else if (isInterleaved && positionStride == 32u)
+			ConvertFloatVertices<32u, 32u, 32u>(vertices, positions, normals, uvs, flipZ);
+		else if (isInterleaved && positionStride == 48u)
+			ConvertFloatVertices<48u, 48u, 48u>(vertices, positions, normals, uvs, flipZ);
+		else
+			ConvertFloatVertices<0u, 0u, 0u>(vertices, positions, normals, uvs, flipZ);
+	}
+
+	void AppendVertices(
+		std::vector<Vertex>& vertices, size_t vertexCount, const VertexStreams& streams,
+		bool flipZ, const Vertex& defaultVertex
+	) noexcept {
+		// 8KB, so a batch stays in the L1 cache until it is inserted.
+		static constexpr size_t s_batchVertexCount = 256u;
+
+		std::array<Vertex, s_batchVertexCount> batchVertices;
+
+		for (size_t batchStart = 0u; batchStart < vertexCount; batchStart += s_batchVertexCount)
+		{
+			const size_t batchVertexCount = std::min(s_batchVertexCount, vertexCount - batchStart);
+
+			const VertexStreams batchStreams
+			{
+				.positions = OffsetStream(streams.positions, batchStart),
+				.normals   = OffsetStream(streams.normals, batchStart),
+				.uvs       = OffsetStream(streams.uvs, batchStart)
+			};
+
+			std::span<Vertex> batch = std::span{ batchVertices }.first(batchVertexCount);
+
+			ConvertVertices(batch, batchStreams, flipZ, defaultVertex);
+
+			vertices.insert(std::end(vertices), std::begin(batch), std::end(batch));
+		}
+	}
+}
+}
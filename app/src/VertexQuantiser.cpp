@@ -0,0 +1,484 @@
+#include <VertexQuantiser.hpp>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <SolException.hpp>
+
+namespace Sol
+{
+namespace VertexQuantiser
+{
+	using namespace DirectX;
+
+	VertexQuantisation GenerateQuantisation(std::span<const Vertex> vertices) noexcept
+	{
+		VertexQuantisation quantisation{};
+
+		if (std::empty(vertices))
+			return quantisation;
+
+		// The uvs are in the xy and the negated uvs in the zw, so a single max gets both of
+		// their bounds.
+		XMVECTOR positionMin = XMVectorReplicate(std::numeric_limits<float>::max());
+		XMVECTOR positionMax = XMVectorReplicate(-std::numeric_limits<float>::max());
+		XMVECTOR uvMax       = XMVectorReplicate(-std::numeric_limits<float>::max());
+
+		const XMVECTOR uvSigns = XMVectorSet(1.f, 1.f, -1.f, -1.f);
+
+		for (const Vertex& vertex : vertices)
+		{
+			const XMVECTOR position = XMLoadFloat3(&vertex.position);
+			const XMVECTOR uv       = XMLoadFloat2(&vertex.uv);
+
+			positionMin = XMVectorMin(positionMin, position);
+			positionMax = XMVectorMax(positionMax, position);
+			uvMax       = XMVectorMax(uvMax, XMVectorSwizzle<0, 1, 0, 1>(uv) * uvSigns);
+		}
+
+		const XMVECTOR uvMin = -XMVectorSwizzle<2, 3, 2, 3>(uvMax);
+
+		XMStoreFloat4(&quantisation.positionMin, XMVectorSetW(positionMin, 0.f));
+		XMStoreFloat4(
+			&quantisation.positionExtent, XMVectorSetW(positionMax - positionMin, 0.f)
+		);
+		XMStoreFloat4(
+			&quantisation.uvBounds, XMVectorPermute<0, 1, 4, 5>(uvMin, uvMax - uvMin)
+		);
+
+		return quantisation;
+	}
+
+	// The flat axes don't have any extent, so their attributes are just stored as 0.
+	[[nodiscard]]
+	static XMVECTOR GetInverseExtent(FXMVECTOR extent) noexcept
+	{
+		return XMVectorSelect(
+			XMVectorZero(), XMVectorReciprocal(extent),
+			XMVectorGreater(extent, XMVectorReplicate(std::numeric_limits<float>::min()))
+		);
+	}
+
+	[[nodiscard]]
+	static XMVECTOR DecodeOctahedral(FXMVECTOR octahedral) noexcept
+	{
+		const XMVECTOR absolute = XMVectorAbs(octahedral);
+		const XMVECTOR z        = XMVectorSplatOne() - XMVectorSplatX(absolute)
+			- XMVectorSplatY(absolute);
+
+		// Unfold the lower half.
+		const XMVECTOR fold     = XMVectorMax(-z, XMVectorZero());
+		const XMVECTOR xy       = octahedral - XMVectorOrInt(
+			XMVectorAndInt(octahedral, XMVectorSplatSignMask()), fold
+		);
+
+		return XMVector3Normalize(XMVectorSelect(xy, z, g_XMSelect0010));
+	}
+
+	// The vertices are quantised four at a time, with the x, y and z of each attribute in
+	// their own vector.
+	static constexpr size_t s_vertexBatchSize = 4u;
+
+	struct VertexBatch
+	{
+		std::array<XMVECTOR, 3u> position;
+		std::array<XMVECTOR, 3u> normal;
+		std::array<XMVECTOR, 2u> uv;
+	};
+
+	// The lanes after the batch count repeat the last vertex.
+	[[nodiscard]]
+	static VertexBatch LoadVertexBatch(std::span<const Vertex> vertices) noexcept
+	{
+		const size_t lastLane = std::size(vertices) - 1u;
+
+		const Vertex& vertex0 = vertices[0];
+		const Vertex& vertex1 = vertices[std::min<size_t>(1u, lastLane)];
+		const Vertex& vertex2 = vertices[std::min<size_t>(2u, lastLane)];
+		const Vertex& vertex3 = vertices[std::min<size_t>(3u, lastLane)];
+
+		auto GatherLanes = [&](auto&& GetComponent)
+		{
+			return XMVectorSet(
+				GetComponent(vertex0), GetComponent(vertex1), GetComponent(vertex2),
+				GetComponent(vertex3)
+			);
+		};
+
+		return VertexBatch
+		{
+			.position = {
+				GatherLanes([](const Vertex& vertex) { return vertex.position.x; }),
+				GatherLanes([](const Vertex& vertex) { return vertex.position.y; }),
+				GatherLanes([](const Vertex& vertex) { return vertex.position.z; })
+			},
+			.normal   = {
+				GatherLanes([](const Vertex& vertex) { return vertex.normal.x; }),
+				GatherLanes([](const Vertex& vertex) { return vertex.normal.y; }),
+				GatherLanes([](const Vertex& vertex) { return vertex.normal.z; })
+			},
+			.uv       = {
+				GatherLanes([](const Vertex& vertex) { return vertex.uv.x; }),
+				GatherLanes([](const Vertex& vertex) { return vertex.uv.y; })
+			}
+		};
+	}
+
+	// Saturates and rounds to the nearest, like the unorm16 stores.
+	[[nodiscard]]
+	static XMVECTOR QuantiseUNorm16(FXMVECTOR value, FXMVECTOR min, FXMVECTOR scale) noexcept
+	{
+		return XMVectorFloor(
+			XMVectorMultiplyAdd(
+				XMVectorSaturate(XMVectorMultiply(XMVectorSubtract(value, min), scale)),
+				XMVectorReplicate(65535.f), XMVectorReplicate(0.5f)
+			)
+		);
+	}
+
+	// The normals are projected onto the octahedron and its lower half is folded over the
+	// diagonals. Then they are clamped and rounded to the nearest, like the snorm16 stores.
+	// The zero normals stay zero.
+	[[nodiscard]]
+	static std::array<XMVECTOR, 2u> QuantiseOctahedral(
+		const std::array<XMVECTOR, 3u>& normal
+	) noexcept {
+		const XMVECTOR one = XMVectorSplatOne();
+
+		const XMVECTOR l1Length = XMVectorAdd(
+			XMVectorAdd(XMVectorAbs(normal[0]), XMVectorAbs(normal[1])), XMVectorAbs(normal[2])
+		);
+		const XMVECTOR inverseLength = XMVectorSelect(
+			XMVectorZero(), XMVectorReciprocal(l1Length),
+			XMVectorGreater(l1Length, XMVectorZero())
+		);
+
+		const XMVECTOR octahedralX = XMVectorMultiply(normal[0], inverseLength);
+		const XMVECTOR octahedralY = XMVectorMultiply(normal[1], inverseLength);
+
+		auto GetSigns = [&one](FXMVECTOR value)
+		{
+			return XMVectorOrInt(XMVectorAndInt(value, XMVectorSplatSignMask()), one);
+		};
+
+		const XMVECTOR foldedX = XMVectorMultiply(
+			XMVectorSubtract(one, XMVectorAbs(octahedralY)), GetSigns(octahedralX)
+		);
+		const XMVECTOR foldedY = XMVectorMultiply(
+			XMVectorSubtract(one, XMVectorAbs(octahedralX)), GetSigns(octahedralY)
+		);
+
+		const XMVECTOR isLowerHalf = XMVectorLess(normal[2], XMVectorZero());
+
+		auto QuantiseSNorm16 = [&one](FXMVECTOR value)
+		{
+			return XMVectorRound(
+				XMVectorMultiply(
+					XMVectorClamp(value, XMVectorNegate(one), one), XMVectorReplicate(32767.f)
+				)
+			);
+		};
+
+		return {
+			QuantiseSNorm16(XMVectorSelect(octahedralX, foldedX, isLowerHalf)),
+			QuantiseSNorm16(XMVectorSelect(octahedralY, foldedY, isLowerHalf))
+		};
+	}
+
+	[[nodiscard]]
+	static std::array<float, s_vertexBatchSize> GetLanes(FXMVECTOR value) noexcept
+	{
+		XMFLOAT4 lanes{};
+		XMStoreFloat4(&lanes, value);
+
+		return { lanes.x, lanes.y, lanes.z, lanes.w };
+	}
+
+	void QuantiseVertices(
+		std::span<const Vertex> vertices, const VertexQuantisation& quantisation,
+		std::span<QuantisedVertex> quantisedVertices
+	) noexcept {
+		assert(
+			std::size(vertices) == std::size(quantisedVertices)
+			&& "The vertex counts aren't the same."
+		);
+
+		const XMVECTOR positionScale = GetInverseExtent(
+			XMLoadFloat4(&quantisation.positionExtent)
+		);
+		const XMVECTOR uvScale       = GetInverseExtent(
+			XMVectorSwizzle<2, 3, 2, 3>(XMLoadFloat4(&quantisation.uvBounds))
+		);
+
+		// Each bound splatted to every lane.
+		const std::array<XMVECTOR, 3u> positionMins
+		{
+			XMVectorReplicate(quantisation.positionMin.x),
+			XMVectorReplicate(quantisation.positionMin.y),
+			XMVectorReplicate(quantisation.positionMin.z)
+		};
+		const std::array<XMVECTOR, 3u> positionScales
+		{
+			XMVectorSplatX(positionScale), XMVectorSplatY(positionScale),
+			XMVectorSplatZ(positionScale)
+		};
+		const std::array<XMVECTOR, 2u> uvMins
+		{
+			XMVectorReplicate(quantisation.uvBounds.x),
+			XMVectorReplicate(quantisation.uvBounds.y)
+		};
+		const std::array<XMVECTOR, 2u> uvScales
+		{
+			XMVectorSplatX(uvScale), XMVectorSplatY(uvScale)
+		};
+
+		const size_t vertexCount = std::size(vertices);
+
+		for (size_t batchStart = 0u; batchStart < vertexCount; batchStart += s_vertexBatchSize)
+		{
+			const size_t batchCount = std::min(s_vertexBatchSize, vertexCount - batchStart);
+
+			const VertexBatch batch = LoadVertexBatch(vertices.subspan(batchStart, batchCount));
+
+			const std::array<XMVECTOR, 2u> normals = QuantiseOctahedral(batch.normal);
+
+			const auto positionX = GetLanes(
+				QuantiseUNorm16(batch.position[0], positionMins[0], positionScales[0])
+			);
+			const auto positionY = GetLanes(
+				QuantiseUNorm16(batch.position[1], positionMins[1], positionScales[1])
+			);
+			const auto positionZ = GetLanes(
+				QuantiseUNorm16(batch.position[2], positionMins[2], positionScales[2])
+			);
+			const auto normalX   = GetLanes(normals[0]);
+			const auto normalY   = GetLanes(normals[1]);
+			const auto uvX       = GetLanes(QuantiseUNorm16(batch.uv[0], uvMins[0], uvScales[0]));
+			const auto uvY       = GetLanes(QuantiseUNorm16(batch.uv[1], uvMins[1], uvScales[1]));
+
+			for (size_t lane = 0u; lane < batchCount; ++lane)
+			{
+				QuantisedVertex& quantisedVertex = quantisedVertices[batchStart + lane];
+
+				quantisedVertex.position.x = static_cast<std::uint16_t>(positionX[lane]);
+				quantisedVertex.position.y = static_cast<std::uint16_t>(positionY[lane]);
+				quantisedVertex.position.z = static_cast<std::uint16_t>(positionZ[lane]);
+				quantisedVertex.position.w = 0u;
+				quantisedVertex.normal.x   = static_cast<std::int16_t>(normalX[lane]);
+				quantisedVertex.normal.y   = static_cast<std::int16_t>(normalY[lane]);
+				quantisedVertex.uv.x       = static_cast<std::uint16_t>(uvX[lane]);
+				quantisedVertex.uv.y       = static_cast<std::uint16_t>(uvY[lane]);
+			}
+		}
+	}
+
+	void DequantiseVertices(
+		std::span<const QuantisedVertex> quantisedVertices,
+		const VertexQuantisation& quantisation, std::span<Vertex> vertices
+	) noexcept {
+		assert(
+			std::size(vertices) == std::size(quantisedVertices)
+			&& "The vertex counts aren't the same."
+		);
+
+		const XMVECTOR positionMin    = XMLoadFloat4(&quantisation.positionMin);
+		const XMVECTOR positionExtent = XMLoadFloat4(&quantisation.positionExtent);
+
+		const XMVECTOR uvBounds = XMLoadFloat4(&quantisation.uvBounds);
+		const XMVECTOR uvExtent = XMVectorSwizzle<2, 3, 2, 3>(uvBounds);
+
+		const size_t vertexCount = std::size(vertices);
+
+		for (size_t index = 0u; index < vertexCount; ++index)
+		{
+			const QuantisedVertex& quantisedVertex = quantisedVertices[index];
+			Vertex& vertex                         = vertices[index];
+
+			XMStoreFloat3(
+				&vertex.position,
+				XMVectorMultiplyAdd(
+					PackedVector::XMLoadUShortN4(&quantisedVertex.position), positionExtent,
+					positionMin
+				)
+			);
+			XMStoreFloat3(
+				&vertex.normal,
+				DecodeOctahedral(PackedVector::XMLoadShortN2(&quantisedVertex.normal))
+			);
+			XMStoreFloat2(
+				&vertex.uv,
+				XMVectorMultiplyAdd(
+					PackedVector::XMLoadUShortN2(&quantisedVertex.uv), uvExtent, uvBounds
+				)
+			);
+		}
+	}
+}
+
+// The vertices of a mesh go from its vertexOffset to the next larger offset of any mesh. The
+// meshes which share their vertices with an earlier one have its index as the firstMeshIndex.
+struct MeshVertexRange
+{
+	size_t vertexOffset;
+	size_t vertexCount;
+	size_t firstMeshIndex;
+};
+
+// In the same order as the quantisations.
+[[nodiscard]]
+static std::vector<MeshVertexRange> GetMeshVertexRanges(
+	const MeshBundleTemporaryDetails& bundleDetails, size_t bundleVertexCount
+) {
+	std::vector<std::uint32_t> vertexOffsets{};
+
+	for (const MeshTemporaryDetailsMS& meshDetails : bundleDetails.meshTemporaryDetailsMS)
+		vertexOffsets.emplace_back(meshDetails.vertexOffset);
+
+	for (const MeshTemporaryDetailsVS& meshDetails : bundleDetails.meshTemporaryDetailsVS)
+		vertexOffsets.emplace_back(meshDetails.vertexOffset);
+
+	std::vector<std::uint32_t> sortedOffsets = vertexOffsets;
+
+	std::ranges::sort(sortedOffsets);
+
+	const auto duplicateOffsets = std::ranges::unique(sortedOffsets);
+	sortedOffsets.erase(std::begin(duplicateOffsets), std::end(duplicateOffsets));
+
+	constexpr auto noMesh = std::numeric_limits<size_t>::max();
+
+	std::vector<size_t> firstMeshIndices(std::size(sortedOffsets), noMesh);
+
+	const size_t meshCount = std::size(vertexOffsets);
+
+	std::vector<MeshVertexRange> vertexRanges{};
+	vertexRanges.reserve(meshCount);
+
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		const size_t vertexOffset = vertexOffsets[index];
+
+		assert(vertexOffset <= bundleVertexCount && "The vertex offset is outside.");
+
+		const auto nextOffset = std::ranges::upper_bound(sortedOffsets, vertexOffset);
+		const size_t vertexEnd
+			= nextOffset != std::end(sortedOffsets) ? *nextOffset : bundleVertexCount;
+
+		size_t& firstMeshIndex = firstMeshIndices[
+			static_cast<size_t>(std::distance(std::begin(sortedOffsets), nextOffset)) - 1u
+		];
+
+		if (firstMeshIndex == noMesh)
+			firstMeshIndex = index;
+
+		vertexRanges.emplace_back(
+			MeshVertexRange
+			{
+				.vertexOffset   = vertexOffset,
+				.vertexCount    = vertexEnd - vertexOffset,
+				.firstMeshIndex = firstMeshIndex
+			}
+		);
+	}
+
+	return vertexRanges;
+}
+
+void QuantiseMeshBundleVertices(MeshBundleTemporaryData& bundleData)
+{
+	if (bundleData.vertexLayout == VertexLayout::Quantised)
+		return;
+
+	std::span<const Vertex> vertices = bundleData.vertices;
+	const size_t vertexCount         = std::size(vertices);
+
+	const std::vector<MeshVertexRange> vertexRanges = GetMeshVertexRanges(
+		bundleData.bundleDetails, vertexCount
+	);
+
+	// Without any meshes, there would be nothing to decode the vertices with.
+	if (std::empty(vertexRanges))
+		return;
+
+	const size_t meshCount = std::size(vertexRanges);
+
+	bundleData.quantisedVertices.resize(vertexCount);
+	bundleData.vertexQuantisations.resize(meshCount);
+
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		const MeshVertexRange& vertexRange = vertexRanges[index];
+		VertexQuantisation& quantisation   = bundleData.vertexQuantisations[index];
+
+		// The shared vertices have already been quantised.
+		if (vertexRange.firstMeshIndex != index)
+		{
+			quantisation = bundleData.vertexQuantisations[vertexRange.firstMeshIndex];
+
+			continue;
+		}
+
+		std::span<const Vertex> meshVertices = vertices.subspan(
+			vertexRange.vertexOffset, vertexRange.vertexCount
+		);
+
+		quantisation = VertexQuantiser::GenerateQuantisation(meshVertices);
+
+		VertexQuantiser::QuantiseVertices(
+			meshVertices, quantisation,
+			std::span{ bundleData.quantisedVertices }.subspan(
+				vertexRange.vertexOffset, vertexRange.vertexCount
+			)
+		);
+	}
+
+	bundleData.vertices     = std::vector<Vertex>{};
+	bundleData.vertexLayout = VertexLayout::Quantised;
+}
+
+std::vector<Vertex> DequantiseMeshBundleVertices(const MeshBundleTemporaryData& bundleData)
+{
+	if (bundleData.vertexLayout == VertexLayout::Float)
+		return bundleData.vertices;
+
+	std::span<const QuantisedVertex> quantisedVertices = bundleData.quantisedVertices;
+	const size_t vertexCount = std::size(quantisedVertices);
+
+	const std::vector<MeshVertexRange> vertexRanges = GetMeshVertexRanges(
+		bundleData.bundleDetails, vertexCount
+	);
+
+	const size_t meshCount = std::size(vertexRanges);
+
+	assert(
+		meshCount == std::size(bundleData.vertexQuantisations)
+		&& "Each mesh should have a quantisation."
+	);
+
+	std::vector<Vertex> vertices(vertexCount);
+
+	for (size_t index = 0u; index < meshCount; ++index)
+	{
+		const MeshVertexRange& vertexRange = vertexRanges[index];
+
+		if (vertexRange.firstMeshIndex != index)
+			continue;
+
+		VertexQuantiser::DequantiseVertices(
+			quantisedVertices.subspan(vertexRange.vertexOffset, vertexRange.vertexCount),
+			bundleData.vertexQuantisations[index],
+			std::span{ vertices }.subspan(vertexRange.vertexOffset, vertexRange.vertexCount)
+		);
+	}
+
+	return vertices;
+}
+
+void CheckRenderableVertexLayout(const MeshBundleTemporaryData& bundleData)
+{
+	if (bundleData.vertexLayout != VertexLayout::Float)
+		throw Exception{
+			"QuantisedMeshBundle", "The renderer can't draw the quantised vertices yet."
+		};
+}
+}
@@ -14,7 +14,9 @@
 #include <SceneMaterialProcessor.hpp>
 #include <AllocationLiterals.hpp>
 #include <SolScene.hpp>
+#include <AsyncSceneLoader.hpp>
 #include <RendererUtility.hpp>
+#include <ConfigManager.hpp>
 
 namespace ExampleApp
 {
@@ -48,8 +50,12 @@ public:
 	template<class Renderer_t, class ExtensionManager_t, class RenderPassManager_t>
 	void Init(
 		Renderer_t& renderer, ExtensionManager_t& extensionManager,
-		RenderPassManager_t& renderPassManager
+		RenderPassManager_t& renderPassManager, const ConfigManager& configManager,
+		const ParallelWork& meshWork
 	) {
+		// Every mesh bundle is made with the limits the mesh shaders were configured for.
+		meshletLimits = configManager.GetMeshletLimitsType();
+
 		auto* blinnPhong       = extensionManager.GetBlinnPhongLight();
 
 		auto* transparencyPass = extensionManager.GetWeightedTransparency();
@@ -107,36 +113,33 @@ public:
 		}
 
 		{
-			MeshBundleTempAssimp assimpMeshBundle{};
-
-			auto sceneProcessor = std::make_shared<SceneProcessor>(
-				"resources/meshes/shiba/scene.gltf"
-			);
-
-			SceneMaterialProcessor materialProcessor{ sceneProcessor };
-			materialProcessor.ProcessMeshAndMaterialData();
+			// The scene is imported and processed on the thread pool, or read from its cooked
+			// cache, so the first frames don't wait for it. The PhysicsUpdate adds it to the
+			// renderer once it is ready.
+			const bool isMeshPipeline
+				= renderPassManager.GetGraphicsPipelineManager().IsMeshShaderPipeline();
 
-			materialProcessor.LoadBlinnPhongMaterials(renderer, *blinnPhong);
-			//materialProcessor.LoadTextures(*m_renderer);
-			materialProcessor.LoadTexturesAsAtlas(renderer);
-
-			assimpMeshBundle.SetSceneProcessor(sceneProcessor);
-
-			testScene.SetSceneNodes(*sceneProcessor);
-			testScene.SetMeshMaterialDetails(*sceneProcessor, materialProcessor);
+			const SceneLoadOptions loadOptions
+			{
+				.meshShader  = isMeshPipeline,
+				.meshOptions = MeshProcessingOptions{ .meshletLimits = meshletLimits },
+				.importFlags = configManager.GetSceneImportFlags(),
+				.workerCount = meshWork.workerCount,
+				.useCache    = true
+			};
 
-			assimpMeshBundleIndex = renderer.AddMeshBundle(
-				GetPipelineSpecificMeshBundle(assimpMeshBundle, renderPassManager)
+			sceneLoad = LoadSceneAsync(
+				"resources/meshes/shiba/scene.gltf", loadOptions, meshWork.submitWork
 			);
 		}
 
 		{
 			GLTFObject gltf{};
 
-			gltf.LoadFromFile("resources/meshes/shiba/scene.gltf");
+			gltf.LoadFromFile("resources/meshes/shiba/scene.gltf", GLTFBufferMode::Mapped);
 
 			MeshBundleTemporaryData meshData = SceneMeshProcessor1::GenerateTemporaryMeshData(
-				gltf, true
+				gltf, true, MeshProcessingOptions{ .meshletLimits = meshletLimits }
 			);
 		}
 
@@ -363,64 +366,6 @@ public:
 			if (transparencyPass)
 				transparencyPass->AddTransparentModelBundle(quadBundleIndexT, renderer);
 		}
-
-	{
-		assimpModelBundle1 = std::make_unique<ModelBundleBase>();
-
-		assimpModelBundle1->SetModelContainer(modelContainer);
-
-		assimpModelBundle1->SetMeshBundle(assimpMeshBundleIndex, 0.5f, testScene);
-		assimpModelBundle1->MoveTowardsZ(0u, -1.f);
-		//assimpModelBundle1->MoveTowardsY(0u, -0.75f);
-		assimpModelBundle1->RotateRollDegree(0u, 90.f);
-		assimpModelBundle1->RotatePitchDegree(0u, 90.f);
-		assimpModelBundle1->SetMeshBundleIndex(assimpMeshBundleIndex);
-
-		assimpBundleIndex1 = renderer.AddModelBundle(assimpModelBundle1->GetModelBundle());
-
-		renderPassManager.AddModelBundle(assimpBundleIndex1, renderer);
-
-		if (transparencyPass)
-			transparencyPass->AddTransparentModelBundle(assimpBundleIndex1, renderer);
-	}
-
-		/*
-		{
-			assimpModelBundle2 = std::make_unique<ModelBundleBase>();
-
-			assimpModelBundle2->SetMeshBundle(assimpMeshBundleIndex, 0.5f, assimpMeshBundle);
-			assimpModelBundle2->MoveTowardsZ(0u, 1.f).MoveTowardsX(0u, 10.f);
-			assimpModelBundle2->MoveTowardsY(0u, -0.75f);
-			assimpModelBundle2->RotateRollDegree(0u, 90.f);
-			assimpModelBundle2->RotatePitchDegree(0u, 90.f);
-			assimpModelBundle2->SetMeshBundleIndex(assimpMeshBundleIndex);
-
-			assimpBundleIndex2 = renderer.AddModelBundle(assimpModelBundle2->GetModelBundle());
-
-			renderPassManager.AddModelBundle(assimpBundleIndex2, renderer);
-
-			if (transparencyPass)
-				transparencyPass->AddTransparentModelBundle(assimpBundleIndex2, renderer);
-		}
-
-		{
-			assimpModelBundle3 = std::make_unique<ModelBundleBase>();
-
-			assimpModelBundle3->SetMeshBundle(assimpMeshBundleIndex, 0.5f, assimpMeshBundle);
-			assimpModelBundle3->MoveTowardsZ(0u, 1.f).MoveTowardsX(0u, -10.f);
-			assimpModelBundle3->MoveTowardsY(0u, -0.75f);
-			assimpModelBundle3->RotateRollDegree(0u, 90.f);
-			assimpModelBundle3->RotatePitchDegree(0u, 90.f);
-			assimpModelBundle3->SetMeshBundleIndex(assimpMeshBundleIndex);
-
-			assimpBundleIndex3 = renderer.AddModelBundle(assimpModelBundle3->GetModelBundle());
-
-			renderPassManager.AddModelBundle(assimpBundleIndex3, renderer);
-
-			if (transparencyPass)
-				transparencyPass->AddTransparentModelBundle(assimpBundleIndex3, renderer);
-		}
-		*/
 	}
 
 	template<
@@ -433,6 +378,10 @@ public:
 		InputManager_t& inputManager, Renderer_t& renderer, ExtensionManager_t& extensionManager,
 		RenderPassManager_t& renderPassManager, CameraManager& cameraManager
 	) {
+		// The scene is added on the first update after its load has finished.
+		if (sceneLoad.IsValid() && sceneLoad.IsReady())
+			AddLoadedScene(renderer, extensionManager, renderPassManager);
+
 		const Keyboard& keyboard = inputManager.GetKeyboard();
 
 		if (keyboard.IsKeyPressed(SKeyCodes::UpArrow))
@@ -806,6 +755,78 @@ public:
 	}
 
 private:
+	// Adds the materials, the textures and the meshes of the loaded scene to the renderer and
+	// draws it. Rethrows the exception of a failed load.
+	template<class Renderer_t, class ExtensionManager_t, class RenderPassManager_t>
+	void AddLoadedScene(
+		Renderer_t& renderer, ExtensionManager_t& extensionManager,
+		RenderPassManager_t& renderPassManager
+	) {
+		SceneLoadResult loadResult = sceneLoad.Get();
+
+		assimpMeshBundleIndex = loadResult.AddToRenderer(
+			renderer, *extensionManager.GetBlinnPhongLight(), testScene
+		);
+
+		auto* transparencyPass = extensionManager.GetWeightedTransparency();
+
+		assimpModelBundle1 = std::make_unique<ModelBundleBase>();
+
+		assimpModelBundle1->SetModelContainer(modelContainer);
+
+		assimpModelBundle1->SetMeshBundle(assimpMeshBundleIndex, 0.5f, testScene);
+		assimpModelBundle1->MoveTowardsZ(0u, -1.f);
+		//assimpModelBundle1->MoveTowardsY(0u, -0.75f);
+		assimpModelBundle1->RotateRollDegree(0u, 90.f);
+		assimpModelBundle1->RotatePitchDegree(0u, 90.f);
+		assimpModelBundle1->SetMeshBundleIndex(assimpMeshBundleIndex);
+
+		assimpBundleIndex1 = renderer.AddModelBundle(assimpModelBundle1->GetModelBundle());
+
+		renderPassManager.AddModelBundle(assimpBundleIndex1, renderer);
+
+		if (transparencyPass)
+			transparencyPass->AddTransparentModelBundle(assimpBundleIndex1, renderer);
+
+		/*
+		{
+			assimpModelBundle2 = std::make_unique<ModelBundleBase>();
+
+			assimpModelBundle2->SetMeshBundle(assimpMeshBundleIndex, 0.5f, assimpMeshBundle);
+			assimpModelBundle2->MoveTowardsZ(0u, 1.f).MoveTowardsX(0u, 10.f);
+			assimpModelBundle2->MoveTowardsY(0u, -0.75f);
+			assimpModelBundle2->RotateRollDegree(0u, 90.f);
+			assimpModelBundle2->RotatePitchDegree(0u, 90.f);
+			assimpModelBundle2->SetMeshBundleIndex(assimpMeshBundleIndex);
+
+			assimpBundleIndex2 = renderer.AddModelBundle(assimpModelBundle2->GetModelBundle());
+
+			renderPassManager.AddModelBundle(assimpBundleIndex2, renderer);
+
+			if (transparencyPass)
+				transparencyPass->AddTransparentModelBundle(assimpBundleIndex2, renderer);
+		}
+
+		{
+			assimpModelBundle3 = std::make_unique<ModelBundleBase>();
+
+			assimpModelBundle3->SetMeshBundle(assimpMeshBundleIndex, 0.5f, assimpMeshBundle);
+			assimpModelBundle3->MoveTowardsZ(0u, 1.f).MoveTowardsX(0u, -10.f);
+			assimpModelBundle3->MoveTowardsY(0u, -0.75f);
+			assimpModelBundle3->RotateRollDegree(0u, 90.f);
+			assimpModelBundle3->RotatePitchDegree(0u, 90.f);
+			assimpModelBundle3->SetMeshBundleIndex(assimpMeshBundleIndex);
+
+			assimpBundleIndex3 = renderer.AddModelBundle(assimpModelBundle3->GetModelBundle());
+
+			renderPassManager.AddModelBundle(assimpBundleIndex3, renderer);
+
+			if (transparencyPass)
+				transparencyPass->AddTransparentModelBundle(assimpBundleIndex3, renderer);
+		}
+		*/
+	}
+
 	template<class MeshBundle_t, class RenderPassManager_t>
 	[[nodiscard]]
 	MeshBundleTemporaryData GetPipelineSpecificMeshBundle(
@@ -814,12 +835,16 @@ private:
 		const bool isMeshPipeline
 			= renderPassManager.GetGraphicsPipelineManager().IsMeshShaderPipeline();
 
+		meshBundle.SetMeshletLimits(meshletLimits);
+
 		return meshBundle.GenerateTemporaryData(isMeshPipeline);
 	}
 
 private:
 	std::shared_ptr<ModelContainer> modelContainer{};
 	SolScene testScene{};
+	SceneLoadHandle sceneLoad{};
+	MeshletLimitsType meshletLimits     = MeshletLimitsType::Vertex64Primitive126;
 	std::uint32_t testMeshBundleIndex   = std::numeric_limits<std::uint32_t>::max();
 	std::uint32_t assimpMeshBundleIndex = std::numeric_limits<std::uint32_t>::max();
 	std::uint32_t sphereMeshBundleIndex = std::numeric_limits<std::uint32_t>::max();
@@ -860,6 +885,7 @@ public:
 	App(App&& other) noexcept
 		: modelContainer{ std::move(other.modelContainer) },
 		testScene{ std::move(other.testScene) },
+		sceneLoad{ std::move(other.sceneLoad) },
 		testMeshBundleIndex{ other.testMeshBundleIndex },
 		assimpMeshBundleIndex{ other.assimpMeshBundleIndex },
 		sphereMeshBundleIndex{ other.sphereMeshBundleIndex },
@@ -898,6 +924,7 @@ public:
 	{
 		modelContainer        = std::move(other.modelContainer);
 		testScene             = std::move(other.testScene);
+		sceneLoad             = std::move(other.sceneLoad);
 		testMeshBundleIndex   = other.testMeshBundleIndex;
 		assimpMeshBundleIndex = other.assimpMeshBundleIndex;
 		sphereMeshBundleIndex = other.sphereMeshBundleIndex;
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+#include <AsyncSceneLoader.hpp>
+#include <SolException.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// An OBJ plane in the temporary directory. The loads are given to a submitter which keeps the
+// work, so the tests decide when it runs.
+class AsyncSceneLoaderTest : public testing::Test
+{
+protected:
+	static constexpr std::uint32_t s_quadCount = 16u;
+
+	void SetUp() override
+	{
+		m_scenePath = (std::filesystem::temp_directory_path() / "SolAsyncSceneLoaderTest.obj")
+			.string();
+
+		WriteObjPlane(m_scenePath, s_quadCount);
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode{};
+
+		std::filesystem::remove(m_scenePath, errorCode);
+	}
+
+	[[nodiscard]]
+	SceneLoadWorkSubmitter GetDeferredSubmitter()
+	{
+		return [this](std::function<void()> work)
+		{
+			m_deferredWork.emplace_back(std::move(work));
+		};
+	}
+
+	void RunDeferredWork()
+	{
+		// The work might submit more work.
+		for (size_t index = 0u; index < std::size(m_deferredWork); ++index)
+			m_deferredWork[index]();
+
+		m_deferredWork.clear();
+	}
+
+	static constexpr SceneLoadOptions s_loadOptions{ .loadTextures = false };
+
+	std::string                        m_scenePath;
+	std::vector<std::function<void()>> m_deferredWork;
+};
+
+TEST_F(AsyncSceneLoaderTest, ProgressOfADeferredLoad)
+{
+	SceneLoadHandle loadHandle = LoadSceneAsync(
+		m_scenePath, s_loadOptions, GetDeferredSubmitter()
+	);
+
+	ASSERT_TRUE(loadHandle.IsValid());
+	EXPECT_FALSE(loadHandle.IsReady());
+	EXPECT_EQ(loadHandle.GetStage(), SceneLoadStage::Queued);
+	EXPECT_EQ(loadHandle.GetProgress(), 0.f);
+
+	ASSERT_EQ(std::size(m_deferredWork), 1u);
+
+	RunDeferredWork();
+
+	EXPECT_TRUE(loadHandle.IsReady());
+	EXPECT_EQ(loadHandle.GetStage(), SceneLoadStage::Ready);
+	EXPECT_EQ(loadHandle.GetProgress(), 1.f);
+
+	const SceneLoadResult loadResult = loadHandle.Get();
+
+	EXPECT_NE(loadResult.sceneProcessor, nullptr);
+	EXPECT_NE(loadResult.materialProcessor, nullptr);
+	EXPECT_EQ(std::size(loadResult.sceneData.bundleData.indices), s_quadCount * s_quadCount * 6u);
+	EXPECT_FALSE(std::empty(loadResult.sceneData.sceneNodeData));
+}
+
+// The hierarchies are only made on the mesh shader path, and only when they are asked for.
+TEST_F(AsyncSceneLoaderTest, MeshletHierarchiesOfTheMeshShaderPath)
+{
+	SceneLoadOptions loadOptions = s_loadOptions;
+
+	loadOptions.meshShader = true;
+
+	SceneLoadResult loadResult = LoadSceneAsync(m_scenePath, loadOptions).Get();
+
+	EXPECT_TRUE(std::empty(loadResult.meshletHierarchies));
+
+	loadOptions.meshOptions.generateHierarchy = true;
+
+	loadResult = LoadSceneAsync(m_scenePath, loadOptions).Get();
+
+	ASSERT_EQ(std::size(loadResult.meshletHierarchies), 1u);
+
+	const MeshletHierarchy& hierarchy = loadResult.meshletHierarchies.front();
+
+	EXPECT_GT(hierarchy.firstLevelMeshletCount, 0u);
+	EXPECT_GE(std::size(hierarchy.lodDetails), hierarchy.firstLevelMeshletCount);
+	// The bundle is made as it would be without the hierarchies.
+	EXPECT_FALSE(std::empty(loadResult.sceneData.bundleData.meshletDetails));
+}
+
+// On its own thread, the progress can only go up while it is polled, and ends at 1.
+TEST_F(AsyncSceneLoaderTest, ProgressOnItsOwnThread)
+{
+	SceneLoadHandle loadHandle = LoadSceneAsync(m_scenePath, s_loadOptions);
+
+	float previousProgress = 0.f;
+
+	while (!loadHandle.IsReady())
+	{
+		const float progress = loadHandle.GetProgress();
+
+		EXPECT_GE(progress, previousProgress);
+		EXPECT_LE(progress, 1.f);
+
+		previousProgress = progress;
+	}
+
+	EXPECT_EQ(loadHandle.GetStage(), SceneLoadStage::Ready);
+	EXPECT_EQ(loadHandle.GetProgress(), 1.f);
+	EXPECT_NO_THROW(std::ignore = loadHandle.Get());
+}
+
+// The cancellation is checked before the first stage, so the load doesn't import anything.
+TEST_F(AsyncSceneLoaderTest, CancelledBeforeItStarts)
+{
+	SceneLoadHandle loadHandle = LoadSceneAsync(
+		m_scenePath, s_loadOptions, GetDeferredSubmitter()
+	);
+
+	loadHandle.Cancel();
+
+	RunDeferredWork();
+
+	EXPECT_TRUE(loadHandle.IsReady());
+	EXPECT_EQ(loadHandle.GetStage(), SceneLoadStage::Cancelled);
+	EXPECT_EQ(loadHandle.GetProgress(), 0.f);
+	EXPECT_THROW(std::ignore = loadHandle.Get(), Exception);
+}
+
+TEST_F(AsyncSceneLoaderTest, MissingFileFails)
+{
+	const std::string missingPath = m_scenePath + ".missing";
+
+	SceneLoadHandle loadHandle = LoadSceneAsync(missingPath, s_loadOptions);
+
+	EXPECT_THROW(std::ignore = loadHandle.Get(), Exception);
+	EXPECT_EQ(loadHandle.GetStage(), SceneLoadStage::Failed);
+	EXPECT_EQ(loadHandle.GetProgress(), 0.f);
+}
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <MeshBoundImpl.hpp>
+#include <MeshBundleBase.hpp>
+#include <MeshletValidator.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// The sphere is computed in floats, so a point on the sphere can be a few ulps outside of it.
+static constexpr float s_radiusTolerance = 1e-5f;
+
+static constexpr std::array s_sphereAlgorithms
+{
+	std::pair{ "AABB centre", SphereBVAlgorithm::AABBCentre },
+	std::pair{ "Ritter     ", SphereBVAlgorithm::Ritter },
+	std::pair{ "Welzl      ", SphereBVAlgorithm::Welzl }
+};
+
+[[nodiscard]]
+static float GetDistance(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& sphere)
+{
+	const float x = position.x - sphere.x;
+	const float y = position.y - sphere.y;
+	const float z = position.z - sphere.z;
+
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+static void ExpectPositionsInside(
+	std::span<const DirectX::XMFLOAT3> positions, const SphereBoundingVolume& sphereB,
+	const char* name
+) {
+	const DirectX::XMFLOAT4& sphere = sphereB.sphere;
+	const float maxRadius           = sphere.w + s_radiusTolerance * std::max(sphere.w, 1.f);
+
+	EXPECT_GE(sphere.w, 0.f) << name;
+
+	for (size_t index = 0u; index < std::size(positions); ++index)
+		EXPECT_LE(GetDistance(positions[index], sphere), maxRadius)
+			<< name << " misses the position " << index;
+}
+
+// Checks that every position is inside the sphere of each algorithm and that Welzl's sphere,
+// which is the minimum one, isn't larger than the others.
+static void ExpectAlgorithmsContain(
+	std::span<const DirectX::XMFLOAT3> positions, const char* positionsName
+) {
+	std::array<float, std::size(s_sphereAlgorithms)> radii{};
+
+	for (size_t index = 0u; index < std::size(s_sphereAlgorithms); ++index)
+	{
+		const auto& [name, algorithm] = s_sphereAlgorithms[index];
+
+		const SphereBoundingVolume sphereB = GenerateSphereBV(positions, algorithm);
+
+		SCOPED_TRACE(positionsName);
+
+		ExpectPositionsInside(positions, sphereB, name);
+
+		radii[index] = sphereB.sphere.w;
+	}
+
+	const float welzlRadius = radii[2] * (1.f - s_radiusTolerance);
+
+	EXPECT_LE(welzlRadius, radii[0]) << positionsName;
+	EXPECT_LE(welzlRadius, radii[1]) << positionsName;
+}
+
+[[nodiscard]]
+static std::vector<DirectX::XMFLOAT3> GenerateRandomPositions(
+	size_t positionCount, std::uint32_t seed
+) {
+	std::mt19937 randomEngine{ seed };
+	std::uniform_real_distribution<float> distribution{ -10.f, 10.f };
+
+	std::vector<DirectX::XMFLOAT3> positions(positionCount);
+
+	for (DirectX::XMFLOAT3& position : positions)
+		position = DirectX::XMFLOAT3{
+			distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)
+		};
+
+	return positions;
+}
+
+TEST(MeshBoundTest, SpheresContainRandomPositions)
+{
+	for (std::uint32_t seed = 0u; seed < 32u; ++seed)
+	{
+		const std::vector<DirectX::XMFLOAT3> positions = GenerateRandomPositions(
+			3u + seed * 4u, seed
+		);
+
+		ExpectAlgorithmsContain(positions, "random");
+	}
+}
+
+// The points on a line, in a plane and on a sphere are the cases where the spheres through
+// two, three and four points are degenerate.
+TEST(MeshBoundTest, SpheresContainDegeneratePositions)
+{
+	std::vector<DirectX::XMFLOAT3> collinear{};
+
+	for (std::uint32_t index = 0u; index < 17u; ++index)
+	{
+		const float offset = static_cast<float>((index * 7u) % 17u) - 8.f;
+
+		collinear.emplace_back(DirectX::XMFLOAT3{ 1.f + offset, 2.f + 2.f * offset, 3.f });
+	}
+
+	ExpectAlgorithmsContain(collinear, "collinear");
+
+	EXPECT_NEAR(
+		GenerateSphereBV(collinear, SphereBVAlgorithm::Welzl).sphere.w,
+		8.f * std::sqrt(5.f), 1e-3f
+	);
+
+	std::vector<DirectX::XMFLOAT3> coplanar{};
+
+	for (std::uint32_t row = 0u; row < 9u; ++row)
+		for (std::uint32_t column = 0u; column < 9u; ++column)
+			coplanar.emplace_back(
+				DirectX::XMFLOAT3{
+					static_cast<float>(column) * 0.25f, 5.f, static_cast<float>(row) * 0.25f
+				}
+			);
+
+	ExpectAlgorithmsContain(coplanar, "coplanar");
+
+	EXPECT_NEAR(
+		GenerateSphereBV(coplanar, SphereBVAlgorithm::Welzl).sphere.w, std::sqrt(2.f), 1e-3f
+	);
+
+	const Mesh sphere = GenerateSphere(8u, 16u);
+
+	std::vector<DirectX::XMFLOAT3> cospherical{};
+
+	for (const Vertex& vertex : sphere.vertices)
+		cospherical.emplace_back(vertex.position);
+
+	ExpectAlgorithmsContain(cospherical, "cospherical");
+
+	EXPECT_NEAR(
+		GenerateSphereBV(cospherical, SphereBVAlgorithm::Welzl).sphere.w, 1.f, 1e-3f
+	);
+}
+
+TEST(MeshBoundTest, SpheresContainDuplicatePositions)
+{
+	const std::vector<DirectX::XMFLOAT3> single{ DirectX::XMFLOAT3{ 1.f, -2.f, 3.f } };
+
+	ExpectAlgorithmsContain(single, "single");
+
+	const std::vector<DirectX::XMFLOAT3> identical(12u, DirectX::XMFLOAT3{ 4.f, 5.f, -6.f });
+
+	ExpectAlgorithmsContain(identical, "identical");
+
+	for (const auto& [name, algorithm] : s_sphereAlgorithms)
+		EXPECT_NEAR(GenerateSphereBV(identical, algorithm).sphere.w, 0.f, 1e-5f) << name;
+
+	// Every position of a random set is repeated, with the copies after all of the originals.
+	std::vector<DirectX::XMFLOAT3> duplicates = GenerateRandomPositions(40u, 7u);
+
+	duplicates.insert(std::end(duplicates), std::begin(duplicates), std::end(duplicates));
+
+	ExpectAlgorithmsContain(duplicates, "duplicates");
+
+	const std::vector<DirectX::XMFLOAT3> pair
+	{
+		DirectX::XMFLOAT3{ 0.f, 0.f, 0.f }, DirectX::XMFLOAT3{ 2.f, 0.f, 0.f },
+		DirectX::XMFLOAT3{ 0.f, 0.f, 0.f }, DirectX::XMFLOAT3{ 2.f, 0.f, 0.f }
+	};
+
+	ExpectAlgorithmsContain(pair, "pair");
+}
+
+[[nodiscard]]
+static MeshBundleTemporaryData GenerateTestBundle(SphereBVAlgorithm algorithm)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.SetSphereBVAlgorithm(algorithm);
+
+	bundle.AddMesh(GenerateShuffledSphere(32u, 64u));
+	bundle.AddMesh(GeneratePlane(32u));
+
+	return bundle.GenerateTemporaryData(true);
+}
+
+TEST(MeshBoundTest, MeshletSpheresContainVertices)
+{
+	for (const auto& [name, algorithm] : s_sphereAlgorithms)
+	{
+		const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+			GenerateTestBundle(algorithm)
+		);
+
+		ASSERT_EQ(std::size(report.meshReports), 2u) << name;
+
+		for (const MeshletValidator::MeshReport& meshReport : report.meshReports)
+		{
+			EXPECT_GT(meshReport.meshletCount, 0u) << name;
+			EXPECT_EQ(meshReport.nonConservativeSphereCount, 0u)
+				<< name << '\n' << MeshletValidator::FormatReport(report);
+		}
+	}
+}
+
+// The vertex positions of each meshlet of a bundle.
+[[nodiscard]]
+static std::vector<std::vector<DirectX::XMFLOAT3>> GetMeshletPositions(
+	const MeshBundleTemporaryData& bundleData
+) {
+	std::vector<std::vector<DirectX::XMFLOAT3>> meshletPositions{};
+
+	for (const MeshTemporaryDetailsMS& meshDetails
+		: bundleData.bundleDetails.meshTemporaryDetailsMS)
+	{
+		std::span<const MeshletDetails> meshletDetails = std::span{
+			bundleData.meshletDetails
+		}.subspan(meshDetails.meshletOffset, meshDetails.meshletCount);
+
+		for (const MeshletDetails& meshletDetail : meshletDetails)
+		{
+			std::vector<DirectX::XMFLOAT3>& positions = meshletPositions.emplace_back();
+
+			const Meshlet& meshlet = meshletDetail.meshlet;
+
+			for (std::uint32_t index = 0u; index < meshlet.indexCount; ++index)
+			{
+				const std::uint32_t vertexIndex = bundleData.indices[
+					meshDetails.indexOffset + meshlet.indexOffset + index
+				];
+
+				positions.emplace_back(
+					bundleData.vertices[meshDetails.vertexOffset + vertexIndex].position
+				);
+			}
+		}
+	}
+
+	return meshletPositions;
+}
+
+// Prints the average radius of the meshlet spheres of each algorithm and the meshlets per
+// second it generates them at.
+TEST(MeshBoundBenchmark, SphereRadiusAndTime)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.AddMesh(GenerateShuffledSphere(128u, 256u));
+	bundle.AddMesh(GeneratePlane(256u));
+
+	const std::vector<std::vector<DirectX::XMFLOAT3>> meshletPositions = GetMeshletPositions(
+		bundle.GenerateTemporaryData(true)
+	);
+
+	ASSERT_FALSE(std::empty(meshletPositions));
+
+	using Clock_t = std::chrono::steady_clock;
+
+	std::cout << "Meshlet spheres of " << std::size(meshletPositions) << " meshlets:\n";
+
+	for (const auto& [name, algorithm] : s_sphereAlgorithms)
+	{
+		double radiusSum = 0.;
+
+		const Clock_t::time_point start = Clock_t::now();
+
+		for (const std::vector<DirectX::XMFLOAT3>& positions : meshletPositions)
+			radiusSum += GenerateSphereBV(positions, algorithm).sphere.w;
+
+		const Clock_t::duration duration = Clock_t::now() - start;
+
+		const double meshletCount      = static_cast<double>(std::size(meshletPositions));
+		const double meshletsPerSecond = meshletCount
+			/ std::chrono::duration<double>{ duration }.count() / 1e6;
+
+		std::cout << "  " << name << " : average radius " << radiusSum / meshletCount << ", "
+			<< meshletsPerSecond << " M meshlets/s\n";
+	}
+}
@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <MeshBundleCache.hpp>
+#include <MeshBundleBase.hpp>
+
+using namespace Sol;
+
+// A glTF source which references an external buffer and an embedded one, and the cache next
+// to it, in the temporary directory.
+class MeshBundleCacheTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+		m_sourcePath = (directory / "SolMeshBundleCacheTest.gltf").string();
+		m_bufferPath = (directory / "SolMeshBundleCacheTest buffer.bin").string();
+		m_cachePath  = MeshBundleCache::GetCachePath(m_sourcePath);
+
+		WriteSource("original");
+		WriteFile(m_bufferPath, "The original buffer.");
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode{};
+
+		std::filesystem::remove(m_sourcePath, errorCode);
+		std::filesystem::remove(m_bufferPath, errorCode);
+		std::filesystem::remove(m_cachePath, errorCode);
+	}
+
+	static void WriteFile(const std::string& filePath, const std::string& content)
+	{
+		std::ofstream file{ filePath, std::ios_base::binary | std::ios_base::trunc };
+
+		file << content;
+	}
+
+	// The name only changes the source's content, not the buffers it references.
+	void WriteSource(const std::string& name) const
+	{
+		WriteFile(
+			m_sourcePath,
+			"{ \"asset\" : { \"version\" : \"2.0\" }, \"meshes\" : [ { \"name\" : \"" + name
+			+ "\" } ],\n\"buffers\" : [\n{ \"byteLength\" : 4, \"uri\" : "
+			"\"SolMeshBundleCacheTest%20buffer.bin\" },\n{ \"byteLength\" : 4, \"uri\" : "
+			"\"data:application/octet-stream;base64,AAAAAA==\" } ] }"
+		);
+	}
+
+	[[nodiscard]]
+	MeshBundleCache::CacheKey GenerateCacheKey(
+		bool meshShader, const MeshProcessingOptions& options = MeshProcessingOptions{}
+	) const {
+		return MeshBundleCache::GenerateCacheKey(m_sourcePath, meshShader, options);
+	}
+
+	[[nodiscard]]
+	static SceneCacheData GenerateSceneData(bool meshShader)
+	{
+		MeshBundleTempCustom bundle{};
+
+		Mesh mesh{};
+
+		mesh.vertices =
+		{
+			Vertex{ .position = { 0.f, 0.f, 0.f }, .normal = { 0.f, 0.f, -1.f } },
+			Vertex{ .position = { 0.f, 1.f, 0.f }, .normal = { 0.f, 0.f, -1.f } },
+			Vertex{ .position = { 1.f, 0.f, 0.f }, .normal = { 0.f, 0.f, -1.f } },
+			Vertex{ .position = { 1.f, 1.f, 0.f }, .normal = { 0.f, 0.f, -1.f } }
+		};
+		mesh.indices  = { 0u, 1u, 2u, 2u, 1u, 3u };
+
+		bundle.AddMesh(std::move(mesh));
+
+		SceneCacheData sceneData{ .bundleData = bundle.GenerateTemporaryData(meshShader) };
+
+		sceneData.sceneNodeData.emplace_back(
+			SceneNodeData
+			{
+				.modelNodeData = ModelNodeData{ .modelIndex = 0u, .meshIndex = 0u },
+				.worldMatrix   = DirectX::XMMatrixTranslation(1.f, 2.f, 3.f)
+			}
+		);
+		sceneData.meshMaterialIndices = { 2u };
+		sceneData.materials.emplace_back(
+			SceneMaterialData
+			{
+				.diffuse              = { 0.5f, 0.25f, 1.f, 1.f },
+				.shininess            = 32.f,
+				.isTransparent        = 1u,
+				.diffuseTextureCount  = 1u,
+				.specularTextureCount = 0u
+			}
+		);
+
+		using namespace std::string_literals;
+
+		const std::string materialStrings = "Material\0textures/diffuse.png"s;
+
+		sceneData.materialStrings.assign(std::begin(materialStrings), std::end(materialStrings));
+		sceneData.materialStrings.emplace_back('\0');
+
+		return sceneData;
+	}
+
+protected:
+	std::string m_sourcePath;
+	std::string m_bufferPath;
+	std::string m_cachePath;
+};
+
+TEST_F(MeshBundleCacheTest, RoundTrip)
+{
+	for (const bool meshShader : { false, true })
+	{
+		const SceneCacheData sceneData           = GenerateSceneData(meshShader);
+		const MeshBundleCache::CacheKey cacheKey = GenerateCacheKey(meshShader);
+
+		ASSERT_TRUE(MeshBundleCache::WriteCache(m_cachePath, cacheKey, sceneData));
+
+		const std::optional<SceneCacheData> cachedData = MeshBundleCache::ReadCache(
+			m_cachePath, cacheKey
+		);
+
+		ASSERT_TRUE(cachedData.has_value());
+
+		const MeshBundleTemporaryData& bundleData       = sceneData.bundleData;
+		const MeshBundleTemporaryData& cachedBundleData = cachedData->bundleData;
+
+		EXPECT_EQ(std::size(cachedBundleData.vertices), std::size(bundleData.vertices));
+		EXPECT_EQ(cachedBundleData.indices, bundleData.indices);
+		EXPECT_EQ(cachedBundleData.primIndices, bundleData.primIndices);
+		EXPECT_EQ(std::size(cachedBundleData.meshletDetails), std::size(bundleData.meshletDetails));
+		EXPECT_EQ(
+			std::size(cachedBundleData.bundleDetails.meshTemporaryDetailsVS),
+			std::size(bundleData.bundleDetails.meshTemporaryDetailsVS)
+		);
+		EXPECT_EQ(
+			std::size(cachedBundleData.bundleDetails.meshTemporaryDetailsMS),
+			std::size(bundleData.bundleDetails.meshTemporaryDetailsMS)
+		);
+		EXPECT_EQ(cachedBundleData.vertexLayout, bundleData.vertexLayout);
+		EXPECT_EQ(
+			std::memcmp(
+				std::data(cachedBundleData.vertices), std::data(bundleData.vertices),
+				sizeof(Vertex) * std::size(bundleData.vertices)
+			), 0
+		);
+
+		ASSERT_EQ(std::size(cachedData->sceneNodeData), 1u);
+		EXPECT_EQ(cachedData->sceneNodeData[0].modelNodeData.meshIndex, 0u);
+		EXPECT_EQ(DirectX::XMVectorGetZ(cachedData->sceneNodeData[0].worldMatrix.r[3]), 3.f);
+		EXPECT_EQ(cachedData->meshMaterialIndices, sceneData.meshMaterialIndices);
+		EXPECT_EQ(cachedData->materialStrings, sceneData.materialStrings);
+
+		ASSERT_EQ(std::size(cachedData->materials), 1u);
+		EXPECT_EQ(
+			std::memcmp(
+				std::data(cachedData->materials), std::data(sceneData.materials),
+				sizeof(SceneMaterialData)
+			), 0
+		);
+	}
+}
+
+TEST_F(MeshBundleCacheTest, StaleCacheIsInvalidated)
+{
+	const SceneCacheData sceneData           = GenerateSceneData(false);
+	const MeshBundleCache::CacheKey cacheKey = GenerateCacheKey(false);
+
+	// The source and the external buffer.
+	ASSERT_EQ(std::size(cacheKey.fileStamps), 2u);
+
+	ASSERT_TRUE(MeshBundleCache::WriteCache(m_cachePath, cacheKey, sceneData));
+	ASSERT_TRUE(MeshBundleCache::ReadCache(m_cachePath, cacheKey).has_value());
+
+	// A changed source.
+	WriteSource("changed");
+
+	const MeshBundleCache::CacheKey changedSourceKey = GenerateCacheKey(false);
+
+	EXPECT_NE(changedSourceKey.hash, cacheKey.hash);
+	EXPECT_FALSE(MeshBundleCache::ReadCache(m_cachePath, changedSourceKey).has_value());
+
+	WriteSource("original");
+
+	EXPECT_EQ(GenerateCacheKey(false).hash, cacheKey.hash);
+
+	// A changed buffer.
+	WriteFile(m_bufferPath, "The changed buffer.");
+
+	const MeshBundleCache::CacheKey changedBufferKey = GenerateCacheKey(false);
+
+	EXPECT_NE(changedBufferKey.hash, cacheKey.hash);
+	EXPECT_FALSE(MeshBundleCache::ReadCache(m_cachePath, changedBufferKey).has_value());
+
+	// A missing buffer.
+	std::filesystem::remove(m_bufferPath);
+
+	EXPECT_NE(GenerateCacheKey(false).hash, cacheKey.hash);
+
+	// The original buffer is written again, which only touches it, so its new stamp is stored.
+	WriteFile(m_bufferPath, "The original buffer.");
+
+	const MeshBundleCache::CacheKey touchedKey = GenerateCacheKey(false);
+
+	EXPECT_EQ(touchedKey.hash, cacheKey.hash);
+	ASSERT_TRUE(MeshBundleCache::ReadCache(m_cachePath, touchedKey).has_value());
+
+	// With an unchanged size and write time, the stored hash of the buffer is used instead of
+	// its content.
+	const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(
+		m_bufferPath
+	);
+
+	WriteFile(m_bufferPath, "The unhashed buffer.");
+
+	std::filesystem::last_write_time(m_bufferPath, writeTime);
+
+	EXPECT_EQ(GenerateCacheKey(false).hash, cacheKey.hash);
+
+	// Changed options and the other pipeline.
+	MeshProcessingOptions lodOptions{};
+	lodOptions.lodCount = 2u;
+
+	EXPECT_NE(GenerateCacheKey(false, lodOptions).hash, cacheKey.hash);
+	EXPECT_NE(GenerateCacheKey(true).hash, cacheKey.hash);
+
+	// The scene imported with a different profile.
+	EXPECT_NE(
+		MeshBundleCache::GenerateCacheKey(
+			m_sourcePath, false, MeshProcessingOptions{},
+			SceneImportFlags::FromProfile(SceneImportProfile::CookedSource)
+		).hash, cacheKey.hash
+	);
+}
+
+TEST_F(MeshBundleCacheTest, BrokenCacheIsRejected)
+{
+	const SceneCacheData sceneData           = GenerateSceneData(true);
+	const MeshBundleCache::CacheKey cacheKey = GenerateCacheKey(true);
+
+	ASSERT_TRUE(MeshBundleCache::WriteCache(m_cachePath, cacheKey, sceneData));
+
+	// A truncated cache.
+	std::filesystem::resize_file(m_cachePath, std::filesystem::file_size(m_cachePath) - 4u);
+
+	EXPECT_FALSE(MeshBundleCache::ReadCache(m_cachePath, cacheKey).has_value());
+
+	// An older version.
+	ASSERT_TRUE(MeshBundleCache::WriteCache(m_cachePath, cacheKey, sceneData));
+
+	{
+		std::fstream cacheFile{
+			m_cachePath, std::ios_base::binary | std::ios_base::in | std::ios_base::out
+		};
+
+		const std::uint32_t olderVersion = MeshBundleCache::s_cacheVersion - 1u;
+
+		cacheFile.seekp(sizeof(std::uint32_t));
+		cacheFile.write(reinterpret_cast<char const*>(&olderVersion), sizeof(olderVersion));
+	}
+
+	EXPECT_FALSE(MeshBundleCache::ReadCache(m_cachePath, cacheKey).has_value());
+
+	// A missing cache.
+	std::filesystem::remove(m_cachePath);
+
+	EXPECT_FALSE(MeshBundleCache::ReadCache(m_cachePath, cacheKey).has_value());
+}
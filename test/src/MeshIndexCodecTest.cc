@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <MeshIndexCodec.hpp>
+#include <MeshBundleBase.hpp>
+#include <MeshOptimiser.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// The codec can rotate the triangles. So, each triangle is rotated to start with its smallest
+// index, which keeps the winding, before they are compared.
+[[nodiscard]]
+static std::vector<std::array<std::uint32_t, 3u>> GetRotatedTriangles(
+	std::span<const std::uint32_t> indices
+) {
+	std::vector<std::array<std::uint32_t, 3u>> triangles{};
+
+	for (size_t index = 0u; index + 2u < std::size(indices); index += 3u)
+	{
+		std::array triangle{ indices[index], indices[index + 1u], indices[index + 2u] };
+
+		std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+
+		triangles.emplace_back(triangle);
+	}
+
+	return triangles;
+}
+
+static void ExpectTrianglesRoundTrip(std::span<const std::uint32_t> indices)
+{
+	std::vector<std::uint8_t> data{};
+
+	IndexCodec::EncodeTriangles(indices, data);
+
+	std::vector<std::uint32_t> decodedIndices(std::size(indices));
+
+	EXPECT_EQ(IndexCodec::DecodeTriangles(data, decodedIndices), std::size(data));
+	EXPECT_EQ(GetRotatedTriangles(decodedIndices), GetRotatedTriangles(indices));
+}
+
+// Random triangles, with the indices far apart, so the vertices aren't in the FIFOs and
+// aren't the next ones. They have to be coded explicitly, with positive and negative deltas
+// of every varint size.
+[[nodiscard]]
+static std::vector<std::uint32_t> GenerateScatteredTriangles(size_t triangleCount)
+{
+	std::mt19937 randomEngine{ 3u };
+	std::uniform_int_distribution<std::uint32_t> distribution{ 0u, ~0u };
+
+	std::vector<std::uint32_t> indices{};
+
+	for (size_t index = 0u; index < triangleCount * 3u; ++index)
+		indices.emplace_back(distribution(randomEngine) >> (index % 32u));
+
+	return indices;
+}
+
+TEST(MeshIndexCodecTest, TrianglesRoundTrip)
+{
+	Mesh sphere = GenerateShuffledSphere(32u, 64u);
+
+	// Unoptimised, most of the vertices are coded explicitly.
+	ExpectTrianglesRoundTrip(sphere.indices);
+
+	// Optimised, most of them are in the FIFOs or are the next ones.
+	MeshOptimiser::OptimiseVertexCache(sphere.indices);
+
+	ExpectTrianglesRoundTrip(sphere.indices);
+
+	// A triangle which uses the same vertex more than once.
+	ExpectTrianglesRoundTrip(std::vector<std::uint32_t>{ 0u, 1u, 1u, 2u, 2u, 2u, 1u, 0u, 2u });
+}
+
+TEST(MeshIndexCodecTest, ExplicitVerticesRoundTrip)
+{
+	const std::vector<std::uint32_t> indices = GenerateScatteredTriangles(512u);
+
+	std::vector<std::uint8_t> data{};
+
+	IndexCodec::EncodeTriangles(indices, data);
+
+	// Two bytes of codes and a delta for each vertex, which is at least a byte.
+	EXPECT_GE(std::size(data), std::size(indices) / 3u * 5u);
+
+	ExpectTrianglesRoundTrip(indices);
+}
+
+TEST(MeshIndexCodecTest, SequenceRoundTrip)
+{
+	std::vector<std::uint32_t> indices{ 0u, 1u, 2u, 1u, 0u, ~0u, 0u, ~0u, 0x8000'0000u, 5u };
+
+	const std::vector<std::uint32_t> scatteredIndices = GenerateScatteredTriangles(64u);
+
+	indices.insert(std::end(indices), std::begin(scatteredIndices), std::end(scatteredIndices));
+
+	std::vector<std::uint8_t> data{};
+
+	IndexCodec::EncodeSequence(indices, data);
+
+	std::vector<std::uint32_t> decodedIndices(std::size(indices));
+
+	EXPECT_EQ(IndexCodec::DecodeSequence(data, decodedIndices), std::size(data));
+	EXPECT_EQ(decodedIndices, indices);
+}
+
+// Every byte is needed, so any shorter data must be rejected, instead of being read past.
+TEST(MeshIndexCodecTest, TruncatedDataIsRejected)
+{
+	std::vector<std::uint32_t> triangles = GenerateSphere(8u, 16u).indices;
+
+	const std::vector<std::uint32_t> scatteredTriangles = GenerateScatteredTriangles(16u);
+
+	triangles.insert(
+		std::end(triangles), std::begin(scatteredTriangles), std::end(scatteredTriangles)
+	);
+
+	std::vector<std::uint8_t> triangleData{};
+	IndexCodec::EncodeTriangles(triangles, triangleData);
+
+	std::vector<std::uint8_t> sequenceData{};
+	IndexCodec::EncodeSequence(triangles, sequenceData);
+
+	std::vector<std::uint32_t> decodedIndices(std::size(triangles));
+
+	for (size_t size = 0u; size < std::size(triangleData); ++size)
+		EXPECT_EQ(
+			IndexCodec::DecodeTriangles(
+				std::span{ triangleData }.first(size), decodedIndices
+			), 0u
+		) << size << " bytes";
+
+	for (size_t size = 0u; size < std::size(sequenceData); ++size)
+		EXPECT_EQ(
+			IndexCodec::DecodeSequence(std::span{ sequenceData }.first(size), decodedIndices),
+			0u
+		) << size << " bytes";
+}
+
+[[nodiscard]]
+static MeshBundleTemporaryData GenerateTestBundle(bool meshShader)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.AddMesh(GenerateShuffledSphere(32u, 64u));
+	bundle.AddMesh(GeneratePlane(32u));
+
+	return bundle.GenerateTemporaryData(meshShader);
+}
+
+// The triangles of each meshlet with their local indices.
+[[nodiscard]]
+static std::vector<std::array<std::uint32_t, 3u>> GetMeshletTriangles(
+	const MeshBundleTemporaryData& bundleData
+) {
+	std::vector<std::uint32_t> indices{};
+
+	for (const MeshTemporaryDetailsMS& meshDetails
+		: bundleData.bundleDetails.meshTemporaryDetailsMS)
+	{
+		std::span<const MeshletDetails> meshletDetails = std::span{
+			bundleData.meshletDetails
+		}.subspan(meshDetails.meshletOffset, meshDetails.meshletCount);
+
+		for (const MeshletDetails& meshletDetail : meshletDetails)
+		{
+			const Meshlet& meshlet = meshletDetail.meshlet;
+
+			for (std::uint32_t index = 0u; index < meshlet.primitiveCount; ++index)
+			{
+				const PrimitiveIndicesUnpacked prim = UnpackPrim(
+					bundleData.primIndices[
+						meshDetails.primitiveOffset + meshlet.primitiveOffset + index
+					]
+				);
+
+				indices.insert(
+					std::end(indices), { prim.firstIndex, prim.secondIndex, prim.thirdIndex }
+				);
+			}
+		}
+	}
+
+	return GetRotatedTriangles(indices);
+}
+
+TEST(MeshIndexCodecTest, MeshBundleRoundTrip)
+{
+	for (const bool meshShader : { false, true })
+	{
+		const MeshBundleTemporaryData bundleData = GenerateTestBundle(meshShader);
+
+		const EncodedMeshBundleIndices encodedIndices = EncodeMeshBundleIndices(bundleData);
+
+		MeshBundleTemporaryData decodedBundleData = bundleData;
+
+		decodedBundleData.indices.clear();
+		decodedBundleData.primIndices.clear();
+
+		ASSERT_TRUE(DecodeMeshBundleIndices(encodedIndices, decodedBundleData));
+
+		if (meshShader)
+		{
+			EXPECT_EQ(decodedBundleData.indices, bundleData.indices);
+			EXPECT_EQ(GetMeshletTriangles(decodedBundleData), GetMeshletTriangles(bundleData));
+		}
+		else
+			EXPECT_EQ(
+				GetRotatedTriangles(decodedBundleData.indices),
+				GetRotatedTriangles(bundleData.indices)
+			);
+
+		// Truncating the triangles of the last meshlet or the last triangles.
+		EncodedMeshBundleIndices truncatedIndices = encodedIndices;
+
+		std::vector<std::uint8_t>& triangleData
+			= meshShader ? truncatedIndices.primIndices : truncatedIndices.indices;
+
+		triangleData.pop_back();
+
+		EXPECT_FALSE(DecodeMeshBundleIndices(truncatedIndices, decodedBundleData))
+			<< (meshShader ? "Mesh shader" : "Vertex shader");
+
+		if (meshShader)
+		{
+			truncatedIndices = encodedIndices;
+
+			truncatedIndices.indices.pop_back();
+
+			EXPECT_FALSE(DecodeMeshBundleIndices(truncatedIndices, decodedBundleData));
+		}
+	}
+}
+
+// Prints the compressed size of the indices of each bundle type and the encoding and the
+// decoding speeds, over the uncompressed size.
+TEST(MeshIndexCodecBenchmark, MeshBundleThroughput)
+{
+	using Clock_t = std::chrono::steady_clock;
+
+	constexpr size_t iterationCount = 10u;
+
+	auto GetMegabytesPerSecond = [](size_t byteCount, Clock_t::duration duration)
+	{
+		return static_cast<double>(byteCount * iterationCount) / 1e6
+			/ std::chrono::duration<double>{ duration }.count();
+	};
+
+	for (const bool meshShader : { false, true })
+	{
+		MeshBundleTempCustom bundle{};
+
+		bundle.AddMesh(GenerateShuffledSphere(256u, 512u));
+		bundle.AddMesh(GeneratePlane(256u));
+
+		const MeshBundleTemporaryData bundleData = bundle.GenerateTemporaryData(meshShader);
+
+		const size_t byteCount = (std::size(bundleData.indices) + std::size(bundleData.primIndices))
+			* sizeof(std::uint32_t);
+
+		EncodedMeshBundleIndices encodedIndices{};
+
+		const Clock_t::time_point encodeStart = Clock_t::now();
+
+		for (size_t index = 0u; index < iterationCount; ++index)
+			encodedIndices = EncodeMeshBundleIndices(bundleData);
+
+		const Clock_t::duration encodeDuration = Clock_t::now() - encodeStart;
+
+		MeshBundleTemporaryData decodedBundleData = bundleData;
+
+		const Clock_t::time_point decodeStart = Clock_t::now();
+
+		for (size_t index = 0u; index < iterationCount; ++index)
+			ASSERT_TRUE(DecodeMeshBundleIndices(encodedIndices, decodedBundleData));
+
+		const Clock_t::duration decodeDuration = Clock_t::now() - decodeStart;
+
+		const size_t encodedByteCount
+			= std::size(encodedIndices.indices) + std::size(encodedIndices.primIndices);
+
+		std::cout << (meshShader ? "Mesh shader  " : "Vertex shader") << " : "
+			<< byteCount / 1000u << " KB -> " << encodedByteCount / 1000u << " KB, encode "
+			<< GetMegabytesPerSecond(byteCount, encodeDuration) << " MB/s, decode "
+			<< GetMegabytesPerSecond(byteCount, decodeDuration) << " MB/s\n";
+	}
+}
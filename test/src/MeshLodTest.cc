@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <MeshLod.hpp>
+#include <MeshSimplifier.hpp>
+#include <MeshBundleBase.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+TEST(MeshSimplifierTest, TriangleCountTarget)
+{
+	Mesh sphere = GenerateSphere(32u, 64u);
+
+	const size_t targetIndexCount = std::size(sphere.indices) / 4u / 3u * 3u;
+
+	const float error = MeshSimplifier::Simplify(
+		sphere.indices, sphere.vertices, targetIndexCount, std::numeric_limits<float>::max()
+	);
+
+	EXPECT_LE(std::size(sphere.indices), targetIndexCount);
+	EXPECT_GT(std::size(sphere.indices), 0u);
+	EXPECT_GT(error, 0.f);
+}
+
+TEST(MeshSimplifierTest, ErrorTarget)
+{
+	Mesh sphere = GenerateSphere(32u, 64u);
+
+	const size_t indexCount = std::size(sphere.indices);
+
+	constexpr float targetError = 0.01f;
+
+	const float error = MeshSimplifier::Simplify(sphere.indices, sphere.vertices, 0u, targetError);
+
+	EXPECT_LE(error, targetError);
+	EXPECT_LT(std::size(sphere.indices), indexCount);
+	EXPECT_GT(std::size(sphere.indices), 0u);
+}
+
+TEST(MeshSimplifierTest, UnlockedBordersKeepTheirOutline)
+{
+	Mesh plane = GeneratePlane(16u);
+
+	const float error = MeshSimplifier::Simplify(
+		plane.indices, plane.vertices, 0u, 1e-4f, {},
+		MeshSimplifier::SimplificationOptions{ .lockBorders = false }
+	);
+
+	// A flat plane can go down to its two corner triangles without any error.
+	EXPECT_LE(error, 1e-4f);
+	EXPECT_EQ(std::size(plane.indices), 6u);
+
+	for (const std::uint32_t vertexIndex : plane.indices)
+	{
+		const DirectX::XMFLOAT3& position = plane.vertices[vertexIndex].position;
+
+		EXPECT_TRUE(position.x == 0.f || position.x == 16.f);
+		EXPECT_TRUE(position.z == 0.f || position.z == 16.f);
+	}
+}
+
+TEST(MeshSimplifierTest, LockedBordersKeepTheirVertices)
+{
+	Mesh plane = GeneratePlane(16u);
+
+	std::ignore = MeshSimplifier::Simplify(
+		plane.indices, plane.vertices, 0u, std::numeric_limits<float>::max()
+	);
+
+	std::vector<std::uint8_t> isReferenced(std::size(plane.vertices), 0u);
+
+	for (const std::uint32_t vertexIndex : plane.indices)
+		isReferenced[vertexIndex] = 1u;
+
+	size_t referencedBorderCount = 0u;
+
+	for (size_t index = 0u; index < std::size(plane.vertices); ++index)
+	{
+		const DirectX::XMFLOAT3& position = plane.vertices[index].position;
+
+		if (position.x == 0.f || position.x == 16.f || position.z == 0.f || position.z == 16.f)
+			referencedBorderCount += isReferenced[index];
+	}
+
+	EXPECT_EQ(referencedBorderCount, 64u);
+}
+
+TEST(MeshLodTest, LevelTargets)
+{
+	const Mesh sphere = GenerateSphere(32u, 64u);
+
+	const std::vector<MeshLodLevel> levels = GenerateMeshLods(
+		sphere.indices, sphere.vertices, 4u, 0.5f
+	);
+
+	ASSERT_EQ(std::size(levels), 4u);
+
+	size_t previousTriangleCount = std::size(sphere.indices) / 3u;
+	float previousError          = 0.f;
+
+	for (const MeshLodLevel& level : levels)
+	{
+		const size_t triangleCount = std::size(level.indices) / 3u;
+
+		EXPECT_EQ(std::size(level.indices) % 3u, 0u);
+		EXPECT_LE(triangleCount, previousTriangleCount / 2u);
+		EXPECT_GT(triangleCount, 0u);
+		EXPECT_GE(level.error, previousError);
+
+		previousTriangleCount = triangleCount;
+		previousError         = level.error;
+	}
+
+	// The error must cover how far the coarsest level's triangles are from the unit sphere,
+	// but still be smaller than the sphere.
+	const std::vector<std::uint32_t>& coarsestIndices = levels.back().indices;
+
+	float deviation = 0.f;
+
+	for (size_t index = 0u; index < std::size(coarsestIndices); index += 3u)
+	{
+		using namespace DirectX;
+
+		const XMVECTOR centroid = (
+			XMLoadFloat3(&sphere.vertices[coarsestIndices[index]].position)
+			+ XMLoadFloat3(&sphere.vertices[coarsestIndices[index + 1u]].position)
+			+ XMLoadFloat3(&sphere.vertices[coarsestIndices[index + 2u]].position)
+		) / 3.f;
+
+		deviation = std::max(deviation, 1.f - XMVectorGetX(XMVector3Length(centroid)));
+	}
+
+	EXPECT_GE(levels.back().error, deviation);
+	EXPECT_LT(levels.back().error, 1.f);
+}
+
+TEST(MeshLodTest, BundleLevels)
+{
+	for (const bool meshShader : { false, true })
+	{
+		MeshBundleTempCustom bundle{};
+
+		bundle.SetLodGeneration(3u);
+		bundle.AddMesh(GenerateSphere(32u, 64u));
+
+		const MeshBundleTemporaryData bundleData = bundle.GenerateTemporaryData(meshShader);
+
+		const MeshBundleTemporaryDetails& bundleDetails = bundleData.bundleDetails;
+
+		if (meshShader)
+		{
+			const std::vector<MeshTemporaryDetailsMS>& meshDetails
+				= bundleDetails.meshTemporaryDetailsMS;
+
+			ASSERT_EQ(std::size(meshDetails), 4u);
+			EXPECT_EQ(meshDetails[0].lodOffset, 1u);
+			EXPECT_EQ(meshDetails[0].lodCount, 3u);
+
+			for (size_t index = 1u; index < std::size(meshDetails); ++index)
+				EXPECT_LT(meshDetails[index].meshletCount, meshDetails[index - 1u].meshletCount);
+
+			EXPECT_EQ(SelectMeshLod(meshDetails, 0u, 0.f, 0.01f), 0u);
+			EXPECT_EQ(SelectMeshLod(meshDetails, 0u, 1000.f, 0.01f), 3u);
+		}
+		else
+		{
+			const std::vector<MeshTemporaryDetailsVS>& meshDetails
+				= bundleDetails.meshTemporaryDetailsVS;
+
+			ASSERT_EQ(std::size(meshDetails), 4u);
+			EXPECT_EQ(meshDetails[0].lodOffset, 1u);
+			EXPECT_EQ(meshDetails[0].lodCount, 3u);
+
+			for (size_t index = 1u; index < std::size(meshDetails); ++index)
+			{
+				EXPECT_LE(meshDetails[index].indexCount, meshDetails[index - 1u].indexCount / 2u);
+				EXPECT_GE(meshDetails[index].lodError, meshDetails[index - 1u].lodError);
+			}
+
+			EXPECT_EQ(SelectMeshLod(meshDetails, 0u, 0.f, 0.01f), 0u);
+			EXPECT_EQ(SelectMeshLod(meshDetails, 0u, 1000.f, 0.01f), 3u);
+		}
+	}
+}
@@ -0,0 +1,360 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <MeshOptimiser.hpp>
+#include <MeshBundleBase.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// The triangles of an index list, sorted. Only the triangle order should be changed by the
+// vertex cache optimisation, not the order of the indices in a triangle.
+[[nodiscard]]
+static std::vector<std::array<std::uint32_t, 3u>> GetSortedTriangles(
+	std::span<const std::uint32_t> indices
+) {
+	std::vector<std::array<std::uint32_t, 3u>> triangles{};
+
+	for (size_t index = 0u; index + 2u < std::size(indices); index += 3u)
+		triangles.emplace_back(
+			std::array{ indices[index], indices[index + 1u], indices[index + 2u] }
+		);
+
+	std::ranges::sort(triangles);
+
+	return triangles;
+}
+
+TEST(MeshOptimiserTest, VertexCacheKeepsTriangles)
+{
+	Mesh sphere = GenerateShuffledSphere(32u, 64u);
+
+	const auto sortedTriangles = GetSortedTriangles(sphere.indices);
+
+	MeshOptimiser::OptimiseVertexCache(sphere.indices);
+
+	EXPECT_EQ(GetSortedTriangles(sphere.indices), sortedTriangles);
+}
+
+// The first vertex is only in a triangle which can't be reached from the first index.
+TEST(MeshOptimiserTest, VertexCacheKeepsUnreachableFirstVertex)
+{
+	std::vector<std::uint32_t> indices{ 1u, 2u, 3u, 0u, 0u, 0u, 1u, 3u, 2u };
+
+	const auto sortedTriangles = GetSortedTriangles(indices);
+
+	MeshOptimiser::OptimiseVertexCache(indices);
+
+	EXPECT_EQ(GetSortedTriangles(indices), sortedTriangles);
+}
+
+// The transforms of a FIFO cache which holds the last cacheSize vertices, the same cache the
+// optimisation is done for.
+TEST(MeshOptimiserTest, VertexCacheStatisticsKnownValues)
+{
+	auto ExpectStatistics = [](
+		const std::vector<std::uint32_t>& indices, size_t cacheSize, size_t transformCount,
+		float acmr, float atvr
+	) {
+		const MeshOptimiser::VertexCacheStatistics statistics
+			= MeshOptimiser::AnalyseVertexCache(indices, cacheSize);
+
+		EXPECT_EQ(statistics.vertexTransformCount, transformCount) << cacheSize;
+		EXPECT_FLOAT_EQ(statistics.acmr, acmr) << cacheSize;
+		EXPECT_FLOAT_EQ(statistics.atvr, atvr) << cacheSize;
+	};
+
+	ExpectStatistics({ 0u, 0u, 0u }, 1u, 1u, 1.f, 1.f);
+	ExpectStatistics({ 0u, 1u, 2u, 0u, 1u, 2u }, 3u, 3u, 1.5f, 1.f);
+	ExpectStatistics({ 0u, 1u, 2u, 3u, 4u, 5u, 0u, 1u, 2u }, 3u, 9u, 3.f, 1.5f);
+
+	// The first vertex is evicted by the fourth one from a cache of 3, but not of 4.
+	const std::vector<std::uint32_t> indices{ 0u, 1u, 2u, 2u, 1u, 3u, 0u, 3u, 2u };
+
+	ExpectStatistics(indices, 4u, 4u, 4.f / 3.f, 1.f);
+	ExpectStatistics(indices, 3u, 5u, 5.f / 3.f, 1.25f);
+}
+
+// The x, y and z of the three positions.
+using TrianglePositions = std::array<float, 9u>;
+
+[[nodiscard]]
+static TrianglePositions GetTrianglePositions(
+	const DirectX::XMFLOAT3& position0, const DirectX::XMFLOAT3& position1,
+	const DirectX::XMFLOAT3& position2
+) noexcept {
+	return TrianglePositions{
+		position0.x, position0.y, position0.z, position1.x, position1.y, position1.z,
+		position2.x, position2.y, position2.z
+	};
+}
+
+// The positions of every triangle of every mesh of a bundle, in the order they are drawn.
+[[nodiscard]]
+static std::vector<std::vector<TrianglePositions>> GetBundleTriangles(
+	const MeshBundleTemporaryData& bundleData, bool meshShader
+) {
+	std::vector<std::vector<TrianglePositions>> meshTriangles{};
+
+	auto GetPosition = [&bundleData](size_t vertexIndex)
+	{
+		return bundleData.vertices[vertexIndex].position;
+	};
+
+	if (meshShader)
+		for (const MeshTemporaryDetailsMS& meshDetails
+			: bundleData.bundleDetails.meshTemporaryDetailsMS)
+		{
+			std::vector<TrianglePositions>& triangles = meshTriangles.emplace_back();
+
+			std::span<const MeshletDetails> meshletDetails = std::span{
+				bundleData.meshletDetails
+			}.subspan(meshDetails.meshletOffset, meshDetails.meshletCount);
+
+			for (const MeshletDetails& meshletDetail : meshletDetails)
+			{
+				const Meshlet& meshlet = meshletDetail.meshlet;
+
+				auto GetMeshletPosition = [&](std::uint32_t localIndex)
+				{
+					const std::uint32_t vertexIndex = bundleData.indices[
+						meshDetails.indexOffset + meshlet.indexOffset + localIndex
+					];
+
+					return GetPosition(meshDetails.vertexOffset + vertexIndex);
+				};
+
+				for (std::uint32_t index = 0u; index < meshlet.primitiveCount; ++index)
+				{
+					const PrimitiveIndicesUnpacked prim = UnpackPrim(
+						bundleData.primIndices[
+							meshDetails.primitiveOffset + meshlet.primitiveOffset + index
+						]
+					);
+
+					triangles.emplace_back(
+						GetTrianglePositions(
+							GetMeshletPosition(prim.firstIndex),
+							GetMeshletPosition(prim.secondIndex),
+							GetMeshletPosition(prim.thirdIndex)
+						)
+					);
+				}
+			}
+		}
+	else
+		for (const MeshTemporaryDetailsVS& meshDetails
+			: bundleData.bundleDetails.meshTemporaryDetailsVS)
+		{
+			std::vector<TrianglePositions>& triangles = meshTriangles.emplace_back();
+
+			// The indices have already been offset.
+			for (size_t index = 0u; index < meshDetails.indexCount; index += 3u)
+			{
+				const size_t firstIndex = meshDetails.indexOffset + index;
+
+				triangles.emplace_back(
+					GetTrianglePositions(
+						GetPosition(bundleData.indices[firstIndex]),
+						GetPosition(bundleData.indices[firstIndex + 1u]),
+						GetPosition(bundleData.indices[firstIndex + 2u])
+					)
+				);
+			}
+		}
+
+	return meshTriangles;
+}
+
+[[nodiscard]]
+static MeshBundleTemporaryData GenerateTestBundle(bool meshShader, bool optimiseVertexFetch)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.SetVertexFetchOptimisation(optimiseVertexFetch);
+
+	// The second mesh doesn't start at the first vertex of the bundle.
+	bundle.AddMesh(GenerateShuffledSphere(32u, 64u));
+	bundle.AddMesh(GeneratePlane(32u));
+
+	return bundle.GenerateTemporaryData(meshShader);
+}
+
+// Only the vertices should be reordered. Every triangle must still have the same positions,
+// in the same order.
+TEST(MeshOptimiserTest, VertexFetchKeepsTopology)
+{
+	for (const bool meshShader : { false, true })
+	{
+		const MeshBundleTemporaryData bundleData          = GenerateTestBundle(meshShader, false);
+		const MeshBundleTemporaryData optimisedBundleData = GenerateTestBundle(meshShader, true);
+
+		ASSERT_EQ(std::size(optimisedBundleData.vertices), std::size(bundleData.vertices));
+
+		const auto meshTriangles          = GetBundleTriangles(bundleData, meshShader);
+		const auto optimisedMeshTriangles = GetBundleTriangles(optimisedBundleData, meshShader);
+
+		ASSERT_EQ(std::size(meshTriangles), 2u);
+
+		for (size_t index = 0u; index < std::size(meshTriangles); ++index)
+			EXPECT_EQ(optimisedMeshTriangles[index], meshTriangles[index])
+				<< (meshShader ? "Mesh shader" : "Vertex shader") << " mesh " << index;
+
+		// The vertices of the shuffled sphere aren't in the order they are used.
+		EXPECT_NE(
+			std::memcmp(
+				std::data(optimisedBundleData.vertices), std::data(bundleData.vertices),
+				std::size(bundleData.vertices) * sizeof(Vertex)
+			), 0
+		);
+	}
+}
+
+// Planes stacked on top of each other, facing up. The lowest one is drawn first, so from
+// above every plane is shaded, unless they are drawn the other way round.
+[[nodiscard]]
+static Mesh GenerateStackedPlanes(std::uint32_t planeCount, std::uint32_t quadCount)
+{
+	Mesh stackedPlanes{};
+
+	for (std::uint32_t planeIndex = 0u; planeIndex < planeCount; ++planeIndex)
+	{
+		Mesh plane = GeneratePlane(quadCount);
+
+		const auto vertexOffset = static_cast<std::uint32_t>(std::size(stackedPlanes.vertices));
+
+		for (Vertex& vertex : plane.vertices)
+			vertex.position.y = static_cast<float>(planeIndex);
+
+		for (const std::uint32_t index : plane.indices)
+			stackedPlanes.indices.emplace_back(vertexOffset + index);
+
+		stackedPlanes.vertices.insert(
+			std::end(stackedPlanes.vertices), std::begin(plane.vertices), std::end(plane.vertices)
+		);
+	}
+
+	return stackedPlanes;
+}
+
+// The clusters can only be reordered. So, every triangle must still be there, with its
+// indices in the same order, and the overdraw mustn't get worse.
+TEST(MeshOptimiserTest, OverdrawKeepsTrianglesAndDoesntIncrease)
+{
+	const std::array meshes
+	{
+		std::pair{ "stacked planes", GenerateStackedPlanes(4u, 16u) },
+		std::pair{ "shuffled sphere", GenerateShuffledSphere(32u, 64u) },
+		std::pair{ "plane", GeneratePlane(32u) }
+	};
+
+	for (const auto& [name, mesh] : meshes)
+	{
+		std::vector<std::uint32_t> indices = mesh.indices;
+
+		MeshOptimiser::OptimiseVertexCache(indices);
+
+		const auto sortedTriangles = GetSortedTriangles(indices);
+
+		const MeshOptimiser::OverdrawStatistics before
+			= MeshOptimiser::AnalyseOverdraw(indices, mesh.vertices);
+
+		MeshOptimiser::OptimiseOverdraw(indices, mesh.vertices);
+
+		const MeshOptimiser::OverdrawStatistics after
+			= MeshOptimiser::AnalyseOverdraw(indices, mesh.vertices);
+
+		EXPECT_EQ(GetSortedTriangles(indices), sortedTriangles) << name;
+		EXPECT_EQ(after.pixelsCovered, before.pixelsCovered) << name;
+		// The pixels on the shared edges can be shaded by both triangles, depending on their
+		// order. So, a convex mesh can get a few more shaded pixels, without any real overdraw.
+		EXPECT_LE(after.pixelsShaded, before.pixelsShaded + before.pixelsCovered / 10'000u)
+			<< name;
+	}
+
+	// The top plane should now be drawn early enough to hide some of the others.
+	{
+		const Mesh stackedPlanes = GenerateStackedPlanes(4u, 16u);
+
+		std::vector<std::uint32_t> indices = stackedPlanes.indices;
+
+		const float overdraw = MeshOptimiser::AnalyseOverdraw(indices, stackedPlanes.vertices)
+			.overdraw;
+
+		MeshOptimiser::OptimiseOverdraw(indices, stackedPlanes.vertices);
+
+		EXPECT_LT(
+			MeshOptimiser::AnalyseOverdraw(indices, stackedPlanes.vertices).overdraw, overdraw
+		);
+	}
+}
+
+// The indices of a mesh in a bundle have already been offset with its first vertex.
+TEST(MeshOptimiserTest, OverdrawKeepsOffsetTriangles)
+{
+	const Mesh stackedPlanes = GenerateStackedPlanes(4u, 16u);
+
+	constexpr std::uint32_t vertexOffset = 1000u;
+
+	std::vector<Vertex> vertices(vertexOffset);
+	vertices.insert(
+		std::end(vertices), std::begin(stackedPlanes.vertices), std::end(stackedPlanes.vertices)
+	);
+
+	std::vector<std::uint32_t> indices = stackedPlanes.indices;
+	MeshOptimiser::OffsetIndices(indices, vertexOffset);
+
+	const auto sortedTriangles = GetSortedTriangles(indices);
+
+	MeshOptimiser::OptimiseOverdraw(
+		indices, std::span<const Vertex>{ vertices }.subspan(vertexOffset), vertexOffset
+	);
+
+	EXPECT_EQ(GetSortedTriangles(indices), sortedTriangles);
+}
+
+// Checks that the optimised order doesn't miss the cache more. It prints the ACMR and the
+// ATVR before and after, and the triangles per second of the optimisation.
+TEST(MeshOptimiserBenchmark, VertexCacheStatistics)
+{
+	const std::array meshes
+	{
+		std::pair{ "sphere         ", GenerateSphere(128u, 256u) },
+		std::pair{ "shuffled sphere", GenerateShuffledSphere(128u, 256u) },
+		std::pair{ "plane          ", GeneratePlane(256u) }
+	};
+
+	using Clock_t = std::chrono::steady_clock;
+
+	std::cout << "Vertex cache optimisation, " << MeshOptimiser::s_defaultVertexCacheSize
+		<< " entry FIFO:\n";
+
+	for (const auto& [name, mesh] : meshes)
+	{
+		std::vector<std::uint32_t> indices = mesh.indices;
+
+		const MeshOptimiser::VertexCacheStatistics before
+			= MeshOptimiser::AnalyseVertexCache(indices);
+
+		const Clock_t::time_point start = Clock_t::now();
+
+		MeshOptimiser::OptimiseVertexCache(indices);
+
+		const Clock_t::duration duration = Clock_t::now() - start;
+
+		const MeshOptimiser::VertexCacheStatistics after
+			= MeshOptimiser::AnalyseVertexCache(indices);
+
+		EXPECT_LE(after.acmr, before.acmr) << name;
+
+		const double trianglesPerSecond = static_cast<double>(std::size(indices) / 3u)
+			/ std::chrono::duration<double>{ duration }.count() / 1e6;
+
+		std::cout << "  " << name << " : ACMR " << before.acmr << " -> " << after.acmr
+			<< ", ATVR " << before.atvr << " -> " << after.atvr << ", "
+			<< trianglesPerSecond << " M triangles/s\n";
+	}
+}
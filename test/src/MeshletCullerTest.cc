@@ -0,0 +1,634 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <MeshBoundImpl.hpp>
+#include <MeshBundleBase.hpp>
+#include <MeshletCuller.hpp>
+#include <MeshletValidator.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+using namespace DirectX;
+
+// A plane with a height which jumps around, so the neighbouring triangles face very different
+// directions.
+[[nodiscard]]
+static Mesh GenerateJaggedPlane(std::uint32_t quadCount)
+{
+	Mesh plane = GeneratePlane(quadCount);
+
+	for (Vertex& vertex : plane.vertices)
+	{
+		const auto x = static_cast<std::uint32_t>(vertex.position.x);
+		const auto z = static_cast<std::uint32_t>(vertex.position.z);
+
+		vertex.position.y = static_cast<float>((x * z) % 7u) * 0.5f;
+	}
+
+	return plane;
+}
+
+// The planes are so far away that every sphere is inside of the frustum. So, only the normal
+// cone can cull a meshlet.
+[[nodiscard]]
+static Frustum GetOpenFrustum() noexcept
+{
+	const XMFLOAT4 plane{ 0.f, 0.f, 0.f, 1e30f };
+
+	return Frustum
+	{
+		.leftP   = plane,
+		.rightP  = plane,
+		.bottomP = plane,
+		.topP    = plane,
+		.nearP   = plane,
+		.farP    = plane
+	};
+}
+
+// The camera positions around a meshlet. The ones near the apex of the cone and near the
+// sphere are where a cone which is a bit too wide would cull a front facing triangle.
+[[nodiscard]]
+static std::vector<XMFLOAT3> GetCameraPositions(
+	const MeshletDetails& meshletDetails, std::mt19937& randomEngine
+) {
+	const MeshletCuller::NormalCone cone = MeshletCuller::UnpackNormalCone(
+		meshletDetails.coneNormal
+	);
+
+	const XMFLOAT4& sphere = meshletDetails.sphereB.sphere;
+
+	const XMVECTOR centre = XMVectorSet(sphere.x, sphere.y, sphere.z, 0.f);
+	const XMVECTOR apex   = centre
+		- XMLoadFloat3(&cone.axis) * meshletDetails.coneNormal.apexOffset;
+
+	std::normal_distribution<float> distribution{};
+	std::uniform_real_distribution<float> spreadDistribution{ 0.f, 1.2f };
+
+	auto GetRandomDirection = [&distribution, &randomEngine]
+	{
+		return XMVector3Normalize(
+			XMVectorSet(
+				distribution(randomEngine), distribution(randomEngine),
+				distribution(randomEngine), 0.f
+			)
+		);
+	};
+
+	// The cameras which can cull the meshlet are in the inverted cone behind the apex.
+	const XMVECTOR invertedAxis = -XMVector3Normalize(XMLoadFloat3(&cone.axis));
+	const float cutoff          = std::max(cone.cutoff, 1e-3f);
+	const float tangent         = std::sqrt(std::max(1.f - cutoff * cutoff, 0.f)) / cutoff;
+
+	std::vector<XMFLOAT3> cameraPositions{};
+
+	for (const float distanceScale : { 0.05f, 0.5f, 2.f, 20.f })
+		for (size_t index = 0u; index < 32u; ++index)
+		{
+			const float distance = distanceScale * std::max(sphere.w, 1.f);
+
+			const XMVECTOR direction = GetRandomDirection();
+
+			for (const XMVECTOR origin : { apex, centre })
+				XMStoreFloat3(&cameraPositions.emplace_back(), origin + direction * distance);
+
+			if (cone.isDegenerate)
+				continue;
+
+			// Both sides of the edge of the inverted cone.
+			const XMVECTOR perpendicular = XMVector3Normalize(
+				XMVector3Cross(invertedAxis, GetRandomDirection())
+			);
+			const XMVECTOR coneDirection = XMVector3Normalize(
+				invertedAxis + perpendicular * (tangent * spreadDistribution(randomEngine))
+			);
+
+			XMStoreFloat3(&cameraPositions.emplace_back(), apex + coneDirection * distance);
+		}
+
+	return cameraPositions;
+}
+
+struct CullingCounts
+{
+	size_t culledCount            = 0u;
+	// The culled meshlets which have a triangle facing the camera.
+	size_t culledFrontFacingCount = 0u;
+};
+
+// The face normals decide if a triangle faces the camera, as in the backface culling. The
+// triangles are counter clockwise, with the normal the cross of the first two edges.
+[[nodiscard]]
+static bool HasFrontFacingTriangle(
+	const MeshBundleTemporaryData& bundleData, const MeshTemporaryDetailsMS& meshDetails,
+	const Meshlet& meshlet, const XMFLOAT3& cameraPosition
+) noexcept {
+	auto GetPosition = [&](std::uint32_t localIndex)
+	{
+		const std::uint32_t vertexIndex = bundleData.indices[
+			meshDetails.indexOffset + meshlet.indexOffset + localIndex
+		];
+
+		return XMLoadFloat3(
+			&bundleData.vertices[meshDetails.vertexOffset + vertexIndex].position
+		);
+	};
+
+	const XMVECTOR camera = XMLoadFloat3(&cameraPosition);
+
+	for (std::uint32_t index = 0u; index < meshlet.primitiveCount; ++index)
+	{
+		const PrimitiveIndicesUnpacked prim = UnpackPrim(
+			bundleData.primIndices[meshDetails.primitiveOffset + meshlet.primitiveOffset + index]
+		);
+
+		const XMVECTOR position0 = GetPosition(prim.firstIndex);
+		const XMVECTOR position1 = GetPosition(prim.secondIndex);
+		const XMVECTOR position2 = GetPosition(prim.thirdIndex);
+
+		const XMVECTOR faceNormal = XMVector3Cross(
+			position1 - position0, position2 - position0
+		);
+
+		if (XMVectorGetX(XMVector3LengthSq(faceNormal)) == 0.f)
+			continue;
+
+		const XMVECTOR view = camera - position0;
+
+		// A triangle which is almost edge on can go either way in the rasteriser.
+		const float tolerance = 1e-4f * XMVectorGetX(XMVector3Length(view));
+
+		if (XMVectorGetX(XMVector3Dot(XMVector3Normalize(faceNormal), view)) > tolerance)
+			return true;
+	}
+
+	return false;
+}
+
+[[nodiscard]]
+static CullingCounts CountCulledMeshlets(const MeshBundleTemporaryData& bundleData)
+{
+	const Frustum frustum = GetOpenFrustum();
+
+	std::mt19937 randomEngine{ 11u };
+
+	CullingCounts counts{};
+
+	for (const MeshTemporaryDetailsMS& meshDetails
+		: bundleData.bundleDetails.meshTemporaryDetailsMS)
+	{
+		std::span<const MeshletDetails> meshletDetails = std::span{
+			bundleData.meshletDetails
+		}.subspan(meshDetails.meshletOffset, meshDetails.meshletCount);
+
+		for (const MeshletDetails& meshletDetail : meshletDetails)
+			for (const XMFLOAT3& cameraPosition : GetCameraPositions(meshletDetail, randomEngine))
+			{
+				if (MeshletCuller::IsMeshletVisible(
+					meshletDetail, XMMatrixIdentity(), frustum, cameraPosition
+				)) continue;
+
+				++counts.culledCount;
+
+				if (HasFrontFacingTriangle(
+					bundleData, meshDetails, meshletDetail.meshlet, cameraPosition
+				)) ++counts.culledFrontFacingCount;
+			}
+	}
+
+	return counts;
+}
+
+// The culler must never cull a meshlet which has a triangle facing the camera. The validator
+// checks the same thing on the cones themselves, so both of them should agree. Only the face
+// normal cones are checked, as the vertex normal ones are only as good as the normals.
+TEST(MeshletCullerTest, CulledMeshletsAreNeverFrontFacing)
+{
+	const std::array meshes
+	{
+		std::pair{ "sphere", GenerateSphere(32u, 64u) },
+		std::pair{ "shuffled sphere", GenerateShuffledSphere(32u, 64u) },
+		std::pair{ "plane", GeneratePlane(32u) },
+		std::pair{ "jagged plane", GenerateJaggedPlane(32u) }
+	};
+
+	for (const auto& [name, mesh] : meshes)
+		for (const MeshletBuildMode buildMode
+			: { MeshletBuildMode::IndexOrder, MeshletBuildMode::Spatial })
+		{
+			MeshBundleTempCustom bundle{};
+
+			bundle.SetMeshletBuildMode(buildMode);
+			bundle.SetNormalConeAlgorithm(NormalConeAlgorithm::FaceNormals);
+			bundle.AddMesh(Mesh{ mesh });
+
+			const MeshBundleTemporaryData bundleData = bundle.GenerateTemporaryData(true);
+
+			const bool isSpatial = buildMode == MeshletBuildMode::Spatial;
+
+			SCOPED_TRACE(std::string{ name } + (isSpatial ? ", spatial" : ", index order"));
+
+			const MeshletValidator::MeshBundleReport report
+				= MeshletValidator::ValidateMeshBundle(bundleData);
+
+			EXPECT_TRUE(report.IsValid()) << MeshletValidator::FormatReport(report);
+
+			const CullingCounts counts = CountCulledMeshlets(bundleData);
+
+			EXPECT_EQ(counts.culledFrontFacingCount, 0u)
+				<< counts.culledFrontFacingCount << " of " << counts.culledCount
+				<< " culled meshlets have a front facing triangle.";
+
+			// Otherwise nothing was tested. The meshlets of the shuffled sphere are all over
+			// the place in the index order, so their cones are degenerate.
+			if (isSpatial)
+				EXPECT_GT(counts.culledCount, 0u);
+		}
+}
+
+// Six planes around the origin, each tilted a bit and at a random distance from it, so the
+// frustum cuts through the meshes.
+[[nodiscard]]
+static Frustum GenerateRandomFrustum(std::mt19937& randomEngine)
+{
+	std::uniform_real_distribution<float> tiltDistribution{ -0.3f, 0.3f };
+	std::uniform_real_distribution<float> distanceDistribution{ 0.2f, 1.5f };
+
+	auto GetPlane = [&](float x, float y, float z)
+	{
+		const XMVECTOR normal = XMVector3Normalize(
+			XMVectorSet(
+				x + tiltDistribution(randomEngine), y + tiltDistribution(randomEngine),
+				z + tiltDistribution(randomEngine), 0.f
+			)
+		);
+
+		XMFLOAT4 plane{};
+		XMStoreFloat4(&plane, XMVectorSetW(normal, distanceDistribution(randomEngine)));
+
+		return plane;
+	};
+
+	return Frustum
+	{
+		.leftP   = GetPlane(1.f, 0.f, 0.f),
+		.rightP  = GetPlane(-1.f, 0.f, 0.f),
+		.bottomP = GetPlane(0.f, 1.f, 0.f),
+		.topP    = GetPlane(0.f, -1.f, 0.f),
+		.nearP   = GetPlane(0.f, 0.f, 1.f),
+		.farP    = GetPlane(0.f, 0.f, -1.f)
+	};
+}
+
+// A non uniform scale, a rotation and a translation.
+[[nodiscard]]
+static XMMATRIX GenerateRandomModelMatrix(std::mt19937& randomEngine)
+{
+	std::uniform_real_distribution<float> scaleDistribution{ 0.5f, 2.f };
+	std::uniform_real_distribution<float> angleDistribution{ -XM_PI, XM_PI };
+	std::uniform_real_distribution<float> offsetDistribution{ -0.5f, 0.5f };
+
+	return XMMatrixScaling(
+		scaleDistribution(randomEngine), scaleDistribution(randomEngine),
+		scaleDistribution(randomEngine)
+	) * XMMatrixRotationRollPitchYaw(
+		angleDistribution(randomEngine), angleDistribution(randomEngine),
+		angleDistribution(randomEngine)
+	) * XMMatrixTranslation(
+		offsetDistribution(randomEngine), offsetDistribution(randomEngine),
+		offsetDistribution(randomEngine)
+	);
+}
+
+// The visible meshlets of each model from the ranges. The consecutive visible meshlets of a
+// model must have been merged into a single range.
+[[nodiscard]]
+static std::vector<std::vector<bool>> GetVisibleMeshlets(
+	std::span<const MeshletRange> visibleRanges, size_t modelCount, size_t meshletCount
+) {
+	std::vector<std::vector<bool>> visibleMeshlets(
+		modelCount, std::vector<bool>(meshletCount, false)
+	);
+
+	for (size_t index = 0u; index < std::size(visibleRanges); ++index)
+	{
+		const MeshletRange& range = visibleRanges[index];
+
+		EXPECT_GT(range.meshletCount, 0u);
+
+		if (index != 0u)
+		{
+			const MeshletRange& previousRange = visibleRanges[index - 1u];
+
+			if (previousRange.modelIndex == range.modelIndex)
+				EXPECT_LT(
+					previousRange.meshletOffset + previousRange.meshletCount,
+					range.meshletOffset
+				) << "The ranges weren't merged.";
+		}
+
+		for (std::uint32_t offset = 0u; offset < range.meshletCount; ++offset)
+			visibleMeshlets[range.modelIndex][range.meshletOffset + offset] = true;
+	}
+
+	return visibleMeshlets;
+}
+
+// The batched culling must give the same result as culling each meshlet on its own.
+TEST(MeshletCullerTest, BatchedCullingMatchesScalar)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.SetMeshletBuildMode(MeshletBuildMode::Spatial);
+	bundle.SetNormalConeAlgorithm(NormalConeAlgorithm::FaceNormals);
+
+	// The plane is scaled down to about the size of the sphere.
+	Mesh jaggedPlane = GenerateJaggedPlane(32u);
+
+	for (Vertex& vertex : jaggedPlane.vertices)
+		XMStoreFloat3(&vertex.position, XMLoadFloat3(&vertex.position) * (1.f / 16.f) - 1.f);
+
+	bundle.AddMesh(GenerateSphere(32u, 64u));
+	bundle.AddMesh(std::move(jaggedPlane));
+
+	const MeshBundleTemporaryData bundleData = bundle.GenerateTemporaryData(true);
+
+	const std::vector<MeshletDetails>& meshletDetails = bundleData.meshletDetails;
+	const size_t meshletCount                         = std::size(meshletDetails);
+
+	std::mt19937 randomEngine{ 17u };
+	std::uniform_real_distribution<float> cameraDistribution{ -4.f, 4.f };
+
+	size_t visibleCount = 0u;
+	size_t culledCount  = 0u;
+
+	for (size_t iteration = 0u; iteration < 200u; ++iteration)
+	{
+		const Frustum frustum = GenerateRandomFrustum(randomEngine);
+
+		const XMFLOAT3 cameraPosition{
+			cameraDistribution(randomEngine), cameraDistribution(randomEngine),
+			cameraDistribution(randomEngine)
+		};
+
+		// Each mesh as its own model and the whole bundle as a third one.
+		std::vector<MeshletCullingModel> models{};
+
+		for (const MeshTemporaryDetailsMS& meshDetails
+			: bundleData.bundleDetails.meshTemporaryDetailsMS)
+			models.emplace_back(
+				MeshletCullingModel
+				{
+					.modelMatrix   = GenerateRandomModelMatrix(randomEngine),
+					.meshletOffset = meshDetails.meshletOffset,
+					.meshletCount  = meshDetails.meshletCount
+				}
+			);
+
+		models.emplace_back(
+			MeshletCullingModel
+			{
+				.modelMatrix   = GenerateRandomModelMatrix(randomEngine),
+				.meshletOffset = 0u,
+				.meshletCount  = static_cast<std::uint32_t>(meshletCount)
+			}
+		);
+
+		std::vector<MeshletRange> visibleRanges{};
+
+		MeshletCuller::CullMeshlets(
+			meshletDetails, models, frustum, cameraPosition, visibleRanges
+		);
+
+		const std::vector<std::vector<bool>> visibleMeshlets = GetVisibleMeshlets(
+			visibleRanges, std::size(models), meshletCount
+		);
+
+		for (size_t modelIndex = 0u; modelIndex < std::size(models); ++modelIndex)
+		{
+			const MeshletCullingModel& model = models[modelIndex];
+
+			for (size_t index = 0u; index < meshletCount; ++index)
+			{
+				const bool isInModel = index >= model.meshletOffset
+					&& index < model.meshletOffset + model.meshletCount;
+
+				const bool isVisible = isInModel && MeshletCuller::IsMeshletVisible(
+					meshletDetails[index], model.modelMatrix, frustum, cameraPosition
+				);
+
+				EXPECT_EQ(visibleMeshlets[modelIndex][index], isVisible)
+					<< "Iteration " << iteration << ", model " << modelIndex
+					<< ", meshlet " << index;
+
+				if (isInModel)
+					++(isVisible ? visibleCount : culledCount);
+			}
+		}
+	}
+
+	// Otherwise, it wasn't much of a test.
+	EXPECT_GT(visibleCount, 0u);
+	EXPECT_GT(culledCount, 0u);
+}
+
+// Triangles around an axis, with their face normals all at the same angle from it. Each of
+// them is at a different place, around the origin.
+[[nodiscard]]
+static std::vector<XMFLOAT3> GenerateNormalFan(FXMVECTOR axis, float angle)
+{
+	const XMVECTOR tangent   = XMVector3Normalize(
+		XMVector3Cross(axis, std::abs(XMVectorGetX(axis)) < 0.9f
+			? XMVectorSet(1.f, 0.f, 0.f, 0.f) : XMVectorSet(0.f, 1.f, 0.f, 0.f))
+	);
+	const XMVECTOR bitangent = XMVector3Cross(axis, tangent);
+
+	constexpr size_t triangleCount = 8u;
+
+	std::vector<XMFLOAT3> trianglePositions{};
+
+	for (size_t index = 0u; index < triangleCount; ++index)
+	{
+		const float azimuth = XM_2PI * static_cast<float>(index) / triangleCount;
+
+		const XMVECTOR around = tangent * std::cos(azimuth) + bitangent * std::sin(azimuth);
+		const XMVECTOR normal = axis * std::cos(angle) + around * std::sin(angle);
+
+		// Two edges in the plane of the normal, which wind counter clockwise around it.
+		const XMVECTOR edge0 = XMVector3Normalize(XMVector3Cross(normal, around));
+		const XMVECTOR edge1 = XMVector3Cross(normal, edge0);
+
+		const XMVECTOR position0 = around * 0.5f;
+
+		for (const XMVECTOR position : { position0, position0 + edge0, position0 + edge1 })
+			XMStoreFloat3(&trianglePositions.emplace_back(), position);
+	}
+
+	return trianglePositions;
+}
+
+[[nodiscard]]
+static float GetDegrees(FXMVECTOR direction0, FXMVECTOR direction1) noexcept
+{
+	const float cosine = XMVectorGetX(
+		XMVector3Dot(XMVector3Normalize(direction0), XMVector3Normalize(direction1))
+	);
+
+	return XMConvertToDegrees(std::acos(std::clamp(cosine, -1.f, 1.f)));
+}
+
+// The packed cone is checked against the normals it was made from, and the culler is used to
+// check where it culls them from. It must only cull them from behind all of the triangles,
+// and it should cull them from almost everywhere the triangles can't be seen from.
+TEST(MeshletCullerTest, PackedConeMatchesNormals)
+{
+	const Frustum frustum = GetOpenFrustum();
+
+	std::mt19937 randomEngine{ 19u };
+	std::normal_distribution<float> distribution{};
+
+	for (size_t axisIndex = 0u; axisIndex < 16u; ++axisIndex)
+	{
+		const XMVECTOR axis = XMVector3Normalize(
+			XMVectorSet(
+				distribution(randomEngine), distribution(randomEngine),
+				distribution(randomEngine), 0.f
+			)
+		);
+
+		for (const float degrees : { 0.f, 10.f, 30.f, 60.f, 80.f })
+		{
+			SCOPED_TRACE(std::to_string(degrees) + " degrees");
+
+			const std::vector<XMFLOAT3> trianglePositions = GenerateNormalFan(
+				axis, XMConvertToRadians(degrees)
+			);
+
+			MeshletDetails meshletDetails{
+				.meshlet = Meshlet{
+					.indexCount = static_cast<std::uint32_t>(std::size(trianglePositions)),
+					.primitiveCount = static_cast<std::uint32_t>(
+						std::size(trianglePositions) / 3u
+					)
+				},
+				.sphereB = GenerateSphereBV(trianglePositions, SphereBVAlgorithm::Welzl)
+			};
+
+			meshletDetails.coneNormal = GenerateFaceNormalCone(
+				trianglePositions, meshletDetails.sphereB
+			);
+
+			const MeshletCuller::NormalCone cone = MeshletCuller::UnpackNormalCone(
+				meshletDetails.coneNormal
+			);
+
+			ASSERT_FALSE(cone.isDegenerate);
+
+			const XMVECTOR coneAxis = XMVector3Normalize(XMLoadFloat3(&cone.axis));
+
+			// The snorm8 axis can only be about half a degree away.
+			EXPECT_LT(GetDegrees(coneAxis, axis), 1.f);
+
+			// The cutoff is the sine of the normals' angle, with the axis quantisation and
+			// rounded up.
+			const float minimumCutoff = std::sin(XMConvertToRadians(degrees));
+			const float maximumCutoff = std::sin(XMConvertToRadians(degrees + 1.f)) + 1.f / 255.f;
+
+			EXPECT_GE(cone.cutoff, minimumCutoff);
+			EXPECT_LE(cone.cutoff, maximumCutoff);
+
+			const XMFLOAT4& sphere = meshletDetails.sphereB.sphere;
+
+			const XMVECTOR centre = XMVectorSet(sphere.x, sphere.y, sphere.z, 0.f);
+			const XMVECTOR apex   = centre - coneAxis * meshletDetails.coneNormal.apexOffset;
+
+			auto IsVisibleFrom = [&](FXMVECTOR cameraPosition)
+			{
+				XMFLOAT3 camera{};
+				XMStoreFloat3(&camera, cameraPosition);
+
+				return MeshletCuller::IsMeshletVisible(
+					meshletDetails, XMMatrixIdentity(), frustum, camera
+				);
+			};
+
+			auto IsAnyTriangleFacing = [&](FXMVECTOR cameraPosition)
+			{
+				for (size_t index = 0u; index < std::size(trianglePositions); index += 3u)
+				{
+					const XMVECTOR position0 = XMLoadFloat3(&trianglePositions[index]);
+
+					const XMVECTOR faceNormal = XMVector3Cross(
+						XMLoadFloat3(&trianglePositions[index + 1u]) - position0,
+						XMLoadFloat3(&trianglePositions[index + 2u]) - position0
+					);
+
+					if (XMVectorGetX(XMVector3Dot(faceNormal, cameraPosition - position0)) > 0.f)
+						return true;
+				}
+
+				return false;
+			};
+
+			const XMVECTOR behind = apex - coneAxis * 100.f;
+			const XMVECTOR front  = centre + coneAxis * 100.f;
+
+			EXPECT_FALSE(IsVisibleFrom(behind));
+			EXPECT_FALSE(IsAnyTriangleFacing(behind));
+			EXPECT_TRUE(IsVisibleFrom(front));
+			EXPECT_TRUE(IsAnyTriangleFacing(front));
+
+			// A couple of degrees inside and outside of the culling cone's edge.
+			const float edgeAngle = std::acos(cone.cutoff);
+
+			const XMVECTOR sideways = XMVector3Normalize(
+				XMVector3Cross(coneAxis, XMVectorSet(0.3f, -0.5f, 0.8f, 0.f))
+			);
+
+			for (const float angleOffset : { -2.f, 2.f })
+			{
+				const float angle = edgeAngle + XMConvertToRadians(angleOffset);
+
+				if (angle <= 0.f)
+					continue;
+
+				const XMVECTOR direction = -coneAxis * std::cos(angle)
+					+ sideways * std::sin(angle);
+
+				const XMVECTOR cameraPosition = apex + direction * 100.f;
+
+				const bool isVisible = IsVisibleFrom(cameraPosition);
+
+				EXPECT_EQ(isVisible, angleOffset > 0.f) << angleOffset << " degrees off";
+
+				if (!isVisible)
+					EXPECT_FALSE(IsAnyTriangleFacing(cameraPosition));
+			}
+		}
+	}
+}
+
+// The normals facing opposite ways can't be culled from anywhere.
+TEST(MeshletCullerTest, OpposingNormalsAreDegenerate)
+{
+	std::vector<XMFLOAT3> trianglePositions = GenerateNormalFan(
+		XMVectorSet(0.f, 1.f, 0.f, 0.f), XMConvertToRadians(30.f)
+	);
+
+	const std::vector<XMFLOAT3> opposingPositions = GenerateNormalFan(
+		XMVectorSet(0.f, -1.f, 0.f, 0.f), XMConvertToRadians(30.f)
+	);
+
+	trianglePositions.insert(
+		std::end(trianglePositions), std::begin(opposingPositions), std::end(opposingPositions)
+	);
+
+	const ClusterNormalCone packedCone = GenerateFaceNormalCone(
+		trianglePositions, GenerateSphereBV(trianglePositions, SphereBVAlgorithm::Welzl)
+	);
+
+	EXPECT_TRUE(MeshletCuller::UnpackNormalCone(packedCone).isDegenerate);
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <MeshletHierarchy.hpp>
+#include <MeshletMaker.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+static constexpr std::array s_errorThresholds{ 0.f, 1e-4f, 1e-3f, 1e-2f, 1e-1f, 1.f };
+static constexpr std::array s_viewDistances{ 1.5f, 3.f, 10.f };
+
+// For every path from a meshlet up to a root, the count of the selected meshlets on it is
+// set as a bit. Every path from a meshlet of the first level must have exactly one.
+[[nodiscard]]
+static std::vector<std::uint64_t> GeneratePathSelectionCounts(
+	const MeshletHierarchy& hierarchy, const std::vector<std::uint32_t>& selectedMeshlets
+) {
+	const size_t meshletCount = std::size(hierarchy.lodDetails);
+
+	std::vector<std::uint8_t> isMeshletSelected(meshletCount, 0u);
+
+	for (const std::uint32_t meshletIndex : selectedMeshlets)
+		isMeshletSelected[meshletIndex] = 1u;
+
+	std::vector<std::uint64_t> pathSelectionCounts(meshletCount, 0u);
+
+	// The parents are always after their children.
+	for (size_t index = meshletCount; index-- > 0u;)
+	{
+		const MeshletLodDetails& lodDetails = hierarchy.lodDetails[index];
+
+		std::uint64_t parentCounts = 0u;
+
+		for (std::uint32_t parentIndex = 0u; parentIndex < lodDetails.parentCount; ++parentIndex)
+		{
+			EXPECT_GT(lodDetails.parentOffset + parentIndex, index);
+
+			parentCounts |= pathSelectionCounts[lodDetails.parentOffset + parentIndex];
+		}
+
+		if (!lodDetails.parentCount)
+			parentCounts = 1u;
+
+		pathSelectionCounts[index] = parentCounts << isMeshletSelected[index];
+	}
+
+	return pathSelectionCounts;
+}
+
+// The edges of the selected triangles, with their vertices compared by their positions,
+// which don't have a reversed edge.
+[[nodiscard]]
+static size_t CountOpenEdges(
+	const Mesh& mesh, const MeshletHierarchy& hierarchy,
+	const std::vector<std::uint32_t>& selectedMeshlets
+) {
+	using Position_t = std::array<std::uint32_t, 3u>;
+
+	auto GetPosition = [&mesh](std::uint32_t vertexIndex)
+	{
+		const DirectX::XMFLOAT3& position = mesh.vertices[vertexIndex].position;
+
+		return Position_t
+		{
+			std::bit_cast<std::uint32_t>(position.x), std::bit_cast<std::uint32_t>(position.y),
+			std::bit_cast<std::uint32_t>(position.z)
+		};
+	};
+
+	std::map<std::array<Position_t, 2u>, std::int32_t> edgeCounts{};
+
+	for (const std::uint32_t meshletIndex : selectedMeshlets)
+	{
+		const Meshlet& meshlet = hierarchy.meshletDetails[meshletIndex].meshlet;
+
+		for (size_t index = 0u; index < meshlet.primitiveCount; ++index)
+		{
+			const PrimitiveIndicesUnpacked unpackedPrim = UnpackPrim(
+				hierarchy.primIndices[meshlet.primitiveOffset + index]
+			);
+
+			const std::uint32_t* meshletVertices = &hierarchy.vertexIndices[meshlet.indexOffset];
+
+			const std::array<Position_t, 3u> positions
+			{
+				GetPosition(meshletVertices[unpackedPrim.firstIndex]),
+				GetPosition(meshletVertices[unpackedPrim.secondIndex]),
+				GetPosition(meshletVertices[unpackedPrim.thirdIndex])
+			};
+
+			for (size_t vertex = 0u; vertex < 3u; ++vertex)
+			{
+				const Position_t& position     = positions[vertex];
+				const Position_t& nextPosition = positions[(vertex + 1u) % 3u];
+
+				++edgeCounts[{ position, nextPosition }];
+				--edgeCounts[{ nextPosition, position }];
+			}
+		}
+	}
+
+	return static_cast<size_t>(
+		std::ranges::count_if(edgeCounts, [](const auto& edgeCount) { return edgeCount.second; })
+	);
+}
+
+// Every cut of a closed sphere must select each part of it once, and stay closed.
+static void CheckCuts(const Mesh& mesh, const MeshletHierarchy& hierarchy)
+{
+	ASSERT_FALSE(std::empty(hierarchy.lodDetails));
+
+	for (const float viewDistance : s_viewDistances)
+		for (const float errorThreshold : s_errorThresholds)
+		{
+			SCOPED_TRACE(
+				"Distance " + std::to_string(viewDistance) + ", threshold "
+				+ std::to_string(errorThreshold)
+			);
+
+			std::vector<std::uint32_t> selectedMeshlets{};
+
+			SelectMeshlets(
+				hierarchy, DirectX::XMFLOAT3{ viewDistance, 0.f, 0.f }, errorThreshold,
+				selectedMeshlets
+			);
+
+			ASSERT_FALSE(std::empty(selectedMeshlets));
+
+			const std::vector<std::uint64_t> pathSelectionCounts = GeneratePathSelectionCounts(
+				hierarchy, selectedMeshlets
+			);
+
+			for (size_t index = 0u; index < hierarchy.firstLevelMeshletCount; ++index)
+				EXPECT_EQ(pathSelectionCounts[index], 0b10u) << "First level meshlet " << index;
+
+			EXPECT_EQ(CountOpenEdges(mesh, hierarchy, selectedMeshlets), 0u);
+		}
+}
+
+// A meshlet carried from a stuck group has parents more than a level above it.
+[[nodiscard]]
+static size_t CountCarriedMeshlets(const MeshletHierarchy& hierarchy)
+{
+	return static_cast<size_t>(std::ranges::count_if(
+		hierarchy.lodDetails,
+		[&hierarchy](const MeshletLodDetails& lodDetails)
+		{
+			return lodDetails.parentCount
+				&& hierarchy.lodDetails[lodDetails.parentOffset].level > lodDetails.level + 1u;
+		}
+	));
+}
+
+TEST(MeshletHierarchyTest, CutsCoverTheSurfaceOnce)
+{
+	const Mesh sphere = GenerateSphere(32u, 64u);
+
+	const MeshletHierarchy hierarchy = GenerateMeshletHierarchy(
+		sphere, MeshletLimitsType::Vertex64Primitive126
+	);
+
+	EXPECT_GT(hierarchy.levelCount, 2u);
+	EXPECT_LT(std::size(hierarchy.lodDetails), hierarchy.firstLevelMeshletCount * 3u);
+
+	CheckCuts(sphere, hierarchy);
+}
+
+TEST(MeshletHierarchyTest, ErrorsAndBoundsGrowUpTheHierarchy)
+{
+	const Mesh sphere = GenerateSphere(32u, 64u);
+
+	const MeshletHierarchy hierarchy = GenerateMeshletHierarchy(
+		sphere, MeshletLimitsType::Vertex64Primitive126
+	);
+
+	const size_t meshletCount = std::size(hierarchy.lodDetails);
+
+	ASSERT_EQ(meshletCount, std::size(hierarchy.meshletDetails));
+
+	for (size_t index = 0u; index < meshletCount; ++index)
+	{
+		const MeshletLodDetails& lodDetails = hierarchy.lodDetails[index];
+
+		if (index < hierarchy.firstLevelMeshletCount)
+		{
+			EXPECT_EQ(lodDetails.level, 0u);
+			EXPECT_EQ(lodDetails.error, 0.f);
+		}
+
+		if (!lodDetails.parentCount)
+		{
+			EXPECT_EQ(lodDetails.parentError, std::numeric_limits<float>::max());
+
+			continue;
+		}
+
+		EXPECT_GE(lodDetails.parentError, lodDetails.error);
+
+		const DirectX::XMFLOAT4& bounds       = lodDetails.lodBounds.sphere;
+		const DirectX::XMFLOAT4& parentBounds = lodDetails.parentLodBounds.sphere;
+
+		const float centreDistance = std::sqrt(
+			(bounds.x - parentBounds.x) * (bounds.x - parentBounds.x)
+			+ (bounds.y - parentBounds.y) * (bounds.y - parentBounds.y)
+			+ (bounds.z - parentBounds.z) * (bounds.z - parentBounds.z)
+		);
+
+		EXPECT_LE(centreDistance + bounds.w, parentBounds.w * 1.0001f) << "Meshlet " << index;
+
+		// The parents are the meshlets made from this meshlet's group, so their own error and
+		// bounds are the parent ones of this meshlet.
+		for (std::uint32_t parentIndex = 0u; parentIndex < lodDetails.parentCount; ++parentIndex)
+		{
+			const MeshletLodDetails& parentLodDetails
+				= hierarchy.lodDetails[lodDetails.parentOffset + parentIndex];
+
+			EXPECT_EQ(parentLodDetails.error, lodDetails.parentError);
+			EXPECT_EQ(parentLodDetails.lodBounds.sphere.w, parentBounds.w);
+			EXPECT_GT(parentLodDetails.level, lodDetails.level);
+		}
+	}
+}
+
+// Some of the groups of this sphere can't be simplified enough on their level. Their
+// meshlets must be grouped again on the next one, instead of being left as roots, which
+// their neighbours don't lock their borders with.
+TEST(MeshletHierarchyTest, StuckGroupsAreCarried)
+{
+	const Mesh sphere = GenerateSphere(64u, 128u);
+
+	const MeshletHierarchy hierarchy = GenerateMeshletHierarchy(
+		sphere, MeshletLimitsType::Vertex64Primitive126
+	);
+
+	EXPECT_GT(CountCarriedMeshlets(hierarchy), 0u);
+
+	CheckCuts(sphere, hierarchy);
+}
@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <MeshletMaker.hpp>
+#include <MeshBundleBase.hpp>
+#include <MeshletCuller.hpp>
+#include <MeshletValidator.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// The meshlets of a mesh, built with the unordered_map lookup the local index table replaced.
+// It is the reference the table is checked and benchmarked against. It is only valid for
+// meshes without degenerate triangles, as it counted a repeated vertex of a triangle twice.
+struct MapMeshlets
+{
+	std::vector<std::uint32_t> vertexIndices;
+	std::vector<std::uint32_t> primIndices;
+	std::vector<Meshlet>       meshlets;
+};
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+[[nodiscard]]
+static MapMeshlets MakeMapMeshlets(const std::vector<std::uint32_t>& indices)
+{
+	MapMeshlets mapMeshlets{};
+
+	std::unordered_map<std::uint32_t, std::uint32_t> localIndexMap{};
+
+	size_t vertexIndexOffset = 0u;
+	size_t primIndexOffset   = 0u;
+
+	auto AddMeshlet = [&]
+	{
+		mapMeshlets.meshlets.emplace_back(
+			Meshlet
+			{
+				.indexCount      = static_cast<std::uint32_t>(
+					std::size(mapMeshlets.vertexIndices) - vertexIndexOffset
+				),
+				.indexOffset     = static_cast<std::uint32_t>(vertexIndexOffset),
+				.primitiveCount  = static_cast<std::uint32_t>(
+					std::size(mapMeshlets.primIndices) - primIndexOffset
+				),
+				.primitiveOffset = static_cast<std::uint32_t>(primIndexOffset)
+			}
+		);
+
+		vertexIndexOffset = std::size(mapMeshlets.vertexIndices);
+		primIndexOffset   = std::size(mapMeshlets.primIndices);
+
+		localIndexMap.clear();
+	};
+
+	auto GetOrAddLocalIndex = [&](std::uint32_t vertexIndex)
+	{
+		auto [localIndex, isAdded] = localIndexMap.emplace(
+			vertexIndex,
+			static_cast<std::uint32_t>(std::size(mapMeshlets.vertexIndices) - vertexIndexOffset)
+		);
+
+		if (isAdded)
+			mapMeshlets.vertexIndices.emplace_back(vertexIndex);
+
+		return localIndex->second;
+	};
+
+	for (size_t index = 0u; index + 2u < std::size(indices); index += 3u)
+	{
+		size_t addableVertexCount = 0u;
+
+		for (size_t offset = 0u; offset < 3u; ++offset)
+			addableVertexCount += !localIndexMap.contains(indices[index + offset]);
+
+		const size_t vertexCount = std::size(mapMeshlets.vertexIndices) - vertexIndexOffset;
+		const size_t primCount   = std::size(mapMeshlets.primIndices) - primIndexOffset;
+
+		if (vertexCount + addableVertexCount > vertexLimit_t || primCount + 1u > primitiveLimit_t)
+			AddMeshlet();
+
+		const PrimitiveIndicesUnpacked unpackedPrim
+		{
+			.firstIndex  = GetOrAddLocalIndex(indices[index]),
+			.secondIndex = GetOrAddLocalIndex(indices[index + 1u]),
+			.thirdIndex  = GetOrAddLocalIndex(indices[index + 2u])
+		};
+
+		mapMeshlets.primIndices.emplace_back(PackPrim(unpackedPrim));
+	}
+
+	if (std::size(mapMeshlets.primIndices) > primIndexOffset)
+		AddMeshlet();
+
+	return mapMeshlets;
+}
+
+template<size_t vertexLimit_t, size_t primitiveLimit_t>
+static void ExpectSameAsMapMeshlets(const Mesh& mesh)
+{
+	MeshletMaker<vertexLimit_t, primitiveLimit_t> meshletMaker{};
+
+	meshletMaker.GenerateMeshlets(mesh);
+
+	std::vector<std::uint32_t> vertexIndices{};
+	meshletMaker.LoadVertexIndices(vertexIndices);
+
+	const MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+
+	const MapMeshlets mapMeshlets = MakeMapMeshlets<vertexLimit_t, primitiveLimit_t>(
+		mesh.indices
+	);
+
+	EXPECT_EQ(vertexIndices, mapMeshlets.vertexIndices);
+	EXPECT_EQ(extraMeshData.primIndices, mapMeshlets.primIndices);
+
+	ASSERT_EQ(std::size(extraMeshData.meshletDetails), std::size(mapMeshlets.meshlets));
+
+	for (size_t index = 0u; index < std::size(mapMeshlets.meshlets); ++index)
+	{
+		const Meshlet& meshlet    = extraMeshData.meshletDetails[index].meshlet;
+		const Meshlet& mapMeshlet = mapMeshlets.meshlets[index];
+
+		EXPECT_EQ(meshlet.indexCount, mapMeshlet.indexCount);
+		EXPECT_EQ(meshlet.indexOffset, mapMeshlet.indexOffset);
+		EXPECT_EQ(meshlet.primitiveCount, mapMeshlet.primitiveCount);
+		EXPECT_EQ(meshlet.primitiveOffset, mapMeshlet.primitiveOffset);
+	}
+}
+
+TEST(MeshletMakerTest, LocalIndexScanMatchesScalar)
+{
+	std::mt19937 randomEngine{ 3u };
+	// A small range of indices, so there are plenty of matches and of stale slots.
+	std::uniform_int_distribution<std::uint32_t> indexDistribution{ 0u, 300u };
+
+	alignas(16) std::array<std::uint32_t, 256u> localVertexIndices{};
+
+	for (size_t iteration = 0u; iteration < 200u; ++iteration)
+	{
+		// The slots after the count are left with the indices of the previous iteration.
+		const auto localVertexCount = static_cast<std::uint32_t>(iteration % 257u);
+
+		for (std::uint32_t index = 0u; index < localVertexCount; ++index)
+			localVertexIndices[index] = indexDistribution(randomEngine);
+
+		for (std::uint32_t vertexIndex = 0u; vertexIndex <= 300u; ++vertexIndex)
+			ASSERT_EQ(
+				FindLocalVertexIndex(localVertexIndices, localVertexCount, vertexIndex),
+				FindLocalVertexIndexScalar(localVertexIndices, localVertexCount, vertexIndex)
+			) << "count " << localVertexCount << ", vertex index " << vertexIndex;
+	}
+}
+
+TEST(MeshletMakerTest, SameMeshletsAsMapLookup)
+{
+	const Mesh sphere         = GenerateSphere(32u, 64u);
+	const Mesh shuffledSphere = GenerateShuffledSphere(32u, 64u);
+
+	for (const Mesh* mesh : { &sphere, &shuffledSphere })
+	{
+		ExpectSameAsMapMeshlets<64u, 126u>(*mesh);
+		ExpectSameAsMapMeshlets<64u, 84u>(*mesh);
+		ExpectSameAsMapMeshlets<128u, 128u>(*mesh);
+		ExpectSameAsMapMeshlets<256u, 256u>(*mesh);
+	}
+}
+
+TEST(MeshletMakerTest, DegenerateTrianglesAreCountedOnce)
+{
+	// 63 unique vertices, and then a triangle which only adds a single one.
+	Mesh mesh{};
+
+	for (std::uint32_t index = 0u; index < 21u; ++index)
+		mesh.indices.insert(
+			std::end(mesh.indices), { index * 3u, index * 3u + 1u, index * 3u + 2u }
+		);
+
+	mesh.indices.insert(std::end(mesh.indices), { 63u, 63u, 63u });
+
+	MeshletMaker<64u, 126u> meshletMaker{};
+
+	meshletMaker.GenerateMeshlets(mesh);
+
+	const MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+
+	ASSERT_EQ(std::size(extraMeshData.meshletDetails), 1u);
+	EXPECT_EQ(extraMeshData.meshletDetails.front().meshlet.indexCount, 64u);
+	EXPECT_EQ(extraMeshData.meshletDetails.front().meshlet.primitiveCount, 22u);
+}
+
+// Only checks that both built the same number of meshlets. It prints the triangles per second
+// of both lookups.
+TEST(MeshletMakerBenchmark, LocalIndexTableAgainstMap)
+{
+	const Mesh sphere = GenerateShuffledSphere(256u, 512u);
+
+	const auto triangleCount = static_cast<double>(std::size(sphere.indices) / 3u);
+
+	using Clock_t = std::chrono::steady_clock;
+
+	auto GetTrianglesPerSecond = [triangleCount](Clock_t::duration duration)
+	{
+		return triangleCount / std::chrono::duration<double>{ duration }.count() / 1e6;
+	};
+
+	const Clock_t::time_point mapStart = Clock_t::now();
+
+	const MapMeshlets mapMeshlets = MakeMapMeshlets<64u, 126u>(sphere.indices);
+
+	const Clock_t::duration mapDuration = Clock_t::now() - mapStart;
+
+	const Clock_t::time_point tableStart = Clock_t::now();
+
+	MeshletMaker<64u, 126u> meshletMaker{};
+
+	meshletMaker.GenerateMeshlets(sphere);
+
+	const Clock_t::duration tableDuration = Clock_t::now() - tableStart;
+
+	const MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+
+	EXPECT_EQ(std::size(extraMeshData.meshletDetails), std::size(mapMeshlets.meshlets));
+
+	std::cout << "Meshlet building, " << triangleCount << " triangles:\n"
+		<< "  unordered_map     : " << GetTrianglesPerSecond(mapDuration) << " M triangles/s\n"
+		<< "  local index table : " << GetTrianglesPerSecond(tableDuration) << " M triangles/s\n";
+}
+
+struct MeshletBoundsStats
+{
+	size_t meshletCount;
+	float  meanRadius;
+	// The fraction of the meshlets whose cone can cull them.
+	float  cullableConeFraction;
+};
+
+[[nodiscard]]
+static MeshletBoundsStats GetMeshletBoundsStats(
+	const Mesh& mesh, MeshletBuildMode buildMode, NormalConeAlgorithm coneAlgorithm
+) {
+	MeshBundleTempCustom bundle{};
+
+	bundle.SetMeshletBuildMode(buildMode);
+	bundle.SetSphereBVAlgorithm(SphereBVAlgorithm::Ritter);
+	bundle.SetNormalConeAlgorithm(coneAlgorithm);
+	bundle.AddMesh(Mesh{ mesh });
+
+	const MeshBundleTemporaryData bundleData = bundle.GenerateTemporaryData(true);
+
+	float radiusSum      = 0.f;
+	size_t cullableCount = 0u;
+
+	for (const MeshletDetails& meshletDetails : bundleData.meshletDetails)
+	{
+		radiusSum     += meshletDetails.sphereB.sphere.w;
+		cullableCount += !MeshletCuller::UnpackNormalCone(meshletDetails.coneNormal).isDegenerate;
+	}
+
+	const size_t meshletCount = std::size(bundleData.meshletDetails);
+
+	return MeshletBoundsStats
+	{
+		.meshletCount         = meshletCount,
+		.meanRadius           = radiusSum / static_cast<float>(meshletCount),
+		.cullableConeFraction = static_cast<float>(cullableCount) / static_cast<float>(meshletCount)
+	};
+}
+
+// The spatial meshlets of a shuffled mesh must be at least as tight as the index order ones.
+// It prints the mean sphere radius and the fraction of the cones which can cull, of both modes.
+TEST(MeshletMakerBenchmark, SpatialAgainstIndexOrderBounds)
+{
+	const Mesh shuffledSphere = GenerateShuffledSphere(64u, 128u);
+
+	for (const NormalConeAlgorithm coneAlgorithm
+		: { NormalConeAlgorithm::VertexNormals, NormalConeAlgorithm::FaceNormals })
+	{
+		const MeshletBoundsStats indexOrder = GetMeshletBoundsStats(
+			shuffledSphere, MeshletBuildMode::IndexOrder, coneAlgorithm
+		);
+		const MeshletBoundsStats spatial    = GetMeshletBoundsStats(
+			shuffledSphere, MeshletBuildMode::Spatial, coneAlgorithm
+		);
+
+		EXPECT_LE(spatial.meanRadius, indexOrder.meanRadius);
+		EXPECT_GE(spatial.cullableConeFraction, indexOrder.cullableConeFraction);
+
+		std::cout << "Shuffled sphere, "
+			<< (coneAlgorithm == NormalConeAlgorithm::FaceNormals ? "face" : "vertex")
+			<< " normal cones:\n";
+
+		for (const auto& [name, stats]
+			: { std::pair{ "index order", indexOrder }, std::pair{ "spatial    ", spatial } })
+			std::cout << "  " << name << " : " << stats.meshletCount << " meshlets, mean radius "
+				<< stats.meanRadius << ", cullable cones " << stats.cullableConeFraction * 100.f
+				<< "%\n";
+	}
+}
+
+// Every limit with both build modes, on a plane. The meshlets must be valid and within the
+// limits, and the larger limits mustn't need more meshlets. It prints the meshlet count and
+// the utilisation of each.
+TEST(MeshletMakerBenchmark, LimitsMatrix)
+{
+	const std::array limitsTypes
+	{
+		std::pair{ " 64x126", MeshletLimitsType::Vertex64Primitive126 },
+		std::pair{ " 64x84 ", MeshletLimitsType::Vertex64Primitive84 },
+		std::pair{ "128x128", MeshletLimitsType::Vertex128Primitive128 },
+		std::pair{ "256x256", MeshletLimitsType::Vertex256Primitive256 }
+	};
+
+	const std::array buildModes
+	{
+		std::pair{ "index order", MeshletBuildMode::IndexOrder },
+		std::pair{ "spatial    ", MeshletBuildMode::Spatial }
+	};
+
+	std::cout << std::fixed << std::setprecision(1) << "Plane, 200x200 quads:\n"
+		<< "  mode          limits  meshlets  vertex util  prim util\n";
+
+	for (const auto& [modeName, buildMode] : buildModes)
+	{
+		size_t previousMeshletCount = std::numeric_limits<size_t>::max();
+
+		for (const auto& [limitsName, limitsType] : limitsTypes)
+		{
+			MeshBundleTempCustom bundle{};
+
+			bundle.SetMeshletBuildMode(buildMode);
+			bundle.SetMeshletLimits(limitsType);
+			bundle.AddMesh(GeneratePlane(200u));
+
+			const MeshletValidator::MeshBundleReport report
+				= MeshletValidator::ValidateMeshBundle(
+					bundle.GenerateTemporaryData(true), limitsType
+				);
+
+			ASSERT_TRUE(report.IsValid()) << MeshletValidator::FormatReport(report);
+
+			const MeshletValidator::MeshReport& meshReport = report.meshReports.front();
+
+			// The 64x84 limits can need more meshlets than the 64x126 ones.
+			if (limitsType != MeshletLimitsType::Vertex64Primitive84)
+			{
+				EXPECT_LE(meshReport.meshletCount, previousMeshletCount) << limitsName;
+
+				previousMeshletCount = meshReport.meshletCount;
+			}
+
+			std::cout << "  " << modeName << "  " << limitsName << "  " << std::setw(8)
+				<< meshReport.meshletCount << "  " << std::setw(10)
+				<< meshReport.vertexUtilisation * 100.f << "%  " << std::setw(8)
+				<< meshReport.primitiveUtilisation * 100.f << "%\n";
+		}
+	}
+
+	std::cout.unsetf(std::ios_base::floatfield);
+	std::cout << std::setprecision(6);
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <MeshletPacking.hpp>
+#include <MeshletMaker.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+static void ExpectAlignedSections(const PackedMeshletData& packedData)
+{
+	for (const PackedMeshletDetails& packedMeshletDetail : packedData.meshletDetails)
+	{
+		EXPECT_EQ(packedMeshletDetail.meshlet.vertexReferenceOffset % 4u, 0u);
+		EXPECT_EQ(packedMeshletDetail.meshlet.primitiveOffset % 4u, 0u);
+	}
+}
+
+// The meshlets must be contiguous and start at the beginning of the containers, so the
+// unpacked offsets are the same.
+static void ExpectExactRoundTrip(
+	const PackedMeshletData& packedData, const std::vector<std::uint32_t>& vertexIndices,
+	const MeshExtraForMesh& extraMeshData
+) {
+	std::vector<std::uint32_t> unpackedVertexIndices{};
+	MeshExtraForMesh unpackedExtraMeshData{};
+
+	UnpackMeshlets(packedData, unpackedVertexIndices, unpackedExtraMeshData);
+
+	EXPECT_EQ(unpackedVertexIndices, vertexIndices);
+	EXPECT_EQ(unpackedExtraMeshData.primIndices, extraMeshData.primIndices);
+
+	ASSERT_EQ(
+		std::size(unpackedExtraMeshData.meshletDetails), std::size(extraMeshData.meshletDetails)
+	);
+
+	EXPECT_EQ(
+		std::memcmp(
+			std::data(unpackedExtraMeshData.meshletDetails),
+			std::data(extraMeshData.meshletDetails),
+			std::size(extraMeshData.meshletDetails) * sizeof(MeshletDetails)
+		), 0
+	);
+}
+
+[[nodiscard]]
+static MeshletDetails MakeMeshletDetails(
+	std::uint32_t indexCount, std::uint32_t indexOffset, std::uint32_t primitiveCount,
+	std::uint32_t primitiveOffset, float radius
+) noexcept {
+	return MeshletDetails
+	{
+		.meshlet    = Meshlet
+		{
+			.indexCount      = indexCount,
+			.indexOffset     = indexOffset,
+			.primitiveCount  = primitiveCount,
+			.primitiveOffset = primitiveOffset
+		},
+		.sphereB    = SphereBoundingVolume{ .sphere = { 1.f, 2.f, 3.f, radius } },
+		.coneNormal = ClusterNormalCone{ .packedCone = 0x7F80FF01u, .apexOffset = radius }
+	};
+}
+
+TEST(MeshletPackingTest, SixteenBitReferencesRoundTrip)
+{
+	const Mesh sphere = GenerateSphere(32u, 64u);
+
+	MeshletMaker<64u, 126u> meshletMaker{};
+
+	meshletMaker.GenerateMeshlets(sphere);
+
+	std::vector<std::uint32_t> vertexIndices{};
+	meshletMaker.LoadVertexIndices(vertexIndices);
+
+	const MeshExtraForMesh extraMeshData = meshletMaker.GenerateExtraMeshData();
+
+	const PackedMeshletData packedData = PackMeshlets(
+		extraMeshData.meshletDetails, vertexIndices, extraMeshData.primIndices
+	);
+
+	for (const PackedMeshletDetails& packedMeshletDetail : packedData.meshletDetails)
+		EXPECT_EQ(packedMeshletDetail.meshlet.vertexReferenceSize, 2u);
+
+	ExpectAlignedSections(packedData);
+	ExpectExactRoundTrip(packedData, vertexIndices, extraMeshData);
+}
+
+// The vertices of the second meshlet are too far apart for 16 bit references. The odd vertex
+// and triangle counts of the other meshlets make the sections need padding.
+TEST(MeshletPackingTest, ThirtyTwoBitReferencesRoundTrip)
+{
+	const std::vector<std::uint32_t> vertexIndices
+	{
+		100u, 101u, 102u,
+		5u, 70'000u, 6u, 9u, 200'000u,
+		300'000u, 300'001u, 300'002u
+	};
+
+	MeshExtraForMesh extraMeshData{};
+
+	auto AddTriangle = [&extraMeshData](
+		std::uint32_t firstIndex, std::uint32_t secondIndex, std::uint32_t thirdIndex
+	) {
+		extraMeshData.primIndices.emplace_back(
+			PackPrim(
+				PrimitiveIndicesUnpacked
+				{
+					.firstIndex  = firstIndex,
+					.secondIndex = secondIndex,
+					.thirdIndex  = thirdIndex
+				}
+			)
+		);
+	};
+
+	AddTriangle(0u, 1u, 2u);
+
+	AddTriangle(0u, 1u, 2u);
+	AddTriangle(2u, 1u, 3u);
+	AddTriangle(3u, 1u, 4u);
+
+	AddTriangle(2u, 1u, 0u);
+
+	extraMeshData.meshletDetails = {
+		MakeMeshletDetails(3u, 0u, 1u, 0u, 0.5f),
+		MakeMeshletDetails(5u, 3u, 3u, 1u, 2.f),
+		MakeMeshletDetails(3u, 8u, 1u, 4u, 4.f)
+	};
+
+	const PackedMeshletData packedData = PackMeshlets(
+		extraMeshData.meshletDetails, vertexIndices, extraMeshData.primIndices
+	);
+
+	ASSERT_EQ(std::size(packedData.meshletDetails), 3u);
+
+	EXPECT_EQ(packedData.meshletDetails[0].meshlet.vertexReferenceSize, 2u);
+	EXPECT_EQ(packedData.meshletDetails[1].meshlet.vertexReferenceSize, 4u);
+	EXPECT_EQ(packedData.meshletDetails[2].meshlet.vertexReferenceSize, 2u);
+
+	EXPECT_EQ(packedData.meshletDetails[2].meshlet.baseVertex, 300'000u);
+
+	ExpectAlignedSections(packedData);
+	ExpectExactRoundTrip(packedData, vertexIndices, extraMeshData);
+}
+
+// The unpacked meshlets are added after the existing elements.
+TEST(MeshletPackingTest, UnpackAppends)
+{
+	const std::vector<std::uint32_t> vertexIndices{ 10u, 11u, 12u };
+
+	const MeshExtraForMesh extraMeshData
+	{
+		.primIndices    = {
+			PackPrim(
+				PrimitiveIndicesUnpacked{ .firstIndex = 0u, .secondIndex = 1u, .thirdIndex = 2u }
+			)
+		},
+		.meshletDetails = { MakeMeshletDetails(3u, 0u, 1u, 0u, 1.f) }
+	};
+
+	const PackedMeshletData packedData = PackMeshlets(
+		extraMeshData.meshletDetails, vertexIndices, extraMeshData.primIndices
+	);
+
+	std::vector<std::uint32_t> unpackedVertexIndices{ 1u, 2u };
+	MeshExtraForMesh unpackedExtraMeshData{ .primIndices = { 7u } };
+
+	UnpackMeshlets(packedData, unpackedVertexIndices, unpackedExtraMeshData);
+
+	EXPECT_EQ(unpackedVertexIndices, (std::vector<std::uint32_t>{ 1u, 2u, 10u, 11u, 12u }));
+
+	ASSERT_EQ(std::size(unpackedExtraMeshData.meshletDetails), 1u);
+
+	const Meshlet& meshlet = unpackedExtraMeshData.meshletDetails.front().meshlet;
+
+	EXPECT_EQ(meshlet.indexOffset, 2u);
+	EXPECT_EQ(meshlet.primitiveOffset, 1u);
+	EXPECT_EQ(unpackedExtraMeshData.primIndices[1], extraMeshData.primIndices.front());
+}
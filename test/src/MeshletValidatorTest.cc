@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <MeshletValidator.hpp>
+#include <MeshletCuller.hpp>
+#include <MeshBundleBase.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+[[nodiscard]]
+static MeshBundleTemporaryData GenerateTestBundle(bool meshShader)
+{
+	MeshBundleTempCustom bundle{};
+
+	bundle.SetMeshletBuildMode(MeshletBuildMode::Spatial);
+	bundle.SetNormalConeAlgorithm(NormalConeAlgorithm::FaceNormals);
+
+	bundle.AddMesh(GenerateShuffledSphere(32u, 64u));
+	bundle.AddMesh(GeneratePlane(32u));
+
+	return bundle.GenerateTemporaryData(meshShader);
+}
+
+// The index of the first meshlet of the sphere whose cone could cull it from somewhere.
+[[nodiscard]]
+static size_t FindCullingMeshlet(const MeshBundleTemporaryData& bundleData)
+{
+	const MeshTemporaryDetailsMS& meshDetails
+		= bundleData.bundleDetails.meshTemporaryDetailsMS.front();
+
+	for (size_t index = 0u; index < meshDetails.meshletCount; ++index)
+	{
+		const size_t meshletIndex = meshDetails.meshletOffset + index;
+
+		const MeshletCuller::NormalCone cone = MeshletCuller::UnpackNormalCone(
+			bundleData.meshletDetails[meshletIndex].coneNormal
+		);
+
+		if (!cone.isDegenerate && cone.cutoff > 0.1f)
+			return meshletIndex;
+	}
+
+	return std::size(bundleData.meshletDetails);
+}
+
+TEST(MeshletValidatorTest, FreshBundlesAreValid)
+{
+	for (const bool meshShader : { false, true })
+	{
+		const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+			GenerateTestBundle(meshShader)
+		);
+
+		ASSERT_EQ(std::size(report.meshReports), 2u);
+
+		EXPECT_TRUE(report.IsValid()) << MeshletValidator::FormatReport(report);
+
+		for (const MeshletValidator::MeshReport& meshReport : report.meshReports)
+		{
+			EXPECT_EQ(meshReport.isMeshShader, meshShader);
+			EXPECT_GT(meshReport.triangleCount, 0u);
+		}
+	}
+}
+
+TEST(MeshletValidatorTest, CorruptedRangesAreErrors)
+{
+	const MeshBundleTemporaryData bundleData = GenerateTestBundle(true);
+
+	{
+		MeshBundleTemporaryData corruptedData = bundleData;
+
+		corruptedData.bundleDetails.meshTemporaryDetailsMS.back().meshletCount += 1u;
+
+		const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+			corruptedData
+		);
+
+		EXPECT_FALSE(report.IsValid());
+		EXPECT_EQ(report.meshReports.front().errorCount, 0u);
+		EXPECT_GT(report.meshReports.back().errorCount, 0u);
+	}
+
+	{
+		MeshBundleTemporaryData corruptedData = bundleData;
+
+		corruptedData.meshletDetails.back().meshlet.indexOffset
+			= static_cast<std::uint32_t>(std::size(corruptedData.indices));
+
+		EXPECT_FALSE(MeshletValidator::ValidateMeshBundle(corruptedData).IsValid());
+	}
+
+	{
+		MeshBundleTemporaryData corruptedData = bundleData;
+
+		corruptedData.meshletDetails.front().meshlet.primitiveOffset
+			= static_cast<std::uint32_t>(std::size(corruptedData.primIndices));
+
+		EXPECT_FALSE(MeshletValidator::ValidateMeshBundle(corruptedData).IsValid());
+	}
+
+	// A vertex index past the end of the vertices on the vertex shader path.
+	{
+		MeshBundleTemporaryData corruptedData = GenerateTestBundle(false);
+
+		corruptedData.indices.back() = static_cast<std::uint32_t>(
+			std::size(corruptedData.vertices)
+		);
+
+		const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+			corruptedData
+		);
+
+		EXPECT_FALSE(report.IsValid());
+		EXPECT_GT(report.meshReports.back().errorCount, 0u);
+	}
+}
+
+TEST(MeshletValidatorTest, OutOfRangePrimitivesAreErrors)
+{
+	MeshBundleTemporaryData bundleData = GenerateTestBundle(true);
+
+	const MeshTemporaryDetailsMS& meshDetails
+		= bundleData.bundleDetails.meshTemporaryDetailsMS.front();
+	const Meshlet& meshlet = bundleData.meshletDetails[meshDetails.meshletOffset].meshlet;
+
+	// A local index just past the meshlet's vertices.
+	std::uint32_t& packedPrim
+		= bundleData.primIndices[meshDetails.primitiveOffset + meshlet.primitiveOffset];
+
+	PrimitiveIndicesUnpacked prim = UnpackPrim(packedPrim);
+
+	prim.thirdIndex = meshlet.indexCount;
+
+	packedPrim = PackPrim(prim);
+
+	const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+		bundleData
+	);
+
+	EXPECT_FALSE(report.IsValid());
+	EXPECT_EQ(report.meshReports.front().errorCount, 1u)
+		<< MeshletValidator::FormatReport(report);
+	EXPECT_EQ(report.meshReports.back().errorCount, 0u);
+}
+
+TEST(MeshletValidatorTest, ShrunkSphereIsNonConservative)
+{
+	MeshBundleTemporaryData bundleData = GenerateTestBundle(true);
+
+	const MeshTemporaryDetailsMS& meshDetails
+		= bundleData.bundleDetails.meshTemporaryDetailsMS.front();
+
+	bundleData.meshletDetails[meshDetails.meshletOffset].sphereB.sphere.w *= 0.5f;
+
+	const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+		bundleData
+	);
+
+	EXPECT_FALSE(report.IsValid());
+	EXPECT_EQ(report.meshReports.front().nonConservativeSphereCount, 1u);
+	EXPECT_EQ(report.meshReports.back().nonConservativeSphereCount, 0u);
+}
+
+// A smaller cutoff claims the normals are closer to the axis, which widens the region the
+// meshlet is culled from.
+TEST(MeshletValidatorTest, WidenedConeIsNonConservative)
+{
+	MeshBundleTemporaryData bundleData = GenerateTestBundle(true);
+
+	const size_t meshletIndex = FindCullingMeshlet(bundleData);
+
+	ASSERT_LT(meshletIndex, std::size(bundleData.meshletDetails));
+
+	ClusterNormalCone& coneNormal = bundleData.meshletDetails[meshletIndex].coneNormal;
+
+	std::uint8_t values[4]{};
+
+	std::memcpy(values, &coneNormal.packedCone, sizeof(std::uint32_t));
+
+	values[3] = 0u;
+
+	std::memcpy(&coneNormal.packedCone, values, sizeof(std::uint32_t));
+
+	const MeshletValidator::MeshBundleReport report = MeshletValidator::ValidateMeshBundle(
+		bundleData
+	);
+
+	EXPECT_FALSE(report.IsValid());
+	EXPECT_EQ(report.meshReports.front().nonConservativeConeCount, 1u);
+	EXPECT_EQ(report.meshReports.front().nonConservativeSphereCount, 0u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <ParallelUtility.hpp>
+
+using namespace Sol;
+
+TEST(ParallelUtilityTest, EveryIndexOnce)
+{
+	std::vector<std::jthread> threads{};
+	std::mutex threadMutex{};
+
+	ParallelWork parallelWork
+	{
+		.submitWork  = [&threads, &threadMutex](std::function<void()> work)
+		{
+			std::scoped_lock lock{ threadMutex };
+
+			threads.emplace_back(std::move(work));
+		},
+		.workerCount = 4u
+	};
+
+	std::vector<std::atomic<std::uint32_t>> callCounts(1000u);
+
+	ParallelFor(
+		std::size(callCounts), parallelWork,
+		[&callCounts](size_t index) { ++callCounts[index]; }
+	);
+
+	threads.clear();
+
+	for (const std::atomic<std::uint32_t>& callCount : callCounts)
+		EXPECT_EQ(callCount.load(), 1u);
+}
+
+// The submitter's threads might all be busy, possibly with the caller itself. So, the work
+// which only starts after the ParallelFor has returned mustn't do anything.
+TEST(ParallelUtilityTest, LateWorkersDontRun)
+{
+	std::vector<std::function<void()>> queuedWork{};
+
+	ParallelWork parallelWork
+	{
+		.submitWork  = [&queuedWork](std::function<void()> work)
+		{
+			queuedWork.emplace_back(std::move(work));
+		},
+		.workerCount = 8u
+	};
+
+	size_t callCount = 0u;
+
+	ParallelFor(100u, parallelWork, [&callCount](size_t) { ++callCount; });
+
+	EXPECT_EQ(callCount, 100u);
+	EXPECT_EQ(std::size(queuedWork), 7u);
+
+	for (const std::function<void()>& work : queuedWork)
+		work();
+
+	EXPECT_EQ(callCount, 100u);
+}
+
+TEST(ParallelUtilityTest, SerialWithoutSubmitter)
+{
+	std::vector<size_t> calledIndices{};
+
+	ParallelFor(
+		5u, ParallelWork{ .workerCount = 4u },
+		[&calledIndices](size_t index) { calledIndices.emplace_back(index); }
+	);
+
+	EXPECT_EQ(calledIndices, (std::vector<size_t>{ 0u, 1u, 2u, 3u, 4u }));
+}
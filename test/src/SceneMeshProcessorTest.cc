@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <SceneMeshProcessor.hpp>
+#include <MeshletCuller.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// An OBJ grid in the xz plane without any normals, in the temporary directory.
+class SceneMeshProcessorTest : public testing::Test
+{
+protected:
+	static constexpr std::uint32_t s_gridSize = 16u;
+
+	void SetUp() override
+	{
+		m_scenePath = (std::filesystem::temp_directory_path() / "SolSceneMeshProcessorTest.obj")
+			.string();
+
+		WriteObjPlane(m_scenePath, s_gridSize);
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode{};
+
+		std::filesystem::remove(m_scenePath, errorCode);
+	}
+
+	std::string m_scenePath;
+};
+
+// Without generating the normals, the mesh has none. The vertex normal cones must fall back
+// to the face normals, which all point along the y axis.
+TEST_F(SceneMeshProcessorTest, CookedSourceWithoutNormals)
+{
+	auto sceneProcessor = std::make_shared<SceneProcessor>(
+		m_scenePath, SceneImportFlags::FromProfile(SceneImportProfile::CookedSource)
+	);
+
+	aiScene const* scene = sceneProcessor->GetScene();
+
+	ASSERT_EQ(scene->mNumMeshes, 1u);
+	ASSERT_EQ(scene->mMeshes[0]->mNormals, nullptr);
+
+	SceneMeshProcessor meshProcessor{ sceneProcessor };
+
+	meshProcessor.SetNormalConeAlgorithm(NormalConeAlgorithm::VertexNormals);
+
+	const size_t triangleCount = s_gridSize * s_gridSize * 2u;
+
+	const MeshBundleTemporaryData vertexShaderData = meshProcessor.GenerateTemporaryMeshData(
+		false
+	);
+
+	EXPECT_EQ(std::size(vertexShaderData.indices), triangleCount * 3u);
+
+	const MeshBundleTemporaryData meshShaderData = meshProcessor.GenerateTemporaryMeshData(true);
+
+	ASSERT_FALSE(std::empty(meshShaderData.meshletDetails));
+
+	for (const MeshletDetails& meshletDetail : meshShaderData.meshletDetails)
+	{
+		const MeshletCuller::NormalCone cone = MeshletCuller::UnpackNormalCone(
+			meshletDetail.coneNormal
+		);
+
+		EXPECT_FALSE(cone.isDegenerate);
+		EXPECT_GT(std::abs(cone.axis.y), 0.99f);
+	}
+}
+
+// The meshlet data is reserved with upper bounds, which must have been trimmed afterwards.
+TEST_F(SceneMeshProcessorTest, MeshShaderDataIsTrimmed)
+{
+	SceneMeshProcessor meshProcessor{ std::make_shared<SceneProcessor>(m_scenePath) };
+
+	const MeshBundleTemporaryData meshShaderData = meshProcessor.GenerateTemporaryMeshData(true);
+
+	ASSERT_FALSE(std::empty(meshShaderData.meshletDetails));
+
+	EXPECT_EQ(meshShaderData.indices.capacity(), std::size(meshShaderData.indices));
+	EXPECT_EQ(meshShaderData.primIndices.capacity(), std::size(meshShaderData.primIndices));
+	EXPECT_EQ(
+		meshShaderData.meshletDetails.capacity(), std::size(meshShaderData.meshletDetails)
+	);
+}
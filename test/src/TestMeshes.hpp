@@ -0,0 +1,163 @@
+#ifndef TEST_MESHES_HPP_
+#define TEST_MESHES_HPP_
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <SolMeshUtility.hpp>
+
+namespace Sol
+{
+// A closed sphere with a single vertex at each pole.
+inline Mesh GenerateSphere(std::uint32_t ringCount, std::uint32_t segmentCount)
+{
+	Mesh mesh{};
+
+	constexpr float pi = std::numbers::pi_v<float>;
+
+	mesh.vertices.emplace_back(
+		Vertex{ .position = { 0.f, 1.f, 0.f }, .normal = { 0.f, 1.f, 0.f } }
+	);
+
+	for (std::uint32_t ring = 1u; ring < ringCount; ++ring)
+	{
+		const float polar = pi * static_cast<float>(ring) / static_cast<float>(ringCount);
+
+		for (std::uint32_t segment = 0u; segment < segmentCount; ++segment)
+		{
+			const float azimuth
+				= 2.f * pi * static_cast<float>(segment) / static_cast<float>(segmentCount);
+
+			const DirectX::XMFLOAT3 position
+			{
+				std::sin(polar) * std::cos(azimuth), std::cos(polar),
+				std::sin(polar) * std::sin(azimuth)
+			};
+
+			mesh.vertices.emplace_back(Vertex{ .position = position, .normal = position });
+		}
+	}
+
+	mesh.vertices.emplace_back(
+		Vertex{ .position = { 0.f, -1.f, 0.f }, .normal = { 0.f, -1.f, 0.f } }
+	);
+
+	const auto bottomPole = static_cast<std::uint32_t>(std::size(mesh.vertices) - 1u);
+
+	auto GetVertex = [segmentCount](std::uint32_t ring, std::uint32_t segment)
+	{
+		return 1u + (ring - 1u) * segmentCount + segment % segmentCount;
+	};
+
+	for (std::uint32_t segment = 0u; segment < segmentCount; ++segment)
+	{
+		mesh.indices.insert(
+			std::end(mesh.indices), { 0u, GetVertex(1u, segment + 1u), GetVertex(1u, segment) }
+		);
+		mesh.indices.insert(
+			std::end(mesh.indices),
+			{
+				bottomPole, GetVertex(ringCount - 1u, segment),
+				GetVertex(ringCount - 1u, segment + 1u)
+			}
+		);
+	}
+
+	for (std::uint32_t ring = 1u; ring + 1u < ringCount; ++ring)
+		for (std::uint32_t segment = 0u; segment < segmentCount; ++segment)
+		{
+			const std::uint32_t vertex0 = GetVertex(ring, segment);
+			const std::uint32_t vertex1 = GetVertex(ring, segment + 1u);
+			const std::uint32_t vertex2 = GetVertex(ring + 1u, segment);
+			const std::uint32_t vertex3 = GetVertex(ring + 1u, segment + 1u);
+
+			mesh.indices.insert(
+				std::end(mesh.indices), { vertex0, vertex1, vertex2, vertex1, vertex3, vertex2 }
+			);
+		}
+
+	return mesh;
+}
+
+// A flat square made of a grid of quads, with an open border all around.
+inline Mesh GeneratePlane(std::uint32_t quadCount)
+{
+	Mesh mesh{};
+
+	for (std::uint32_t row = 0u; row <= quadCount; ++row)
+		for (std::uint32_t column = 0u; column <= quadCount; ++column)
+			mesh.vertices.emplace_back(
+				Vertex
+				{
+					.position = { static_cast<float>(column), 0.f, static_cast<float>(row) },
+					.normal   = { 0.f, 1.f, 0.f },
+					.uv       = {
+						static_cast<float>(column) / static_cast<float>(quadCount),
+						static_cast<float>(row) / static_cast<float>(quadCount)
+					}
+				}
+			);
+
+	for (std::uint32_t row = 0u; row < quadCount; ++row)
+		for (std::uint32_t column = 0u; column < quadCount; ++column)
+		{
+			const std::uint32_t vertex0 = row * (quadCount + 1u) + column;
+			const std::uint32_t vertex1 = vertex0 + 1u;
+			const std::uint32_t vertex2 = vertex0 + quadCount + 1u;
+			const std::uint32_t vertex3 = vertex2 + 1u;
+
+			mesh.indices.insert(
+				std::end(mesh.indices), { vertex0, vertex2, vertex1, vertex1, vertex2, vertex3 }
+			);
+		}
+
+	return mesh;
+}
+
+// A sphere with its triangles shuffled, so they don't follow the rings.
+inline Mesh GenerateShuffledSphere(std::uint32_t ringCount, std::uint32_t segmentCount)
+{
+	Mesh sphere = GenerateSphere(ringCount, segmentCount);
+
+	const size_t triangleCount = std::size(sphere.indices) / 3u;
+
+	std::vector<std::uint32_t> triangleOrder(triangleCount);
+
+	for (size_t index = 0u; index < triangleCount; ++index)
+		triangleOrder[index] = static_cast<std::uint32_t>(index);
+
+	std::ranges::shuffle(triangleOrder, std::mt19937{ 5u });
+
+	std::vector<std::uint32_t> shuffledIndices{};
+	shuffledIndices.reserve(std::size(sphere.indices));
+
+	for (const std::uint32_t triangleIndex : triangleOrder)
+		for (size_t offset = 0u; offset < 3u; ++offset)
+			shuffledIndices.emplace_back(sphere.indices[triangleIndex * 3u + offset]);
+
+	sphere.indices = std::move(shuffledIndices);
+
+	return sphere;
+}
+
+// Writes the triangles of the GeneratePlane as an OBJ without any normals or uvs, so the
+// scene tests can import it.
+inline void WriteObjPlane(const std::string& filePath, std::uint32_t quadCount)
+{
+	const Mesh plane = GeneratePlane(quadCount);
+
+	std::ofstream file{ filePath, std::ios_base::trunc };
+
+	for (const Vertex& vertex : plane.vertices)
+		file << "v " << vertex.position.x << ' ' << vertex.position.y << ' '
+			<< vertex.position.z << '\n';
+
+	// The OBJ indices start at 1.
+	for (size_t index = 0u; index < std::size(plane.indices); index += 3u)
+		file << "f " << plane.indices[index] + 1u << ' ' << plane.indices[index + 1u] + 1u
+			<< ' ' << plane.indices[index + 2u] + 1u << '\n';
+}
+}
+#endif
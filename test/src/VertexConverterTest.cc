@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <VertexConverter.hpp>
+
+using namespace Sol;
+
+// The strides of the streams. Each one has its own loop in the converter, apart from the
+// runtime strides. The interleaved streams share a buffer, with the normals after the
+// positions and the uvs after the normals. A stride of 0 is a missing attribute.
+struct StreamLayout
+{
+	const char* name;
+	size_t      positionStride;
+	size_t      normalStride;
+	size_t      uvStride;
+	bool        isInterleaved;
+};
+
+static constexpr std::array s_streamLayouts
+{
+	StreamLayout{ "12/12/8", 12u, 12u, 8u, false },
+	StreamLayout{ "24", 24u, 24u, 24u, false },
+	StreamLayout{ "32", 32u, 32u, 32u, true },
+	StreamLayout{ "48", 48u, 48u, 48u, true },
+	StreamLayout{ "40", 40u, 40u, 40u, true },
+	StreamLayout{ "16/20/12", 16u, 20u, 12u, false },
+	StreamLayout{ "12/missing/8", 12u, 0u, 8u, false }
+};
+
+static constexpr Vertex s_defaultVertex
+{
+	.position = DirectX::XMFLOAT3{ 1.f, 2.f, 3.f },
+	.normal   = DirectX::XMFLOAT3{ 0.f, 0.f, 1.f },
+	.uv       = DirectX::XMFLOAT2{ 0.5f, 0.25f }
+};
+
+// The streams of the vertices and the buffers they point into.
+struct TestStreams
+{
+	std::vector<std::uint8_t>     positionData;
+	std::vector<std::uint8_t>     normalData;
+	std::vector<std::uint8_t>     uvData;
+	VertexConverter::VertexStreams streams;
+};
+
+// Every float is random bits, so there are NaNs, infinities, denormals and negative zeros
+// as well. The padding between the elements is random as well, so reading it would be
+// noticed.
+[[nodiscard]]
+static std::vector<std::uint8_t> GenerateRandomBytes(size_t byteCount, std::mt19937& randomEngine)
+{
+	std::uniform_int_distribution<std::uint32_t> distribution{ 0u, 255u };
+
+	std::vector<std::uint8_t> bytes(byteCount);
+
+	for (std::uint8_t& byte : bytes)
+		byte = static_cast<std::uint8_t>(distribution(randomEngine));
+
+	return bytes;
+}
+
+[[nodiscard]]
+static TestStreams GenerateTestStreams(
+	const StreamLayout& layout, size_t vertexCount, std::uint32_t seed
+) {
+	std::mt19937 randomEngine{ seed };
+
+	TestStreams testStreams{};
+
+	// Without any vertices, the streams are left without data.
+	if (!vertexCount)
+		return testStreams;
+
+	VertexConverter::VertexStreams& streams = testStreams.streams;
+
+	if (layout.isInterleaved)
+	{
+		testStreams.positionData = GenerateRandomBytes(
+			layout.positionStride * vertexCount, randomEngine
+		);
+
+		std::uint8_t const* data = std::data(testStreams.positionData);
+
+		streams.positions = { .data = data, .stride = layout.positionStride };
+		streams.normals   = { .data = data + 12u, .stride = layout.normalStride };
+		streams.uvs       = { .data = data + 24u, .stride = layout.uvStride };
+
+		return testStreams;
+	}
+
+	auto GenerateStream = [&randomEngine, vertexCount](
+		std::vector<std::uint8_t>& data, size_t stride
+	) {
+		if (!stride)
+			return VertexConverter::AttributeStream{};
+
+		data = GenerateRandomBytes(stride * vertexCount, randomEngine);
+
+		return VertexConverter::AttributeStream{ .data = std::data(data), .stride = stride };
+	};
+
+	streams.positions = GenerateStream(testStreams.positionData, layout.positionStride);
+	streams.normals   = GenerateStream(testStreams.normalData, layout.normalStride);
+	streams.uvs       = GenerateStream(testStreams.uvData, layout.uvStride);
+
+	return testStreams;
+}
+
+// The conversion one component at a time, with the Zs flipped by their sign bits.
+[[nodiscard]]
+static std::vector<Vertex> ConvertReferenceVertices(
+	const VertexConverter::VertexStreams& streams, size_t vertexCount, bool flipZ
+) {
+	auto ReadElement = [](
+		const VertexConverter::AttributeStream& stream, size_t index, float* element,
+		size_t componentCount
+	) {
+		if (stream.data)
+			std::memcpy(
+				element, static_cast<std::uint8_t const*>(stream.data) + stream.stride * index,
+				sizeof(float) * componentCount
+			);
+	};
+
+	auto FlipZ = [flipZ](float value)
+	{
+		return flipZ
+			? std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) ^ 0x8000'0000u)
+			: value;
+	};
+
+	std::vector<Vertex> vertices(vertexCount, s_defaultVertex);
+
+	for (size_t index = 0u; index < vertexCount; ++index)
+	{
+		Vertex& vertex = vertices[index];
+
+		ReadElement(streams.positions, index, &vertex.position.x, 3u);
+		ReadElement(streams.normals, index, &vertex.normal.x, 3u);
+		ReadElement(streams.uvs, index, &vertex.uv.x, 2u);
+
+		if (streams.positions.data)
+			vertex.position.z = FlipZ(vertex.position.z);
+
+		if (streams.normals.data)
+			vertex.normal.z = FlipZ(vertex.normal.z);
+	}
+
+	return vertices;
+}
+
+[[nodiscard]]
+static VertexConverter::AttributeStream OffsetStream(
+	const VertexConverter::AttributeStream& stream, size_t index
+) {
+	if (!stream.data)
+		return stream;
+
+	return VertexConverter::AttributeStream{
+		.data   = static_cast<std::uint8_t const*>(stream.data) + stream.stride * index,
+		.stride = stream.stride
+	};
+}
+
+[[nodiscard]]
+static bool AreIdentical(std::span<const Vertex> vertices, std::span<const Vertex> otherVertices)
+{
+	if (std::size(vertices) != std::size(otherVertices))
+		return false;
+
+	return std::empty(vertices) || std::memcmp(
+		std::data(vertices), std::data(otherVertices), sizeof(Vertex) * std::size(vertices)
+	) == 0;
+}
+
+// All but the last vertex go through the SSE loop, when DirectXMath uses SSE. A single
+// vertex only goes through the scalar loop, so the vertices converted one at a time must be
+// the same bytes as the ones converted together, and as the reference ones.
+TEST(VertexConverterTest, VectorAndScalarMatch)
+{
+	for (const StreamLayout& layout : s_streamLayouts)
+		for (const size_t vertexCount : { 0u, 1u, 2u, 5u, 1'000u })
+			for (const bool flipZ : { false, true })
+			{
+				SCOPED_TRACE(
+					std::string{ layout.name } + ", " + std::to_string(vertexCount)
+					+ (flipZ ? " vertices, flipped" : " vertices")
+				);
+
+				const TestStreams testStreams = GenerateTestStreams(
+					layout, vertexCount, static_cast<std::uint32_t>(vertexCount)
+				);
+
+				const VertexConverter::VertexStreams& streams = testStreams.streams;
+
+				const std::vector<Vertex> referenceVertices = ConvertReferenceVertices(
+					streams, vertexCount, flipZ
+				);
+
+				std::vector<Vertex> vertices(vertexCount);
+
+				VertexConverter::ConvertVertices(vertices, streams, flipZ, s_defaultVertex);
+
+				EXPECT_TRUE(AreIdentical(vertices, referenceVertices));
+
+				std::vector<Vertex> scalarVertices(vertexCount);
+
+				for (size_t index = 0u; index < vertexCount; ++index)
+				{
+					const VertexConverter::VertexStreams vertexStreams
+					{
+						.positions = OffsetStream(streams.positions, index),
+						.normals   = OffsetStream(streams.normals, index),
+						.uvs       = OffsetStream(streams.uvs, index)
+					};
+
+					VertexConverter::ConvertVertices(
+						std::span{ scalarVertices }.subspan(index, 1u), vertexStreams, flipZ,
+						s_defaultVertex
+					);
+				}
+
+				EXPECT_TRUE(AreIdentical(vertices, scalarVertices));
+
+				// The appended vertices are converted in batches, which have their own
+				// last vertices.
+				std::vector<Vertex> appendedVertices{};
+
+				VertexConverter::AppendVertices(
+					appendedVertices, vertexCount, streams, flipZ, s_defaultVertex
+				);
+
+				EXPECT_TRUE(AreIdentical(appendedVertices, referenceVertices));
+			}
+}
+
+// Prints the vertices per second of each layout, converted one component at a time, by
+// ConvertVertices into sized vertices and by AppendVertices.
+TEST(VertexConverterBenchmark, ConvertVertices)
+{
+	using Clock_t = std::chrono::steady_clock;
+
+	constexpr size_t vertexCount    = 1'000'000u;
+	constexpr size_t iterationCount = 10u;
+
+	auto GetVerticesPerSecond = [](Clock_t::duration duration)
+	{
+		return static_cast<double>(vertexCount * iterationCount) / 1e6
+			/ std::chrono::duration<double>{ duration }.count();
+	};
+
+	for (const StreamLayout& layout : s_streamLayouts)
+	{
+		const TestStreams testStreams = GenerateTestStreams(layout, vertexCount, 1u);
+
+		const VertexConverter::VertexStreams& streams = testStreams.streams;
+
+		const Clock_t::time_point referenceStart = Clock_t::now();
+
+		for (size_t index = 0u; index < iterationCount; ++index)
+		{
+			const std::vector<Vertex> vertices = ConvertReferenceVertices(
+				streams, vertexCount, true
+			);
+
+			ASSERT_EQ(std::size(vertices), vertexCount);
+		}
+
+		const Clock_t::duration referenceDuration = Clock_t::now() - referenceStart;
+
+		const Clock_t::time_point convertStart = Clock_t::now();
+
+		for (size_t index = 0u; index < iterationCount; ++index)
+		{
+			std::vector<Vertex> vertices(vertexCount);
+
+			VertexConverter::ConvertVertices(vertices, streams, true, s_defaultVertex);
+		}
+
+		const Clock_t::duration convertDuration = Clock_t::now() - convertStart;
+
+		const Clock_t::time_point appendStart = Clock_t::now();
+
+		for (size_t index = 0u; index < iterationCount; ++index)
+		{
+			std::vector<Vertex> vertices{};
+
+			vertices.reserve(vertexCount);
+
+			VertexConverter::AppendVertices(vertices, vertexCount, streams, true, s_defaultVertex);
+		}
+
+		const Clock_t::duration appendDuration = Clock_t::now() - appendStart;
+
+		std::cout << layout.name << " : reference " << GetVerticesPerSecond(referenceDuration)
+			<< " M vertices/s, convert " << GetVerticesPerSecond(convertDuration)
+			<< " M vertices/s, append " << GetVerticesPerSecond(appendDuration)
+			<< " M vertices/s\n";
+	}
+}
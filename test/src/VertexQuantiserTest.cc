@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <random>
+#include <VertexQuantiser.hpp>
+#include <MeshBundleBase.hpp>
+#include <SolException.hpp>
+#include "TestMeshes.hpp"
+
+using namespace Sol;
+
+// The largest angle between a normal and its decoded octahedral snorm16 encoding.
+static constexpr float s_maximumNormalDegrees = 0.01f;
+
+[[nodiscard]]
+static std::vector<Vertex> GenerateRandomVertices(size_t vertexCount)
+{
+	std::mt19937 randomEngine{ 13u };
+	std::uniform_real_distribution<float> positionDistribution{ -50.f, 30.f };
+	std::uniform_real_distribution<float> uvDistribution{ -3.f, 5.f };
+	std::normal_distribution<float> normalDistribution{};
+
+	std::vector<Vertex> vertices(vertexCount);
+
+	for (Vertex& vertex : vertices)
+	{
+		vertex.position = DirectX::XMFLOAT3{
+			positionDistribution(randomEngine), positionDistribution(randomEngine) * 0.1f,
+			positionDistribution(randomEngine)
+		};
+
+		DirectX::XMStoreFloat3(
+			&vertex.normal,
+			DirectX::XMVector3Normalize(
+				DirectX::XMVectorSet(
+					normalDistribution(randomEngine), normalDistribution(randomEngine),
+					normalDistribution(randomEngine), 0.f
+				)
+			)
+		);
+
+		vertex.uv = DirectX::XMFLOAT2{ uvDistribution(randomEngine), uvDistribution(randomEngine) };
+	}
+
+	return vertices;
+}
+
+// With the cross product, as the acos of a float dot can't tell apart angles this small.
+[[nodiscard]]
+static float GetNormalDegrees(
+	const DirectX::XMFLOAT3& normal, const DirectX::XMFLOAT3& decodedNormal
+) noexcept {
+	const DirectX::XMVECTOR normalV        = DirectX::XMLoadFloat3(&normal);
+	const DirectX::XMVECTOR decodedNormalV = DirectX::XMLoadFloat3(&decodedNormal);
+
+	const float sine   = DirectX::XMVectorGetX(
+		DirectX::XMVector3Length(DirectX::XMVector3Cross(normalV, decodedNormalV))
+	);
+	const float cosine = DirectX::XMVectorGetX(DirectX::XMVector3Dot(normalV, decodedNormalV));
+
+	return std::atan2(sine, cosine) * 180.f / std::numbers::pi_v<float>;
+}
+
+// Each attribute must be within half a step of its bounds' extent, plus the float error.
+static void ExpectWithinBounds(
+	std::span<const Vertex> vertices, std::span<const Vertex> decodedVertices,
+	const VertexQuantisation& quantisation
+) {
+	ASSERT_EQ(std::size(decodedVertices), std::size(vertices));
+
+	auto GetMaximumError = [](float extent)
+	{
+		return extent * (0.5f / 65535.f + 1e-6f);
+	};
+
+	const DirectX::XMFLOAT4& positionExtent = quantisation.positionExtent;
+
+	const float positionErrorX = GetMaximumError(positionExtent.x);
+	const float positionErrorY = GetMaximumError(positionExtent.y);
+	const float positionErrorZ = GetMaximumError(positionExtent.z);
+	const float uvErrorX       = GetMaximumError(quantisation.uvBounds.z);
+	const float uvErrorY       = GetMaximumError(quantisation.uvBounds.w);
+
+	for (size_t index = 0u; index < std::size(vertices); ++index)
+	{
+		const Vertex& vertex        = vertices[index];
+		const Vertex& decodedVertex = decodedVertices[index];
+
+		EXPECT_NEAR(decodedVertex.position.x, vertex.position.x, positionErrorX) << index;
+		EXPECT_NEAR(decodedVertex.position.y, vertex.position.y, positionErrorY) << index;
+		EXPECT_NEAR(decodedVertex.position.z, vertex.position.z, positionErrorZ) << index;
+		EXPECT_NEAR(decodedVertex.uv.x, vertex.uv.x, uvErrorX) << index;
+		EXPECT_NEAR(decodedVertex.uv.y, vertex.uv.y, uvErrorY) << index;
+		EXPECT_LE(
+			GetNormalDegrees(vertex.normal, decodedVertex.normal), s_maximumNormalDegrees
+		) << index;
+	}
+}
+
+TEST(VertexQuantiserTest, RoundTripErrorBounds)
+{
+	const std::vector<Vertex> vertices = GenerateRandomVertices(10'000u);
+
+	const VertexQuantisation quantisation = VertexQuantiser::GenerateQuantisation(vertices);
+
+	std::vector<QuantisedVertex> quantisedVertices(std::size(vertices));
+	VertexQuantiser::QuantiseVertices(vertices, quantisation, quantisedVertices);
+
+	std::vector<Vertex> decodedVertices(std::size(vertices));
+	VertexQuantiser::DequantiseVertices(quantisedVertices, quantisation, decodedVertices);
+
+	ExpectWithinBounds(vertices, decodedVertices, quantisation);
+}
+
+// The normals on the axes and the diagonals are where the octahedral folding changes sides.
+TEST(VertexQuantiserTest, AxisNormalsRoundTrip)
+{
+	std::vector<Vertex> vertices{};
+
+	for (const float x : { -1.f, 0.f, 1.f })
+		for (const float y : { -1.f, 0.f, 1.f })
+			for (const float z : { -1.f, 0.f, 1.f })
+			{
+				if (x == 0.f && y == 0.f && z == 0.f)
+					continue;
+
+				Vertex& vertex = vertices.emplace_back(Vertex{ .position = { x, y, z } });
+
+				DirectX::XMStoreFloat3(
+					&vertex.normal,
+					DirectX::XMVector3Normalize(DirectX::XMVectorSet(x, y, z, 0.f))
+				);
+			}
+
+	const VertexQuantisation quantisation = VertexQuantiser::GenerateQuantisation(vertices);
+
+	std::vector<QuantisedVertex> quantisedVertices(std::size(vertices));
+	VertexQuantiser::QuantiseVertices(vertices, quantisation, quantisedVertices);
+
+	std::vector<Vertex> decodedVertices(std::size(vertices));
+	VertexQuantiser::DequantiseVertices(quantisedVertices, quantisation, decodedVertices);
+
+	ExpectWithinBounds(vertices, decodedVertices, quantisation);
+}
+
+// The vertices are quantised in batches, so the ones in a partial batch at the end must come
+// out the same as they would on their own.
+TEST(VertexQuantiserTest, BatchTailsMatch)
+{
+	const std::vector<Vertex> vertices = GenerateRandomVertices(9u);
+
+	const VertexQuantisation quantisation = VertexQuantiser::GenerateQuantisation(vertices);
+
+	std::vector<QuantisedVertex> singleVertices(std::size(vertices));
+
+	for (size_t index = 0u; index < std::size(vertices); ++index)
+		VertexQuantiser::QuantiseVertices(
+			std::span{ vertices }.subspan(index, 1u), quantisation,
+			std::span{ singleVertices }.subspan(index, 1u)
+		);
+
+	for (size_t vertexCount = 1u; vertexCount <= std::size(vertices); ++vertexCount)
+	{
+		std::vector<QuantisedVertex> quantisedVertices(vertexCount);
+
+		VertexQuantiser::QuantiseVertices(
+			std::span{ vertices }.first(vertexCount), quantisation, quantisedVertices
+		);
+
+		EXPECT_EQ(
+			std::memcmp(
+				std::data(quantisedVertices), std::data(singleVertices),
+				vertexCount * sizeof(QuantisedVertex)
+			), 0
+		) << vertexCount << " vertices";
+	}
+}
+
+// Each mesh is quantised to its own bounds. The plane is flat, so its height comes back as
+// it was.
+TEST(VertexQuantiserTest, MeshBundleRoundTrip)
+{
+	for (const bool meshShader : { false, true })
+	{
+		auto GenerateBundle = [meshShader](bool quantise)
+		{
+			MeshBundleTempCustom bundle{};
+
+			bundle.SetVertexQuantisation(quantise);
+
+			bundle.AddMesh(GenerateSphere(16u, 32u));
+
+			Mesh plane = GeneratePlane(16u);
+
+			for (Vertex& vertex : plane.vertices)
+				vertex.position.y = 2.f;
+
+			bundle.AddMesh(std::move(plane));
+
+			return bundle.GenerateTemporaryData(meshShader);
+		};
+
+		const MeshBundleTemporaryData bundleData          = GenerateBundle(false);
+		const MeshBundleTemporaryData quantisedBundleData = GenerateBundle(true);
+
+		EXPECT_NO_THROW(CheckRenderableVertexLayout(bundleData));
+		EXPECT_THROW(CheckRenderableVertexLayout(quantisedBundleData), Exception);
+
+		ASSERT_EQ(quantisedBundleData.vertexLayout, VertexLayout::Quantised);
+		ASSERT_EQ(std::size(quantisedBundleData.vertexQuantisations), 2u);
+		EXPECT_TRUE(std::empty(quantisedBundleData.vertices));
+
+		const std::vector<Vertex> decodedVertices = DequantiseMeshBundleVertices(
+			quantisedBundleData
+		);
+
+		ASSERT_EQ(std::size(decodedVertices), std::size(bundleData.vertices));
+
+		const size_t sphereVertexCount = std::size(GenerateSphere(16u, 32u).vertices);
+
+		std::span<const Vertex> vertices          = bundleData.vertices;
+		std::span<const Vertex> decodedVertexSpan = decodedVertices;
+
+		ExpectWithinBounds(
+			vertices.first(sphereVertexCount), decodedVertexSpan.first(sphereVertexCount),
+			quantisedBundleData.vertexQuantisations[0]
+		);
+		ExpectWithinBounds(
+			vertices.subspan(sphereVertexCount), decodedVertexSpan.subspan(sphereVertexCount),
+			quantisedBundleData.vertexQuantisations[1]
+		);
+
+		for (const Vertex& vertex : decodedVertexSpan.subspan(sphereVertexCount))
+			EXPECT_EQ(vertex.position.y, 2.f);
+	}
+}